@@ -19,7 +19,10 @@ class CSAPEX_COMMAND_EXPORT Meta : public CommandImplementation<Meta>
 public:
     typedef std::shared_ptr<Meta> Ptr;
 
-    Meta(const AUUID& graph_uuid, const std::string& type, bool transaction = false);
+    /**
+     * @brief Meta groups commands, with transaction set the graph is only analyzed once all of them have been executed
+     */
+    Meta(const AUUID& graph_uuid, const std::string& type, bool transaction = true);
     virtual void clear();
     void add(Command::Ptr cmd);
 
@@ -40,6 +43,12 @@ protected:
 
     virtual std::string getDescription() const override;
 
+    /**
+     * @brief getTransactionGraph returns the graph whose analysis is deferred until all nested commands are done
+     * @return nullptr, if the nested commands are not run in a transaction
+     */
+    GraphImplementationPtr getTransactionGraph();
+
 protected:
     std::vector<Command::Ptr> nested;
     bool locked;
@@ -0,0 +1,64 @@
+#ifndef GRAPH_BINARY_FORMAT_H
+#define GRAPH_BINARY_FORMAT_H
+
+/// PROJECT
+#include <csapex/serialization/serialization_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <cstdint>
+#include <string>
+
+namespace YAML
+{
+class Node;
+}
+
+namespace csapex
+{
+/**
+ * @brief The GraphBinaryFormat class contains the framing of binary graph files.
+ * A file starts with a magic string and the format version, followed by a yaml tree with the settings and the view state
+ * and then by the graph itself, written by GraphIO with the regular serializers of the model.
+ */
+class CSAPEX_CORE_EXPORT GraphBinaryFormat
+{
+public:
+    static const char MAGIC[8];
+    static const uint16_t VERSION;
+
+public:
+    /**
+     * @brief isBinaryFile checks whether the path uses the extension of binary graph files
+     */
+    static bool isBinaryFile(const std::string& path);
+
+    static void writeHeader(SerializationBuffer& data);
+
+    /**
+     * @brief readHeader checks the magic string and the version
+     * @throws std::runtime_error if the data is not a binary graph or was written by a newer version
+     */
+    static uint16_t readHeader(const SerializationBuffer& data);
+
+    /**
+     * @brief writeYaml stores a yaml tree without emitting it as text, tags and styles other than the tag are dropped
+     */
+    static void writeYaml(SerializationBuffer& data, const YAML::Node& node);
+    static void readYaml(const SerializationBuffer& data, YAML::Node& node);
+
+    /**
+     * @brief readFile loads a whole file, the buffer is positioned at the first byte of the file
+     */
+    static SerializationBuffer readFile(const std::string& path);
+    static void writeFile(const std::string& path, const SerializationBuffer& data);
+
+    /**
+     * @brief append copies the payload of a buffer without its packet header
+     */
+    static void append(SerializationBuffer& data, const SerializationBuffer& payload);
+};
+
+}  // namespace csapex
+
+#endif  // GRAPH_BINARY_FORMAT_H
@@ -26,6 +26,12 @@ public:
     // options
     void setIgnoreForwardingConnections(bool ignore);
 
+    /**
+     * @brief setLoadThreads sets how many threads construct and deserialize nodes that allow concurrent loading, 0 uses one per core.
+     * The default of 1 loads every node on the calling thread.
+     */
+    void setLoadThreads(std::size_t threads);
+
     // api
     void saveSettings(YAML::Node& yaml);
     void loadSettings(const YAML::Node& doc);
@@ -36,6 +42,18 @@ public:
     void loadGraph(const Snippet& doc);
     void loadGraphFrom(const YAML::Node& doc);
 
+    /**
+     * @brief saveGraphTo writes the graph in the binary format, only the view state is stored in yaml
+     */
+    void saveGraphTo(SerializationBuffer& data, YAML::Node& yaml);
+    void loadGraphFrom(const SerializationBuffer& data, const YAML::Node& yaml);
+
+    /**
+     * @brief convertToBinary converts a complete graph file between the two formats without instantiating any nodes
+     */
+    static void convertToBinary(const YAML::Node& yaml, SerializationBuffer& data);
+    static void convertToYaml(const SerializationBuffer& data, YAML::Node& yaml);
+
     Snippet saveSelectedGraph(const std::vector<UUID>& nodes);
 
     std::unordered_map<UUID, UUID, UUID::Hasher> loadIntoGraph(const Snippet& blueprint, const csapex::Point& position);
@@ -45,17 +63,32 @@ public:
     csapex::slim_signal::Signal<void(GraphFacade&, const YAML::Node& n)> loadViewRequest;
 
 private:
+    struct LoadedNode;
+
     void saveNodes(YAML::Node& yaml);
     void loadNodes(const YAML::Node& doc);
-    void loadNode(const YAML::Node& doc);
+    void loadNodes(std::vector<LoadedNode>& nodes);
 
     void saveConnections(YAML::Node& yaml);
     void loadConnections(const YAML::Node& doc);
     void loadConnection(const YAML::Node& connection);
 
-    void saveFulcrums(YAML::Node& fulcrum, const ConnectionDescription& connection);
+    static void saveFulcrums(YAML::Node& fulcrum, const ConnectionDescription& connection);
     void loadFulcrum(const YAML::Node& fulcrum);
 
+    void saveNodes(SerializationBuffer& data);
+    void loadNodes(const SerializationBuffer& data);
+
+    void saveConnections(SerializationBuffer& data);
+    void loadConnections(const SerializationBuffer& data);
+    void loadConnection(const ConnectionDescription& connection);
+
+    static void encodeConnections(YAML::Node& yaml, const std::vector<ConnectionDescription>& connections, bool ignore_forwarding_connections);
+    static std::vector<ConnectionDescription> decodeConnections(const YAML::Node& doc);
+
+    static void convertGraphToBinary(const YAML::Node& yaml, SerializationBuffer& data);
+    static void convertGraphToYaml(const SerializationBuffer& data, YAML::Node& yaml);
+
     void sendNotification(const std::string& notification);
 
 protected:
@@ -65,7 +98,22 @@ protected:
     void serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr node_handle);
     void deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_handle);
 
-    void loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type);
+    /**
+     * @brief deserializeNodeState restores a node that is not yet part of the graph, it may run concurrently for different nodes
+     */
+    void deserializeNodeState(const YAML::Node& doc, NodeFacadeImplementationPtr node_handle);
+
+    /**
+     * @brief insertNode adds a deserialized node to the graph and loads its subgraph
+     */
+    void insertNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_handle);
+
+    void serializeNode(SerializationBuffer& data, NodeFacadeImplementationConstPtr node_handle);
+    void deserializeNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_handle);
+    void deserializeNodeState(const SerializationBuffer& data, NodeFacadeImplementationPtr node_handle);
+    void insertNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_handle);
+
+    ConnectionPtr loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type);
 
     UUID readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
     UUID readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
@@ -80,6 +128,7 @@ private:
 
     bool ignore_forwarding_connections_;
     bool throw_on_error_;
+    std::size_t load_threads_;
 };
 
 }  // namespace csapex
@@ -40,6 +40,13 @@ public:
     NodeFacadeImplementationPtr makeGraph(const UUID& uuid, const UUIDProviderPtr& uuid_provider);
     NodeFacadeImplementationPtr makeGraph(const UUID& uuid, const UUIDProviderPtr& uuid_provider, NodeStatePtr state);
 
+    /**
+     * @brief makeNodes constructs and sets up a batch of nodes, given as pairs of type and uuid, on up to threads threads.
+     * Only types that allow concurrent loading are spread over the threads, all others are constructed by the calling thread.
+     * Unknown types and failed constructions yield nullptr. Notifications and node_constructed are emitted afterwards in the order of the batch.
+     */
+    std::vector<NodeFacadeImplementationPtr> makeNodes(const std::vector<std::pair<std::string, UUID>>& nodes, const UUIDProviderPtr& uuid_provider, std::size_t threads);
+
 public:
     slim_signal::Signal<void(const std::string&)> loaded;
     slim_signal::Signal<void()> new_node_type;
@@ -51,6 +58,8 @@ protected:
     void rebuildPrototypes();
     void rebuildMap();
 
+    NodeFacadeImplementationPtr constructNode(const NodeConstructorPtr& constructor, const UUID& uuid, const UUIDProviderPtr& uuid_provider, NodeStatePtr state);
+
 protected:
     Settings& settings_;
     csapex::PluginLocator* plugin_locator_;
@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include <csapex/serialization/serialization_fwd.h>
+#include <csapex/plugin/plugin_fwd.h>
 #include <csapex/utility/slim_signal.hpp>
 
 /// SYSTEM
@@ -14,8 +15,6 @@
 
 namespace csapex
 {
-class PluginLocator;
-
 class SnippetFactory
 {
 public:
@@ -37,6 +36,7 @@ public:
 
 private:
     void addSnippet(SnippetPtr s);
+    SnippetPtr loadSnippet(const std::string& file, PluginManifestCache& cache);
 
 private:
     PluginLocator* plugin_locator_;
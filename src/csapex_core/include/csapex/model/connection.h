@@ -10,6 +10,7 @@
 #include <csapex/model/token.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/connection_description.h>
+#include <csapex/model/queue_policy.h>
 
 /// SYSTEM
 #include <memory>
@@ -84,6 +85,26 @@ public:
     bool holdsToken() const;
     bool holdsActiveToken() const;
 
+    /**
+     * @brief canReceiveToken checks if the producer may send another token without waiting for the consumer
+     * @return true, iff the connection is done or there is room left in the queue
+     */
+    bool canReceiveToken() const;
+
+    /**
+     * @brief setQueueCapacity sets the maximum number of tokens held by this connection
+     * @param capacity 1 means unbuffered, the producer always waits for the consumer
+     */
+    void setQueueCapacity(std::size_t capacity);
+    std::size_t getQueueCapacity() const;
+
+    void setQueuePolicy(QueuePolicy policy);
+    QueuePolicy getQueuePolicy() const;
+
+    std::size_t countQueuedTokens() const;
+    std::size_t countDroppedTokens() const;
+    void clearQueue();
+
     bool isActive() const;
     void setActive(bool active);
 
@@ -143,6 +164,11 @@ protected:
     State state_;
     TokenPtr message_;
 
+    std::deque<TokenPtr> queue_;
+    std::size_t queue_capacity_;
+    QueuePolicy queue_policy_;
+    std::size_t dropped_tokens_;
+
     static int next_connection_id_;
 
     mutable std::recursive_mutex sync;
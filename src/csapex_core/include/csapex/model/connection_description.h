@@ -7,6 +7,7 @@
 #include <csapex/model/model_fwd.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/fulcrum.h>
+#include <csapex/model/queue_policy.h>
 
 namespace csapex
 {
@@ -28,6 +29,9 @@ public:
 
     std::vector<Fulcrum> fulcrums;
 
+    std::size_t queue_capacity;
+    QueuePolicy queue_policy;
+
     ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums);
 
     ConnectionDescription(const ConnectionDescription& other);
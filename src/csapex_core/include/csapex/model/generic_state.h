@@ -66,12 +66,19 @@ public:
 
     void setFrom(const GenericState& rhs);
 
+    /**
+     * @brief mergeFrom adds or updates the parameters of a deserialized state, the same way readYaml does
+     */
+    void mergeFrom(const GenericState& loaded);
+
     void writeYaml(YAML::Node& out) const;
     void readYaml(const YAML::Node& node);
 
     void initializePersistentParameters();
 
 private:
+    void mergeParameters(const std::map<std::string, csapex::param::ParameterPtr>& loaded);
+
     void registerParameter(const csapex::param::ParameterPtr& param);
     void unregisterParameter(const csapex::param::ParameterPtr& param);
 
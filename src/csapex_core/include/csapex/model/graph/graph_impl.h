@@ -4,6 +4,10 @@
 /// COMPONENT
 #include <csapex/model/graph.h>
 
+/// SYSTEM
+#include <unordered_map>
+#include <unordered_set>
+
 namespace csapex
 {
 class GraphImplementation : public Graph
@@ -58,15 +62,27 @@ public:
 
     std::size_t countNodes() override;
 
+    /**
+     * @brief addNode
+     * @throws std::invalid_argument if the UUID of the node is not relative to this graph
+     */
     void addNode(NodeFacadeImplementationPtr node);
     void deleteNode(const UUID& uuid);
 
     bool addConnection(ConnectionPtr connection);
     void deleteConnection(ConnectionPtr connection);
 
+    /**
+     * @brief beginTransaction defers the analysis of all following changes until the matching finalizeTransaction.
+     * Transactions can be nested, only the outermost one analyzes the graph.
+     */
     void beginTransaction();
     void finalizeTransaction();
+    bool isInTransaction() const;
 
+    /**
+     * @brief analyzeGraph rebuilds the components and the characteristics of all nodes from scratch
+     */
     void analyzeGraph();
 
     void setNodeFacade(NodeFacadeImplementation* nf);
@@ -81,26 +97,79 @@ public:
 private:
     void checkNodeState(NodeHandle* nh);
 
+    /**
+     * @brief findVertexNoThrow resolves the first depth levels of uuid without copying it
+     */
+    graph::Vertex* findVertexNoThrow(const UUID& uuid, std::size_t depth) const noexcept;
+    bool isLocalVertex(const graph::VertexPtr& vertex) const;
+
+    void indexConnector(const ConnectablePtr& connector);
+    void unindexConnector(const ConnectablePtr& connector);
+    static uint64_t getConnectorKey(const UUID& connector_uuid);
+
+    graph::VertexPtr findLocalVertexForConnector(const UUID& connector_uuid) const;
+
+    // components are kept up to date on every change, their characteristics only when the outermost transaction ends
+    void markChanged(const graph::VertexPtr& vertex);
+    void addComponent(const graph::VertexPtr& vertex);
+    void mergeComponents(const graph::VertexPtr& a, const graph::VertexPtr& b);
+    void removeFromComponent(const graph::VertexPtr& vertex);
+    void splitComponent(int component);
+    void analyzeChanges();
+
     void buildConnectedComponents();
-    void calculateDepths();
+    void analyzeRegion(const std::vector<graph::VertexPtr>& region);
+    void calculateDepths(const std::vector<graph::VertexPtr>& region, const std::unordered_set<graph::Vertex*>& in_region);
 
-    std::set<graph::Vertex*> findVerticesThatNeedMessages();
-    std::set<graph::Vertex*> findVerticesThatJoinStreams();
+    std::set<graph::Vertex*> findVerticesThatNeedMessages(const std::vector<graph::VertexPtr>& region);
+    std::set<graph::Vertex*> findVerticesThatJoinStreams(const std::vector<graph::VertexPtr>& region, const std::unordered_set<graph::Vertex*>& in_region);
 
 protected:
     std::vector<graph::VertexPtr> vertices_;
     std::vector<ConnectionPtr> edges_;
 
+    // indices of the nodes of this graph by their id and of their external connectors by (node id, connector id)
+    std::unordered_map<UUID::Symbol, graph::VertexPtr> vertex_index_;
+    std::unordered_map<uint64_t, ConnectableWeakPtr> connector_index_;
+    std::map<graph::Vertex*, std::vector<slim_signal::ScopedConnection>> vertex_observations_;
+
     std::map<Connection*, std::vector<slim_signal::ScopedConnection>> connection_observations_;
 
     std::set<graph::VertexPtr> sources_;
     std::set<graph::VertexPtr> sinks_;
 
-    bool in_transaction_;
+    // members of each connected component, indexed by NodeCharacteristics::component
+    std::unordered_map<int, std::vector<graph::VertexPtr>> components_;
+    int next_component_;
+
+    // components whose characteristics are outdated and components that might have fallen apart
+    std::set<int> changed_components_;
+    std::set<int> split_components_;
+
+    int transaction_depth_;
 
     NodeFacadeImplementation* nf_;
 };
 
+/**
+ * @brief The GraphTransaction class keeps a transaction of a graph open for its own lifetime.
+ * Without a graph, it does nothing.
+ */
+class GraphTransaction
+{
+public:
+    explicit GraphTransaction(GraphImplementation& graph);
+    explicit GraphTransaction(const GraphImplementationPtr& graph);
+    ~GraphTransaction();
+
+    GraphTransaction(const GraphTransaction&) = delete;
+    GraphTransaction& operator=(const GraphTransaction&) = delete;
+
+private:
+    GraphImplementationPtr keep_alive_;
+    GraphImplementation* graph_;
+};
+
 }  // namespace csapex
 
 #endif  // GRAPH_IMPL_H
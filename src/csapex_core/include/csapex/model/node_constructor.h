@@ -57,6 +57,12 @@ public:
     NodeConstructor& setDescription(const std::string& description);
     std::string getDescription() const;
 
+    /**
+     * @brief setConcurrentLoading marks the type as safe to construct, set up and deserialize concurrently to other nodes, off by default
+     */
+    NodeConstructor& setConcurrentLoading(bool concurrent);
+    bool allowsConcurrentLoading() const;
+
     NodeHandlePtr makePrototype() const;
     NodeHandlePtr makeNodeHandle(const UUID& uuid, const UUIDProviderPtr& uuid_provider) const;
 
@@ -75,6 +81,7 @@ protected:
     std::string descr_;
     std::string icon_;
     std::vector<TagPtr> tags_;
+    bool concurrent_loading_;
 
     mutable std::vector<std::string> properties_;
     mutable bool properties_loaded_;
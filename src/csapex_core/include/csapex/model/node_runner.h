@@ -2,6 +2,7 @@
 #define NODE_RUNNER_H
 
 /// PROJECT
+#include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/task_generator.h>
 #include <csapex/model/model_fwd.h>
 #include <csapex/model/notifier.h>
@@ -12,12 +13,24 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 namespace csapex
 {
 class CSAPEX_CORE_EXPORT NodeRunner : public TaskGenerator, public Observer, public Notifier
 {
+public:
+    /**
+     * @brief DEADLINE_MISSES names the profiler counter of processing cycles of rate limited nodes that finished after their deadline
+     */
+    static const std::string DEADLINE_MISSES;
+
+    /**
+     * @brief QUEUE_WAIT names the profiler step that records how long a scheduled processing task waited until its execution started
+     */
+    static const std::string QUEUE_WAIT;
+
 public:
     NodeRunner(NodeWorkerPtr worker);
     ~NodeRunner();
@@ -42,7 +55,7 @@ public:
     virtual void reset() override;
 
     void schedule(TaskPtr task);
-    void scheduleDelayed(TaskPtr task, std::chrono::system_clock::time_point time);
+    void scheduleDelayed(TaskPtr task, std::chrono::steady_clock::time_point time);
 
     void setSuppressExceptions(bool suppress_exceptions);
 
@@ -52,7 +65,10 @@ private:
     void connectNodeWorker();
 
     void measureFrequency();
+    void checkDeadline();
+    void recordQueueWait();
     void scheduleProcess();
+    void prioritize(const TaskPtr& task);
     void checkParameters();
     void execute();
 
@@ -72,9 +88,11 @@ private:
     TaskPtr execute_;
 
     std::vector<TaskPtr> remaining_tasks_;
+    std::vector<DelayedTask> remaining_delayed_tasks_;
 
     long guard_;
     double max_frequency_;
+    std::chrono::steady_clock::time_point processing_deadline_;
 
     bool waiting_for_execution_;
 
@@ -36,6 +36,12 @@ public:
     void writeYaml(YAML::Node& out) const;
     void readYaml(const YAML::Node& node);
 
+    /**
+     * @brief readState applies a deserialized state the same way readYaml does.
+     * The thread and the activity are runtime properties and are left untouched.
+     */
+    void readState(const NodeState& loaded);
+
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -0,0 +1,17 @@
+#ifndef QUEUE_POLICY_H
+#define QUEUE_POLICY_H
+
+namespace csapex
+{
+/**
+ * @brief The QueuePolicy enum determines what a buffered connection does when its queue is full
+ */
+enum class QueuePolicy
+{
+    BLOCK,
+    DROP_OLDEST,
+    DROP_NEWEST
+};
+}  // namespace csapex
+
+#endif  // QUEUE_POLICY_H
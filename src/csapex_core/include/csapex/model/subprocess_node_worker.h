@@ -72,6 +72,9 @@ private:
 private:
     pid_t pid_;
 
+    /// the newest sequence number of the tokens the child is processing
+    int received_sequence_number_;
+
     std::unique_ptr<Subprocess> subprocess_;
 
     std::vector<param::Parameter*> changed_parameters_;
@@ -21,6 +21,7 @@ public:
 
 public:
     Token(const TokenDataConstPtr& token);
+    Token(const Token& other);
 
     void setActivityModifier(ActivityModifier active);
     bool hasActivityModifier() const;
@@ -33,7 +34,18 @@ public:
 
     virtual void cloneData(const Token& other);
 
+    /**
+     * @brief shallowClone creates a token with a copy of the per-send metadata that shares the immutable payload
+     */
+    Ptr shallowClone() const;
+
+    /**
+     * @brief isImmutable is true for tokens that are shared between senders, their metadata must not be changed
+     */
+    bool isImmutable() const;
+
     static Ptr makeEmpty();
+    static Ptr makeImmutable(const TokenDataConstPtr& token);
 
 private:
     Token();
@@ -44,6 +56,8 @@ private:
     ActivityModifier activity_modifier_;
 
     mutable int seq_no_;
+
+    bool immutable_;
 };
 
 }  // namespace csapex
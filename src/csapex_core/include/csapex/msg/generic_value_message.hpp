@@ -42,6 +42,16 @@ public:
         static csapex::DirectMessageSerializerRegistered<connection_types::GenericValueMessage, Type> reg_s;
     }
 
+    /**
+     * @brief recycle reinitializes a pooled message, the storage of the previous value is reused where possible
+     */
+    void recycle(const Type& value = Type(), const std::string& frame_id = "/", Message::Stamp stamp = 0)
+    {
+        this->value = value;
+        this->frame_id = frame_id;
+        this->stamp_micro_seconds = stamp;
+    }
+
     bool acceptsConnectionFrom(const TokenData* other_side) const override
     {
         if (dynamic_cast<const GenericValueMessage<Type>*>(other_side)) {
@@ -7,6 +7,7 @@
 #include <csapex/model/node_runner.h>
 
 /// SYSTEM
+#include <atomic>
 #include <unordered_map>
 
 namespace csapex
@@ -48,6 +49,12 @@ protected:
 private:
     bool areConnectionsReady() const;
 
+    /**
+     * @brief realignSequenceNumbers skips the tokens of inputs that fell behind after a connection dropped a token
+     * @return false, if another realignment is in progress, which checks the transition once it is done
+     */
+    bool realignSequenceNumbers();
+
 private:
     std::map<InputPtr, std::vector<slim_signal::Connection>> input_signal_connections_;
 
@@ -55,6 +62,10 @@ private:
 
     bool forwarded_;
     bool processed_;
+
+    std::atomic<bool> realigning_;
+    bool realign_pending_;
+    std::size_t dropped_tokens_seen_;
 };
 
 }  // namespace csapex
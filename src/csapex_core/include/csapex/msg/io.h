@@ -220,6 +220,12 @@ std::shared_ptr<T> allocate(Output* output, Args&&... args)
     return allocator.allocate<T>(std::forward<Args>(args)...);
 }
 
+/**
+ * @brief setMessagePooling lets allocate and publish recycle the messages of an output once every reader has released them
+ */
+CSAPEX_CORE_EXPORT void setMessagePooling(Output* output, bool pooling, std::size_t capacity = MessagePool::DEFAULT_CAPACITY);
+CSAPEX_CORE_EXPORT MessagePool::Statistics getMessagePoolStatistics(Output* output);
+
 CSAPEX_CORE_EXPORT void publish(Output* output, TokenDataConstPtr message);
 
 template <typename T, typename = typename std::enable_if<connection_types::should_use_pointer_message<T>::value && !connection_types::is_std_vector<T>::value>::type>
@@ -3,6 +3,8 @@
 
 /// PROJECT
 #include <csapex_core/csapex_core_export.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/msg/message_pool.h>
 
 /// SYSTEM
 #include <memory>
@@ -93,11 +95,18 @@ public:
                 allocator_->deallocate(raw);
                 return nullptr;
             }
+        } else if (pool_) {
+            return pool_->allocate<T>(std::forward<Args>(args)...);
         } else {
             return std::make_shared<T>(std::forward<Args>(args)...);
         }
     }
 
+    /**
+     * @brief allocateToken creates the token that carries a published message, pooled if pooling is enabled
+     */
+    TokenPtr allocateToken(const TokenDataConstPtr& data);
+
     template <typename T, typename Alloc>
     void setAllocator(const Alloc& alloc)
     {
@@ -105,8 +114,19 @@ public:
         allocator_ = new MessageAllocatorImplementation<T, Alloc>(alloc);
     }
 
+    /**
+     * @brief setPooling enables recycling of messages once every reader has released them.
+     * An allocator set with setAllocator takes precedence over the pool.
+     * @param capacity the maximum number of released messages that are kept per type
+     */
+    void setPooling(bool pooling, std::size_t capacity = MessagePool::DEFAULT_CAPACITY);
+    bool isPooling() const;
+
+    MessagePool::Statistics getPoolStatistics() const;
+
 private:
     MessageAllocatorImplementationInterface* allocator_;
+    std::shared_ptr<MessagePool> pool_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,216 @@
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+/// PROJECT
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace csapex
+{
+namespace detail
+{
+template <typename T>
+class is_recyclable
+{
+    template <typename U>
+    static auto test(int) -> decltype(std::declval<U&>().recycle(), std::true_type());
+    template <typename>
+    static std::false_type test(...);
+
+public:
+    static constexpr bool value = decltype(test<T>(0))::value;
+};
+}  // namespace detail
+
+/**
+ * @brief The MessagePool class recycles the memory of messages once every holder has released them.
+ * Messages that provide a <code>recycle(...)</code> member are kept alive in the pool and are reset
+ * with the allocation arguments, so that large inner buffers survive. All other messages are
+ * destroyed as usual and only their storage is reused.
+ * Messages hold a reference to their pool, so it is safe to release them after the owner is gone.
+ */
+class CSAPEX_CORE_EXPORT MessagePool : public std::enable_shared_from_this<MessagePool>
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 16;
+
+    struct Statistics
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t recycled;
+        std::size_t dropped;
+    };
+
+    /**
+     * @brief The BlockAllocator class serves the shared_ptr control blocks of pooled messages
+     */
+    template <typename T>
+    class BlockAllocator
+    {
+    public:
+        typedef T value_type;
+
+        BlockAllocator(const std::shared_ptr<MessagePool>& pool) : pool_(pool)
+        {
+        }
+        template <typename U>
+        BlockAllocator(const BlockAllocator<U>& other) : pool_(other.pool_)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(pool_->takeBlock(n * sizeof(T)));
+        }
+        void deallocate(T* ptr, std::size_t n)
+        {
+            pool_->giveBlock(ptr, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const BlockAllocator<U>& other) const
+        {
+            return pool_ == other.pool_;
+        }
+        template <typename U>
+        bool operator!=(const BlockAllocator<U>& other) const
+        {
+            return pool_ != other.pool_;
+        }
+
+    private:
+        template <typename U>
+        friend class BlockAllocator;
+
+        std::shared_ptr<MessagePool> pool_;
+    };
+
+public:
+    static std::shared_ptr<MessagePool> make(std::size_t capacity = DEFAULT_CAPACITY);
+    ~MessagePool();
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> allocate(Args&&... args)
+    {
+        return allocateImpl<T>(std::integral_constant<bool, detail::is_recyclable<T>::value>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief capacity is the maximum number of released entries that are kept per type
+     */
+    std::size_t getCapacity() const;
+    Statistics getStatistics() const;
+
+    /**
+     * @brief clear frees all entries that are currently in the pool
+     */
+    void clear();
+
+private:
+    typedef void (*Destructor)(void*);
+
+    struct FreeList
+    {
+        std::vector<void*> entries;
+        Destructor destroy;
+    };
+
+    template <typename T>
+    struct Recycler
+    {
+        std::shared_ptr<MessagePool> pool;
+
+        void operator()(T* ptr) noexcept
+        {
+            if (!pool->give(typeid(T), ptr, &destroyObject<T>)) {
+                delete ptr;
+            }
+        }
+    };
+
+    template <typename T>
+    struct Releaser
+    {
+        std::shared_ptr<MessagePool> pool;
+
+        void operator()(T* ptr) noexcept
+        {
+            ptr->~T();
+            if (!pool->give(typeid(T), ptr, &releaseStorage)) {
+                releaseStorage(ptr);
+            }
+        }
+    };
+
+    template <typename T>
+    static void destroyObject(void* ptr)
+    {
+        delete static_cast<T*>(ptr);
+    }
+    static void releaseStorage(void* ptr);
+
+private:
+    explicit MessagePool(std::size_t capacity);
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> allocateImpl(std::true_type /*recyclable*/, Args&&... args)
+    {
+        T* ptr = static_cast<T*>(take(typeid(T)));
+        if (ptr) {
+            ptr->recycle(std::forward<Args>(args)...);
+        } else {
+            ptr = new T(std::forward<Args>(args)...);
+        }
+        return std::shared_ptr<T>(ptr, Recycler<T>{ shared_from_this() }, BlockAllocator<T>(shared_from_this()));
+    }
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> allocateImpl(std::false_type /*recyclable*/, Args&&... args)
+    {
+        void* storage = take(typeid(T));
+        if (!storage) {
+            storage = ::operator new(sizeof(T));
+        }
+        T* ptr;
+        try {
+            ptr = new (storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            releaseStorage(storage);
+            throw;
+        }
+        return std::shared_ptr<T>(ptr, Releaser<T>{ shared_from_this() }, BlockAllocator<T>(shared_from_this()));
+    }
+
+    void* take(const std::type_index& type);
+    bool give(const std::type_index& type, void* entry, Destructor destroy);
+
+    void* takeBlock(std::size_t size);
+    void giveBlock(void* block, std::size_t size);
+
+private:
+    std::size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::type_index, FreeList> entries_;
+    std::unordered_map<std::size_t, std::vector<void*>> blocks_;
+
+    std::atomic<std::size_t> hits_;
+    std::atomic<std::size_t> misses_;
+    std::atomic<std::size_t> recycled_;
+    std::atomic<std::size_t> dropped_;
+};
+
+}  // namespace csapex
+
+#endif  // MESSAGE_POOL_H
@@ -28,11 +28,30 @@ inline std::string serializationName()
 }
 
 TokenPtr makeToken(const TokenDataConstPtr& data);
+TokenPtr makeImmutableToken(const TokenDataConstPtr& data);
+
+template <typename T>
+inline TokenDataConstPtr getEmptyTokenData()
+{
+    // empty payloads are immutable, so all tokens of one type can share the same instance
+    static const TokenDataConstPtr data = makeEmpty<T>();
+    return data;
+}
 
 template <typename T>
 inline TokenPtr makeEmptyToken()
 {
-    return makeToken(makeEmpty<T>());
+    return makeToken(getEmptyTokenData<T>());
+}
+
+/**
+ * @brief getSharedEmptyToken returns one immutable empty token per type, it must not be modified
+ */
+template <typename T>
+inline TokenPtr getSharedEmptyToken()
+{
+    static const TokenPtr token = makeImmutableToken(getEmptyTokenData<T>());
+    return token;
 }
 
 template <typename M, bool is_message>
@@ -6,6 +6,8 @@
 
 /// SYSTEM
 #include <csapex/utility/slim_signal.hpp>
+#include <memory>
+#include <mutex>
 
 namespace csapex
 {
@@ -16,7 +18,7 @@ public:
     typedef std::function<typename std::shared_ptr<M>()> Call;
 
 public:
-    PluginConstructor()
+    PluginConstructor() : instances_mutex_(std::make_shared<std::mutex>())
     {
     }
 
@@ -32,6 +34,8 @@ public:
         if (!res) {
             throw std::runtime_error(std::string("cannot construct class ") + type);
         }
+        // plugins can be constructed concurrently, e.g. while a graph is loaded
+        std::unique_lock<std::mutex> lock(*instances_mutex_);
         instances_.push_back(res);
         return res;
     }
@@ -60,6 +64,7 @@ public:
 
     std::vector<std::weak_ptr<M> > getInstances()
     {
+        std::unique_lock<std::mutex> lock(*instances_mutex_);
         return instances_;
     }
 
@@ -68,6 +73,7 @@ private:
 
     std::string library_name_;
     mutable std::vector<std::weak_ptr<M> > instances_;
+    std::shared_ptr<std::mutex> instances_mutex_;
 };
 }  // namespace csapex
 
@@ -17,6 +17,7 @@ template <typename T>
 class PluginManager;
 
 FWD(PluginLocator)
+FWD(PluginManifestCache)
 }  // namespace csapex
 
 #undef FWD
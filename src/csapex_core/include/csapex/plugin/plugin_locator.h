@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include <csapex/core/settings.h>
+#include <csapex/plugin/plugin_fwd.h>
 
 /// SYSTEM
 #include <string>
@@ -61,6 +62,11 @@ public:
     void setPluginPaths(const std::string& type, const std::vector<std::string>& paths);
     std::vector<std::string> getPluginPaths(const std::string& type) const;
 
+    /**
+     * @brief getManifestCache returns the cache shared by all factories, it is loaded from the path in the setting "plugin_cache" on first use
+     */
+    PluginManifestCachePtr getManifestCache();
+
 private:
     PluginLocator(const PluginLocator& copy) = delete;
     PluginLocator& operator=(const PluginLocator& copy) = delete;
@@ -80,6 +86,8 @@ private:
     param::StringListParameterPtr ignored_persistent_;
 
     std::map<std::string, std::vector<std::string>> plugin_paths_;
+
+    PluginManifestCachePtr manifest_cache_;
 };
 }  // namespace csapex
 
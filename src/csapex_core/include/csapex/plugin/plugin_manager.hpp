@@ -121,6 +121,7 @@ protected:
             bf3::path file_candidate = ld_path + '/' + library_name + ".so";
             if (bf3::exists(file_candidate)) {
                 library_stamp_[library_name] = bf3::last_write_time(file_candidate);
+                library_file_[library_name] = file_candidate.string();
                 exists = true;
                 break;
             }
@@ -249,6 +250,17 @@ protected:
         }
     }
 
+    std::string getLibraryFile(const std::string& class_name)
+    {
+        std::string library = plugin_to_library_.at(class_name);
+        auto pos = library_file_.find(library);
+        if (pos == library_file_.end()) {
+            return library;
+        } else {
+            return pos->second;
+        }
+    }
+
 protected:
     slim_signal::Signal<void(const std::string&)> loaded;
     slim_signal::Signal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
@@ -259,6 +271,7 @@ protected:
     std::map<std::string, std::shared_ptr<class_loader::ClassLoader> > loaders_;
     std::map<std::string, std::string> plugin_to_library_;
     std::map<std::string, std::time_t> library_stamp_;
+    std::map<std::string, std::string> library_file_;
 
     std::vector<std::string> library_paths_;
     std::map<std::string, csapex::PluginLocator*> library_to_locator_;
@@ -385,6 +398,15 @@ public:
         return instance->getLastModification(class_name);
     }
 
+    /**
+     * @brief getLibraryFile returns the path of the library that provides a class, or the name of the library if it has not been located
+     */
+    std::string getLibraryFile(const std::string& class_name)
+    {
+        std::unique_lock<std::mutex> lock(PluginManagerLocker::getMutex());
+        return instance->getLibraryFile(class_name);
+    }
+
 public:
     slim_signal::Signal<void(const std::string&)> loaded;
     slim_signal::Signal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
@@ -0,0 +1,103 @@
+#ifndef PLUGIN_MANIFEST_CACHE_H
+#define PLUGIN_MANIFEST_CACHE_H
+
+/// PROJECT
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The PluginManifestCache class remembers what has been learned about plugin libraries and snippets on a previous start.
+ * Every entry is stored together with the modification time and the size of its file and is discarded as soon as either changes,
+ * so that nodes can be listed without loading their library.
+ */
+class CSAPEX_CORE_EXPORT PluginManifestCache
+{
+public:
+    static const int VERSION;
+
+    struct Stamp
+    {
+        Stamp();
+
+        std::time_t modification;
+        std::uintmax_t size;
+
+        bool operator==(const Stamp& other) const;
+        bool operator!=(const Stamp& other) const;
+    };
+
+    struct NodeEntry
+    {
+        std::vector<std::string> properties;
+    };
+
+    struct SnippetEntry
+    {
+        std::string name;
+        std::string description;
+        std::vector<std::string> tags;
+    };
+
+public:
+    PluginManifestCache(const std::string& path);
+
+    /**
+     * @brief stamp returns the modification time and size of a file, missing files yield an empty stamp
+     */
+    static Stamp stamp(const std::string& file);
+
+    std::string getPath() const;
+
+    /**
+     * @brief load reads the cache file, a missing or unreadable file results in an empty cache
+     */
+    void load();
+
+    /**
+     * @brief save writes the cache file if any entry has changed since it was loaded
+     */
+    void save();
+
+    bool isDirty() const;
+
+    bool findNode(const std::string& library_file, const Stamp& stamp, const std::string& type, NodeEntry& entry) const;
+    void storeNode(const std::string& library_file, const Stamp& stamp, const std::string& type, const NodeEntry& entry);
+
+    bool findSnippet(const std::string& file, const Stamp& stamp, SnippetEntry& entry) const;
+    void storeSnippet(const std::string& file, const Stamp& stamp, const SnippetEntry& entry);
+
+private:
+    struct Library
+    {
+        Stamp stamp;
+        std::map<std::string, NodeEntry> nodes;
+    };
+
+    struct Snippet
+    {
+        Stamp stamp;
+        SnippetEntry entry;
+    };
+
+    std::string path_;
+
+    mutable std::mutex mutex_;
+
+    std::map<std::string, Library> libraries_;
+    std::map<std::string, Snippet> snippets_;
+
+    bool dirty_;
+};
+
+}  // namespace csapex
+
+#endif  // PLUGIN_MANIFEST_CACHE_H
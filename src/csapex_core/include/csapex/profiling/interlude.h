@@ -6,12 +6,17 @@
 #include <csapex_profiling_export.h>
 
 /// SYSTEM
+#include <cstdint>
 #include <memory>
 
 namespace csapex
 {
 class Timer;
 
+/**
+ * @brief The Interlude class measures one step of a Timer, the step is recorded as a single TraceEvent on destruction.
+ * A null or disabled timer makes the interlude a no-op.
+ */
 class CSAPEX_PROFILING_EXPORT Interlude
 {
 public:
@@ -28,7 +33,10 @@ private:
 
 private:
     Timer* parent_;
-    Interval::Ptr interval_;
+
+    uint64_t start_;
+    uint32_t name_;
+    uint32_t cycle_;
 };
 
 }  // namespace csapex
@@ -45,6 +45,16 @@ public:
 
     void entries(std::vector<std::pair<std::string, double> >& out) const;
 
+    /**
+     * @brief addSpan attaches a finished span to the sub interval with the given name, repeated spans are accumulated
+     */
+    Ptr addSpan(const std::string& name, const std::chrono::high_resolution_clock::time_point& start, const std::chrono::high_resolution_clock::time_point& end);
+
+    /**
+     * @brief deepCopy copies the interval together with all of its sub intervals
+     */
+    Ptr deepCopy() const;
+
     void setActive(bool active);
     bool isActive() const;
 
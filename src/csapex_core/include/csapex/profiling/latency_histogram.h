@@ -0,0 +1,59 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+/// COMPONENT
+#include <csapex_profiling_export.h>
+#include <csapex/serialization/serializable.h>
+
+/// SYSTEM
+#include <cstdint>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The LatencyHistogram class counts durations in log-bucketed bins, similar to an HDR histogram.
+ * Values below 2^SUB_BUCKET_BITS microseconds are counted exactly, larger values with a relative
+ * error below 2^-(SUB_BUCKET_BITS - 1). Recording is O(1) and memory grows with the largest value seen.
+ */
+class CSAPEX_PROFILING_EXPORT LatencyHistogram : public Serializable
+{
+protected:
+    CLONABLE_IMPLEMENTATION(LatencyHistogram);
+
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t micro_seconds);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t max() const;
+    double mean() const;
+
+    /**
+     * @brief percentile returns the highest value that is equivalent to the value at the given percentile
+     * @param percentile in [0, 100]
+     */
+    uint64_t percentile(double percentile) const;
+
+    void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+    static std::size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketUpperBound(std::size_t index);
+
+private:
+    std::vector<uint64_t> buckets_;
+    uint64_t count_;
+    uint64_t max_;
+    double sum_;
+};
+
+}  // namespace csapex
+
+#endif  // LATENCY_HISTOGRAM_H
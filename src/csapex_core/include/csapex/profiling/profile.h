@@ -3,9 +3,12 @@
 
 /// COMPONENT
 #include <csapex/profiling/timer.h>
+#include <csapex/profiling/latency_histogram.h>
+#include <csapex/profiling/trace_recorder.h>
 #include <csapex_profiling_export.h>
 
 /// SYSTEM
+#include <mutex>
 #define BOOST_PARAMETER_MAX_ARITY 7
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics.hpp>
@@ -16,6 +19,13 @@ struct ProfilerStats
 {
     double mean;
     double stddev;
+
+    // percentiles of the current window in milliseconds
+    std::size_t count;
+    double p50;
+    double p99;
+    double p999;
+    double max;
 };
 
 struct CSAPEX_PROFILING_EXPORT Profile
@@ -32,16 +42,49 @@ public:
     std::size_t size() const;
     int getCurrentIndex() const;
 
-    const std::vector<Interval::Ptr>& getIntervals() const;
+    /**
+     * @brief getIntervals attaches all buffered steps and returns copies of the interval history
+     */
+    std::vector<Interval::Ptr> getIntervals() const;
     Interval::Ptr getInterval(const std::size_t index) const;
 
     ProfilerStats getStats(const std::string& name) const;
+    const LatencyHistogram& getHistogram(const std::string& name) const;
+    std::vector<std::string> getStepNames() const;
+
+    /**
+     * @brief getCounter returns how often an event has been counted since the last reset, 0 for unknown events
+     */
+    long getCounter(const std::string& name) const;
+    std::vector<std::string> getCounterNames() const;
+
     void reset();
 
+    /**
+     * @brief resetWindow starts a new statistics window, the interval history is kept
+     */
+    void resetWindow();
+
 protected:
     void addInterval(Interval::Ptr interval);
 
+    /**
+     * @brief addStep accounts a step that was recorded by the timer of this profile
+     */
+    void addStep(const TraceEvent& event);
+
+    void increment(const std::string& name, long amount);
+    void addSample(const std::string& name, uint64_t nano_seconds);
+
+private:
+    void record(const std::string& name, uint64_t nano_seconds);
+    void recordInterval(const Interval& interval);
+    void addSpan(Interval& interval, const std::string& name, const TraceEvent& event);
+    void resetWindowUnlocked();
+
 private:
+    std::unique_ptr<std::mutex> mutex_;
+
     Timer::Ptr timer;
 
     std::size_t timer_history_length;
@@ -50,7 +93,11 @@ private:
     typedef boost::accumulators::stats<boost::accumulators::tag::variance> stats;
     typedef boost::accumulators::accumulator_set<double, stats> accumulator;
     std::map<std::string, accumulator> steps_acc_;
+    std::map<std::string, LatencyHistogram> steps_hist_;
+    std::map<std::string, long> counters_;
     std::vector<Interval::Ptr> timer_history_;
+    std::vector<uint32_t> timer_history_cycles_;
+    std::vector<TraceEvent> pending_steps_;
     unsigned int count_;
 };
 
@@ -18,16 +18,34 @@ public:
     slim_signal::Signal<void()> updated;
 
 public:
+    virtual ~Profiler();
+
     virtual void setEnabled(bool enabled);
     bool isEnabled() const;
 
     void reset();
 
+    /**
+     * @brief resetWindow starts a new window for the latency statistics of all profiles
+     */
+    virtual void resetWindow();
+
     Timer::Ptr getTimer(const std::string& key);
     const Profile& getProfile(const std::string& key);
 
+    /**
+     * @brief increment counts an event, like a missed deadline, in the profile of the given key
+     */
+    void increment(const std::string& key, const std::string& counter, long amount = 1);
+
+    /**
+     * @brief record accounts a duration that was not measured by the timer of the given key, like the wake-up latency of a worker
+     */
+    void record(const std::string& key, const std::string& step, uint64_t nano_seconds);
+
 public:
     slim_signal::Signal<void(bool)> enabled_changed;
+    slim_signal::Signal<void()> window_reset;
 
 protected:
     Profiler(bool enabled, int history);
@@ -8,6 +8,7 @@
 #include <csapex_profiling_export.h>
 
 /// SYSTEM
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -44,6 +45,12 @@ public:
 
     long elapsedMs() const;
 
+    /**
+     * @brief getScope identifies the steps of this timer in the TraceRecorder
+     */
+    uint32_t getScope() const;
+    uint32_t getCycle() const;
+
 public:
     std::string timer_name_;
 
@@ -53,6 +60,10 @@ public:
     bool enabled_;
     bool dirty_;
     bool finished_;
+
+private:
+    uint32_t scope_;
+    std::atomic<uint32_t> cycle_;
 };
 
 }  // namespace csapex
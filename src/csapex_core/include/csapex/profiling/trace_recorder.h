@@ -0,0 +1,112 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+/// COMPONENT
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The TraceEvent struct describes one completed step, it is trivially copyable and fixed-size
+ */
+struct TraceEvent
+{
+    uint64_t start;     // nanoseconds of the steady clock
+    uint64_t duration;  // nanoseconds
+    uint32_t name;      // interned step name
+    uint32_t scope;     // the timer that recorded the step
+    uint32_t cycle;     // the cycle of the timer in which the step started
+    uint32_t padding;
+};
+
+/**
+ * @brief The TraceBuffer class is a fixed-size single producer / single consumer ring of events.
+ * Events that do not fit into the ring are dropped and counted.
+ */
+class CSAPEX_PROFILING_EXPORT TraceBuffer
+{
+public:
+    static constexpr std::size_t CAPACITY = 2048;
+
+public:
+    TraceBuffer();
+
+    bool push(const TraceEvent& event);
+    std::size_t consume(const std::function<void(const TraceEvent&)>& callback);
+
+    std::size_t size() const;
+    std::size_t getDropped() const;
+
+private:
+    TraceEvent events_[CAPACITY];
+    std::atomic<std::size_t> head_;
+    std::atomic<std::size_t> tail_;
+    std::atomic<std::size_t> dropped_;
+};
+
+/**
+ * @brief The TraceRecorder class collects step events of all threads without locking on the recording side.
+ * Every thread writes into its own TraceBuffer, flush() drains all buffers and hands the events to the
+ * subscriber of their scope. Flushing happens when statistics are requested or when a buffer runs full.
+ */
+class CSAPEX_PROFILING_EXPORT TraceRecorder
+{
+public:
+    typedef std::function<void(const TraceEvent&)> Subscriber;
+
+public:
+    static TraceRecorder& instance();
+
+    static uint64_t now();
+    static std::chrono::high_resolution_clock::time_point toWallTime(uint64_t steady_ns);
+
+    /**
+     * @brief intern maps a step name to a stable id, repeated lookups from one thread do not lock
+     */
+    static uint32_t intern(const std::string& name);
+    static std::string nameOf(uint32_t id);
+
+    uint32_t makeScope();
+
+    void record(const TraceEvent& event);
+
+    void subscribe(uint32_t scope, const Subscriber& subscriber);
+    void unsubscribe(uint32_t scope);
+
+    void flush();
+    std::size_t getDropped() const;
+
+private:
+    TraceRecorder();
+
+    TraceBuffer& getLocalBuffer();
+    void flush(std::unique_lock<std::mutex>& consumer_lock);
+
+private:
+    std::atomic<uint32_t> next_scope_;
+
+    mutable std::mutex buffers_mutex_;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers_;
+    std::size_t dropped_by_exited_threads_;
+
+    std::mutex consumer_mutex_;
+    std::map<uint32_t, Subscriber> subscribers_;
+
+    uint64_t steady_origin_;
+    std::chrono::high_resolution_clock::time_point wall_origin_;
+};
+
+}  // namespace csapex
+
+#endif  // TRACE_RECORDER_H
@@ -0,0 +1,32 @@
+#ifndef IDLE_STRATEGY_H
+#define IDLE_STRATEGY_H
+
+/// COMPONENT
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief The IdleStrategy enum selects what the workers of a thread group do while there is no task to execute.
+ * BLOCK parks the worker until a producer wakes it up, which costs a context switch per hand-off.
+ * SPIN_THEN_PARK polls for the spin budget of the group before it parks, producers do not need to wake spinning workers.
+ * BUSY_POLL never parks and only yields to other threads, it occupies a core even if the group is idle.
+ */
+enum class IdleStrategy
+{
+    BLOCK,
+    SPIN_THEN_PARK,
+    BUSY_POLL
+};
+
+namespace idle_strategy
+{
+CSAPEX_CORE_EXPORT std::string name(IdleStrategy strategy);
+CSAPEX_CORE_EXPORT IdleStrategy fromName(const std::string& name);
+}  // namespace idle_strategy
+}  // namespace csapex
+
+#endif  // IDLE_STRATEGY_H
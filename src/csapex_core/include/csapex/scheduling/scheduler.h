@@ -3,14 +3,25 @@
 
 /// PROJECT
 #include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/scheduling/task_priority.h>
 #include <csapex_core/csapex_core_export.h>
 
 /// SYSTEM
+#include <chrono>
 #include <vector>
 #include <csapex/utility/slim_signal.hpp>
 
 namespace csapex
 {
+/**
+ * @brief DelayedTask is a task that is handed to its scheduler once time has come
+ */
+struct DelayedTask
+{
+    TaskPtr task;
+    std::chrono::steady_clock::time_point time;
+};
+
 class CSAPEX_CORE_EXPORT Scheduler
 {
 public:
@@ -34,12 +45,17 @@ public:
 
     virtual bool isEmpty() const = 0;
 
+    virtual TaskPriorityPolicy getPriorityPolicy() const = 0;
+
     virtual void add(TaskGeneratorPtr schedulable) = 0;
     virtual void add(TaskGeneratorPtr schedulable, const std::vector<TaskPtr>& initial_tasks) = 0;
-    virtual std::vector<TaskPtr> remove(TaskGenerator* schedulable) = 0;
+    /**
+     * @brief remove detaches a generator and returns its queued tasks, its delayed tasks are moved into delayed with their time
+     */
+    virtual std::vector<TaskPtr> remove(TaskGenerator* schedulable, std::vector<DelayedTask>& delayed) = 0;
 
     virtual void schedule(TaskPtr schedulable) = 0;
-    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::system_clock::time_point time) = 0;
+    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::steady_clock::time_point time) = 0;
 
 public:
     slim_signal::Signal<void()> stepping_enabled;
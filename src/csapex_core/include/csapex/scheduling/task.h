@@ -7,6 +7,9 @@
 
 /// SYSTEM
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <string>
 
 namespace csapex
 {
@@ -18,12 +21,37 @@ public:
 
     virtual void execute();
 
+    /**
+     * @brief setPriority orders the task in the ready queue of its group, see TaskQueue::PRIORITY_LEVELS for the valid range
+     */
     void setPriority(long priority);
     long getPriority() const;
 
+    /**
+     * @brief setDeadline marks the task as periodic, groups with deadline scheduling execute the earliest deadline first
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    void clearDeadline();
+    bool hasDeadline() const;
+    std::chrono::steady_clock::time_point getDeadline() const;
+
+    /**
+     * @brief setScheduledTime remembers when the task was handed to an idle or profiled group,
+     * to measure how long waking up a worker takes and how long the task waited for its execution.
+     * The default time point means that the task was not stamped.
+     */
+    void setScheduledTime(std::chrono::steady_clock::time_point time);
+    std::chrono::steady_clock::time_point getScheduledTime() const;
+
     void setScheduled(bool scheduled);
     bool isScheduled() const;
 
+    /**
+     * @brief trySetScheduled atomically marks the task as scheduled
+     * @return false, iff the task already was scheduled
+     */
+    bool trySetScheduled();
+
     TaskGenerator* getParent() const;
     std::string getName() const;
 
@@ -33,7 +61,9 @@ private:
     std::function<void()> callback_;
 
     long priority_;
-    bool scheduled_;
+    std::chrono::steady_clock::time_point deadline_;
+    std::chrono::steady_clock::time_point scheduled_time_;
+    std::atomic<bool> scheduled_;
 };
 
 }  // namespace csapex
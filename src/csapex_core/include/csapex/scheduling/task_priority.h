@@ -0,0 +1,41 @@
+#ifndef TASK_PRIORITY_H
+#define TASK_PRIORITY_H
+
+/// COMPONENT
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief The TaskPriorityPolicy enum selects how a thread pool orders the ready tasks of its groups.
+ * FIFO executes all tasks in the order they became ready.
+ * CRITICAL_PATH prefers nodes that are further away from the sources of their graph, so that tokens
+ * which are already in flight are processed before the sources start new ones.
+ */
+enum class TaskPriorityPolicy
+{
+    FIFO,
+    CRITICAL_PATH
+};
+
+namespace task_priority
+{
+CSAPEX_CORE_EXPORT std::string name(TaskPriorityPolicy policy);
+CSAPEX_CORE_EXPORT TaskPriorityPolicy fromName(const std::string& name);
+
+/**
+ * @brief forProcessing returns the priority of processing a node at the given depth, -1 for unknown depths
+ */
+CSAPEX_CORE_EXPORT long forProcessing(TaskPriorityPolicy policy, int depth);
+
+/**
+ * @brief forControl returns the priority of parameter updates and other short tasks that must not starve behind processing
+ */
+CSAPEX_CORE_EXPORT long forControl(TaskPriorityPolicy policy);
+}  // namespace task_priority
+}  // namespace csapex
+
+#endif  // TASK_PRIORITY_H
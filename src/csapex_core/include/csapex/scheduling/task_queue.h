@@ -0,0 +1,60 @@
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+/// COMPONENT
+#include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// PROJECT
+#include <csapex/utility/mpsc_queue.hpp>
+
+/// SYSTEM
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The TaskQueue class holds ready tasks in a fixed number of priority levels.
+ * Tasks with a higher priority are popped first, tasks of the same priority in FIFO order.
+ * Every priority is its own level, so valid priorities are in [0, PRIORITY_LEVELS).
+ * Pushing never blocks. Groups with several workers have several consumers,
+ * so popping takes a mutex and is not lock-free.
+ */
+class CSAPEX_CORE_EXPORT TaskQueue
+{
+public:
+    static constexpr std::size_t PRIORITY_LEVELS = 16;
+
+public:
+    TaskQueue();
+
+    void push(const TaskPtr& task);
+    TaskPtr pop();
+
+    /**
+     * @brief drain removes all tasks that are currently visible in the queue
+     * @return the removed tasks in the order they would have been popped
+     */
+    std::vector<TaskPtr> drain();
+
+    std::size_t size() const;
+    bool empty() const;
+
+    /**
+     * @brief getLevel maps a priority to its level, priorities outside of [0, PRIORITY_LEVELS) are rejected
+     */
+    static std::size_t getLevel(long priority);
+
+private:
+    std::array<MPSCQueue<TaskPtr>, PRIORITY_LEVELS> levels_;
+    std::atomic<std::size_t> size_;
+
+    std::mutex consumer_mtx_;
+};
+
+}  // namespace csapex
+
+#endif  // TASK_QUEUE_H
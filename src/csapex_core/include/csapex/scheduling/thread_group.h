@@ -2,8 +2,10 @@
 #define THREAD_GROUP_H
 
 /// PROJECT
+#include <csapex/scheduling/idle_strategy.h>
 #include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/task.h>
+#include <csapex/scheduling/task_queue.h>
 #include <csapex/core/core_fwd.h>
 #include <csapex/utility/utility_fwd.h>
 #include <csapex/profiling/profiling_fwd.h>
@@ -14,9 +16,13 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <set>
+#include <map>
+#include <mutex>
+#include <memory>
 
 namespace YAML
 {
@@ -36,6 +42,11 @@ public:
         MINIMUM_THREAD_ID = 2
     };
 
+    /**
+     * @brief WAKE_UP_STEP is the profiler step of a group's timers that records how long an idle worker took to start a newly scheduled task
+     */
+    static const std::string WAKE_UP_STEP;
+
 public:
     static int nextId();
 
@@ -51,8 +62,69 @@ public:
 
     CpuAffinityPtr getCpuAffinity() const;
 
+    /**
+     * @brief thread returns the first worker of this group
+     * @deprecated groups can have several workers, use getThreads
+     */
     const std::thread& thread() const;
 
+    /**
+     * @brief getThreads lists the threads of all workers, it is empty while the group is stopped
+     */
+    std::vector<const std::thread*> getThreads() const;
+
+    /**
+     * @brief setWorkerCount changes the number of threads executing the tasks of this group
+     * @param worker_count number of worker threads, 1 uses a single scheduling thread
+     * Groups with more than one worker share work with each other by stealing tasks.
+     */
+    void setWorkerCount(std::size_t worker_count);
+    std::size_t getWorkerCount() const;
+    bool isWorkStealingEnabled() const;
+
+    /**
+     * @brief setWorkStealingPeers sets the groups that idle workers may steal tasks from
+     */
+    void setWorkStealingPeers(const std::vector<ThreadGroupPtr>& peers);
+
+    /**
+     * @brief getTimerNames lists the profiler timers that record the tasks of this group, one per worker
+     */
+    std::vector<std::string> getTimerNames() const;
+
+    /**
+     * @brief setPriorityPolicy selects how the generators of this group prioritize their tasks, it is set by the owning thread pool
+     */
+    void setPriorityPolicy(TaskPriorityPolicy policy);
+    TaskPriorityPolicy getPriorityPolicy() const override;
+
+    /**
+     * @brief setDeadlineScheduling executes tasks with a deadline in earliest deadline first order, before all other tasks
+     * Tasks without a deadline keep their priority order and run whenever no task with a deadline is ready.
+     */
+    void setDeadlineScheduling(bool enabled);
+    bool isDeadlineSchedulingEnabled() const;
+
+    /**
+     * @brief setIdleStrategy selects how idle workers wait for new tasks
+     */
+    void setIdleStrategy(IdleStrategy strategy);
+    IdleStrategy getIdleStrategy() const;
+
+    /**
+     * @brief setSpinBudget sets how long workers poll for new tasks before they park, if the idle strategy is SPIN_THEN_PARK
+     */
+    void setSpinBudget(std::chrono::microseconds budget);
+    std::chrono::microseconds getSpinBudget() const;
+
+    /**
+     * @brief setRealtimePriority runs the workers with the SCHED_FIFO policy at the given priority, 0 uses the default policy
+     * Realtime priorities usually require elevated permissions. Busy polling workers with a realtime priority
+     * starve all threads with a lower priority on their cores, so they should get cores of their own via the cpu affinity.
+     */
+    void setRealtimePriority(int priority);
+    int getRealtimePriority() const;
+
     std::size_t size() const;
     virtual bool isEmpty() const override;
 
@@ -73,10 +145,10 @@ public:
     virtual void add(TaskGeneratorPtr generator) override;
     virtual void add(TaskGeneratorPtr generator, const std::vector<TaskPtr>& initial_tasks) override;
 
-    virtual std::vector<TaskPtr> remove(TaskGenerator* generator) override;
+    virtual std::vector<TaskPtr> remove(TaskGenerator* generator, std::vector<DelayedTask>& delayed) override;
 
     virtual void schedule(TaskPtr schedulable) override;
-    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::system_clock::time_point time) override;
+    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::steady_clock::time_point time) override;
 
     std::vector<TaskGeneratorPtr>::iterator begin();
     std::vector<TaskGeneratorPtr>::const_iterator begin() const;
@@ -90,16 +162,54 @@ public:
     slim_signal::Signal<void(TaskGeneratorPtr)> generator_added;
     slim_signal::Signal<void(TaskGeneratorPtr)> generator_removed;
 
+private:
+    struct Worker
+    {
+        ThreadGroup* group;
+        std::size_t index;
+        std::thread thread;
+
+        std::mutex tasks_mtx;
+        std::deque<TaskPtr> tasks;
+
+        // when the worker ran out of tasks, the epoch if it did not wait
+        std::chrono::steady_clock::time_point idle_since;
+    };
+
 private:
     void setup();
-    void schedulingLoop();
+    void startWorkers();
+    void stopWorkers();
+    void schedulingLoop(Worker& worker);
     void updateAffinity();
+    void updateRealtimePriority();
 
-    bool waitForTasks();
+    bool waitForTasks(Worker& worker);
+    bool hasTasks();
+    bool spinForTasks();
+    void wakeWorkers();
+    void recordWakeUp(Worker& worker, const TaskPtr& task);
     void handlePause();
-    bool executeNextTask();
+    bool executeNextTask(Worker& worker);
+
+    bool hasStealableTasks() const;
+    bool canStealTasks();
+    void notifyPeers();
 
-    void executeTask(const TaskPtr& task);
+    void enqueue(const TaskPtr& task);
+    bool usesDeadline(const TaskPtr& task) const;
+    TaskPtr popDeadlineTask();
+
+    TaskPtr popTask(Worker* worker);
+    TaskPtr takeNextTask(Worker* worker);
+    TaskPtr stealTask();
+    TaskPtr stealFromPeers(ThreadGroupPtr& victim);
+    bool claimTask(const TaskPtr& task);
+    void releaseTask(const TaskPtr& task);
+
+    std::string getTimerName(const Worker& worker) const;
+    void executeTask(const std::string& timer_name, const TaskPtr& task);
+    void waitForExecutingTasks(std::unique_lock<std::recursive_mutex>& execution_lock);
 
     void checkIfStepIsDone();
 
@@ -117,7 +227,12 @@ private:
 
     TimedQueuePtr timed_queue_;
 
-    std::thread scheduler_thread_;
+    std::atomic<std::size_t> worker_count_;
+    std::atomic<TaskPriorityPolicy> priority_policy_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex peers_mtx_;
+    std::vector<ThreadGroupWeakPtr> peers_;
 
     std::vector<TaskGeneratorPtr> generators_;
     std::map<TaskGenerator*, std::vector<slim_signal::ScopedConnection>> generator_connections_;
@@ -126,15 +241,24 @@ private:
     std::condition_variable_any pause_changed_;
 
     std::recursive_mutex tasks_mtx_;
-    struct greater
-    {
-        bool operator()(const TaskPtr& a, const TaskPtr& b)
-        {
-            return a->getPriority() > b->getPriority();
-        }
-    };
+    std::atomic<int> sleeping_workers_;
+    std::atomic<int> spinning_workers_;
 
-    std::multiset<TaskPtr, greater> tasks_;
+    std::atomic<IdleStrategy> idle_strategy_;
+    std::atomic<std::chrono::microseconds::rep> spin_budget_us_;
+    std::atomic<int> realtime_priority_;
+
+    TaskQueue tasks_;
+    std::atomic<std::size_t> queued_tasks_;
+
+    std::atomic<bool> deadline_scheduling_;
+    std::mutex deadline_mtx_;
+    std::multimap<std::chrono::steady_clock::time_point, TaskPtr> deadline_tasks_;
+    std::atomic<std::size_t> queued_deadline_tasks_;
+
+    std::mutex busy_mtx_;
+    std::set<TaskGenerator*> busy_generators_;
+    std::map<TaskGenerator*, std::deque<TaskPtr>> deferred_tasks_;
 
     std::recursive_mutex state_mtx_;
     std::atomic<bool> running_;
@@ -142,6 +266,11 @@ private:
     std::atomic<bool> stepping_;
 
     mutable std::recursive_mutex execution_mtx_;
+    std::condition_variable_any execution_done_;
+    int executing_tasks_;
+
+    static thread_local Worker* current_worker_;
+    static thread_local ThreadGroup* executing_group_;
 };
 
 }  // namespace csapex
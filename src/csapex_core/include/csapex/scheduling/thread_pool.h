@@ -4,6 +4,7 @@
 /// COMPONENT
 #include <csapex/scheduling/executor.h>
 #include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/scheduling/task_priority.h>
 #include <csapex/core/exception_handler.h>
 #include <csapex/utility/utility_fwd.h>
 #include <csapex/model/observer.h>
@@ -54,7 +55,7 @@ public:
     void usePrivateThreadFor(TaskGenerator* task);
     void addToGroup(TaskGenerator* task, int group_id);
 
-    ThreadGroup* createGroup(const std::string& name, int id = -1);
+    ThreadGroup* createGroup(const std::string& name, int id = -1, std::size_t worker_count = 1);
     int createNewGroupFor(TaskGenerator* task, const std::string& name);
     void removeGroup(int id);
 
@@ -66,6 +67,12 @@ public:
     void setPrivateThreadGroupCpuAffinity(const std::vector<bool>& affinity);
     std::vector<bool> getPrivateThreadGroupCpuAffinity() const;
 
+    /**
+     * @brief setPriorityPolicy selects how the tasks of all groups of this pool are prioritized, the default is FIFO
+     */
+    void setPriorityPolicy(TaskPriorityPolicy policy);
+    TaskPriorityPolicy getPriorityPolicy() const;
+
     void setSuppressExceptions(bool suppress_exceptions) override;
 
     void useProfiler(std::shared_ptr<Profiler> profiler) override;
@@ -88,6 +95,7 @@ protected:
 private:
     void setup();
     void assignGeneratorToGroup(TaskGenerator* task, ThreadGroup* group);
+    void updateWorkStealingPeers();
 
     bool isInPrivateThread(TaskGenerator* task) const;
     bool isInGroup(TaskGenerator* task, int id) const;
@@ -112,6 +120,8 @@ private:
     CpuAffinityPtr private_group_cpu_affinity_;
     std::map<ThreadGroup*, std::vector<slim_signal::ScopedConnection>> private_group_connections_;
 
+    TaskPriorityPolicy priority_policy_;
+
     bool suppress_exceptions_;
 };
 
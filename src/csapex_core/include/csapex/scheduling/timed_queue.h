@@ -2,61 +2,123 @@
 #define TIMED_QUEUE_H
 
 /// COMPONENT
+#include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex_core/csapex_core_export.h>
 
 /// SYSTEM
+#include <array>
 #include <thread>
 #include <condition_variable>
 #include <chrono>
-#include <set>
-#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace csapex
 {
-class TimedQueue
+/**
+ * @brief The TimedQueue class hands delayed tasks back to their scheduler once their time has come.
+ * Timers are kept in a hierarchical timer wheel with LEVELS levels of SLOTS slots each, so that adding and
+ * cancelling a timer is O(1). A single thread sleeps until the next occupied slot and is only woken
+ * when a new timer expires before that, timers that fall into the same tick are handed over together in the
+ * order they were added.
+ * Timers never fire before their time, but up to one RESOLUTION late.
+ */
+class CSAPEX_CORE_EXPORT TimedQueue
 {
+public:
+    static constexpr std::chrono::microseconds RESOLUTION{ 100 };
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr std::size_t SLOTS = 1 << SLOT_BITS;
+    static constexpr std::size_t LEVELS = 5;
+
 public:
     TimedQueue();
     ~TimedQueue();
 
-    void schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::system_clock::time_point time);
+    void schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::steady_clock::time_point time);
+
+    /**
+     * @brief cancel removes all timers of tasks belonging to the given generator
+     * @return the tasks of the removed timers with their time, a task with several timers only once with the earliest
+     */
+    std::vector<DelayedTask> cancel(TaskGenerator* generator);
+
+    std::size_t size() const;
 
     void start();
     void stop();
 
 private:
-    void loop();
-    void sleep();
-
-private:
-    std::thread scheduling_thread_;
-    std::thread sleeping_thread_;
-
-    std::atomic<bool> scheduling_running_;
-    std::atomic<bool> sleeping_running_;
-
-    struct Unit
+    struct Timer
     {
         SchedulerPtr scheduler;
         TaskPtr schedulable;
-        std::chrono::system_clock::time_point time;
+        TaskGenerator* generator;
+        uint64_t expiry;
+
+        // position in the wheel, level == LEVELS means the overflow list
+        std::size_t level;
+        std::size_t slot;
+        Timer* prev;
+        Timer* next;
+
+        // timers of the same generator
+        Timer* prev_of_generator;
+        Timer* next_of_generator;
     };
 
-    struct UnitCompare
+    struct Slot
     {
-        bool operator()(const Unit& a, const Unit& b) const
-        {
-            return a.time < b.time;
-        }
+        Timer* head = nullptr;
+        Timer* tail = nullptr;
     };
 
-    std::mutex task_mtx_;
-    std::condition_variable tasks_changed_;
-    std::set<Unit, UnitCompare> tasks_;
+    typedef std::vector<std::pair<SchedulerPtr, TaskPtr>> Expired;
+
+    void loop();
+
+    uint64_t toTick(std::chrono::steady_clock::time_point time) const;
+    std::chrono::steady_clock::time_point toTime(uint64_t tick) const;
+
+    void insert(Timer* timer);
+    void link(Timer* timer, Slot& slot);
+    void unlink(Timer* timer);
+    void release(Timer* timer);
+    Slot& slotOf(const Timer* timer);
+
+    /**
+     * @brief nextEvent returns the next tick at which a timer expires or has to be moved to a lower level
+     */
+    uint64_t nextEvent() const;
+    void advanceTo(uint64_t tick, Expired& expired);
+    void cascade(std::size_t level);
+
+private:
+    static const uint64_t NEVER;
+
+    std::thread thread_;
+    bool running_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_up_;
+
+    std::chrono::steady_clock::time_point epoch_;
+    uint64_t current_;
+    uint64_t next_wake_up_;
+
+    std::array<std::array<Slot, SLOTS>, LEVELS> wheel_;
+    std::array<uint64_t, LEVELS> occupied_;
+    Slot overflow_;
+
+    std::unordered_map<TaskGenerator*, Timer*> generators_;
 
-    std::mutex sleep_mtx_;
-    std::condition_variable next_wake_up_changed_;
-    std::chrono::system_clock::time_point next_wake_up_;
+    std::deque<Timer> timers_;
+    std::vector<Timer*> free_timers_;
+    std::size_t size_;
 };
 
 }  // namespace csapex
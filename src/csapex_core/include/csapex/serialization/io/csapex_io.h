@@ -26,8 +26,7 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, UUID& s);
 template <typename S, typename std::enable_if<std::is_base_of<Serializable, S>::value, int>::type = 0>
 SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
 {
-    apex_assert_lt_hard(s.size(), std::numeric_limits<uint8_t>::max());
-    data << (static_cast<uint8_t>(s.size()));
+    data.writeLength(s.size());
     for (const S& elem : s) {
         // disambiguate possible overloads for serializable objects
         data << static_cast<const Serializable&>(elem);
@@ -38,11 +37,10 @@ SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>&
 template <typename S, typename std::enable_if<std::is_integral<S>::value && std::is_base_of<Serializable, S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         S integral;
         data >> integral;
         s.push_back(integral);
@@ -53,11 +51,10 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vect
 template <typename S, typename std::enable_if<!std::is_integral<S>::value && std::is_base_of<Serializable, S>::value && std::is_default_constructible<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         s.emplace_back();
         data >> static_cast<Serializable&>(s.back());
     }
@@ -67,11 +64,10 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vect
 template <typename S, typename std::enable_if<!std::is_integral<S>::value && std::is_base_of<Serializable, S>::value && !std::is_default_constructible<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         std::shared_ptr<S> object = makeEmpty<S>();
         data >> static_cast<Serializable&>(*object);
         s.push_back(*object);
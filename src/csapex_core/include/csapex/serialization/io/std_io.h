@@ -22,25 +22,58 @@ SerializationBuffer& operator<<(SerializationBuffer& data, const std::stringstre
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::stringstream& s);
 
 // VECTOR
-template <typename S, typename std::enable_if<!std::is_base_of<Serializable, S>::value, int>::type = 0>
+// Arithmetic vectors of at least SerializationBuffer::LENGTH_ESCAPE elements are stored as one little endian block,
+// shorter floating point vectors keep the element wise format for compatibility.
+template <typename S, typename std::enable_if<std::is_arithmetic<S>::value && !std::is_same<S, bool>::value, int>::type = 0>
 SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
 {
-    apex_assert_lt_hard(s.size(), std::numeric_limits<uint8_t>::max());
-    data << (static_cast<uint8_t>(s.size()));
+    data.writeLength(s.size());
+    if (std::is_floating_point<S>::value && s.size() < SerializationBuffer::LENGTH_ESCAPE) {
+        for (const S& elem : s) {
+            data << elem;
+        }
+    } else {
+        data.writeArray(s.data(), s.size());
+    }
+    return data;
+}
+
+template <typename S, typename std::enable_if<std::is_arithmetic<S>::value && !std::is_same<S, bool>::value, int>::type = 0>
+const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
+{
+    std::size_t len = data.readLength();
+    if (std::is_floating_point<S>::value && len < SerializationBuffer::LENGTH_ESCAPE) {
+        s.clear();
+        s.reserve(len);
+        for (std::size_t i = 0; i < len; ++i) {
+            S value;
+            data >> value;
+            s.push_back(value);
+        }
+    } else {
+        s.resize(len);
+        data.readArray(s.data(), len);
+    }
+    return data;
+}
+
+template <typename S, typename std::enable_if<(!std::is_arithmetic<S>::value || std::is_same<S, bool>::value) && !std::is_base_of<Serializable, S>::value, int>::type = 0>
+SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
+{
+    data.writeLength(s.size());
     for (const S& elem : s) {
         data << elem;
     }
     return data;
 }
 
-template <typename S, typename std::enable_if<std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<std::is_same<S, bool>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         S integral;
         data >> integral;
         s.push_back(integral);
@@ -48,28 +81,26 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vect
     return data;
 }
 
-template <typename S, typename std::enable_if<!std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value && std::is_default_constructible<S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<!std::is_arithmetic<S>::value && !std::is_base_of<Serializable, S>::value && std::is_default_constructible<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         s.emplace_back();
         data >> s.back();
     }
     return data;
 }
 
-template <typename S, typename std::enable_if<!std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value && !std::is_default_constructible<S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<!std::is_arithmetic<S>::value && !std::is_base_of<Serializable, S>::value && !std::is_default_constructible<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         std::shared_ptr<S> object = makeEmpty<S>();
         data >> object;
         s.push_back(*object);
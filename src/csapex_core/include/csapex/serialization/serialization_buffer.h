@@ -4,9 +4,11 @@
 /// PROJECT
 #include <csapex/utility/assert.h>
 #include <csapex/serialization/serialization_fwd.h>
+#include <csapex/serialization/serialization_buffer_allocator.h>
 
 /// SYSTEM
 #include <vector>
+#include <algorithm>
 #include <inttypes.h>
 #include <string>
 #include <functional>
@@ -15,6 +17,8 @@
 #include <typeindex>
 #include <boost/any.hpp>
 #include <map>
+#include <cstring>
+#include <type_traits>
 
 namespace YAML
 {
@@ -25,17 +29,40 @@ namespace csapex
 {
 /**
  * @brief SerializationBuffer
+ * Integers are stored in little endian byte order. On little endian hosts they are copied with memcpy.
+ * A buffer bound to a SerializationRegion serializes directly into that memory until it outgrows it.
  */
-class SerializationBuffer : public std::vector<uint8_t>
+class SerializationBuffer : public std::vector<uint8_t, SerializationBufferAllocator<uint8_t>>
 {
 public:
     static const uint8_t HEADER_LENGTH = 4;
 
+    static constexpr bool HOST_IS_LITTLE_ENDIAN = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+    /// container lengths of at least LENGTH_ESCAPE are stored as this byte followed by a 64 bit length
+    static const uint8_t LENGTH_ESCAPE = 255;
+
 public:
     SerializationBuffer();
     SerializationBuffer(const std::vector<uint8_t>& copy, bool insert_header = false);
     SerializationBuffer(const uint8_t* raw_data, const std::size_t length, bool insert_header = false);
 
+    /**
+     * @brief SerializationBuffer writes into region, data that does not fit moves the buffer to the heap
+     */
+    explicit SerializationBuffer(const std::shared_ptr<SerializationRegion>& region);
+
+    /**
+     * @brief view reads serialized data in place, which has to outlive the returned buffer
+     */
+    static SerializationBuffer view(const uint8_t* raw_data, const std::size_t length);
+
+    /**
+     * @brief isInRegion
+     * @return true, iff the data still lives in the region the buffer was created with
+     */
+    bool isInRegion() const;
+
     void finalize();
 
     void seek(uint32_t p) const;
@@ -46,6 +73,10 @@ public:
 
     std::string toString() const;
 
+    // CONTAINER LENGTHS
+    void writeLength(const std::size_t length);
+    std::size_t readLength() const;
+
     // SERIALIZABLES
     void write(const Streamable& i);
     void write(const StreamableConstPtr& i);
@@ -56,6 +87,39 @@ public:
     void readRaw(char* data, const std::size_t length) const;
     void readRaw(uint8_t* data, const std::size_t length) const;
 
+    /**
+     * @brief writeArray stores count arithmetic values as a contiguous little endian block
+     * Floating point values are stored as IEEE 754, which differs from the format of operator<<(float).
+     */
+    template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    void writeArray(const T* data, const std::size_t count)
+    {
+        const std::size_t length = count * sizeof(T);
+        uint8_t* target = grow(length);
+        if (HOST_IS_LITTLE_ENDIAN) {
+            std::memcpy(target, data, length);
+        } else {
+            const uint8_t* source = reinterpret_cast<const uint8_t*>(data);
+            for (std::size_t i = 0; i < count; ++i, source += sizeof(T), target += sizeof(T)) {
+                std::reverse_copy(source, source + sizeof(T), target);
+            }
+        }
+    }
+    template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    void readArray(T* data, const std::size_t count) const
+    {
+        const std::size_t length = count * sizeof(T);
+        const uint8_t* source = consume(length);
+        if (HOST_IS_LITTLE_ENDIAN) {
+            std::memcpy(data, source, length);
+        } else {
+            uint8_t* target = reinterpret_cast<uint8_t*>(data);
+            for (std::size_t i = 0; i < count; ++i, source += sizeof(T), target += sizeof(T)) {
+                std::reverse_copy(source, source + sizeof(T), target);
+            }
+        }
+    }
+
     template <typename T, typename std::enable_if<std::is_base_of<Streamable, T>::value, int>::type = 0>
     SerializationBuffer& operator<<(const std::shared_ptr<T>& i)
     {
@@ -73,23 +137,13 @@ public:
     template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
     SerializationBuffer& operator<<(T i)
     {
-        std::size_t nbytes = sizeof(T);
-        for (std::size_t byte = 0; byte < nbytes; ++byte) {
-            uint8_t part = (i >> (byte * 8)) & 0xFF;
-            push_back(part);
-        }
+        writeArray(&i, 1);
         return *this;
     }
     template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
     const SerializationBuffer& operator>>(T& i) const
     {
-        std::size_t nbytes = sizeof(T);
-        T res = 0;
-        for (std::size_t byte = 0; byte < nbytes; ++byte) {
-            uint8_t part = static_cast<T>(at(pos++));
-            res |= (part << (byte * 8));
-        }
-        i = res;
+        readArray(&i, 1);
         return *this;
     }
 
@@ -136,8 +190,23 @@ public:
     const SerializationBuffer& operator>>(YAML::Node& node) const;
 
 private:
+    SerializationBuffer(const std::shared_ptr<SerializationRegion>& region, std::size_t length);
+
     static void init();
 
+    /**
+     * @brief grow appends length uninitialized bytes
+     * @return a pointer to the first new byte
+     */
+    uint8_t* grow(const std::size_t length);
+
+    /**
+     * @brief consume advances the read position by length bytes
+     * @return a pointer to the first consumed byte
+     * @throws std::out_of_range if fewer than length bytes are left
+     */
+    const uint8_t* consume(const std::size_t length) const;
+
 private:
     mutable std::size_t pos;
 
@@ -0,0 +1,123 @@
+#ifndef SERIALIZATION_BUFFER_ALLOCATOR_H
+#define SERIALIZATION_BUFFER_ALLOCATOR_H
+
+/// SYSTEM
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace csapex
+{
+/**
+ * @brief SerializationRegion is externally owned memory that a SerializationBuffer can serialize into or read from
+ */
+struct SerializationRegion
+{
+    SerializationRegion(void* data, std::size_t capacity) : data(data), capacity(capacity), used(false)
+    {
+    }
+
+    void* data;
+    std::size_t capacity;
+    bool used;
+};
+
+/**
+ * @brief SerializationBufferAllocator allocates from the heap unless it is bound to a region.
+ * A bound allocator hands out the region for the first allocation that fits and falls back to the heap otherwise.
+ * Elements in the region are not value initialized, so a buffer can be resized over data that is already there.
+ */
+template <typename T>
+class SerializationBufferAllocator
+{
+public:
+    typedef T value_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    SerializationBufferAllocator() = default;
+    explicit SerializationBufferAllocator(const std::shared_ptr<SerializationRegion>& region) : region_(region)
+    {
+    }
+    template <typename U>
+    SerializationBufferAllocator(const SerializationBufferAllocator<U>& other) : region_(other.region())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (region_ && !region_->used && n * sizeof(T) <= region_->capacity) {
+            region_->used = true;
+            return static_cast<T*>(region_->data);
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        if (isRegion(p)) {
+            region_->used = false;
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    void construct(U* p)
+    {
+        if (!isRegion(p)) {
+            ::new (static_cast<void*>(p)) U();
+        }
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    /// copies of a buffer never share its region
+    SerializationBufferAllocator select_on_container_copy_construction() const
+    {
+        return SerializationBufferAllocator();
+    }
+
+    const std::shared_ptr<SerializationRegion>& region() const
+    {
+        return region_;
+    }
+
+private:
+    template <typename U>
+    bool isRegion(const U* p) const
+    {
+        if (!region_) {
+            return false;
+        }
+        const char* begin = static_cast<const char*>(region_->data);
+        const char* ptr = reinterpret_cast<const char*>(p);
+        return ptr >= begin && ptr < begin + region_->capacity;
+    }
+
+private:
+    std::shared_ptr<SerializationRegion> region_;
+};
+
+template <typename T, typename U>
+bool operator==(const SerializationBufferAllocator<T>& a, const SerializationBufferAllocator<U>& b)
+{
+    return a.region() == b.region();
+}
+
+template <typename T, typename U>
+bool operator!=(const SerializationBufferAllocator<T>& a, const SerializationBufferAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+}  // namespace csapex
+
+#endif  // SERIALIZATION_BUFFER_ALLOCATOR_H
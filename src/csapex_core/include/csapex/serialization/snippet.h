@@ -35,6 +35,11 @@ public:
     void save(const std::string& file) const;
     static Snippet load(const std::string& file);
 
+    /**
+     * @brief deferred makes a snippet that only reads its graph from the file when it is used for the first time
+     */
+    static Snippet deferred(const std::string& file);
+
     void setName(const std::string& name);
     std::string getName() const;
 
@@ -53,8 +58,12 @@ public:
 
     static std::shared_ptr<Snippet> makeEmpty();
 
+private:
+    void ensureLoaded() const;
+
 private:
     mutable std::shared_ptr<YAML::Node> yaml_;
+    std::string file_;
 
     std::string name_;
     std::string description_;
@@ -42,6 +42,8 @@ std::string GroupNodes::getDescription() const
 
 bool GroupNodes::doExecute()
 {
+    GraphTransaction batch(getTransactionGraph());
+
     SubgraphNodePtr graph = getSubgraphNode();
     {
         GraphIO io(*getGraphFacade(), getNodeFactory());
@@ -65,13 +65,20 @@ int Meta::commands() const
     return nested.size();
 }
 
+GraphImplementationPtr Meta::getTransactionGraph()
+{
+    if (!transaction) {
+        return nullptr;
+    }
+    return getGraph();
+}
+
 bool Meta::doExecute()
 {
     locked = true;
 
-    if (transaction) {
-        root_graph_facade_->getLocalGraph()->beginTransaction();
-    }
+    // the nested commands are analyzed together once all of them are done
+    GraphTransaction batch(getTransactionGraph());
 
     bool success = true;
     for (Command::Ptr cmd : nested) {
@@ -83,18 +90,12 @@ bool Meta::doExecute()
         success &= s;
     }
 
-    if (transaction) {
-        root_graph_facade_->getLocalGraph()->finalizeTransaction();
-    }
-
     return success;
 }
 
 bool Meta::doUndo()
 {
-    if (transaction) {
-        root_graph_facade_->getLocalGraph()->beginTransaction();
-    }
+    GraphTransaction batch(getTransactionGraph());
 
     for (auto it = nested.rbegin(); it != nested.rend(); ++it) {
         bool s = Access::undoCommand(*it);
@@ -103,20 +104,19 @@ bool Meta::doUndo()
         }
     }
 
-    if (transaction) {
-        root_graph_facade_->getLocalGraph()->finalizeTransaction();
-    }
-
     return true;
 }
 
 bool Meta::doRedo()
 {
+    GraphTransaction batch(getTransactionGraph());
+
     bool success = true;
     for (Command::Ptr cmd : nested) {
         bool s = Access::redoCommand(cmd);
         success &= s;
     }
+
     return success;
 }
 
@@ -49,6 +49,8 @@ bool UngroupNodes::doExecute()
     GraphImplementationPtr graph = std::dynamic_pointer_cast<GraphImplementation>(getGraph());
     apex_assert_hard(graph);
 
+    GraphTransaction batch(getTransactionGraph());
+
     NodeHandle* nh = graph->findNodeHandle(uuid);
     subgraph = std::dynamic_pointer_cast<SubgraphNode>(nh->getNode().lock());
 
@@ -5,6 +5,7 @@
 #include <csapex/core/bootstrap.h>
 #include <csapex/core/core_plugin.h>
 #include <csapex/core/exception_handler.h>
+#include <csapex/core/graph_binary_format.h>
 #include <csapex/core/graphio.h>
 #include <csapex/factory/node_factory_impl.h>
 #include <csapex/factory/snippet_factory.h>
@@ -22,6 +23,7 @@
 #include <csapex/plugin/plugin_manager.hpp>
 #include <csapex/profiling/profiler_impl.h>
 #include <csapex/scheduling/thread_pool.h>
+#include <csapex/serialization/serialization_buffer.h>
 #include <csapex/serialization/snippet.h>
 #include <csapex/utility/assert.h>
 #include <csapex/utility/error_handling.h>
@@ -31,6 +33,7 @@
 #include <csapex/io/server.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <fstream>
 #ifdef WIN32
 #include <direct.h>
@@ -503,21 +506,36 @@ void CsApexCore::saveAs(const std::string& file, bool quiet)
     thread_pool_->saveSettings(node_map);
 
     graphio.saveSettings(node_map);
-    graphio.saveGraphTo(node_map);
 
-    YAML::Emitter yaml;
+    if (GraphBinaryFormat::isBinaryFile(file)) {
+        // the graph has to be saved first, it also collects the view state into the yaml tree
+        SerializationBuffer graph;
+        graphio.saveGraphTo(graph, node_map);
 
-    {
-        auto interlude = timer->step("emit yaml");
-        yaml << node_map;
-    }
+        auto interlude = timer->step("write binary");
+        SerializationBuffer data;
+        GraphBinaryFormat::writeHeader(data);
+        GraphBinaryFormat::writeYaml(data, node_map);
+        GraphBinaryFormat::append(data, graph);
+        GraphBinaryFormat::writeFile(file, data);
+
+    } else {
+        graphio.saveGraphTo(node_map);
+
+        YAML::Emitter yaml;
+
+        {
+            auto interlude = timer->step("emit yaml");
+            yaml << node_map;
+        }
 
-    //    std::cerr << yaml.c_str() << std::endl;
-    {
-        auto interlude = timer->step("write yaml");
-        std::ofstream ofs(file.c_str());
-        ofs << "#!" << settings_.get<std::string>("path_to_bin") << '\n';
-        ofs << yaml.c_str();
+        //    std::cerr << yaml.c_str() << std::endl;
+        {
+            auto interlude = timer->step("write yaml");
+            std::ofstream ofs(file.c_str());
+            ofs << "#!" << settings_.get<std::string>("path_to_bin") << '\n';
+            ofs << yaml.c_str();
+        }
     }
 
     timer->finish();
@@ -554,8 +572,26 @@ void CsApexCore::load(const std::string& file)
     slim_signal::ScopedConnection connection = graphio.loadViewRequest.connect(load_detail_request);
 
     graphio.useProfiler(profiler_);
+    // nodes are loaded serially, unless load_threads allows the types that support it to be loaded concurrently, 0 uses one thread per core
+    graphio.setLoadThreads(std::max(0, settings_.getTemporary<int>("load_threads", 1)));
+
+    if (bf3::exists(file) && GraphBinaryFormat::isBinaryFile(file)) {
+        SerializationBuffer data = GraphBinaryFormat::readFile(file);
+        GraphBinaryFormat::readHeader(data);
+
+        // settings and view state are stored as yaml, the graph itself follows in binary
+        YAML::Node node_map;
+        GraphBinaryFormat::readYaml(data, node_map);
+
+        settings_.loadTemporary(node_map);
+        settings_.set("config", file);
+
+        graphio.loadSettings(node_map);
+        graphio.loadGraphFrom(data, node_map);
+
+        thread_pool_->loadSettings(node_map);
 
-    if (bf3::exists(file)) {
+    } else if (bf3::exists(file)) {
         YAML::Node node_map = YAML::LoadFile(file.c_str());
 
         // first load settings
@@ -0,0 +1,204 @@
+/// HEADER
+#include <csapex/core/graph_binary_format.h>
+
+/// PROJECT
+#include <csapex/core/settings.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/std_io.h>
+
+/// SYSTEM
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <yaml-cpp/yaml.h>
+
+using namespace csapex;
+
+const char GraphBinaryFormat::MAGIC[8] = { 'C', 'S', 'A', 'P', 'E', 'X', 'G', 'B' };
+const uint16_t GraphBinaryFormat::VERSION = 1;
+
+namespace
+{
+enum class YamlType : uint8_t
+{
+    UNDEFINED = 0,
+    NULL_VALUE = 1,
+    SCALAR = 2,
+    SEQUENCE = 3,
+    MAP = 4
+};
+
+void writeString(SerializationBuffer& data, const std::string& str)
+{
+    // scalars can be larger than the 16 bit length of regular strings
+    data.writeLength(str.size());
+    data.writeRaw(str.data(), str.size());
+}
+
+std::string readString(const SerializationBuffer& data)
+{
+    std::string str(data.readLength(), '\0');
+    if (!str.empty()) {
+        data.readRaw(&str[0], str.size());
+    }
+    return str;
+}
+
+void writeTag(SerializationBuffer& data, const YAML::Node& node)
+{
+    // the implicit tags are restored by the emitter, only explicit ones have to be kept
+    const std::string& tag = node.Tag();
+    bool explicit_tag = !tag.empty() && tag != "?" && tag != "!";
+    data << explicit_tag;
+    if (explicit_tag) {
+        writeString(data, tag);
+    }
+}
+
+std::string readTag(const SerializationBuffer& data)
+{
+    bool explicit_tag;
+    data >> explicit_tag;
+    return explicit_tag ? readString(data) : std::string();
+}
+}  // namespace
+
+bool GraphBinaryFormat::isBinaryFile(const std::string& path)
+{
+    const std::string& extension = Settings::config_extension_binary;
+    return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+void GraphBinaryFormat::writeHeader(SerializationBuffer& data)
+{
+    data.writeRaw(MAGIC, sizeof(MAGIC));
+    data << VERSION;
+}
+
+uint16_t GraphBinaryFormat::readHeader(const SerializationBuffer& data)
+{
+    char magic[sizeof(MAGIC)];
+    try {
+        data.readRaw(magic, sizeof(MAGIC));
+    } catch (const std::out_of_range&) {
+        throw std::runtime_error("not a binary graph: file is too short");
+    }
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("not a binary graph: invalid magic string");
+    }
+
+    uint16_t version;
+    data >> version;
+    if (version > VERSION) {
+        throw std::runtime_error(std::string("binary graph has version ") + std::to_string(version) + ", only versions up to " + std::to_string(VERSION) + " are supported");
+    }
+    return version;
+}
+
+void GraphBinaryFormat::writeYaml(SerializationBuffer& data, const YAML::Node& node)
+{
+    switch (node.Type()) {
+        case YAML::NodeType::Undefined:
+            data << YamlType::UNDEFINED;
+            break;
+        case YAML::NodeType::Null:
+            data << YamlType::NULL_VALUE;
+            break;
+        case YAML::NodeType::Scalar:
+            data << YamlType::SCALAR;
+            writeTag(data, node);
+            writeString(data, node.Scalar());
+            break;
+        case YAML::NodeType::Sequence:
+            data << YamlType::SEQUENCE;
+            writeTag(data, node);
+            data.writeLength(node.size());
+            for (const YAML::Node& child : node) {
+                writeYaml(data, child);
+            }
+            break;
+        case YAML::NodeType::Map:
+            data << YamlType::MAP;
+            writeTag(data, node);
+            data.writeLength(node.size());
+            for (const auto& pair : node) {
+                writeYaml(data, pair.first);
+                writeYaml(data, pair.second);
+            }
+            break;
+    }
+}
+
+void GraphBinaryFormat::readYaml(const SerializationBuffer& data, YAML::Node& node)
+{
+    YamlType type;
+    data >> type;
+
+    switch (type) {
+        case YamlType::UNDEFINED:
+        case YamlType::NULL_VALUE:
+            // undefined nodes only occur at the top level, where they are equivalent to null
+            node = YAML::Node(YAML::NodeType::Null);
+            return;
+        case YamlType::SCALAR:
+        case YamlType::SEQUENCE:
+        case YamlType::MAP:
+            break;
+        default:
+            throw std::runtime_error(std::string("binary graph contains an invalid yaml node of type ") + std::to_string(static_cast<int>(type)));
+    }
+
+    std::string tag = readTag(data);
+
+    if (type == YamlType::SCALAR) {
+        node = YAML::Node(readString(data));
+
+    } else if (type == YamlType::SEQUENCE) {
+        node = YAML::Node(YAML::NodeType::Sequence);
+        std::size_t size = data.readLength();
+        for (std::size_t i = 0; i < size; ++i) {
+            YAML::Node child;
+            readYaml(data, child);
+            node.push_back(child);
+        }
+
+    } else {
+        node = YAML::Node(YAML::NodeType::Map);
+        std::size_t size = data.readLength();
+        for (std::size_t i = 0; i < size; ++i) {
+            YAML::Node key, value;
+            readYaml(data, key);
+            readYaml(data, value);
+            node.force_insert(key, value);
+        }
+    }
+
+    if (!tag.empty()) {
+        node.SetTag(tag);
+    }
+}
+
+SerializationBuffer GraphBinaryFormat::readFile(const std::string& path)
+{
+    std::ifstream ifs(path.c_str(), std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error(std::string("cannot open ") + path);
+    }
+    std::vector<uint8_t> raw((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return SerializationBuffer(raw, true);
+}
+
+void GraphBinaryFormat::writeFile(const std::string& path, const SerializationBuffer& data)
+{
+    std::ofstream ofs(path.c_str(), std::ios::binary);
+    if (!ofs) {
+        throw std::runtime_error(std::string("cannot write ") + path);
+    }
+    ofs.write(reinterpret_cast<const char*>(data.data() + SerializationBuffer::HEADER_LENGTH), data.size() - SerializationBuffer::HEADER_LENGTH);
+}
+
+void GraphBinaryFormat::append(SerializationBuffer& data, const SerializationBuffer& payload)
+{
+    data.writeRaw(payload.data() + SerializationBuffer::HEADER_LENGTH, payload.size() - SerializationBuffer::HEADER_LENGTH);
+}
@@ -4,6 +4,7 @@
 /// PROJECT
 #include <csapex/model/node.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/node_constructor.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/factory/node_factory_impl.h>
 #include <csapex/msg/direct_connection.h>
@@ -26,8 +27,15 @@
 #include <csapex/utility/exceptions.h>
 #include <csapex/profiling/profiler.h>
 #include <csapex/profiling/timer.h>
+#include <csapex/core/graph_binary_format.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/utility/parallel_for.h>
 
 /// SYSTEM
+#include <algorithm>
+#include <set>
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <fstream>
@@ -44,15 +52,36 @@ using namespace csapex;
     }
 
 GraphIO::GraphIO(GraphFacadeImplementation& graph, NodeFactoryImplementation* node_factory, bool throw_on_error)
-  : graph_(graph), node_factory_(node_factory), position_offset_x_(0.0), position_offset_y_(0.0), ignore_forwarding_connections_(false), throw_on_error_(throw_on_error)
+  : graph_(graph), node_factory_(node_factory), position_offset_x_(0.0), position_offset_y_(0.0), ignore_forwarding_connections_(false), throw_on_error_(throw_on_error), load_threads_(1)
 {
 }
 
+/**
+ * @brief The LoadedNode struct holds one node of a graph file between the concurrent and the serial phase of loading
+ */
+struct GraphIO::LoadedNode
+{
+    UUID uuid;
+    std::string type;
+
+    // either the yaml description or the binary record of the node
+    YAML::Node doc;
+    std::shared_ptr<SerializationBuffer> record;
+
+    NodeFacadeImplementationPtr facade;
+    std::string error;
+};
+
 void GraphIO::setIgnoreForwardingConnections(bool ignore)
 {
     ignore_forwarding_connections_ = ignore;
 }
 
+void GraphIO::setLoadThreads(std::size_t threads)
+{
+    load_threads_ = threads;
+}
+
 void GraphIO::saveSettings(YAML::Node& doc)
 {
     doc["uuid_map"] = graph_.getLocalGraph()->getUUIDMap();
@@ -103,21 +132,64 @@ void GraphIO::loadGraphFrom(const YAML::Node& doc)
     TimerPtr timer = getProfiler()->getTimer("load graph");
     timer->restart();
 
-    graph_.getLocalGraph()->beginTransaction();
     {
-        auto interlude = timer->step("load nodes");
-        loadNodes(doc);
+        GraphTransaction transaction(graph_.getLocalGraph());
+        {
+            auto interlude = timer->step("load nodes");
+            loadNodes(doc);
+        }
+
+        {
+            auto interlude = timer->step("load connections");
+            loadConnections(doc);
+        }
+    }
+
+    {
+        auto interlude = timer->step("load view");
+        loadViewRequest(graph_, doc);
+    }
+
+    timer->finish();
+}
+
+void GraphIO::saveGraphTo(SerializationBuffer& data, YAML::Node& yaml)
+{
+    TimerPtr timer = getProfiler()->getTimer("save graph");
+    timer->restart();
+
+    saveNodes(data);
+    saveConnections(data);
+
+    {
+        auto interlude = timer->step("save view");
+        saveViewRequest(graph_, yaml);
     }
 
+    timer->finish();
+}
+
+void GraphIO::loadGraphFrom(const SerializationBuffer& data, const YAML::Node& yaml)
+{
+    TimerPtr timer = getProfiler()->getTimer("load graph");
+    timer->restart();
+
     {
-        auto interlude = timer->step("load connections");
-        loadConnections(doc);
+        GraphTransaction transaction(graph_.getLocalGraph());
+        {
+            auto interlude = timer->step("load nodes");
+            loadNodes(data);
+        }
+
+        {
+            auto interlude = timer->step("load connections");
+            loadConnections(data);
+        }
     }
-    graph_.getLocalGraph()->finalizeTransaction();
 
     {
         auto interlude = timer->step("load view");
-        loadViewRequest(graph_, doc);
+        loadViewRequest(graph_, yaml);
     }
 
     timer->finish();
@@ -194,8 +266,11 @@ std::unordered_map<UUID, UUID, UUID::Hasher> GraphIO::loadIntoGraph(const Snippe
         position_offset_y_ = position.y - min_y;
     }
 
-    loadNodes(blueprint);
-    loadConnections(blueprint);
+    {
+        GraphTransaction transaction(graph_.getLocalGraph());
+        loadNodes(blueprint);
+        loadConnections(blueprint);
+    }
 
     auto res = old_node_uuid_to_new_;
 
@@ -227,16 +302,96 @@ void GraphIO::saveNodes(YAML::Node& yaml, const std::vector<NodeFacadeImplementa
 }
 
 void GraphIO::loadNodes(const YAML::Node& doc)
+{
+    YAML::Node nodes = doc["nodes"];
+    if (!nodes.IsDefined()) {
+        return;
+    }
+
+    std::vector<LoadedNode> loaded(nodes.size());
+    for (std::size_t i = 0, total = nodes.size(); i < total; ++i) {
+        const YAML::Node& n = nodes[i];
+
+        LoadedNode& node = loaded[i];
+        node.uuid = readNodeUUID(graph_.getLocalGraph()->shared_from_this(), n["uuid"]);
+        node.type = n["type"].as<std::string>();
+        // every node gets its own copy of the tree, yaml nodes of one document must not be read concurrently
+        node.doc = YAML::Clone(n);
+    }
+
+    loadNodes(loaded);
+}
+
+void GraphIO::loadNodes(std::vector<LoadedNode>& nodes)
 {
     TimerPtr timer = getProfiler()->getTimer("load graph");
 
-    YAML::Node nodes = doc["nodes"];
-    if (nodes.IsDefined()) {
-        for (std::size_t i = 0, total = nodes.size(); i < total; ++i) {
-            const YAML::Node& n = nodes[i];
+    std::vector<std::pair<std::string, UUID>> requests;
+    requests.reserve(nodes.size());
+    for (const LoadedNode& node : nodes) {
+        requests.emplace_back(node.type, node.uuid);
+    }
+
+    std::vector<NodeFacadeImplementationPtr> facades;
+    {
+        auto interlude = timer->step("construct nodes");
+        facades = node_factory_->makeNodes(requests, graph_.getLocalGraph(), load_threads_);
+    }
+
+    {
+        auto interlude = timer->step("deserialize nodes");
+        auto deserialize = [&](LoadedNode& node) {
+            try {
+                if (node.record) {
+                    deserializeNodeState(*node.record, node.facade);
+                } else {
+                    deserializeNodeState(node.doc, node.facade);
+                }
+            } catch (const std::exception& e) {
+                node.error = type2name(typeid(e)) + ", what=" + e.what();
+            }
+        };
+
+        // the serializers of a plugin are only called concurrently if its type allows it
+        std::vector<std::size_t> concurrent;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            LoadedNode& node = nodes[i];
+            node.facade = facades[i];
+            if (!node.facade) {
+                continue;
+            }
 
-            auto interlude = timer->step(n["uuid"].as<std::string>());
-            loadNode(n);
+            NodeConstructorPtr constructor = node_factory_->getConstructor(node.type);
+            if (load_threads_ != 1 && constructor && constructor->allowsConcurrentLoading()) {
+                concurrent.push_back(i);
+            } else {
+                deserialize(node);
+            }
+        }
+        parallelFor(concurrent.size(), load_threads_, [&](std::size_t j) { deserialize(nodes[concurrent[j]]); });
+    }
+
+    // the graph is only changed here, in the order of the file, so that the result does not depend on the scheduling above
+    for (LoadedNode& node : nodes) {
+        if (!node.facade) {
+            continue;
+        }
+
+        auto interlude = timer->step(node.uuid.getFullName());
+        if (!node.error.empty()) {
+            sendNotificationStreamGraphio("cannot load state for box " << node.uuid << ": " << node.error);
+            continue;
+        }
+
+        try {
+            if (node.record) {
+                insertNode(*node.record, node.facade);
+            } else {
+                insertNode(node.doc, node.facade);
+            }
+
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot load state for box " << node.uuid << ": " << type2name(typeid(e)) << ", what=" << e.what());
         }
     }
 }
@@ -255,7 +410,9 @@ UUID GraphIO::readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node&
     return uuid;
 }
 
-UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc)
+namespace
+{
+std::string readConnectorId(const YAML::Node& doc)
 {
     std::string id = doc.as<std::string>();
 
@@ -268,6 +425,14 @@ UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::
         }
     }
 
+    return id;
+}
+}  // namespace
+
+UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc)
+{
+    std::string id = readConnectorId(doc);
+
     UUID uuid = UUIDProvider::makeUUID_forced(parent, id);
 
     if (!old_node_uuid_to_new_.empty()) {
@@ -283,45 +448,69 @@ UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::
     return uuid;
 }
 
-void GraphIO::loadNode(const YAML::Node& doc)
+void GraphIO::saveConnections(YAML::Node& yaml)
 {
-    UUID uuid = readNodeUUID(graph_.getLocalGraph()->shared_from_this(), doc["uuid"]);
-
-    std::string type = doc["type"].as<std::string>();
+    auto interlude = getProfiler()->getTimer("save graph")->step("save connections");
+    saveConnections(yaml, graph_.enumerateAllConnections());
+}
 
-    NodeFacadeImplementationPtr node_facade = node_factory_->makeNode(type, uuid, graph_.getLocalGraph());
-    if (!node_facade) {
-        return;
+namespace
+{
+std::string queuePolicyToString(QueuePolicy policy)
+{
+    switch (policy) {
+        case QueuePolicy::DROP_OLDEST:
+            return "drop_oldest";
+        case QueuePolicy::DROP_NEWEST:
+            return "drop_newest";
+        default:
+            return "block";
     }
+}
 
-    try {
-        deserializeNode(doc, node_facade);
-
-    } catch (const std::exception& e) {
-        sendNotificationStreamGraphio("cannot load state for box " << uuid << ": " << type2name(typeid(e)) << ", what=" << e.what());
+QueuePolicy queuePolicyFromString(const std::string& policy)
+{
+    if (policy == "drop_oldest") {
+        return QueuePolicy::DROP_OLDEST;
+    } else if (policy == "drop_newest") {
+        return QueuePolicy::DROP_NEWEST;
+    } else {
+        return QueuePolicy::BLOCK;
     }
 }
 
-void GraphIO::saveConnections(YAML::Node& yaml)
+bool isQueueConfigured(const ConnectionDescription& connection)
 {
-    auto interlude = getProfiler()->getTimer("save graph")->step("save connections");
-    saveConnections(yaml, graph_.enumerateAllConnections());
+    return connection.queue_capacity != 1 || connection.queue_policy != QueuePolicy::BLOCK;
 }
 
+bool isForwardingConnection(const ConnectionDescription& connection)
+{
+    return connection.from.type() == "relayout" || connection.to.type() == "relayin" || connection.from.type() == "relayevent" || connection.to.type() == "relayslot";
+}
+}  // namespace
+
 void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDescription>& connections)
 {
-    std::unordered_map<UUID, std::vector<std::pair<UUID, std::string>>, UUID::Hasher> connection_map;
+    encodeConnections(yaml, connections, ignore_forwarding_connections_);
+}
+
+void GraphIO::encodeConnections(YAML::Node& yaml, const std::vector<ConnectionDescription>& connections, bool ignore_forwarding_connections)
+{
+    std::unordered_map<UUID, std::vector<ConnectionDescription>, UUID::Hasher> connection_map;
+    // keep the order of the connections, so that converted documents are stable
+    std::vector<UUID> sources;
 
     for (const ConnectionDescription& connection : connections) {
-        if (ignore_forwarding_connections_) {
-            if (connection.from.type() == "relayout" || connection.to.type() == "relayin" || connection.from.type() == "relayevent" || connection.to.type() == "relayslot") {
-                continue;
-            }
+        if (ignore_forwarding_connections && isForwardingConnection(connection)) {
+            continue;
         }
 
-        std::string type = connection.active ? "active" : "default";
-
-        connection_map[connection.from].push_back(std::make_pair(connection.to, type));
+        std::vector<ConnectionDescription>& outgoing = connection_map[connection.from];
+        if (outgoing.empty()) {
+            sources.push_back(connection.from);
+        }
+        outgoing.push_back(connection);
 
         if (!connection.fulcrums.empty()) {
             YAML::Node fulcrum;
@@ -331,12 +520,27 @@ void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDesc
     }
 
     yaml["connections"] = YAML::Node(YAML::NodeType::Sequence);
-    for (const auto& pair : connection_map) {
+    for (const UUID& source : sources) {
+        const std::vector<ConnectionDescription>& outgoing = connection_map[source];
+
         YAML::Node entry(YAML::NodeType::Map);
-        entry["uuid"] = pair.first.getFullName();
-        for (const auto& info : pair.second) {
-            entry["targets"].push_back(info.first.getFullName());
-            entry["types"].push_back(info.second);
+        entry["uuid"] = source.getFullName();
+
+        bool has_queue = false;
+        for (const ConnectionDescription& connection : outgoing) {
+            entry["targets"].push_back(connection.to.getFullName());
+            entry["types"].push_back(connection.active ? "active" : "default");
+            has_queue |= isQueueConfigured(connection);
+        }
+
+        // only write the queue configuration if any of the connections is buffered
+        if (has_queue) {
+            for (const ConnectionDescription& connection : outgoing) {
+                YAML::Node queue(YAML::NodeType::Map);
+                queue["capacity"] = connection.queue_capacity;
+                queue["policy"] = queuePolicyToString(connection.queue_policy);
+                entry["queues"].push_back(queue);
+            }
         }
         yaml["connections"].push_back(entry);
     }
@@ -387,6 +591,9 @@ void GraphIO::loadConnection(const YAML::Node& connection)
     const YAML::Node& types = connection["types"];
     apex_assert_hard(!types.IsDefined() || (types.Type() == YAML::NodeType::Sequence && targets.size() == types.size()));
 
+    const YAML::Node& queues = connection["queues"];
+    apex_assert_hard(!queues.IsDefined() || (queues.Type() == YAML::NodeType::Sequence && targets.size() == queues.size()));
+
     for (unsigned j = 0; j < targets.size(); ++j) {
         UUID to_uuid = readConnectorUUID(graph_.getLocalGraph()->shared_from_this(), targets[j]);
 
@@ -399,7 +606,16 @@ void GraphIO::loadConnection(const YAML::Node& connection)
 
         ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
         if (from) {
-            loadConnection(from, to_uuid, connection_type);
+            ConnectionPtr c = loadConnection(from, to_uuid, connection_type);
+            if (c && queues.IsDefined()) {
+                const YAML::Node& queue = queues[j];
+                if (queue["capacity"].IsDefined()) {
+                    c->setQueueCapacity(std::max(1, queue["capacity"].as<int>()));
+                }
+                if (queue["policy"].IsDefined()) {
+                    c->setQueuePolicy(queuePolicyFromString(queue["policy"].as<std::string>()));
+                }
+            }
         } else {
             sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
         }
@@ -492,7 +708,7 @@ void GraphIO::loadFulcrum(const YAML::Node& fulcrum)
     }
 }
 
-void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type)
+ConnectionPtr GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type)
 {
     try {
         NodeHandle* target = graph_.getLocalGraph()->findNodeHandleForConnector(to_uuid);
@@ -500,7 +716,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
         InputPtr in = std::dynamic_pointer_cast<Input>(target->getConnector(to_uuid));
         if (!in) {
             sendNotificationStreamGraphio("cannot load message connection from " << from->getUUID() << " to " << to_uuid << ", input doesn't exist.");
-            return;
+            return nullptr;
         }
 
         OutputPtr out = std::dynamic_pointer_cast<Output>(from);
@@ -512,6 +728,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
                 c->setActive(true);
             }
             graph_.getLocalGraph()->addConnection(c);
+            return c;
         }
 
     } catch (const std::exception& e) {
@@ -519,6 +736,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
     } catch (const Failure& e) {
         sendNotificationStreamGraphio("failure loading connection: " << e.what());
     }
+    return nullptr;
 }
 
 void GraphIO::serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr node_facade)
@@ -547,6 +765,12 @@ void GraphIO::serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr no
 }
 
 void GraphIO::deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_facade)
+{
+    deserializeNodeState(doc, node_facade);
+    insertNode(doc, node_facade);
+}
+
+void GraphIO::deserializeNodeState(const YAML::Node& doc, NodeFacadeImplementationPtr node_facade)
 {
     NodeState::Ptr s = node_facade->getNodeState();
     s->readYaml(doc);
@@ -564,7 +788,10 @@ void GraphIO::deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr
     apex_assert_hard(node);
 
     NodeSerializer::instance().deserialize(*node, doc);
+}
 
+void GraphIO::insertNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_facade)
+{
     graph_.getLocalGraph()->addNode(node_facade);
 
     node_facade->handleChangedParameters();
@@ -573,6 +800,7 @@ void GraphIO::deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr
         GraphFacadeImplementationPtr subgraph = graph_.getLocalSubGraph(node_facade->getUUID());
         if (subgraph) {
             GraphIO sub_graph_io(*subgraph, node_factory_, throw_on_error_);
+            sub_graph_io.setLoadThreads(load_threads_);
             slim_signal::ScopedConnection connection = sub_graph_io.loadViewRequest.connect(loadViewRequest);
 
             sub_graph_io.loadGraph(doc["subgraph"]);
@@ -580,6 +808,376 @@ void GraphIO::deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr
     }
 }
 
+void GraphIO::saveNodes(SerializationBuffer& data)
+{
+    std::vector<NodeFacadeImplementationPtr> nodes = graph_.getLocalGraph()->getAllLocalNodeFacades();
+
+    data.writeLength(nodes.size());
+    for (const NodeFacadeImplementationPtr& node : nodes) {
+        try {
+            data << node->getUUID().getFullName();
+            data << node->getType();
+
+            // each node is prefixed with its length, so that nodes of unknown types can be skipped when loading
+            SerializationBuffer record;
+            serializeNode(record, node);
+            data.writeLength(record.size() - SerializationBuffer::HEADER_LENGTH);
+            GraphBinaryFormat::append(data, record);
+
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot save state for node " << node->getUUID() << ": " << e.what());
+            throw e;
+        }
+    }
+}
+
+void GraphIO::loadNodes(const SerializationBuffer& data)
+{
+    std::vector<LoadedNode> loaded(data.readLength());
+    for (LoadedNode& node : loaded) {
+        std::string uuid_str;
+        data >> uuid_str;
+        data >> node.type;
+        node.uuid = UUIDProvider::makeUUID_forced(graph_.getLocalGraph()->shared_from_this(), uuid_str);
+
+        // every record is copied into its own buffer, a buffer has a single read position and cannot be shared between threads
+        std::size_t length = data.readLength();
+        node.record = std::make_shared<SerializationBuffer>(data.data() + data.getPos(), length, true);
+        data.advance(length);
+    }
+
+    loadNodes(loaded);
+}
+
+void GraphIO::serializeNode(SerializationBuffer& data, NodeFacadeImplementationConstPtr node_facade)
+{
+    auto interlude = getProfiler()->getTimer("save graph")->step("serialize node");
+
+    data << *node_facade->getNodeState();
+
+    auto node = node_facade->getNode();
+
+    // hook for nodes to serialize, the custom data stays in yaml
+    YAML::Node extra;
+    if (node) {
+        NodeSerializer::instance().serialize(*node, extra);
+    }
+    GraphBinaryFormat::writeYaml(data, extra);
+
+    GraphFacadeImplementationPtr subgraph;
+    if (node && node_facade->isGraph()) {
+        subgraph = graph_.getLocalSubGraph(node_facade->getUUID());
+    }
+
+    data << (subgraph != nullptr);
+    if (subgraph) {
+        SerializationBuffer subgraph_data;
+        YAML::Node subgraph_yaml;
+        GraphIO sub_graph_io(*subgraph, node_factory_);
+        slim_signal::ScopedConnection connection = sub_graph_io.saveViewRequest.connect(saveViewRequest);
+
+        sub_graph_io.saveGraphTo(subgraph_data, subgraph_yaml);
+        GraphBinaryFormat::writeYaml(data, subgraph_yaml);
+        GraphBinaryFormat::append(data, subgraph_data);
+    }
+}
+
+void GraphIO::deserializeNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_facade)
+{
+    deserializeNodeState(data, node_facade);
+    insertNode(data, node_facade);
+}
+
+void GraphIO::deserializeNodeState(const SerializationBuffer& data, NodeFacadeImplementationPtr node_facade)
+{
+    NodeState loaded;
+    data >> loaded;
+
+    NodeState::Ptr s = node_facade->getNodeState();
+    s->readState(loaded);
+    s->getParameterState()->initializePersistentParameters();
+
+    YAML::Node extra;
+    GraphBinaryFormat::readYaml(data, extra);
+
+    // hook for nodes to deserialize
+    auto node = node_facade->getNode();
+    apex_assert_hard(node);
+
+    NodeSerializer::instance().deserialize(*node, extra);
+}
+
+void GraphIO::insertNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_facade)
+{
+    graph_.getLocalGraph()->addNode(node_facade);
+
+    node_facade->handleChangedParameters();
+
+    bool has_subgraph;
+    data >> has_subgraph;
+    if (has_subgraph && node_facade->isGraph()) {
+        GraphFacadeImplementationPtr subgraph = graph_.getLocalSubGraph(node_facade->getUUID());
+        if (subgraph) {
+            YAML::Node subgraph_yaml;
+            GraphBinaryFormat::readYaml(data, subgraph_yaml);
+
+            GraphIO sub_graph_io(*subgraph, node_factory_, throw_on_error_);
+            sub_graph_io.setLoadThreads(load_threads_);
+            slim_signal::ScopedConnection connection = sub_graph_io.loadViewRequest.connect(loadViewRequest);
+
+            sub_graph_io.loadGraphFrom(data, subgraph_yaml);
+        }
+    }
+}
+
+void GraphIO::saveConnections(SerializationBuffer& data)
+{
+    auto interlude = getProfiler()->getTimer("save graph")->step("save connections");
+
+    std::vector<ConnectionDescription> connections;
+    for (ConnectionDescription connection : graph_.enumerateAllConnections()) {
+        if (ignore_forwarding_connections_ && isForwardingConnection(connection)) {
+            continue;
+        }
+        // the message type is derived from the connectors again when loading
+        connection.type = nullptr;
+        connections.push_back(connection);
+    }
+
+    data << connections;
+}
+
+void GraphIO::loadConnections(const SerializationBuffer& data)
+{
+    std::vector<ConnectionDescription> connections;
+    data >> connections;
+
+    for (const ConnectionDescription& connection : connections) {
+        try {
+            loadConnection(connection);
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot load connection: " << e.what());
+        }
+    }
+}
+
+void GraphIO::loadConnection(const ConnectionDescription& connection)
+{
+    UUID from_uuid = UUIDProvider::makeUUID_forced(graph_.getLocalGraph()->shared_from_this(), connection.from.getFullName());
+    UUID to_uuid = UUIDProvider::makeUUID_forced(graph_.getLocalGraph()->shared_from_this(), connection.to.getFullName());
+
+    ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
+    if (!from) {
+        sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
+        return;
+    }
+
+    ConnectionPtr c = loadConnection(from, to_uuid, connection.active ? "active" : "default");
+    if (!c) {
+        return;
+    }
+
+    if (isQueueConfigured(connection)) {
+        c->setQueueCapacity(std::max<std::size_t>(1, connection.queue_capacity));
+        c->setQueuePolicy(connection.queue_policy);
+    }
+
+    for (std::size_t i = 0; i < connection.fulcrums.size(); ++i) {
+        const Fulcrum& f = connection.fulcrums[i];
+        c->addFulcrum(i, f.pos(), f.type(), f.handleIn(), f.handleOut());
+    }
+}
+
+std::vector<ConnectionDescription> GraphIO::decodeConnections(const YAML::Node& doc)
+{
+    std::vector<ConnectionDescription> result;
+
+    const YAML::Node& connections = doc["connections"];
+    if (connections.IsDefined()) {
+        apex_assert_hard(connections.Type() == YAML::NodeType::Sequence);
+
+        for (const YAML::Node& connection : connections) {
+            UUID from = UUIDProvider::makeUUID_without_parent(readConnectorId(connection["uuid"]));
+
+            const YAML::Node& targets = connection["targets"];
+            const YAML::Node& types = connection["types"];
+            const YAML::Node& queues = connection["queues"];
+            apex_assert_hard(targets.Type() == YAML::NodeType::Sequence);
+            apex_assert_hard(!types.IsDefined() || targets.size() == types.size());
+            apex_assert_hard(!queues.IsDefined() || targets.size() == queues.size());
+
+            for (std::size_t j = 0; j < targets.size(); ++j) {
+                UUID to = UUIDProvider::makeUUID_without_parent(readConnectorId(targets[j]));
+                bool active = types.IsDefined() && types[j].as<std::string>() == "active";
+
+                ConnectionDescription description(from, to, nullptr, -1, active, {});
+                if (queues.IsDefined()) {
+                    const YAML::Node& queue = queues[j];
+                    if (queue["capacity"].IsDefined()) {
+                        description.queue_capacity = std::max(1, queue["capacity"].as<int>());
+                    }
+                    if (queue["policy"].IsDefined()) {
+                        description.queue_policy = queuePolicyFromString(queue["policy"].as<std::string>());
+                    }
+                }
+                result.push_back(description);
+            }
+        }
+    }
+
+    const YAML::Node& fulcrums = doc["fulcrums"];
+    if (fulcrums.IsDefined()) {
+        apex_assert_hard(fulcrums.Type() == YAML::NodeType::Sequence);
+
+        for (const YAML::Node& fulcrum : fulcrums) {
+            if (!fulcrum["from"].IsDefined() || !fulcrum["to"].IsDefined()) {
+                continue;
+            }
+            std::string from = fulcrum["from"].as<std::string>();
+            std::string to = fulcrum["to"].as<std::string>();
+
+            auto pos = std::find_if(result.begin(), result.end(),
+                                    [&](const ConnectionDescription& description) { return description.from.getFullName() == from && description.to.getFullName() == to; });
+            if (pos == result.end()) {
+                continue;
+            }
+
+            std::vector<std::vector<double>> pts = fulcrum["pts"].as<std::vector<std::vector<double>>>();
+            std::vector<std::vector<double>> handles;
+            if (fulcrum["handles"].IsDefined()) {
+                handles = fulcrum["handles"].as<std::vector<std::vector<double>>>();
+            }
+            std::vector<int> types;
+            if (fulcrum["types"].IsDefined()) {
+                types = fulcrum["types"].as<std::vector<int>>();
+            }
+
+            for (std::size_t i = 0; i < pts.size(); ++i) {
+                int type = (!types.empty()) ? types[i] : Fulcrum::FULCRUM_LINEAR;
+                // the same defaults as Connection::addFulcrum
+                Point in(-10.0, 0.0);
+                Point out(10.0, 0.0);
+                if (!handles.empty()) {
+                    in = Point(handles[i][0], handles[i][1]);
+                    out = Point(handles[i][2], handles[i][3]);
+                }
+                pos->fulcrums.emplace_back(pos->id, Point(pts[i][0], pts[i][1]), type, in, out);
+            }
+        }
+    }
+
+    return result;
+}
+
+namespace
+{
+// the keys of a node that are covered by NodeState, all others are written by node serializers
+const std::set<std::string> g_node_state_keys = { "type", "uuid", "max_frequency", "label", "pos", "color", "z", "minimized", "muted", "enabled", "flipped", "exec_mode", "exec_type", "logger_level", "dict", "state", "subgraph" };
+
+// the keys of a graph that are stored in binary, everything else belongs to the settings or the view
+const std::set<std::string> g_graph_keys = { "nodes", "connections", "fulcrums" };
+
+YAML::Node withoutKeys(const YAML::Node& map, const std::set<std::string>& keys)
+{
+    YAML::Node rest(YAML::NodeType::Map);
+    for (const auto& pair : map) {
+        if (keys.find(pair.first.as<std::string>()) == keys.end()) {
+            rest[pair.first] = pair.second;
+        }
+    }
+    return rest;
+}
+}  // namespace
+
+void GraphIO::convertToBinary(const YAML::Node& yaml, SerializationBuffer& data)
+{
+    GraphBinaryFormat::writeHeader(data);
+    GraphBinaryFormat::writeYaml(data, withoutKeys(yaml, g_graph_keys));
+    convertGraphToBinary(yaml, data);
+}
+
+void GraphIO::convertToYaml(const SerializationBuffer& data, YAML::Node& yaml)
+{
+    GraphBinaryFormat::readHeader(data);
+    GraphBinaryFormat::readYaml(data, yaml);
+    convertGraphToYaml(data, yaml);
+}
+
+void GraphIO::convertGraphToBinary(const YAML::Node& yaml, SerializationBuffer& data)
+{
+    const YAML::Node& nodes = yaml["nodes"];
+    data.writeLength(nodes.IsDefined() ? nodes.size() : 0);
+    if (nodes.IsDefined()) {
+        for (const YAML::Node& node : nodes) {
+            data << node["uuid"].as<std::string>();
+            data << node["type"].as<std::string>();
+
+            SerializationBuffer record;
+            NodeState state;
+            state.readYaml(node);
+            record << state;
+
+            GraphBinaryFormat::writeYaml(record, withoutKeys(node, g_node_state_keys));
+
+            const YAML::Node& subgraph = node["subgraph"];
+            record << subgraph.IsDefined();
+            if (subgraph.IsDefined()) {
+                GraphBinaryFormat::writeYaml(record, withoutKeys(subgraph, g_graph_keys));
+                convertGraphToBinary(subgraph, record);
+            }
+
+            data.writeLength(record.size() - SerializationBuffer::HEADER_LENGTH);
+            GraphBinaryFormat::append(data, record);
+        }
+    }
+
+    data << decodeConnections(yaml);
+}
+
+void GraphIO::convertGraphToYaml(const SerializationBuffer& data, YAML::Node& yaml)
+{
+    std::size_t count = data.readLength();
+    for (std::size_t i = 0; i < count; ++i) {
+        YAML::Node node(YAML::NodeType::Map);
+
+        std::string uuid;
+        std::string type;
+        data >> uuid;
+        data >> type;
+        node["type"] = type;
+        node["uuid"] = uuid;
+
+        data.readLength();
+
+        NodeState state;
+        data >> state;
+        state.writeYaml(node);
+
+        YAML::Node extra;
+        GraphBinaryFormat::readYaml(data, extra);
+        if (extra.IsMap()) {
+            for (const auto& pair : extra) {
+                node[pair.first] = pair.second;
+            }
+        }
+
+        bool has_subgraph;
+        data >> has_subgraph;
+        if (has_subgraph) {
+            YAML::Node subgraph;
+            GraphBinaryFormat::readYaml(data, subgraph);
+            convertGraphToYaml(data, subgraph);
+            node["subgraph"] = subgraph;
+        }
+
+        yaml["nodes"].push_back(node);
+    }
+
+    std::vector<ConnectionDescription> connections;
+    data >> connections;
+    encodeConnections(yaml, connections, false);
+}
+
 void GraphIO::sendNotification(const std::string& notification)
 {
     if (throw_on_error_) {
@@ -28,13 +28,15 @@ namespace bf3 = boost::filesystem3;
 using namespace csapex;
 
 const std::string Settings::settings_file = defaultConfigPath() + "cfg/persistent_settings";
+const std::string Settings::plugin_cache_file = defaultConfigPath() + "cfg/plugin_cache";
 const std::string Settings::config_extension = ".apex";
+const std::string Settings::config_extension_binary = ".apexbin";
 const std::string Settings::template_extension = ".apexs";
 const std::string Settings::message_extension = ".apexm";
 const std::string Settings::message_extension_compressed = ".apexm.gz";
 const std::string Settings::message_extension_binary = ".apexb";
 const std::string Settings::default_config = Settings::defaultConfigFile();
-const std::string Settings::config_selector = "Configs(*" + Settings::config_extension + ");;LegacyConfigs(*.vecfg)";
+const std::string Settings::config_selector = "Configs(*" + Settings::config_extension + " *" + Settings::config_extension_binary + ");;LegacyConfigs(*.vecfg)";
 
 const std::string Settings::namespace_separator = ":/:";
 
@@ -13,10 +13,11 @@
 #include <csapex/model/tag.h>
 #include <csapex/utility/uuid.h>
 #include <csapex/plugin/plugin_manager.hpp>
+#include <csapex/plugin/plugin_manifest_cache.h>
 #include <csapex/model/subgraph_node.h>
 #include <csapex/nodes/sticky_note.h>
-#include <csapex/param/string_list_parameter.h>
 #include <csapex/model/graph/graph_impl.h>
+#include <csapex/utility/parallel_for.h>
 
 using namespace csapex;
 
@@ -80,11 +81,10 @@ void NodeFactoryImplementation::shutdown()
 
 void NodeFactoryImplementation::rebuildPrototypes()
 {
-    settings_.setQuiet(true);
-
-    bool dirty = false;
+    PluginManifestCachePtr cache = plugin_locator_->getManifestCache();
 
     int plugin_count = 0;
+    int cached_count = 0;
     for (const auto& p : node_manager_->getConstructors()) {
         const PluginConstructor<Node>& plugin_constructor = p.second;
 
@@ -94,32 +94,21 @@ void NodeFactoryImplementation::rebuildPrototypes()
 
         constructor->setDescription(p.second.getDescription()).setIcon(p.second.getIcon()).setTags(p.second.getTags());
 
-        // set cached properties, if the library modification time has not changed.
-        // otherwise rely on lazy initialization
-        std::string mod = std::string("__last_mod_") + type;
-        std::string key = std::string("__cached_properties_") + type;
-        bool loaded = false;
-        if (settings_.knows(mod)) {
-            long last_mod = settings_.get<long>(mod);
-            if (last_mod == node_manager_->getLastModification(type)) {
-                param::StringListParameter::Ptr properties = std::dynamic_pointer_cast<param::StringListParameter>(settings_.get(key));
-                if (properties) {
-                    constructor->setProperties(properties->getValues());
-                    loaded = true;
-                }
-            }
-        }
+        // use the cached properties, if the library has not changed.
+        // otherwise the library has to be loaded once to inspect a prototype
+        std::string library_file = node_manager_->getLibraryFile(type);
+        PluginManifestCache::Stamp stamp = PluginManifestCache::stamp(library_file);
+
+        PluginManifestCache::NodeEntry entry;
+        if (cache->findNode(library_file, stamp, type, entry)) {
+            constructor->setProperties(entry.properties);
+            ++cached_count;
 
-        if (!loaded) {
+        } else {
             NOTIFICATION_INFO("reloading properties for node type " << type);
-            dirty = true;
             try {
-                auto last_modification = node_manager_->getLastModification(type);
-
-                param::StringListParameter::Ptr properties(new param::StringListParameter(key, param::ParameterDescription()));
-                properties->set(constructor->getProperties());
-                settings_.addPersistent(properties);
-                settings_.setPersistent(mod, last_modification);
+                entry.properties = constructor->getProperties();
+                cache->storeNode(library_file, stamp, type, entry);
 
             } catch (const std::exception& e) {
                 NOTIFICATION("plugin '" << type << "' cannot be loaded");
@@ -130,13 +119,9 @@ void NodeFactoryImplementation::rebuildPrototypes()
         ++plugin_count;
     }
 
-    std::cout << "loaded " << plugin_count << " plugins" << std::endl;
-
-    settings_.setQuiet(false);
+    std::cout << "loaded " << plugin_count << " plugins (" << cached_count << " from cache)" << std::endl;
 
-    if (dirty) {
-        settings_.savePersistent();
-    }
+    cache->save();
 }
 
 void NodeFactoryImplementation::rebuildMap()
@@ -212,18 +197,12 @@ NodeFacadeImplementationPtr NodeFactoryImplementation::makeNode(const std::strin
 {
     NodeConstructorPtr p = getConstructor(target_type);
     if (p) {
-        NodeHandlePtr nh = p->makeNodeHandle(uuid, uuid_provider);
-        if (!nh) {
+        NodeFacadeImplementationPtr result = constructNode(p, uuid, uuid_provider, state);
+        if (!result) {
             NOTIFICATION("error: cannot make node of type '" << target_type);
             return nullptr;
         }
 
-        if (state) {
-            nh->setNodeState(state);
-        }
-
-        NodeFacadeImplementationPtr result = std::make_shared<NodeFacadeImplementation>(nh);
-
         node_constructed(result);
 
         return result;
@@ -234,6 +213,60 @@ NodeFacadeImplementationPtr NodeFactoryImplementation::makeNode(const std::strin
     }
 }
 
+std::vector<NodeFacadeImplementationPtr> NodeFactoryImplementation::makeNodes(const std::vector<std::pair<std::string, UUID>>& nodes, const UUIDProviderPtr& uuid_provider, std::size_t threads)
+{
+    // the lookup may load plugins and is done up front, only the construction itself runs concurrently
+    std::vector<NodeConstructorPtr> constructors;
+    constructors.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        constructors.push_back(getConstructor(node.first));
+    }
+
+    // plugins may share state between their instances, so only types that allow it are constructed concurrently
+    std::vector<NodeFacadeImplementationPtr> result(nodes.size());
+    std::vector<std::size_t> concurrent;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (!constructors[i]) {
+            continue;
+        }
+        if (threads != 1 && constructors[i]->allowsConcurrentLoading()) {
+            concurrent.push_back(i);
+        } else {
+            result[i] = constructNode(constructors[i], nodes[i].second, uuid_provider, nullptr);
+        }
+    }
+    parallelFor(concurrent.size(), threads, [&](std::size_t j) {
+        std::size_t i = concurrent[j];
+        result[i] = constructNode(constructors[i], nodes[i].second, uuid_provider, nullptr);
+    });
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (!constructors[i]) {
+            NOTIFICATION("error: cannot make node, type '" << nodes[i].first << "' is unknown");
+        } else if (!result[i]) {
+            NOTIFICATION("error: cannot make node of type '" << nodes[i].first);
+        } else {
+            node_constructed(result[i]);
+        }
+    }
+
+    return result;
+}
+
+NodeFacadeImplementationPtr NodeFactoryImplementation::constructNode(const NodeConstructorPtr& constructor, const UUID& uuid, const UUIDProviderPtr& uuid_provider, NodeStatePtr state)
+{
+    NodeHandlePtr nh = constructor->makeNodeHandle(uuid, uuid_provider);
+    if (!nh) {
+        return nullptr;
+    }
+
+    if (state) {
+        nh->setNodeState(state);
+    }
+
+    return std::make_shared<NodeFacadeImplementation>(nh);
+}
+
 NodeFacadeImplementationPtr NodeFactoryImplementation::makeGraph(const UUID& uuid, const UUIDProviderPtr& uuid_provider)
 {
     return makeNode("csapex::Graph", uuid, uuid_provider);
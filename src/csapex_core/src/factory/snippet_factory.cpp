@@ -3,6 +3,7 @@
 
 /// PROJECT
 #include <csapex/plugin/plugin_locator.h>
+#include <csapex/plugin/plugin_manifest_cache.h>
 #include <csapex/serialization/snippet.h>
 #include <csapex/model/tag.h>
 
@@ -36,6 +37,8 @@ void SnippetFactory::addSnippet(SnippetPtr s)
 
 void SnippetFactory::loadSnippets()
 {
+    PluginManifestCachePtr cache = plugin_locator_->getManifestCache();
+
     for (const std::string& dir_string : plugin_locator_->getPluginPaths("snippets")) {
         boost::filesystem::path directory(dir_string);
 
@@ -51,11 +54,43 @@ void SnippetFactory::loadSnippets()
             boost::filesystem::path path = dir->path();
 
             if (path.extension() == Settings::template_extension) {
-                SnippetPtr s = std::make_shared<Snippet>(Snippet::load(path.string()));
-                addSnippet(s);
+                addSnippet(loadSnippet(path.string(), *cache));
             }
         }
     }
+
+    cache->save();
+}
+
+SnippetPtr SnippetFactory::loadSnippet(const std::string& file, PluginManifestCache& cache)
+{
+    // known snippets are listed from the cache, their graph is only parsed once they are used
+    PluginManifestCache::Stamp stamp = PluginManifestCache::stamp(file);
+    PluginManifestCache::SnippetEntry entry;
+    if (cache.findSnippet(file, stamp, entry)) {
+        SnippetPtr s = std::make_shared<Snippet>(Snippet::deferred(file));
+        s->setName(entry.name);
+        s->setDescription(entry.description);
+
+        std::vector<TagConstPtr> tags;
+        for (const std::string& tag : entry.tags) {
+            Tag::createIfNotExists(tag);
+            tags.push_back(Tag::get(tag));
+        }
+        s->setTags(tags);
+        return s;
+    }
+
+    SnippetPtr s = std::make_shared<Snippet>(Snippet::load(file));
+
+    entry.name = s->getName();
+    entry.description = s->getDescription();
+    for (const TagConstPtr& tag : s->getTags()) {
+        entry.tags.push_back(tag->getName());
+    }
+    cache.storeSnippet(file, stamp, entry);
+
+    return s;
 }
 
 void SnippetFactory::saveSnippet(const Snippet& s, const std::string& path)
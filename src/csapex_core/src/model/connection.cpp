@@ -28,7 +28,8 @@ Connection::Connection(OutputPtr from, InputPtr to) : Connection(from, to, next_
 {
 }
 
-Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(to), id_(id), active_(false), detached_(false), state_(State::NOT_INITIALIZED)
+Connection::Connection(OutputPtr from, InputPtr to, int id)
+  : from_(from), to_(to), id_(id), active_(false), detached_(false), state_(State::NOT_INITIALIZED), queue_capacity_(1), queue_policy_(QueuePolicy::BLOCK), dropped_tokens_(0)
 {
     from->enabled_changed.connect(source_enable_changed);
     to->enabled_changed.connect(sink_enabled_changed);
@@ -117,6 +118,8 @@ void Connection::reset()
     std::unique_lock<std::recursive_mutex> lock(sync);
     state_ = Connection::State::NOT_INITIALIZED;
     message_.reset();
+    queue_.clear();
+    dropped_tokens_ = 0;
 }
 
 TokenPtr Connection::getToken() const
@@ -143,34 +146,130 @@ bool Connection::holdsActiveToken() const
     return message_ && message_->hasActivityModifier();
 }
 
+bool Connection::canReceiveToken() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    if (state_ == State::NOT_INITIALIZED) {
+        return true;
+    }
+    if (queue_capacity_ <= 1) {
+        return false;
+    }
+    // the current token occupies one slot, the remaining slots are queued
+    return queue_policy_ != QueuePolicy::BLOCK || queue_.size() + 1 < queue_capacity_;
+}
+
+void Connection::setQueueCapacity(std::size_t capacity)
+{
+    apex_assert_hard(capacity >= 1);
+
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    queue_capacity_ = capacity;
+    while (queue_.size() + 1 > queue_capacity_ && !queue_.empty()) {
+        queue_.pop_front();
+        ++dropped_tokens_;
+    }
+}
+
+std::size_t Connection::getQueueCapacity() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return queue_capacity_;
+}
+
+void Connection::setQueuePolicy(QueuePolicy policy)
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    queue_policy_ = policy;
+}
+
+QueuePolicy Connection::getQueuePolicy() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return queue_policy_;
+}
+
+std::size_t Connection::countQueuedTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return queue_.size();
+}
+
+std::size_t Connection::countDroppedTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return dropped_tokens_;
+}
+
+void Connection::clearQueue()
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    queue_.clear();
+}
+
 void Connection::setTokenProcessed()
 {
+    bool has_next_token = false;
     {
         std::unique_lock<std::recursive_mutex> lock(sync);
         if (getState() == State::DONE) {
             return;
         }
         setState(State::DONE);
+
+        if (!queue_.empty()) {
+            // the consumer is done with the current token, move on to the next queued one
+            message_ = queue_.front();
+            queue_.pop_front();
+            setState(State::UNREAD);
+            has_next_token = true;
+        }
     }
 
     // TRACE std::cout << *this << " is done" << std::endl;
     notifyMessageProcessed();
+
+    if (has_next_token) {
+        notifyMessageSet();
+    }
 }
 
 void Connection::setToken(const TokenPtr& token)
 {
     {
-        TokenPtr msg = token->cloneAs<Token>();
+        // the payload is immutable and shared, only the per-send metadata is copied
+        TokenPtr msg = token->shallowClone();
 
         std::unique_lock<std::recursive_mutex> lock(sync);
         apex_assert_hard(msg != nullptr);
-        apex_assert_hard(state_ == State::NOT_INITIALIZED);
 
         if (!isActive() && msg->hasActivityModifier()) {
             // remove active flag if the connection is inactive
             msg->setActivityModifier(ActivityModifier::NONE);
         }
 
+        if (state_ != State::NOT_INITIALIZED) {
+            // the consumer still holds the current token -> buffer the new one
+            if (queue_.size() + 1 >= queue_capacity_) {
+                switch (queue_policy_) {
+                    case QueuePolicy::DROP_OLDEST:
+                        if (!queue_.empty()) {
+                            queue_.pop_front();
+                            ++dropped_tokens_;
+                        }
+                        break;
+                    case QueuePolicy::DROP_NEWEST:
+                        ++dropped_tokens_;
+                        return;
+                    default:
+                        // keep the token, the full queue holds the output back until the consumer caught up
+                        break;
+                }
+            }
+            queue_.push_back(msg);
+            return;
+        }
+
         message_ = msg;
         setState(State::UNREAD);
     }
@@ -286,7 +385,10 @@ int Connection::id() const
 ConnectionDescription Connection::getDescription() const
 {
     TokenDataConstPtr type = message_ ? message_->getTokenData() : makeEmpty<connection_types::AnyMessage>();
-    return ConnectionDescription(from_->getUUID(), to_->getUUID(), type, id_, isActive(), getFulcrumsCopy());
+    ConnectionDescription description(from_->getUUID(), to_->getUUID(), type, id_, isActive(), getFulcrumsCopy());
+    description.queue_capacity = getQueueCapacity();
+    description.queue_policy = getQueuePolicy();
+    return description;
 }
 
 bool Connection::contains(Connector* c) const
@@ -10,16 +10,25 @@
 using namespace csapex;
 
 ConnectionDescription::ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums)
-  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), active(active), fulcrums(fulcrums)
+  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), active(active), fulcrums(fulcrums), queue_capacity(1), queue_policy(QueuePolicy::BLOCK)
 {
 }
 
 ConnectionDescription::ConnectionDescription(const ConnectionDescription& other)
-  : from(other.from), to(other.to), from_label(other.from_label), to_label(other.to_label), type(other.type), id(other.id), active(other.active), fulcrums(other.fulcrums)
+  : from(other.from)
+  , to(other.to)
+  , from_label(other.from_label)
+  , to_label(other.to_label)
+  , type(other.type)
+  , id(other.id)
+  , active(other.active)
+  , fulcrums(other.fulcrums)
+  , queue_capacity(other.queue_capacity)
+  , queue_policy(other.queue_policy)
 {
 }
 
-ConnectionDescription::ConnectionDescription()
+ConnectionDescription::ConnectionDescription() : queue_capacity(1), queue_policy(QueuePolicy::BLOCK)
 {
 }
 
@@ -33,6 +42,8 @@ ConnectionDescription& ConnectionDescription::operator=(const ConnectionDescript
     id = other.id;
     active = other.active;
     fulcrums = other.fulcrums;
+    queue_capacity = other.queue_capacity;
+    queue_policy = other.queue_policy;
 
     return *this;
 }
@@ -44,6 +55,9 @@ bool ConnectionDescription::operator==(const ConnectionDescription& other) const
 
 void ConnectionDescription::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
+    // version 1 adds the queue settings
+    version = SemanticVersion(1, 0, 0);
+
     data << from;
     data << to;
     data << from_label;
@@ -52,6 +66,8 @@ void ConnectionDescription::serialize(SerializationBuffer& data, SemanticVersion
     data << id;
     data << active;
     data << fulcrums;
+    data << queue_capacity;
+    data << queue_policy;
 }
 void ConnectionDescription::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
 {
@@ -63,4 +79,12 @@ void ConnectionDescription::deserialize(const SerializationBuffer& data, const S
     data >> id;
     data >> active;
     data >> fulcrums;
+
+    if (version.major_v >= 1) {
+        data >> queue_capacity;
+        data >> queue_policy;
+    } else {
+        queue_capacity = 1;
+        queue_policy = QueuePolicy::BLOCK;
+    }
 }
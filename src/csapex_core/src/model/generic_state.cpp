@@ -78,19 +78,7 @@ void GenericState::writeYaml(YAML::Node& out) const
 void GenericState::readYaml(const YAML::Node& node)
 {
     if (node["params"].IsDefined()) {
-        auto serialized_params = node["params"].as<std::map<std::string, csapex::param::Parameter::Ptr> >();
-        for (auto pair : serialized_params) {
-            apex_assert_hard(pair.first == pair.second->name());
-            auto pos = params.find(pair.first);
-            if (pos == params.end()) {
-                params[pair.first] = pair.second;
-                legacy_parameter_added(params[pair.first]);
-            } else {
-                param::ParameterPtr p = pos->second;
-                p->cloneDataFrom(*pair.second);
-            }
-            legacy.insert(pair.first);
-        }
+        mergeParameters(node["params"].as<std::map<std::string, csapex::param::Parameter::Ptr> >());
     }
     if (node["persistent_params"].IsDefined()) {
         std::vector<std::string> persistent_v = node["persistent_params"].as<std::vector<std::string> >();
@@ -99,6 +87,28 @@ void GenericState::readYaml(const YAML::Node& node)
     }
 }
 
+void GenericState::mergeFrom(const GenericState& loaded)
+{
+    mergeParameters(loaded.params);
+    persistent = loaded.persistent;
+}
+
+void GenericState::mergeParameters(const std::map<std::string, csapex::param::ParameterPtr>& loaded)
+{
+    for (auto pair : loaded) {
+        apex_assert_hard(pair.first == pair.second->name());
+        auto pos = params.find(pair.first);
+        if (pos == params.end()) {
+            params[pair.first] = pair.second;
+            legacy_parameter_added(params[pair.first]);
+        } else {
+            param::ParameterPtr p = pos->second;
+            p->cloneDataFrom(*pair.second);
+        }
+        legacy.insert(pair.first);
+    }
+}
+
 void GenericState::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     version = { 0, 0, 0 };
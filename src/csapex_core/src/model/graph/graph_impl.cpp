@@ -21,9 +21,14 @@
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/subgraph_node.h>
 
+/// SYSTEM
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
 using namespace csapex;
 
-GraphImplementation::GraphImplementation() : in_transaction_(false), nf_(nullptr)
+GraphImplementation::GraphImplementation() : next_component_(0), transaction_depth_(0), nf_(nullptr)
 {
 }
 
@@ -64,7 +69,7 @@ void GraphImplementation::clear()
 {
     UUIDProvider::clearCache();
 
-    beginTransaction();
+    GraphTransaction transaction(*this);
 
     auto connections = edges_;
     for (const ConnectionPtr& c : connections) {
@@ -78,24 +83,47 @@ void GraphImplementation::clear()
         deleteNode(node->getUUID());
     }
     apex_assert_hard(vertices_.empty());
-
-    finalizeTransaction();
 }
 
 void GraphImplementation::addNode(NodeFacadeImplementationPtr nf)
 {
     apex_assert_hard_msg(nf, "NodeFacade added is not null");
+
+    const UUID& uuid = nf->getUUID();
+    if (uuid.depth() != 1) {
+        throw std::invalid_argument(std::string("node UUIDs have to be relative to their graph: ") + uuid.getFullName());
+    }
+
     graph::VertexPtr vertex = std::make_shared<graph::Vertex>(nf);
     vertices_.push_back(vertex);
+    vertex_index_[uuid.symbol(0)] = vertex;
+
+    NodeHandlePtr nh = nf->getNodeHandle();
+    for (const ConnectablePtr& connector : nh->getExternalConnectors()) {
+        indexConnector(connector);
+    }
+    std::vector<slim_signal::ScopedConnection>& observations = vertex_observations_[vertex.get()];
+    observations.emplace_back(nh->connector_created.connect([this](ConnectablePtr connector, bool internal) {
+        if (!internal) {
+            indexConnector(connector);
+        }
+    }));
+    observations.emplace_back(nh->connector_removed.connect([this](ConnectablePtr connector, bool internal) {
+        if (!internal) {
+            unindexConnector(connector);
+        }
+    }));
 
-    nf->getNodeHandle()->setVertex(vertex);
+    nh->setVertex(vertex);
 
     sources_.insert(vertex);
     sinks_.insert(vertex);
 
+    addComponent(vertex);
+
     vertex_added(vertex);
-    if (!in_transaction_) {
-        analyzeGraph();
+    if (!isInTransaction()) {
+        analyzeChanges();
     }
 }
 
@@ -137,9 +165,17 @@ void GraphImplementation::deleteNode(const UUID& uuid)
     apex_assert_hard(removed);
     apex_assert_hard(removed == node_handle->getVertex());
 
+    vertex_observations_.erase(removed.get());
+    vertex_index_.erase(uuid.symbol(0));
+    for (const ConnectablePtr& connector : node_handle->getExternalConnectors()) {
+        unindexConnector(connector);
+    }
+
     sources_.erase(removed);
     sinks_.erase(removed);
 
+    removeFromComponent(removed);
+
     for (const graph::VertexPtr& source : sources_) {
         apex_assert_neq(source, removed);
     }
@@ -157,8 +193,8 @@ void GraphImplementation::deleteNode(const UUID& uuid)
     //        }
 
     vertex_removed(removed);
-    if (!in_transaction_) {
-        analyzeGraph();
+    if (!isInTransaction()) {
+        analyzeChanges();
     }
 }
 
@@ -172,9 +208,14 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
     apex_assert_hard(connection);
     edges_.push_back(connection);
 
-    connection_observations_[connection.get()].push_back(connection->connection_changed.connect([this]() {
-        if (!in_transaction_) {
-            analyzeGraph();
+    Connection* observed = connection.get();
+    connection_observations_[observed].push_back(connection->connection_changed.connect([this, observed]() {
+        if (!observed->isDetached()) {
+            markChanged(findLocalVertexForConnector(observed->from()->getUUID()));
+            markChanged(findLocalVertexForConnector(observed->to()->getUUID()));
+        }
+        if (!isInTransaction()) {
+            analyzeChanges();
         }
     }));
 
@@ -194,15 +235,22 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
 
                 sources_.erase(v_to);
                 sinks_.erase(v_from);
+
+                if (isLocalVertex(v_from) && isLocalVertex(v_to)) {
+                    mergeComponents(v_from, v_to);
+                }
             }
         }
     }
 
+    markChanged(findLocalVertexForConnector(connection->from()->getUUID()));
+    markChanged(findLocalVertexForConnector(connection->to()->getUUID()));
+
     if (connection_added.isConnected()) {
         connection_added(connection->getDescription());
     }
-    if (!in_transaction_) {
-        analyzeGraph();
+    if (!isInTransaction()) {
+        analyzeChanges();
     }
     return true;
 }
@@ -258,24 +306,22 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
                         if (!still_connected) {
                             v_to->removeParent(v_from.get());
                             v_from->removeChild(v_to.get());
+
+                            if (isLocalVertex(v_from) && isLocalVertex(v_to)) {
+                                split_components_.insert(v_from->getNodeCharacteristics().component);
+                            }
                         }
 
                         if (!n_from->getOutputTransition()->hasConnection()) {
                             // verify that v_from is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_from) {
-                                    sinks_.insert(v_from);
-                                    break;
-                                }
+                            if (isLocalVertex(v_from)) {
+                                sinks_.insert(v_from);
                             }
                         }
                         if (!n_to->getInputTransition()->hasConnection()) {
                             // verify that v_to is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_to) {
-                                    sources_.insert(v_to);
-                                    break;
-                                }
+                            if (isLocalVertex(v_to)) {
+                                sources_.insert(v_to);
                             }
                         }
                     }
@@ -284,11 +330,14 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
 
             edges_.erase(c);
 
+            markChanged(findLocalVertexForConnector(out->getUUID()));
+            markChanged(findLocalVertexForConnector(in->getUUID()));
+
             if (connection_removed.isConnected()) {
                 connection_removed(connection->getDescription());
             }
-            if (!in_transaction_) {
-                analyzeGraph();
+            if (!isInTransaction()) {
+                analyzeChanges();
             }
             for (const auto& c : edges_) {
                 apex_assert_hard(c);
@@ -306,21 +355,198 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
 
 void GraphImplementation::beginTransaction()
 {
-    in_transaction_ = true;
+    ++transaction_depth_;
 }
 
 void GraphImplementation::finalizeTransaction()
 {
-    in_transaction_ = false;
+    apex_assert_hard(transaction_depth_ > 0);
+    if (--transaction_depth_ == 0) {
+        analyzeChanges();
+    }
+}
+
+bool GraphImplementation::isInTransaction() const
+{
+    return transaction_depth_ > 0;
+}
 
-    analyzeGraph();
+GraphTransaction::GraphTransaction(GraphImplementation& graph) : graph_(&graph)
+{
+    graph_->beginTransaction();
+}
+
+GraphTransaction::GraphTransaction(const GraphImplementationPtr& graph) : keep_alive_(graph), graph_(graph.get())
+{
+    if (graph_) {
+        graph_->beginTransaction();
+    }
+}
+
+GraphTransaction::~GraphTransaction()
+{
+    if (graph_) {
+        graph_->finalizeTransaction();
+    }
 }
 
 void GraphImplementation::analyzeGraph()
 {
     buildConnectedComponents();
 
-    calculateDepths();
+    analyzeRegion(vertices_);
+
+    state_changed();
+}
+
+graph::VertexPtr GraphImplementation::findLocalVertexForConnector(const UUID& connector_uuid) const
+{
+    NodeHandle* nh = findNodeHandleForConnectorNoThrow(connector_uuid);
+    if (!nh) {
+        return nullptr;
+    }
+
+    // forwarding connectors belong to the vertex of this graph in the parent graph
+    graph::VertexPtr vertex = nh->getVertex();
+    if (vertex && isLocalVertex(vertex)) {
+        return vertex;
+    }
+    return nullptr;
+}
+
+void GraphImplementation::markChanged(const graph::VertexPtr& vertex)
+{
+    if (vertex) {
+        changed_components_.insert(vertex->getNodeCharacteristics().component);
+    }
+}
+
+void GraphImplementation::addComponent(const graph::VertexPtr& vertex)
+{
+    int component = next_component_++;
+    vertex->getNodeCharacteristics().component = component;
+    components_[component].push_back(vertex);
+    changed_components_.insert(component);
+}
+
+void GraphImplementation::mergeComponents(const graph::VertexPtr& a, const graph::VertexPtr& b)
+{
+    int into = a->getNodeCharacteristics().component;
+    int from = b->getNodeCharacteristics().component;
+    if (into == from) {
+        return;
+    }
+
+    // relabel the smaller component, so that every vertex changes its component at most log(n) times
+    if (components_[into].size() < components_[from].size()) {
+        std::swap(into, from);
+    }
+
+    std::vector<graph::VertexPtr>& members = components_[into];
+    for (const graph::VertexPtr& vertex : components_[from]) {
+        vertex->getNodeCharacteristics().component = into;
+        members.push_back(vertex);
+    }
+    components_.erase(from);
+
+    changed_components_.erase(from);
+    changed_components_.insert(into);
+    if (split_components_.erase(from) > 0) {
+        split_components_.insert(into);
+    }
+}
+
+void GraphImplementation::removeFromComponent(const graph::VertexPtr& vertex)
+{
+    int component = vertex->getNodeCharacteristics().component;
+    auto pos = components_.find(component);
+    if (pos == components_.end()) {
+        return;
+    }
+
+    std::vector<graph::VertexPtr>& members = pos->second;
+    members.erase(std::remove(members.begin(), members.end(), vertex), members.end());
+
+    if (members.empty()) {
+        components_.erase(pos);
+        changed_components_.erase(component);
+        split_components_.erase(component);
+
+    } else {
+        // the remaining members might only have been connected via the removed vertex
+        changed_components_.insert(component);
+        split_components_.insert(component);
+    }
+}
+
+void GraphImplementation::splitComponent(int component)
+{
+    auto pos = components_.find(component);
+    if (pos == components_.end()) {
+        return;
+    }
+
+    std::vector<graph::VertexPtr> members;
+    members.swap(pos->second);
+    components_.erase(pos);
+
+    std::unordered_set<graph::Vertex*> unvisited;
+    for (const graph::VertexPtr& vertex : members) {
+        unvisited.insert(vertex.get());
+    }
+
+    // the first part keeps the id of the component, every further part gets a new one
+    int part = component;
+    for (const graph::VertexPtr& start : members) {
+        if (unvisited.erase(start.get()) == 0) {
+            continue;
+        }
+
+        std::vector<graph::VertexPtr>& part_members = components_[part];
+        changed_components_.insert(part);
+
+        std::deque<graph::VertexPtr> Q;
+        Q.push_back(start);
+        while (!Q.empty()) {
+            graph::VertexPtr front = Q.front();
+            Q.pop_front();
+
+            front->getNodeCharacteristics().component = part;
+            part_members.push_back(front);
+
+            for (const graph::VertexPtr& parent : front->getParents()) {
+                if (unvisited.erase(parent.get()) > 0) {
+                    Q.push_back(parent);
+                }
+            }
+            for (const graph::VertexPtr& child : front->getChildren()) {
+                if (unvisited.erase(child.get()) > 0) {
+                    Q.push_back(child);
+                }
+            }
+        }
+
+        part = next_component_++;
+    }
+}
+
+void GraphImplementation::analyzeChanges()
+{
+    for (int component : split_components_) {
+        splitComponent(component);
+    }
+    split_components_.clear();
+
+    std::vector<graph::VertexPtr> region;
+    for (int component : changed_components_) {
+        auto pos = components_.find(component);
+        if (pos != components_.end()) {
+            region.insert(region.end(), pos->second.begin(), pos->second.end());
+        }
+    }
+    changed_components_.clear();
+
+    analyzeRegion(region);
 
     state_changed();
 }
@@ -328,67 +554,77 @@ void GraphImplementation::analyzeGraph()
 void GraphImplementation::buildConnectedComponents()
 {
     /* Find all connected sub components of this graph */
-    std::deque<graph::Vertex*> unmarked;
-    for (auto vertex : vertices_) {
-        unmarked.push_back(vertex.get());
+    components_.clear();
+    changed_components_.clear();
+    split_components_.clear();
+    next_component_ = 0;
+
+    for (const graph::VertexPtr& vertex : vertices_) {
         vertex->getNodeCharacteristics().component = -1;
     }
 
-    std::deque<graph::Vertex*> Q;
-    int component = 0;
-    while (!unmarked.empty()) {
-        // take a random unmarked node to start bfs from
-        auto* start = unmarked.front();
-        Q.push_back(start);
+    for (const graph::VertexPtr& start : vertices_) {
+        if (start->getNodeCharacteristics().component != -1) {
+            continue;
+        }
 
+        int component = next_component_++;
+        std::vector<graph::VertexPtr>& members = components_[component];
+
+        std::deque<graph::VertexPtr> Q;
+        Q.push_back(start);
         start->getNodeCharacteristics().component = component;
 
         while (!Q.empty()) {
-            graph::Vertex* front = Q.front();
+            graph::VertexPtr front = Q.front();
             Q.pop_front();
 
-            NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(front->getNodeFacade());
-            apex_assert_hard(local_facade);
-
-            checkNodeState(local_facade->getNodeHandle().get());
+            members.push_back(front);
 
-            auto it = std::find(unmarked.begin(), unmarked.end(), front);
-            if (it == unmarked.end()) {
-                continue;
-            }
-            unmarked.erase(it);
-
-            // iterate all neighbors
-            std::vector<graph::Vertex*> neighbors;
-            for (auto parent : front->getParents()) {
-                neighbors.push_back(parent.get());
-            }
-            for (auto child : front->getChildren()) {
-                neighbors.push_back(child.get());
+            // iterate all neighbors in this graph
+            std::vector<graph::VertexPtr> neighbors = front->getParents();
+            for (const graph::VertexPtr& child : front->getChildren()) {
+                neighbors.push_back(child);
             }
 
-            for (auto* neighbor : neighbors) {
-                if (neighbor->getNodeCharacteristics().component == -1) {
+            for (const graph::VertexPtr& neighbor : neighbors) {
+                if (isLocalVertex(neighbor) && neighbor->getNodeCharacteristics().component == -1) {
                     neighbor->getNodeCharacteristics().component = component;
                     Q.push_back(neighbor);
                 }
             }
         }
+    }
+}
+
+void GraphImplementation::analyzeRegion(const std::vector<graph::VertexPtr>& region)
+{
+    std::unordered_set<graph::Vertex*> in_region;
+    for (const graph::VertexPtr& vertex : region) {
+        in_region.insert(vertex.get());
+
+        NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        apex_assert_hard(local_facade);
 
-        ++component;
+        checkNodeState(local_facade->getNodeHandle().get());
     }
+
+    calculateDepths(region, in_region);
 }
 
-std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams()
+std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams(const std::vector<graph::VertexPtr>& region, const std::unordered_set<graph::Vertex*>& in_region)
 {
     std::set<graph::Vertex*> joins;
 
-    for (graph::VertexPtr vertex : vertices_) {
+    for (const graph::VertexPtr& vertex : region) {
         vertex->getNodeCharacteristics().depth = -1;
     }
 
     // init node_depth_ and find merging nodes
-    for (const graph::VertexPtr source : sources_) {
+    for (const graph::VertexPtr& source : region) {
+        if (sources_.find(source) == sources_.end()) {
+            continue;
+        }
         source->getNodeCharacteristics().depth = 0;
 
         std::deque<const graph::Vertex*> Q;
@@ -398,6 +634,9 @@ std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams()
             Q.pop_back();
 
             for (auto child : top->getChildren()) {
+                if (in_region.find(child.get()) == in_region.end()) {
+                    continue;
+                }
                 if (child->getNodeCharacteristics().depth < 0) {
                     child->getNodeCharacteristics().depth = std::numeric_limits<int>::max();
                     Q.push_back(child.get());
@@ -413,11 +652,11 @@ std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams()
     return joins;
 }
 
-std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages()
+std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages(const std::vector<graph::VertexPtr>& region)
 {
     std::set<graph::Vertex*> vertices_that_need_messages;
 
-    for (const graph::VertexPtr v : vertices_) {
+    for (const graph::VertexPtr& v : region) {
         if (v->getNodeFacade()->isProcessingNothingMessages()) {
             vertices_that_need_messages.insert(v.get());
             break;
@@ -437,14 +676,16 @@ std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages()
     return vertices_that_need_messages;
 }
 
-void GraphImplementation::calculateDepths()
+void GraphImplementation::calculateDepths(const std::vector<graph::VertexPtr>& region, const std::unordered_set<graph::Vertex*>& in_region)
 {
     // start DFSs at each source. assign each node:
     // - depth: the minimum distance to any source
     // - joining: true, iff more than one path leads from any source to a node
 
+    // only the vertices in the region are updated, all others are in different components and thus unaffected
+
     // initialize
-    for (const graph::VertexPtr& vertex : vertices_) {
+    for (const graph::VertexPtr& vertex : region) {
         NodeCharacteristics& characteristics = vertex->getNodeCharacteristics();
         characteristics.is_joining_vertex = false;
         characteristics.is_joining_vertex_counterpart = false;
@@ -454,7 +695,7 @@ void GraphImplementation::calculateDepths()
         characteristics.is_leading_to_essential_vertex = false;
     }
 
-    std::set<graph::Vertex*> essentials = findVerticesThatNeedMessages();
+    std::set<graph::Vertex*> essentials = findVerticesThatNeedMessages(region);
 
     for (const graph::Vertex* essential : essentials) {
         essential->getNodeCharacteristics().is_leading_to_essential_vertex = true;
@@ -475,10 +716,13 @@ void GraphImplementation::calculateDepths()
         }
     }
 
-    std::set<graph::Vertex*> joins = findVerticesThatJoinStreams();
+    std::set<graph::Vertex*> joins = findVerticesThatJoinStreams(region, in_region);
 
     // populate node_depth_ with minimal depths
-    for (const graph::VertexPtr source : sources_) {
+    for (const graph::VertexPtr& source : region) {
+        if (sources_.find(source) == sources_.end()) {
+            continue;
+        }
         source->getNodeCharacteristics().depth = 0;
 
         std::deque<const graph::Vertex*> Q;
@@ -489,6 +733,9 @@ void GraphImplementation::calculateDepths()
 
             int top_depth = top->getNodeCharacteristics().depth;
             for (auto child : top->getChildren()) {
+                if (in_region.find(child.get()) == in_region.end()) {
+                    continue;
+                }
                 int& child_depth = child->getNodeCharacteristics().depth;
                 if (child_depth == std::numeric_limits<int>::max()) {
                     child_depth = top_depth + 1;
@@ -546,7 +793,7 @@ void GraphImplementation::calculateDepths()
             done.insert(top);
             Q.erase(Q.begin());
             for (graph::VertexPtr parent : top->getParents()) {
-                if (done.find(parent.get()) != done.end()) {
+                if (done.find(parent.get()) != done.end() || in_region.find(parent.get()) == in_region.end()) {
                     continue;
                 }
                 if (std::find(Q.begin(), Q.end(), parent.get()) == Q.end()) {
@@ -689,26 +936,11 @@ NodeHandle* GraphImplementation::findNodeHandleNoThrow(const UUID& uuid) const n
         apex_assert_hard(nf_->getNodeHandle()->guard_ == -1);
         return nf_->getNodeHandle().get();
     }
-    if (uuid.composite()) {
-        UUID root = uuid.rootUUID();
-
-        NodeFacadePtr nf = findNodeFacade(root);
-        if (nf->isGraph()) {
-            GraphImplementationPtr local_graph = std::dynamic_pointer_cast<GraphImplementation>(nf->getSubgraph());
-            apex_assert_hard(local_graph);
-
-            return local_graph->findNodeHandleNoThrow(uuid.nestedUUID());
-        }
-
-    } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr facade = vertex->getNodeFacade();
-            if (facade->getUUID() == uuid) {
-                NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(facade);
-                apex_assert_hard(local_facade);
-                return local_facade->getNodeHandle().get();
-            }
-        }
+    graph::Vertex* vertex = findVertexNoThrow(uuid, uuid.depth());
+    if (vertex) {
+        NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        apex_assert_hard(local_facade);
+        return local_facade->getNodeHandle().get();
     }
 
     return nullptr;
@@ -766,22 +998,9 @@ NodeFacadePtr GraphImplementation::findNodeFacadeNoThrow(const UUID& uuid) const
         apex_assert_hard(nf_);
         return nf_->shared_from_this();
     }
-    if (uuid.composite()) {
-        NodeFacadePtr root = findNodeFacadeNoThrow(uuid.rootUUID());
-        if (root && root->isGraph()) {
-            GraphPtr graph = root->getSubgraph();
-            apex_assert_hard(graph);
-
-            return graph->findNodeFacadeNoThrow(uuid.nestedUUID());
-        }
-
-    } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr nf = vertex->getNodeFacade();
-            if (nf->getUUID() == uuid) {
-                return nf;
-            }
-        }
+    graph::Vertex* vertex = findVertexNoThrow(uuid, uuid.depth());
+    if (vertex) {
+        return vertex->getNodeFacade();
     }
 
     return nullptr;
@@ -877,6 +1096,15 @@ ConnectorPtr GraphImplementation::findConnector(const UUID& uuid)
 
 ConnectorPtr GraphImplementation::findConnectorNoThrow(const UUID& uuid) noexcept
 {
+    if (uuid.depth() == 2) {
+        auto pos = connector_index_.find(getConnectorKey(uuid));
+        if (pos != connector_index_.end()) {
+            if (ConnectablePtr connector = pos->second.lock()) {
+                return connector;
+            }
+        }
+    }
+
     NodeHandle* owner = findNodeHandleNoThrow(uuid.parentUUID());
     if (!owner) {
         return nullptr;
@@ -885,6 +1113,59 @@ ConnectorPtr GraphImplementation::findConnectorNoThrow(const UUID& uuid) noexcep
     return owner->getConnectorNoThrow(uuid);
 }
 
+graph::Vertex* GraphImplementation::findVertexNoThrow(const UUID& uuid, std::size_t depth) const noexcept
+{
+    // the root of the first depth levels is a node of this graph, the remaining levels are nested in it
+    auto pos = vertex_index_.find(uuid.symbol(depth - 1));
+    if (pos == vertex_index_.end()) {
+        return nullptr;
+    }
+
+    graph::Vertex* vertex = pos->second.get();
+    if (depth == 1) {
+        return vertex;
+    }
+
+    NodeFacadePtr root = vertex->getNodeFacade();
+    if (!root->isGraph()) {
+        return nullptr;
+    }
+
+    GraphImplementationPtr local_graph = std::dynamic_pointer_cast<GraphImplementation>(root->getSubgraph());
+    apex_assert_hard(local_graph);
+    return local_graph->findVertexNoThrow(uuid, depth - 1);
+}
+
+bool GraphImplementation::isLocalVertex(const graph::VertexPtr& vertex) const
+{
+    auto pos = vertex_index_.find(vertex->getUUID().symbol(0));
+    return pos != vertex_index_.end() && pos->second == vertex;
+}
+
+uint64_t GraphImplementation::getConnectorKey(const UUID& connector_uuid)
+{
+    return (static_cast<uint64_t>(connector_uuid.symbol(1)) << 32) | connector_uuid.symbol(0);
+}
+
+void GraphImplementation::indexConnector(const ConnectablePtr& connector)
+{
+    const UUID& uuid = connector->getUUID();
+    if (uuid.depth() == 2) {
+        connector_index_[getConnectorKey(uuid)] = connector;
+    }
+}
+
+void GraphImplementation::unindexConnector(const ConnectablePtr& connector)
+{
+    const UUID& uuid = connector->getUUID();
+    if (uuid.depth() == 2) {
+        auto pos = connector_index_.find(getConnectorKey(uuid));
+        if (pos != connector_index_.end() && pos->second.lock() == connector) {
+            connector_index_.erase(pos);
+        }
+    }
+}
+
 bool GraphImplementation::isConnected(const UUID& from, const UUID& to) const
 {
     for (const ConnectionConstPtr& connection : edges_) {
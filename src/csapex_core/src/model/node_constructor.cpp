@@ -22,15 +22,15 @@ NodeConstructor::NodeConstructionException::NodeConstructionException(const std:
 {
 }
 
-NodeConstructor::NodeConstructor(const std::string& type, std::function<NodePtr()> c) : type_(type), icon_(":/no_icon.png"), properties_loaded_(false), c(c)
+NodeConstructor::NodeConstructor(const std::string& type, std::function<NodePtr()> c) : type_(type), icon_(":/no_icon.png"), concurrent_loading_(false), properties_loaded_(false), c(c)
 {
 }
 
-NodeConstructor::NodeConstructor(const std::string& type) : type_(type), icon_(":/no_icon.png"), properties_loaded_(false)
+NodeConstructor::NodeConstructor(const std::string& type) : type_(type), icon_(":/no_icon.png"), concurrent_loading_(false), properties_loaded_(false)
 {
 }
 
-NodeConstructor::NodeConstructor() : type_("unnamed"), icon_(":/no_icon.png"), properties_loaded_(false)
+NodeConstructor::NodeConstructor() : type_("unnamed"), icon_(":/no_icon.png"), concurrent_loading_(false), properties_loaded_(false)
 {
 }
 
@@ -129,6 +129,17 @@ std::string NodeConstructor::getDescription() const
     return descr_;
 }
 
+NodeConstructor& NodeConstructor::setConcurrentLoading(bool concurrent)
+{
+    concurrent_loading_ = concurrent;
+    return *this;
+}
+
+bool NodeConstructor::allowsConcurrentLoading() const
+{
+    return concurrent_loading_;
+}
+
 NodeHandlePtr NodeConstructor::makePrototype() const
 {
     tmp_uuid_provider_ = std::make_shared<UUIDProvider>();
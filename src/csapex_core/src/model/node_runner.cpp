@@ -11,14 +11,21 @@
 #include <csapex/model/node_state.h>
 #include <csapex/utility/thread.h>
 #include <csapex/model/subgraph_node.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node_characteristics.h>
 #include <csapex/utility/exceptions.h>
+#include <csapex/profiling/profiler_impl.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <memory>
 #include <iostream>
 
 using namespace csapex;
 
+const std::string NodeRunner::DEADLINE_MISSES = "deadline misses";
+const std::string NodeRunner::QUEUE_WAIT = "queue wait";
+
 NodeRunner::NodeRunner(NodeWorkerPtr worker)
   : worker_(worker)
   , nh_(worker->getNodeHandle())
@@ -28,6 +35,7 @@ NodeRunner::NodeRunner(NodeWorkerPtr worker)
   , can_step_(0)
   , step_done_(false)
   , guard_(-1)
+  , processing_deadline_(std::chrono::steady_clock::time_point::max())
   , waiting_for_execution_(false)
   , waiting_for_step_(false)
   , suppress_exceptions_(true)
@@ -63,11 +71,41 @@ void NodeRunner::measureFrequency()
     }
 }
 
+void NodeRunner::checkDeadline()
+{
+    std::chrono::steady_clock::time_point deadline;
+    {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        deadline = processing_deadline_;
+        processing_deadline_ = std::chrono::steady_clock::time_point::max();
+    }
+
+    if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() > deadline) {
+        worker_->getProfiler()->increment(nh_->getUUID().getFullName(), DEADLINE_MISSES);
+    }
+}
+
+void NodeRunner::recordQueueWait()
+{
+    // only tasks scheduled to a profiled or idle group carry the time they were scheduled at
+    std::chrono::steady_clock::time_point scheduled = execute_->getScheduledTime();
+    if (scheduled == std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    std::shared_ptr<ProfilerImplementation> profiler = worker_->getProfiler();
+    if (profiler && profiler->isEnabled()) {
+        auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - scheduled);
+        profiler->record(nh_->getUUID().getFullName(), QUEUE_WAIT, wait.count());
+    }
+}
+
 void NodeRunner::reset()
 {
     waiting_for_execution_ = false;
     waiting_for_step_ = false;
     remaining_tasks_.clear();
+    remaining_delayed_tasks_.clear();
 
     execute_->setScheduled(false);
     check_parameters_->setScheduled(false);
@@ -99,6 +137,7 @@ void NodeRunner::connectNodeWorker()
 
     observe(worker_->messages_processed, [this]() {
         measureFrequency();
+        checkDeadline();
         step_done_ = true;
         // TRACE worker_->getNode()->ainfo << "end step" << std::endl;
         end_step();
@@ -114,10 +153,19 @@ void NodeRunner::assignToScheduler(Scheduler* scheduler)
 
     scheduler_ = scheduler;
 
+    for (const TaskPtr& task : remaining_tasks_) {
+        prioritize(task);
+    }
     scheduler_->add(shared_from_this(), remaining_tasks_);
+    // delayed tasks keep their time, a throttled node must not be executed early because it changed its scheduler
+    for (const DelayedTask& delayed : remaining_delayed_tasks_) {
+        prioritize(delayed.task);
+        scheduler_->scheduleDelayed(delayed.task, delayed.time);
+    }
     nh_->getNodeState()->setThread(scheduler->getName(), scheduler->id());
 
     remaining_tasks_.clear();
+    remaining_delayed_tasks_.clear();
 
     stopObserving();
 
@@ -157,7 +205,6 @@ void NodeRunner::scheduleProcess()
     if (!paused_) {
         bool source = nh_->isSource();
         if (!source || !stepping_ || can_step_) {
-            // execute_->setPriority(std::max<long>(0, worker_->getSequenceNumber()));
             // if(worker_->canExecute()) {
             if (!waiting_for_execution_) {
                 schedule(execute_);
@@ -186,7 +233,7 @@ void NodeRunner::execute()
             if (f > max_frequency_) {
                 auto next_process = rate.endOfCycle();
 
-                auto now = std::chrono::system_clock::now();
+                auto now = std::chrono::steady_clock::now();
 
                 if (next_process > now) {
                     scheduleDelayed(execute_, next_process);
@@ -198,6 +245,8 @@ void NodeRunner::execute()
 
         waiting_for_execution_ = false;
 
+        recordQueueWait();
+
         nh_->getRate().startCycle();
 
         if (stepping_) {
@@ -205,11 +254,19 @@ void NodeRunner::execute()
         }
         can_step_--;
 
+        {
+            // processing might finish before startProcessingMessages returns
+            std::unique_lock<std::recursive_mutex> lock(mutex_);
+            processing_deadline_ = execute_->getDeadline();
+        }
+
         try {
             if (worker_->canExecute()) {
                 if (!worker_->startProcessingMessages()) {
                     // TRACE worker_->getNode()->ainfo << "execute failed" << std::endl;
                     can_step_++;
+                    std::unique_lock<std::recursive_mutex> lock(mutex_);
+                    processing_deadline_ = std::chrono::steady_clock::time_point::max();
                 }
             }
         } catch (const std::exception& e) {
@@ -247,15 +304,46 @@ void NodeRunner::schedule(TaskPtr task)
 
     if (scheduler_) {
         for (const TaskPtr& t : remaining_tasks_) {
+            prioritize(t);
             scheduler_->schedule(t);
         }
         remaining_tasks_.clear();
     }
 }
 
-void NodeRunner::scheduleDelayed(TaskPtr task, std::chrono::system_clock::time_point time)
+void NodeRunner::prioritize(const TaskPtr& task)
+{
+    TaskPriorityPolicy policy = scheduler_->getPriorityPolicy();
+    if (task == execute_) {
+        graph::VertexPtr vertex = nh_->getVertex();
+        task->setPriority(task_priority::forProcessing(policy, vertex ? vertex->getNodeCharacteristics().depth : -1));
+
+        if (max_frequency_ > 0.0) {
+            // the next cycle is released at the end of the current one and has to be done one period later
+            const Rate& rate = nh_->getRate();
+            task->setDeadline(std::max(std::chrono::steady_clock::now(), rate.endOfCycle()) + rate.getPeriod());
+        } else {
+            task->clearDeadline();
+        }
+    } else {
+        task->setPriority(task_priority::forControl(policy));
+    }
+}
+
+void NodeRunner::scheduleDelayed(TaskPtr task, std::chrono::steady_clock::time_point time)
 {
     std::unique_lock<std::recursive_mutex> lock(mutex_);
+    if (!scheduler_) {
+        // like the scheduler, only the earliest time of a task counts
+        auto pos = std::find_if(remaining_delayed_tasks_.begin(), remaining_delayed_tasks_.end(), [&task](const DelayedTask& delayed) { return delayed.task == task; });
+        if (pos == remaining_delayed_tasks_.end()) {
+            remaining_delayed_tasks_.push_back(DelayedTask{ task, time });
+        } else {
+            pos->time = std::min(pos->time, time);
+        }
+        return;
+    }
+    prioritize(task);
     scheduler_->scheduleDelayed(task, time);
 }
 
@@ -264,7 +352,7 @@ void NodeRunner::detach()
     std::unique_lock<std::recursive_mutex> lock(mutex_);
 
     if (scheduler_) {
-        auto t = scheduler_->remove(this);
+        auto t = scheduler_->remove(this, remaining_delayed_tasks_);
         remaining_tasks_.insert(remaining_tasks_.end(), t.begin(), t.end());
         scheduler_ = nullptr;
     }
@@ -7,6 +7,7 @@
 #include <csapex/utility/yaml_io.hpp>
 #include <csapex/model/generic_state.h>
 #include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
 
 /// SYSTEM
 #include <iostream>
@@ -404,7 +405,7 @@ void NodeState::readYaml(const YAML::Node& node)
 
     if (node["label"].IsDefined()) {
         setLabel(node["label"].as<std::string>());
-        if (label_.empty()) {
+        if (label_.empty() && parent_) {
             setLabel(parent_->getUUID().getFullName());
         }
     }
@@ -457,8 +458,8 @@ void NodeState::readYaml(const YAML::Node& node)
 
     if (node["state"].IsDefined()) {
         const YAML::Node& state_map = node["state"];
-        auto node = parent_->getNode().lock();
-        if (!node) {
+        // a state without a parent is only converted, e.g. between file formats
+        if (parent_ && !parent_->getNode().lock()) {
             return;
         }
 
@@ -466,8 +467,38 @@ void NodeState::readYaml(const YAML::Node& node)
     }
 }
 
+void NodeState::readState(const NodeState& loaded)
+{
+    setMaximumFrequency(loaded.max_frequency_);
+    setMinimized(loaded.minimized_);
+    setMuted(loaded.muted_);
+    setEnabled(loaded.enabled_);
+    setFlipped(loaded.flipped_);
+    setExecutionMode(loaded.exec_mode_);
+    setExecutionType(loaded.exec_type_);
+
+    setLabel(loaded.label_);
+    if (label_.empty() && parent_) {
+        setLabel(parent_->getUUID().getFullName());
+    }
+
+    setLoggerLevel(loaded.logger_level_);
+    setPos(loaded.pos_);
+    setColor(loaded.r_, loaded.g_, loaded.b_);
+    setZ(loaded.z_);
+
+    for (const auto& pair : loaded.dictionary) {
+        dictionary[pair.first] = pair.second;
+    }
+
+    parameter_state->mergeFrom(*loaded.parameter_state);
+}
+
 void NodeState::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
+    // version 1 stores the parameters in binary instead of an embedded yaml document
+    version = SemanticVersion(1, 0, 0);
+
     data << max_frequency_;
 
     data << label_;
@@ -494,9 +525,7 @@ void NodeState::serialize(SerializationBuffer& data, SemanticVersion& version) c
     data << exec_mode_;
     data << exec_type_;
 
-    YAML::Node yaml;
-    parameter_state->writeYaml(yaml);
-    data << yaml;
+    data << *parameter_state;
 }
 
 void NodeState::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
@@ -527,11 +556,18 @@ void NodeState::deserialize(const SerializationBuffer& data, const SemanticVersi
     data >> exec_mode_;
     data >> exec_type_;
 
-    YAML::Node yaml;
-    data >> yaml;
+    if (version.major_v >= 1) {
+        GenericState loaded;
+        data >> loaded;
+        parameter_state->mergeFrom(loaded);
 
-    if (yaml.IsDefined()) {
-        parameter_state->readYaml(yaml);
+    } else {
+        YAML::Node yaml;
+        data >> yaml;
+
+        if (yaml.IsDefined()) {
+            parameter_state->readYaml(yaml);
+        }
     }
 }
 
@@ -481,6 +481,7 @@ void NodeWorker::processSlot(const SlotWeakPtr& slot_w)
 
             startProfilerInterval(ActivityType::SLOT_CALLBACK);
             if (profiler_->isEnabled()) {
+                timer = profiler_->getTimer(node_handle_->getUUID().getFullName());
                 interlude = timer->step(std::string("slot ") + slot->getLabel());
             }
 
@@ -189,7 +189,7 @@ void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params,
     apex_assert_hard(is_initialized_);
 
     // can fail...
-    apex_assert_hard(transition_relay_out_->areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(transition_relay_out_->canConnectionsReceiveToken());
     apex_assert_hard(transition_relay_out_->canStartSendingMessages());
 
     is_iterating_ = false;
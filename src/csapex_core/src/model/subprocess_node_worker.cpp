@@ -27,6 +27,7 @@
 #include <csapex/signal/event.h>
 #include <csapex/signal/slot.h>
 #include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
 #include <csapex/utility/debug.h>
 #include <csapex/utility/delegate_bind.h>
 #include <csapex/utility/exceptions.h>
@@ -34,6 +35,8 @@
 #include <csapex/serialization/packet_serializer.h>
 
 /// SYSTEM
+#include <algorithm>
+#include <functional>
 #include <thread>
 #include <iostream>
 #include <cstdlib>
@@ -44,7 +47,60 @@
 
 using namespace csapex;
 
-SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle) : NodeWorker(node_handle), pid_(-1), subprocess_(new Subprocess(node_handle->getUUID().getFullName()))
+namespace
+{
+/**
+ * Tokens are exchanged with the subprocess as a count followed by one record per connector:
+ * the connector's UUID, the binary token data, the activity modifier and the sequence number.
+ */
+void writeToken(SerializationBuffer& buffer, const UUID& uuid, const TokenConstPtr& token, int seq_no)
+{
+    buffer << uuid;
+    buffer.write(token->getTokenData());
+    buffer << token->getActivityModifier();
+    buffer << seq_no;
+}
+
+void writeToken(SerializationBuffer& buffer, const UUID& uuid, const TokenConstPtr& token)
+{
+    writeToken(buffer, uuid, token, token->getSequenceNumber());
+}
+
+TokenPtr readToken(const SerializationBuffer& buffer, UUID& uuid)
+{
+    buffer >> uuid;
+
+    TokenDataConstPtr data;
+    buffer >> data;
+    apex_assert_hard_msg(data, std::string("received an empty token for ") + uuid.getFullName());
+
+    ActivityModifier modifier;
+    buffer >> modifier;
+    int seq_no;
+    buffer >> seq_no;
+
+    TokenPtr token = std::make_shared<Token>(data);
+    token->setActivityModifier(modifier);
+    token->setSequenceNumber(seq_no);
+    return token;
+}
+
+/**
+ * @brief writeInPlace serializes a message directly into the payload region of the channel
+ */
+void writeInPlace(SubprocessChannel& channel, const SubprocessChannel::MessageType type, const std::function<void(SerializationBuffer&)>& serialize)
+{
+    SubprocessChannel::Payload payload = channel.acquirePayload();
+    SerializationBuffer buffer(std::make_shared<SerializationRegion>(payload.data, payload.capacity));
+    serialize(buffer);
+
+    // a message that outgrew the region is copied into a larger one
+    channel.write({ type, buffer.data(), buffer.size() });
+}
+
+}  // namespace
+
+SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle) : NodeWorker(node_handle), pid_(-1), received_sequence_number_(-1), subprocess_(new Subprocess(node_handle->getUUID().getFullName()))
 {
 }
 
@@ -163,17 +219,21 @@ void SubprocessNodeWorker::handleProcessChild(const SubprocessChannel::Message&
     apex_assert_hard(node->canRunInSeparateProcess());
 
     try {
+        received_sequence_number_ = -1;
         if (msg.data) {
-            YAML::Node yaml = YAML::Load(msg.toString());
-            for (const YAML::Node& node : yaml) {
-                UUID uuid = node["uuid"].as<UUID>();
-                auto msg = MessageSerializer::deserializeYamlMessage(node["data"]);
+            SerializationBuffer buffer = SerializationBuffer::view(msg.data, msg.length);
+            uint32_t count;
+            buffer >> count;
+            for (uint32_t i = 0; i < count; ++i) {
+                UUID uuid;
+                TokenPtr token = readToken(buffer, uuid);
+                received_sequence_number_ = std::max(received_sequence_number_, token->getSequenceNumber());
 
                 InputPtr input = node_handle_->getInput(uuid);
                 apex_assert_hard_msg(input, std::string("could not get input ") + uuid.getFullName());
 
-                input->setToken(std::make_shared<Token>(msg));
-            };
+                input->setToken(token);
+            }
         }
 
         if (msg.type == SubprocessChannel::MessageType::PROCESS_SYNC) {
@@ -204,15 +264,16 @@ void SubprocessNodeWorker::handleProcessSlotChild(const SubprocessChannel::Messa
     apex_assert_hard(node->canRunInSeparateProcess());
 
     try {
+        received_sequence_number_ = -1;
         if (msg.data) {
-            YAML::Node yaml = YAML::Load(msg.toString());
-            UUID uuid = yaml["uuid"].as<UUID>();
-            auto msg = MessageSerializer::deserializeYamlMessage(yaml["data"]);
+            SerializationBuffer buffer = SerializationBuffer::view(msg.data, msg.length);
+            UUID uuid;
+            TokenPtr token = readToken(buffer, uuid);
 
             SlotPtr slot = node_handle_->getSlot(uuid);
             apex_assert_hard_msg(slot, std::string("could not get slot ") + uuid.getFullName());
 
-            slot->setToken(std::make_shared<Token>(msg));
+            slot->setToken(token);
             slot->handleEvent();
         }
 
@@ -230,7 +291,7 @@ void SubprocessNodeWorker::finishHandleProcessChild()
 {
     NodePtr node = getNode();
 
-    YAML::Emitter result_emitter;
+    std::vector<std::pair<UUID, TokenPtr>> tokens;
     try {
         // send parameter updates
         for (param::Parameter* parameter : changed_parameters_) {
@@ -239,43 +300,18 @@ void SubprocessNodeWorker::finishHandleProcessChild()
 
         changed_parameters_.clear();
 
-        // send result
-        YAML::Node yaml(YAML::NodeType::Sequence);
-
+        // collect the result
         for (const OutputPtr& output : node_handle_->getExternalOutputs()) {
-            auto msg = output->getAddedToken();
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = output->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg->getTokenData());
-
-                YAML::Emitter emitter;
-                emitter << node;
-
-                yaml.push_back(node);
+            if (TokenPtr token = output->getAddedToken()) {
+                tokens.emplace_back(output->getUUID(), token);
             }
         }
-
         for (const EventPtr& event : node_handle_->getExternalEvents()) {
-            auto msg = event->getAddedToken();
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = event->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg->getTokenData());
-
-                YAML::Emitter emitter;
-                emitter << node;
-
-                yaml.push_back(node);
+            if (TokenPtr token = event->getAddedToken()) {
+                tokens.emplace_back(event->getUUID(), token);
             }
         }
 
-        result_emitter << yaml;
-
     } catch (const std::exception& e) {
         node->aerr << "finishHandleProcessChild: " << e.what() << std::endl;
     } catch (const Failure& f) {
@@ -286,7 +322,31 @@ void SubprocessNodeWorker::finishHandleProcessChild()
 
     subprocess_->flush();
 
-    subprocess_->out.write({ SubprocessChannel::MessageType::PROCESS_FINISHED, result_emitter.c_str() });
+    // send result, uncommitted tokens carry the sequence number of the processed inputs
+    writeInPlace(subprocess_->out, SubprocessChannel::MessageType::PROCESS_FINISHED, [&](SerializationBuffer& result) {
+        bool complete = false;
+        try {
+            result << static_cast<uint32_t>(tokens.size());
+            for (const auto& pair : tokens) {
+                int seq_no = pair.second->getSequenceNumber();
+                writeToken(result, pair.first, pair.second, seq_no >= 0 ? seq_no : received_sequence_number_);
+            }
+            complete = true;
+
+        } catch (const std::exception& e) {
+            node->aerr << "finishHandleProcessChild: " << e.what() << std::endl;
+        } catch (const Failure& f) {
+            node->aerr << "finishHandleProcessChild failure: " << f.what() << std::endl;
+        } catch (...) {
+            node->aerr << "unknown error in finishHandleProcessChild" << std::endl;
+        }
+
+        if (!complete) {
+            // nothing could be serialized, report no tokens
+            result.resize(SerializationBuffer::HEADER_LENGTH);
+            result << static_cast<uint32_t>(0);
+        }
+    });
 }
 
 SubprocessNodeWorker::~SubprocessNodeWorker()
@@ -311,21 +371,26 @@ void SubprocessNodeWorker::handleParameterUpdate(const SubprocessChannel::Messag
 void SubprocessNodeWorker::handleProcessParent(const SubprocessChannel::Message& msg)
 {
     if (msg.data) {
-        YAML::Node yaml = YAML::Load(msg.toString());
-
-        for (const YAML::Node& node : yaml) {
-            UUID uuid = node["uuid"].as<UUID>();
-            auto msg = MessageSerializer::deserializeYamlMessage(node["data"]);
+        SerializationBuffer buffer = SerializationBuffer::view(msg.data, msg.length);
+        uint32_t count;
+        buffer >> count;
+        for (uint32_t i = 0; i < count; ++i) {
+            UUID uuid;
+            TokenPtr token = readToken(buffer, uuid);
 
             ConnectorPtr connector = node_handle_->getConnector(uuid);
             if (OutputPtr output = std::dynamic_pointer_cast<Output>(connector)) {
-                msg::publish(output.get(), msg);
+                int seq_no = token->getSequenceNumber();
+                if (seq_no >= 0) {
+                    // the outputs advance their sequence number on commit, so this commit keeps the one of the child
+                    node_handle_->getOutputTransition()->setSequenceNumber(seq_no - 1);
+                }
+                output->addMessage(token);
 
             } else if (EventPtr event = std::dynamic_pointer_cast<Event>(connector)) {
-                TokenPtr token = std::make_shared<Token>(msg);
                 event->triggerWith(token);
             }
-        };
+        }
     }
 }
 
@@ -371,26 +436,22 @@ void SubprocessNodeWorker::processNode()
 
 void SubprocessNodeWorker::startSubprocess(const SubprocessChannel::MessageType type)
 {
-    YAML::Node yaml(YAML::NodeType::Sequence);
-
+    std::vector<InputPtr> inputs;
     for (const InputPtr& input : node_handle_->getExternalInputs()) {
         if (msg::hasMessage(input.get())) {
-            auto msg = msg::getMessage(input.get());
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = input->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg);
-                yaml.push_back(node);
+            TokenPtr token = input->getToken();
+            if (token && token->getTokenData()) {
+                inputs.push_back(input);
             }
         }
     }
 
-    YAML::Emitter emitter;
-    emitter << yaml;
-
-    subprocess_->in.write({ type, emitter.c_str() });
+    writeInPlace(subprocess_->in, type, [&](SerializationBuffer& buffer) {
+        buffer << static_cast<uint32_t>(inputs.size());
+        for (const InputPtr& input : inputs) {
+            writeToken(buffer, input->getUUID(), input->getToken());
+        }
+    });
 }
 
 void SubprocessNodeWorker::processSlot(const SlotWeakPtr& slot_w)
@@ -417,18 +478,8 @@ void SubprocessNodeWorker::startSubprocessSlot(const SlotPtr& slot)
     TokenPtr token = slot->getToken();
     apex_assert_hard(token);
 
-    auto msg = msg::getMessage(slot.get());
-
-    if (msg) {
-        YAML::Node yaml(YAML::NodeType::Map);
-        yaml["uuid"] = slot->getUUID();
-        // TODO serialize token! (+ activity, ...)
-        yaml["data"] = MessageSerializer::serializeYamlMessage(*msg);
-
-        YAML::Emitter emitter;
-        emitter << yaml;
-
-        subprocess_->in.write({ SubprocessChannel::MessageType::PROCESS_SLOT, emitter.c_str() });
+    if (token->getTokenData()) {
+        writeInPlace(subprocess_->in, SubprocessChannel::MessageType::PROCESS_SLOT, [&](SerializationBuffer& buffer) { writeToken(buffer, slot->getUUID(), token); });
 
         finishSubprocess();
     }
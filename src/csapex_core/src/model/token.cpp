@@ -1,18 +1,26 @@
 /// HEADER
 #include <csapex/model/token.h>
 
+/// PROJECT
+#include <csapex/utility/assert.h>
+
 using namespace csapex;
 
-Token::Token(const TokenDataConstPtr& token) : data_(token), activity_modifier_(ActivityModifier::NONE), seq_no_(-1)
+Token::Token(const TokenDataConstPtr& token) : data_(token), activity_modifier_(ActivityModifier::NONE), seq_no_(-1), immutable_(false)
+{
+}
+
+Token::Token(const Token& other) : data_(other.data_), activity_modifier_(other.activity_modifier_), seq_no_(other.seq_no_), immutable_(false)
 {
 }
 
-Token::Token() : activity_modifier_(ActivityModifier::NONE), seq_no_(-1)
+Token::Token() : activity_modifier_(ActivityModifier::NONE), seq_no_(-1), immutable_(false)
 {
 }
 
 void Token::setActivityModifier(ActivityModifier active)
 {
+    apex_assert_hard(!immutable_);
     activity_modifier_ = active;
 }
 
@@ -38,6 +46,7 @@ int Token::getSequenceNumber() const
 
 void Token::setSequenceNumber(int seq_no) const
 {
+    apex_assert_hard(!immutable_);
     seq_no_ = seq_no;
 }
 
@@ -48,7 +57,24 @@ void Token::cloneData(const Token& other)
     seq_no_ = other.seq_no_;
 }
 
+Token::Ptr Token::shallowClone() const
+{
+    return std::make_shared<Token>(*this);
+}
+
+bool Token::isImmutable() const
+{
+    return immutable_;
+}
+
 Token::Ptr Token::makeEmpty()
 {
     return Ptr{ new Token };
 }
+
+Token::Ptr Token::makeImmutable(const TokenDataConstPtr& token)
+{
+    Ptr res{ new Token(token) };
+    res->immutable_ = true;
+    return res;
+}
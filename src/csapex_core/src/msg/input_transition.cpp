@@ -10,16 +10,18 @@
 #include <csapex/utility/debug.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
 using namespace csapex;
 
-InputTransition::InputTransition(delegate::Delegate0<> activation_fn) : Transition(activation_fn), forwarded_(false), processed_(false)
+InputTransition::InputTransition(delegate::Delegate0<> activation_fn)
+  : Transition(activation_fn), forwarded_(false), processed_(false), realigning_(false), realign_pending_(false), dropped_tokens_seen_(0)
 {
 }
 
-InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false)
+InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false), realigning_(false), realign_pending_(false), dropped_tokens_seen_(0)
 {
 }
 
@@ -55,7 +57,11 @@ void InputTransition::addInput(InputPtr input)
     inputs_[input->getUUID()] = input;
 
     // connect signals
-    auto cm = input->message_available.connect([this](Connection*) { checkIfEnabled(); });
+    auto cm = input->message_available.connect([this](Connection*) {
+        if (realignSequenceNumbers()) {
+            checkIfEnabled();
+        }
+    });
     input_signal_connections_[input].push_back(cm);
 
     auto ca = input->connection_added.connect([this](ConnectionPtr connection) { addConnection(connection); });
@@ -96,6 +102,8 @@ void InputTransition::reset()
 
     forwarded_ = false;
     processed_ = false;
+    realign_pending_ = false;
+    dropped_tokens_seen_ = 0;
 
     Transition::reset();
 }
@@ -111,7 +119,7 @@ void InputTransition::connectionAdded(Connection* connection)
     bool needs_message = has_read_or_unread && connection->getState() == Connection::State::NOT_INITIALIZED;
 
     if (needs_message) {
-        connection->setToken(connection_types::makeEmptyToken<connection_types::NoMessage>());
+        connection->setToken(connection_types::getSharedEmptyToken<connection_types::NoMessage>());
         if (!unread) {
             connection->setState(Connection::State::READ);
         }
@@ -194,6 +202,61 @@ int InputTransition::findHighestDeviantSequenceNumber() const
     }
 }
 
+bool InputTransition::realignSequenceNumbers()
+{
+    bool expected = false;
+    if (!realigning_.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+    std::vector<ConnectionPtr> behind;
+    do {
+        behind.clear();
+        {
+            std::unique_lock<std::recursive_mutex> lock(sync);
+
+            std::size_t dropped = 0;
+            for (const ConnectionPtr& connection : connections_) {
+                dropped += connection->countDroppedTokens();
+            }
+            if (dropped != dropped_tokens_seen_) {
+                dropped_tokens_seen_ = dropped;
+                realign_pending_ = true;
+            }
+
+            // tokens can only be skipped before they are forwarded and once every input holds one
+            if (realign_pending_ && !forwarded_ && areAllConnections(Connection::State::UNREAD)) {
+                int newest = -1;
+                for (const ConnectionPtr& connection : connections_) {
+                    if (connection->isEnabled()) {
+                        newest = std::max(newest, connection->getToken()->getSequenceNumber());
+                    }
+                }
+                for (const ConnectionPtr& connection : connections_) {
+                    if (connection->isEnabled()) {
+                        int seq = connection->getToken()->getSequenceNumber();
+                        if (seq >= 0 && seq < newest) {
+                            behind.push_back(connection);
+                        }
+                    }
+                }
+                if (behind.empty()) {
+                    realign_pending_ = false;
+                }
+            }
+        }
+
+        // skipped tokens are handled as read and processed, so the connections move on to their next queued token
+        for (const ConnectionPtr& connection : behind) {
+            connection->setState(Connection::State::READ);
+            connection->setTokenProcessed();
+        }
+    } while (!behind.empty());
+
+    realigning_ = false;
+    return true;
+}
+
 void InputTransition::notifyMessageRead()
 {
     if (!forwarded_) {
@@ -268,7 +331,7 @@ void InputTransition::forwardMessages()
                 apex_assert_hard(token != nullptr);
                 input->setToken(token);
             } else {
-                input->setToken(connection_types::makeEmptyToken<connection_types::NoMessage>());
+                input->setToken(connection_types::getSharedEmptyToken<connection_types::NoMessage>());
             }
         }
 
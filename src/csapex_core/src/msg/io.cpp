@@ -95,9 +95,19 @@ MessageAllocator& csapex::msg::getMessageAllocator(Output* output)
     return *output;
 }
 
+void csapex::msg::setMessagePooling(Output* output, bool pooling, std::size_t capacity)
+{
+    output->setPooling(pooling, capacity);
+}
+
+MessagePool::Statistics csapex::msg::getMessagePoolStatistics(Output* output)
+{
+    return output->getPoolStatistics();
+}
+
 void csapex::msg::publish(Output* output, TokenDataConstPtr message)
 {
-    output->addMessage(std::make_shared<Token>(message));
+    output->addMessage(output->allocateToken(message));
 }
 
 void csapex::msg::trigger(Event* event)
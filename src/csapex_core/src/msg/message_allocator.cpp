@@ -1,6 +1,9 @@
 /// HEADER
 #include <csapex/msg/message_allocator.h>
 
+/// PROJECT
+#include <csapex/model/token.h>
+
 using namespace csapex;
 
 MessageAllocator::MessageAllocator() : allocator_(nullptr)
@@ -11,3 +14,36 @@ MessageAllocator::~MessageAllocator()
 {
     delete allocator_;
 }
+
+TokenPtr MessageAllocator::allocateToken(const TokenDataConstPtr& data)
+{
+    if (pool_) {
+        return pool_->allocate<Token>(data);
+    } else {
+        return std::make_shared<Token>(data);
+    }
+}
+
+void MessageAllocator::setPooling(bool pooling, std::size_t capacity)
+{
+    if (!pooling) {
+        // messages that are still in flight keep the old pool alive until they are released
+        pool_.reset();
+    } else if (!pool_ || pool_->getCapacity() != capacity) {
+        pool_ = MessagePool::make(capacity);
+    }
+}
+
+bool MessageAllocator::isPooling() const
+{
+    return pool_ != nullptr;
+}
+
+MessagePool::Statistics MessageAllocator::getPoolStatistics() const
+{
+    if (pool_) {
+        return pool_->getStatistics();
+    } else {
+        return MessagePool::Statistics{ 0, 0, 0, 0 };
+    }
+}
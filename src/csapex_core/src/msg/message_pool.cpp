@@ -0,0 +1,123 @@
+/// HEADER
+#include <csapex/msg/message_pool.h>
+
+using namespace csapex;
+
+constexpr std::size_t MessagePool::DEFAULT_CAPACITY;
+
+std::shared_ptr<MessagePool> MessagePool::make(std::size_t capacity)
+{
+    return std::shared_ptr<MessagePool>(new MessagePool(capacity));
+}
+
+MessagePool::MessagePool(std::size_t capacity) : capacity_(capacity), hits_(0), misses_(0), recycled_(0), dropped_(0)
+{
+}
+
+MessagePool::~MessagePool()
+{
+    clear();
+}
+
+std::size_t MessagePool::getCapacity() const
+{
+    return capacity_;
+}
+
+MessagePool::Statistics MessagePool::getStatistics() const
+{
+    Statistics stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.recycled = recycled_;
+    stats.dropped = dropped_;
+    return stats;
+}
+
+void MessagePool::clear()
+{
+    std::unordered_map<std::type_index, FreeList> entries;
+    std::unordered_map<std::size_t, std::vector<void*>> blocks;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entries.swap(entries_);
+        blocks.swap(blocks_);
+    }
+
+    // destructors of recycled messages might release other pooled messages, so they run without the lock
+    for (auto& pair : entries) {
+        FreeList& list = pair.second;
+        for (void* entry : list.entries) {
+            list.destroy(entry);
+        }
+    }
+    for (auto& pair : blocks) {
+        for (void* block : pair.second) {
+            releaseStorage(block);
+        }
+    }
+}
+
+void MessagePool::releaseStorage(void* ptr)
+{
+    ::operator delete(ptr);
+}
+
+void* MessagePool::take(const std::type_index& type)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = entries_.find(type);
+        if (pos != entries_.end() && !pos->second.entries.empty()) {
+            void* entry = pos->second.entries.back();
+            pos->second.entries.pop_back();
+            ++hits_;
+            return entry;
+        }
+    }
+    ++misses_;
+    return nullptr;
+}
+
+bool MessagePool::give(const std::type_index& type, void* entry, Destructor destroy)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        FreeList& list = entries_[type];
+        if (list.entries.size() < capacity_) {
+            list.destroy = destroy;
+            list.entries.push_back(entry);
+            ++recycled_;
+            return true;
+        }
+    }
+    ++dropped_;
+    return false;
+}
+
+void* MessagePool::takeBlock(std::size_t size)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = blocks_.find(size);
+        if (pos != blocks_.end() && !pos->second.empty()) {
+            void* block = pos->second.back();
+            pos->second.pop_back();
+            return block;
+        }
+    }
+    return ::operator new(size);
+}
+
+void MessagePool::giveBlock(void* block, std::size_t size)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::vector<void*>& list = blocks_[size];
+        if (list.size() < capacity_) {
+            list.push_back(block);
+            return;
+        }
+    }
+    releaseStorage(block);
+}
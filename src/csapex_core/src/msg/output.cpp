@@ -60,7 +60,7 @@ void Output::notifyMessageProcessed()
 void Output::notifyMessageProcessed(Connection* connection)
 {
     for (auto connection : connections_) {
-        if (connection->getState() != Connection::State::DONE) {
+        if (!connection->canReceiveToken()) {
             return;
         }
     }
@@ -130,6 +130,7 @@ void Output::disable()
 
     if (isProcessing()) {
         for (auto connection : connections_) {
+            connection->clearQueue();
             if (connection->getState() == Connection::State::UNREAD) {
                 connection->readToken();
             }
@@ -148,7 +149,7 @@ bool Output::isConnected() const
 bool Output::canReceiveToken() const
 {
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->getState() != Connection::State::NOT_INITIALIZED) {
+        if (!connection->canReceiveToken()) {
             return false;
         }
     }
@@ -182,7 +183,8 @@ void Output::publish()
         }
     }
 
-    if (!sent) {
+    if (!sent || canReceiveToken()) {
+        // either nobody is listening or all connections have buffered the token
         notifyMessageProcessed();
     }
 }
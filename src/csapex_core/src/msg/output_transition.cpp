@@ -145,14 +145,14 @@ bool OutputTransition::canStartSendingMessages() const
             }
         }
     }
-    return areAllConnections(Connection::State::DONE, Connection::State::NOT_INITIALIZED);
+    return canConnectionsReceiveToken();
 }
 
 bool OutputTransition::sendMessages(bool is_active)
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
 
-    apex_assert_hard(areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(canConnectionsReceiveToken());
 
     bool has_sent_activator_message = false;
 
@@ -188,13 +188,12 @@ bool OutputTransition::sendMessages(bool is_active)
 void OutputTransition::tokenProcessed()
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
-    if (!areAllConnections(Connection::State::DONE)) {
+    if (!canStartSendingMessages()) {
+        // with buffered connections, the first outputs can be done before the last ones are published
         APEX_DEBUG_CERR << "cannot publish next, not all connections are done" << std::endl;
         return;
     }
 
-    apex_assert_hard(areAllConnections(Connection::State::DONE));
-
     APEX_DEBUG_CERR << "all outputs are done" << std::endl;
 
     lock.unlock();
@@ -231,7 +230,7 @@ void OutputTransition::fillConnections()
         return;
     }
 
-    apex_assert_hard(areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(canConnectionsReceiveToken());
 
     for (const auto& pair : outputs_) {
         OutputPtr out = pair.second;
@@ -30,7 +30,8 @@ void StaticOutput::addMessage(TokenPtr message)
 
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
     apex_assert_hard(message != nullptr);
-    message_to_send_ = message;
+    // the metadata of the token is changed on commit, so shared tokens have to be copied
+    message_to_send_ = message->isImmutable() ? message->shallowClone() : message;
 }
 
 bool StaticOutput::hasMessage()
@@ -59,7 +60,7 @@ TokenPtr StaticOutput::getToken() const
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
 
     if (!committed_message_) {
-        return connection_types::makeEmptyToken<connection_types::NoMessage>();
+        return connection_types::getSharedEmptyToken<connection_types::NoMessage>();
     } else {
         return committed_message_;
     }
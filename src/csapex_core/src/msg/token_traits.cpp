@@ -11,3 +11,8 @@ TokenPtr csapex::connection_types::makeToken(const TokenDataConstPtr& data)
 {
     return std::make_shared<Token>(data);
 }
+
+TokenPtr csapex::connection_types::makeImmutableToken(const TokenDataConstPtr& data)
+{
+    return Token::makeImmutable(data);
+}
@@ -109,6 +109,17 @@ bool Transition::isOneConnection(Connection::State state) const
     return false;
 }
 
+bool Transition::canConnectionsReceiveToken() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    for (const ConnectionPtr& connection : connections_) {
+        if (connection->isEnabled() && !connection->canReceiveToken()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Transition::hasConnection() const
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
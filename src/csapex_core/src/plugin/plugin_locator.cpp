@@ -5,6 +5,7 @@
 #include <csapex/model/node.h>
 #include <csapex/param/string_list_parameter.h>
 #include <csapex/param/parameter_factory.h>
+#include <csapex/plugin/plugin_manifest_cache.h>
 
 /// SYSTEM
 #include <istream>
@@ -125,3 +126,12 @@ std::vector<std::string> PluginLocator::getPluginPaths(const std::string& type)
         return {};
     }
 }
+
+PluginManifestCachePtr PluginLocator::getManifestCache()
+{
+    if (!manifest_cache_) {
+        manifest_cache_ = std::make_shared<PluginManifestCache>(settings_.get<std::string>("plugin_cache", Settings::plugin_cache_file));
+        manifest_cache_->load();
+    }
+    return manifest_cache_;
+}
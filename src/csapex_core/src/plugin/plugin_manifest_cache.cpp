@@ -0,0 +1,230 @@
+/// HEADER
+#include <csapex/plugin/plugin_manifest_cache.h>
+
+/// SYSTEM
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iostream>
+#include <yaml-cpp/yaml.h>
+
+using namespace csapex;
+
+namespace bf = boost::filesystem;
+
+const int PluginManifestCache::VERSION = 1;
+
+namespace
+{
+void writeStamp(YAML::Node& yaml, const PluginManifestCache::Stamp& stamp)
+{
+    yaml["modified"] = static_cast<int64_t>(stamp.modification);
+    yaml["size"] = static_cast<uint64_t>(stamp.size);
+}
+
+PluginManifestCache::Stamp readStamp(const YAML::Node& yaml)
+{
+    PluginManifestCache::Stamp stamp;
+    stamp.modification = static_cast<std::time_t>(yaml["modified"].as<int64_t>());
+    stamp.size = static_cast<std::uintmax_t>(yaml["size"].as<uint64_t>());
+    return stamp;
+}
+}  // namespace
+
+PluginManifestCache::Stamp::Stamp() : modification(0), size(0)
+{
+}
+
+bool PluginManifestCache::Stamp::operator==(const Stamp& other) const
+{
+    return modification == other.modification && size == other.size;
+}
+
+bool PluginManifestCache::Stamp::operator!=(const Stamp& other) const
+{
+    return !(*this == other);
+}
+
+PluginManifestCache::PluginManifestCache(const std::string& path) : path_(path), dirty_(false)
+{
+}
+
+PluginManifestCache::Stamp PluginManifestCache::stamp(const std::string& file)
+{
+    Stamp stamp;
+    boost::system::error_code ec;
+    if (!file.empty() && bf::is_regular_file(file, ec)) {
+        stamp.modification = bf::last_write_time(file, ec);
+        stamp.size = bf::file_size(file, ec);
+    }
+    return stamp;
+}
+
+std::string PluginManifestCache::getPath() const
+{
+    return path_;
+}
+
+void PluginManifestCache::load()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    libraries_.clear();
+    snippets_.clear();
+    dirty_ = false;
+
+    if (!bf::exists(path_)) {
+        return;
+    }
+
+    try {
+        YAML::Node doc = YAML::LoadFile(path_);
+        if (!doc["version"].IsDefined() || doc["version"].as<int>() != VERSION) {
+            return;
+        }
+
+        for (const auto& library_yaml : doc["libraries"]) {
+            Library& library = libraries_[library_yaml.first.as<std::string>()];
+            library.stamp = readStamp(library_yaml.second);
+
+            for (const auto& node_yaml : library_yaml.second["nodes"]) {
+                NodeEntry& entry = library.nodes[node_yaml.first.as<std::string>()];
+                entry.properties = node_yaml.second["properties"].as<std::vector<std::string>>();
+            }
+        }
+
+        for (const auto& snippet_yaml : doc["snippets"]) {
+            Snippet& snippet = snippets_[snippet_yaml.first.as<std::string>()];
+            snippet.stamp = readStamp(snippet_yaml.second);
+            snippet.entry.name = snippet_yaml.second["name"].as<std::string>();
+            snippet.entry.description = snippet_yaml.second["description"].as<std::string>();
+            snippet.entry.tags = snippet_yaml.second["tags"].as<std::vector<std::string>>();
+        }
+
+    } catch (const std::exception& e) {
+        // the cache is rebuilt from the libraries themselves
+        std::cerr << "ignoring invalid plugin cache " << path_ << ": " << e.what() << std::endl;
+        libraries_.clear();
+        snippets_.clear();
+        dirty_ = true;
+    }
+}
+
+void PluginManifestCache::save()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!dirty_) {
+        return;
+    }
+
+    YAML::Node doc(YAML::NodeType::Map);
+    doc["version"] = VERSION;
+
+    YAML::Node libraries(YAML::NodeType::Map);
+    for (const auto& library : libraries_) {
+        YAML::Node library_yaml(YAML::NodeType::Map);
+        writeStamp(library_yaml, library.second.stamp);
+
+        YAML::Node nodes(YAML::NodeType::Map);
+        for (const auto& node : library.second.nodes) {
+            YAML::Node node_yaml(YAML::NodeType::Map);
+            node_yaml["properties"] = node.second.properties;
+
+            nodes[node.first] = node_yaml;
+        }
+        library_yaml["nodes"] = nodes;
+
+        libraries[library.first] = library_yaml;
+    }
+    doc["libraries"] = libraries;
+
+    YAML::Node snippets(YAML::NodeType::Map);
+    for (const auto& snippet : snippets_) {
+        YAML::Node snippet_yaml(YAML::NodeType::Map);
+        writeStamp(snippet_yaml, snippet.second.stamp);
+        snippet_yaml["name"] = snippet.second.entry.name;
+        snippet_yaml["description"] = snippet.second.entry.description;
+        snippet_yaml["tags"] = snippet.second.entry.tags;
+
+        snippets[snippet.first] = snippet_yaml;
+    }
+    doc["snippets"] = snippets;
+
+    boost::system::error_code ec;
+    bf::path dir = bf::path(path_).parent_path();
+    if (!dir.empty()) {
+        bf::create_directories(dir, ec);
+    }
+
+    std::ofstream ofs(path_.c_str());
+    if (!ofs) {
+        std::cerr << "cannot write the plugin cache " << path_ << std::endl;
+        return;
+    }
+    ofs << doc;
+
+    dirty_ = false;
+}
+
+bool PluginManifestCache::isDirty() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return dirty_;
+}
+
+bool PluginManifestCache::findNode(const std::string& library_file, const Stamp& stamp, const std::string& type, NodeEntry& entry) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto library = libraries_.find(library_file);
+    if (library == libraries_.end() || library->second.stamp != stamp) {
+        return false;
+    }
+
+    auto node = library->second.nodes.find(type);
+    if (node == library->second.nodes.end()) {
+        return false;
+    }
+
+    entry = node->second;
+    return true;
+}
+
+void PluginManifestCache::storeNode(const std::string& library_file, const Stamp& stamp, const std::string& type, const NodeEntry& entry)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    Library& library = libraries_[library_file];
+    if (library.stamp != stamp) {
+        // the library has been rebuilt, none of the other entries can be trusted anymore
+        library.nodes.clear();
+        library.stamp = stamp;
+    }
+    library.nodes[type] = entry;
+
+    dirty_ = true;
+}
+
+bool PluginManifestCache::findSnippet(const std::string& file, const Stamp& stamp, SnippetEntry& entry) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto snippet = snippets_.find(file);
+    if (snippet == snippets_.end() || snippet->second.stamp != stamp) {
+        return false;
+    }
+
+    entry = snippet->second.entry;
+    return true;
+}
+
+void PluginManifestCache::storeSnippet(const std::string& file, const Stamp& stamp, const SnippetEntry& entry)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    Snippet& snippet = snippets_[file];
+    snippet.stamp = stamp;
+    snippet.entry = entry;
+
+    dirty_ = true;
+}
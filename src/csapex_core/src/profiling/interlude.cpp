@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include <csapex/profiling/timer.h>
+#include <csapex/profiling/trace_recorder.h>
 
 using namespace csapex;
 
@@ -14,30 +15,25 @@ Interlude::Interlude(const std::shared_ptr<Timer>& parent, const std::string& na
 {
 }
 
-Interlude::Interlude(Timer* parent, const std::string& name) : parent_(parent)
+Interlude::Interlude(Timer* parent, const std::string& name) : parent_(parent && parent->isEnabled() ? parent : nullptr), start_(0), name_(0), cycle_(0)
 {
-    // start new interval in timer
-    if (parent_->active.empty()) {
-        parent_->active.emplace_back(std::make_shared<Interval>(name));
+    if (parent_) {
+        name_ = TraceRecorder::intern(name);
+        cycle_ = parent_->getCycle();
+        start_ = TraceRecorder::now();
     }
-
-    if (parent_->active.back()->sub.find(name) == parent_->active.back()->sub.end()) {
-        interval_ = std::make_shared<Interval>(name);
-        parent_->active.back()->sub[name] = interval_;
-
-    } else {
-        interval_ = parent_->active.back()->sub[name];
-    }
-    interval_->start();
-    parent_->active.push_back(interval_);
 }
 
 Interlude::~Interlude()
 {
-    // stop interval
-    //    Interval::Ptr i = parent_->active.back();
-    if (!interval_->isStopped()) {
-        interval_->stop();
-        parent_->active.pop_back();
+    if (parent_) {
+        TraceEvent event;
+        event.start = start_;
+        event.duration = TraceRecorder::now() - start_;
+        event.name = name_;
+        event.scope = parent_->getScope();
+        event.cycle = cycle_;
+        event.padding = 0;
+        TraceRecorder::instance().record(event);
     }
 }
@@ -5,6 +5,9 @@
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/serialization/io/csapex_io.h>
 
+/// SYSTEM
+#include <algorithm>
+
 using namespace csapex;
 
 Interval::Interval(const std::string& name) : name_(name), length_micro_seconds_(0), active_(false), stopped_(false)
@@ -39,6 +42,29 @@ void Interval::entries(std::vector<std::pair<std::string, double> >& out) const
     }
 }
 
+Interval::Ptr Interval::addSpan(const std::string& name, const std::chrono::high_resolution_clock::time_point& start, const std::chrono::high_resolution_clock::time_point& end)
+{
+    Interval::Ptr& span = sub[name];
+    if (!span) {
+        span.reset(new Interval(name));
+        span->start_ = start;
+    }
+    span->start_ = std::min(span->start_, start);
+    span->end_ = std::max(span->end_, end);
+    span->length_micro_seconds_ += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    span->stopped_ = true;
+    return span;
+}
+
+Interval::Ptr Interval::deepCopy() const
+{
+    Interval::Ptr copy(new Interval(*this));
+    for (auto& pair : copy->sub) {
+        pair.second = pair.second->deepCopy();
+    }
+    return copy;
+}
+
 double Interval::lengthMs() const
 {
     return length_micro_seconds_ * 1e-3;
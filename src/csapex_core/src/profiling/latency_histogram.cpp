@@ -0,0 +1,155 @@
+/// HEADER
+#include <csapex/profiling/latency_histogram.h>
+
+/// PROJECT
+#include <csapex/serialization/io/std_io.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <cmath>
+
+using namespace csapex;
+
+constexpr unsigned LatencyHistogram::SUB_BUCKET_BITS;
+
+namespace
+{
+constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : count_(0), max_(0), sum_(0.0)
+{
+}
+
+std::size_t LatencyHistogram::getBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+
+    // the SUB_BUCKET_BITS most significant bits of the value select the bucket
+    unsigned msb = 63 - __builtin_clzll(value);
+    unsigned shift = msb - (SUB_BUCKET_BITS - 1);
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + ((value >> shift) - SUB_BUCKET_HALF);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(std::size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    std::size_t offset = index - SUB_BUCKET_COUNT;
+    unsigned shift = offset / SUB_BUCKET_HALF + 1;
+    uint64_t mantissa = offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micro_seconds)
+{
+    std::size_t index = getBucketIndex(micro_seconds);
+    if (index >= buckets_.size()) {
+        buckets_.resize(index + 1, 0);
+    }
+    ++buckets_[index];
+
+    ++count_;
+    max_ = std::max(max_, micro_seconds);
+    sum_ += micro_seconds;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.buckets_.size() > buckets_.size()) {
+        buckets_.resize(other.buckets_.size(), 0);
+    }
+    for (std::size_t i = 0; i < other.buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+
+    count_ += other.count_;
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+void LatencyHistogram::reset()
+{
+    buckets_.clear();
+    count_ = 0;
+    max_ = 0;
+    sum_ = 0.0;
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return count_;
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return max_;
+}
+
+double LatencyHistogram::mean() const
+{
+    return count_ > 0 ? sum_ / count_ : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+
+    double clamped = std::min(100.0, std::max(0.0, percentile));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count_)));
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(getBucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << count_;
+    data << max_;
+    data << sum_;
+
+    // most buckets are empty, only the occupied ones are transmitted
+    uint32_t occupied = std::count_if(buckets_.begin(), buckets_.end(), [](uint64_t c) { return c > 0; });
+    data << occupied;
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+        if (buckets_[i] > 0) {
+            data << static_cast<uint32_t>(i);
+            data << buckets_[i];
+        }
+    }
+}
+
+void LatencyHistogram::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    reset();
+
+    data >> count_;
+    data >> max_;
+    data >> sum_;
+
+    uint32_t occupied;
+    data >> occupied;
+    for (uint32_t n = 0; n < occupied; ++n) {
+        uint32_t index;
+        uint64_t count;
+        data >> index;
+        data >> count;
+        if (index >= buckets_.size()) {
+            buckets_.resize(index + 1, 0);
+        }
+        buckets_[index] = count;
+    }
+}
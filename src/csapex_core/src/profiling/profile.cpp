@@ -1,13 +1,17 @@
 /// HEADER
 #include <csapex/profiling/profile.h>
 
+/// SYSTEM
+#include <cmath>
+
 using namespace csapex;
 
 Profile::Profile(const std::string& key, int timer_history_length, bool enabled)
-  : timer(std::make_shared<Timer>(key, enabled)), timer_history_length(timer_history_length), timer_history_pos_(0), count_(0)
+  : mutex_(new std::mutex), timer(std::make_shared<Timer>(key, enabled)), timer_history_length(timer_history_length), timer_history_pos_(0), count_(0)
 {
     apex_assert_hard(timer_history_length > 0);
     timer_history_.resize(timer_history_length);
+    timer_history_cycles_.resize(timer_history_length, 0);
     apex_assert_hard((int)timer_history_.size() == timer_history_length);
     apex_assert_hard((int)timer_history_.capacity() == timer_history_length);
 }
@@ -16,12 +20,32 @@ void Profile::reset()
 {
     timer->restart();
 
+    std::unique_lock<std::mutex> lock(*mutex_);
+    resetWindowUnlocked();
+    counters_.clear();
+    pending_steps_.clear();
+    count_ = 0;
+    timer_history_pos_ = 0;
+}
+
+void Profile::resetWindow()
+{
+    // steps that are still buffered belong to the old window
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    resetWindowUnlocked();
+}
+
+void Profile::resetWindowUnlocked()
+{
     for (auto& pair : steps_acc_) {
         accumulator& acc = pair.second;
         acc = accumulator();
     }
-    count_ = 0;
-    timer_history_pos_ = 0;
+    for (auto& pair : steps_hist_) {
+        pair.second.reset();
+    }
 }
 
 Timer::Ptr Profile::getTimer() const
@@ -43,36 +67,158 @@ int Profile::getCurrentIndex() const
     return timer_history_pos_;
 }
 
-const std::vector<Interval::Ptr>& Profile::getIntervals() const
+std::vector<Interval::Ptr> Profile::getIntervals() const
 {
-    return timer_history_;
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    std::vector<Interval::Ptr> result;
+    result.reserve(timer_history_.size());
+    for (const Interval::Ptr& interval : timer_history_) {
+        result.push_back(interval ? interval->deepCopy() : nullptr);
+    }
+    return result;
 }
 
 Interval::Ptr Profile::getInterval(const std::size_t index) const
 {
-    return timer_history_.at(index);
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    const Interval::Ptr& interval = timer_history_.at(index);
+    return interval ? interval->deepCopy() : nullptr;
 }
 
 ProfilerStats Profile::getStats(const std::string& name) const
 {
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
     ProfilerStats res;
     res.mean = boost::accumulators::mean(steps_acc_.at(name));
     res.stddev = std::sqrt(boost::accumulators::variance(steps_acc_.at(name)));
+
+    const LatencyHistogram& hist = steps_hist_.at(name);
+    res.count = hist.count();
+    res.p50 = hist.percentile(50.0) * 1e-3;
+    res.p99 = hist.percentile(99.0) * 1e-3;
+    res.p999 = hist.percentile(99.9) * 1e-3;
+    res.max = hist.max() * 1e-3;
     return res;
 }
 
+const LatencyHistogram& Profile::getHistogram(const std::string& name) const
+{
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    return steps_hist_.at(name);
+}
+
+std::vector<std::string> Profile::getStepNames() const
+{
+    TraceRecorder::instance().flush();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    std::vector<std::string> names;
+    for (const auto& pair : steps_hist_) {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
+long Profile::getCounter(const std::string& name) const
+{
+    std::unique_lock<std::mutex> lock(*mutex_);
+    auto pos = counters_.find(name);
+    return pos != counters_.end() ? pos->second : 0;
+}
+
+std::vector<std::string> Profile::getCounterNames() const
+{
+    std::unique_lock<std::mutex> lock(*mutex_);
+    std::vector<std::string> names;
+    for (const auto& pair : counters_) {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
+void Profile::increment(const std::string& name, long amount)
+{
+    std::unique_lock<std::mutex> lock(*mutex_);
+    counters_[name] += amount;
+}
+
+void Profile::addSample(const std::string& name, uint64_t nano_seconds)
+{
+    std::unique_lock<std::mutex> lock(*mutex_);
+    record(name, nano_seconds);
+}
+
 void Profile::addInterval(Interval::Ptr interval)
 {
-    timer_history_[timer_history_pos_] = interval;
+    // the published interval is shared with other observers, steps are only ever attached to this copy
+    Interval::Ptr own = interval->deepCopy();
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    uint32_t cycle = timer->getCycle();
+    timer_history_[timer_history_pos_] = own;
+    timer_history_cycles_[timer_history_pos_] = cycle;
 
     if (++timer_history_pos_ >= (int)timer_history_.size()) {
         timer_history_pos_ = 0;
     }
 
-    std::vector<std::pair<std::string, double> > entries;
-    interval->entries(entries);
-    for (const auto& it : entries) {
-        steps_acc_[it.first](it.second);
-    }
+    recordInterval(*interval);
     ++count_;
+
+    // steps that were flushed while their cycle was still running, they are recorded already
+    for (const TraceEvent& event : pending_steps_) {
+        if (event.cycle == cycle) {
+            addSpan(*own, TraceRecorder::nameOf(event.name), event);
+        }
+    }
+    pending_steps_.clear();
+}
+
+void Profile::recordInterval(const Interval& interval)
+{
+    // steps arrive separately via addStep, only intervals received from elsewhere carry sub intervals
+    record(interval.name(), static_cast<uint64_t>(std::llround(interval.lengthMs() * 1e6)));
+    for (const auto& pair : interval.sub) {
+        recordInterval(*pair.second);
+    }
+}
+
+void Profile::addStep(const TraceEvent& event)
+{
+    std::string name = TraceRecorder::nameOf(event.name);
+
+    std::unique_lock<std::mutex> lock(*mutex_);
+    record(name, event.duration);
+
+    for (std::size_t i = 0; i < timer_history_.size(); ++i) {
+        if (timer_history_cycles_[i] == event.cycle && timer_history_[i]) {
+            addSpan(*timer_history_[i], name, event);
+            return;
+        }
+    }
+
+    // the interval of this cycle is added once the timer finishes
+    if (pending_steps_.size() < TraceBuffer::CAPACITY) {
+        pending_steps_.push_back(event);
+    }
+}
+
+void Profile::addSpan(Interval& interval, const std::string& name, const TraceEvent& event)
+{
+    interval.addSpan(name, TraceRecorder::toWallTime(event.start), TraceRecorder::toWallTime(event.start + event.duration));
+}
+
+void Profile::record(const std::string& name, uint64_t nano_seconds)
+{
+    uint64_t micro_seconds = (nano_seconds + 500) / 1000;
+    steps_acc_[name](micro_seconds * 1e-3);
+    steps_hist_[name].record(micro_seconds);
 }
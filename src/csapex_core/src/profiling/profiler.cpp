@@ -9,6 +9,13 @@ Profiler::Profiler(bool enabled, int history) : enabled_(false), history_length_
     setEnabled(enabled);
 }
 
+Profiler::~Profiler()
+{
+    for (auto& pair : profiles_) {
+        TraceRecorder::instance().unsubscribe(pair.second.timer->getScope());
+    }
+}
+
 Timer::Ptr Profiler::getTimer(const std::string& key)
 {
     const Profile& prof = getProfile(key);
@@ -25,6 +32,7 @@ const Profile& Profiler::getProfile(const std::string& key)
         profile.timer->finished.connect([this](Interval::Ptr) { updated(); });
 
         observe(profile.timer->finished, [this, &profile](Interval::Ptr interval) { profile.addInterval(interval); });
+        TraceRecorder::instance().subscribe(profile.timer->getScope(), [&profile](const TraceEvent& event) { profile.addStep(event); });
 
         return profile;
     }
@@ -32,6 +40,18 @@ const Profile& Profiler::getProfile(const std::string& key)
     return pos->second;
 }
 
+void Profiler::increment(const std::string& key, const std::string& counter, long amount)
+{
+    getProfile(key);
+    profiles_.at(key).increment(counter, amount);
+}
+
+void Profiler::record(const std::string& key, const std::string& step, uint64_t nano_seconds)
+{
+    getProfile(key);
+    profiles_.at(key).addSample(step, nano_seconds);
+}
+
 void Profiler::setEnabled(bool enabled)
 {
     if (enabled == enabled_) {
@@ -60,3 +80,13 @@ void Profiler::reset()
         profile.reset();
     }
 }
+
+void Profiler::resetWindow()
+{
+    for (auto& pair : profiles_) {
+        Profile& profile = pair.second;
+        profile.resetWindow();
+    }
+
+    window_reset();
+}
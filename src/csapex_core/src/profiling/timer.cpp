@@ -1,12 +1,16 @@
 /// HEADER
 #include <csapex/profiling/timer.h>
 
+/// COMPONENT
+#include <csapex/profiling/trace_recorder.h>
+
 /// SYSTEM
 #include <assert.h>
 
 using namespace csapex;
 
-Timer::Timer(const std::string& name, bool enabled) : timer_name_(name), root(new Interval(name)), enabled_(enabled), dirty_(false), finished_(true)
+Timer::Timer(const std::string& name, bool enabled)
+  : timer_name_(name), root(new Interval(name)), enabled_(enabled), dirty_(false), finished_(true), scope_(TraceRecorder::instance().makeScope()), cycle_(0)
 {
     restart();
 }
@@ -49,6 +53,7 @@ void Timer::restart()
 
     root.reset(new Interval(timer_name_));
     active.push_back(root);
+    ++cycle_;
 
     finished_ = false;
 }
@@ -65,6 +70,7 @@ void Timer::finish()
         dirty_ = false;
     } else {
         if (enabled_) {
+            // steps stay buffered, they are attached to the profile's copy of the interval once it is read
             finished(root);
         }
     }
@@ -86,3 +92,13 @@ long Timer::elapsedMs() const
     auto start = root->start_;
     return std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
 }
+
+uint32_t Timer::getScope() const
+{
+    return scope_;
+}
+
+uint32_t Timer::getCycle() const
+{
+    return cycle_;
+}
@@ -0,0 +1,216 @@
+/// HEADER
+#include <csapex/profiling/trace_recorder.h>
+
+/// PROJECT
+#include <csapex/utility/assert.h>
+
+/// SYSTEM
+#include <unordered_map>
+
+using namespace csapex;
+
+constexpr std::size_t TraceBuffer::CAPACITY;
+
+namespace
+{
+static_assert((TraceBuffer::CAPACITY & (TraceBuffer::CAPACITY - 1)) == 0, "capacity has to be a power of two");
+constexpr std::size_t MASK = TraceBuffer::CAPACITY - 1;
+
+struct NameRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string> names;
+};
+
+NameRegistry& getNameRegistry()
+{
+    static NameRegistry registry;
+    return registry;
+}
+}  // namespace
+
+TraceBuffer::TraceBuffer() : head_(0), tail_(0), dropped_(0)
+{
+}
+
+bool TraceBuffer::push(const TraceEvent& event)
+{
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= CAPACITY) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    events_[head & MASK] = event;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t TraceBuffer::consume(const std::function<void(const TraceEvent&)>& callback)
+{
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t head = head_.load(std::memory_order_acquire);
+    for (std::size_t i = tail; i != head; ++i) {
+        callback(events_[i & MASK]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return head - tail;
+}
+
+std::size_t TraceBuffer::size() const
+{
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+std::size_t TraceBuffer::getDropped() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+TraceRecorder& TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : next_scope_(1), dropped_by_exited_threads_(0), steady_origin_(now()), wall_origin_(std::chrono::high_resolution_clock::now())
+{
+}
+
+uint64_t TraceRecorder::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::chrono::high_resolution_clock::time_point TraceRecorder::toWallTime(uint64_t steady_ns)
+{
+    // the offset between the clocks is captured once, so converted spans keep their steady durations
+    const TraceRecorder& self = instance();
+    int64_t offset = static_cast<int64_t>(steady_ns) - static_cast<int64_t>(self.steady_origin_);
+    return self.wall_origin_ + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(offset));
+}
+
+uint32_t TraceRecorder::intern(const std::string& name)
+{
+    thread_local std::unordered_map<std::string, uint32_t> cache;
+    auto pos = cache.find(name);
+    if (pos != cache.end()) {
+        return pos->second;
+    }
+
+    NameRegistry& registry = getNameRegistry();
+    uint32_t id;
+    {
+        std::unique_lock<std::mutex> lock(registry.mutex);
+        auto global = registry.ids.find(name);
+        if (global != registry.ids.end()) {
+            id = global->second;
+        } else {
+            id = registry.names.size();
+            registry.names.push_back(name);
+            registry.ids.emplace(name, id);
+        }
+    }
+    cache.emplace(name, id);
+    return id;
+}
+
+std::string TraceRecorder::nameOf(uint32_t id)
+{
+    NameRegistry& registry = getNameRegistry();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+    apex_assert_hard(id < registry.names.size());
+    return registry.names[id];
+}
+
+uint32_t TraceRecorder::makeScope()
+{
+    return next_scope_++;
+}
+
+TraceBuffer& TraceRecorder::getLocalBuffer()
+{
+    // the registry shares ownership, so events of exited threads can still be flushed
+    thread_local std::shared_ptr<TraceBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<TraceBuffer>();
+        std::unique_lock<std::mutex> lock(buffers_mutex_);
+        buffers_.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void TraceRecorder::record(const TraceEvent& event)
+{
+    TraceBuffer& buffer = getLocalBuffer();
+    if (buffer.size() >= TraceBuffer::CAPACITY / 4 * 3) {
+        // never wait for a running flush, the event is dropped instead if the buffer is full
+        std::unique_lock<std::mutex> consumer_lock(consumer_mutex_, std::try_to_lock);
+        if (consumer_lock.owns_lock()) {
+            flush(consumer_lock);
+        }
+    }
+    buffer.push(event);
+}
+
+void TraceRecorder::subscribe(uint32_t scope, const Subscriber& subscriber)
+{
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    subscribers_[scope] = subscriber;
+}
+
+void TraceRecorder::unsubscribe(uint32_t scope)
+{
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    flush(lock);
+    subscribers_.erase(scope);
+}
+
+void TraceRecorder::flush()
+{
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    flush(lock);
+}
+
+void TraceRecorder::flush(std::unique_lock<std::mutex>& consumer_lock)
+{
+    apex_assert_hard(consumer_lock.owns_lock());
+
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::unique_lock<std::mutex> lock(buffers_mutex_);
+        buffers = buffers_;
+    }
+
+    for (const std::shared_ptr<TraceBuffer>& buffer : buffers) {
+        buffer->consume([this](const TraceEvent& event) {
+            auto pos = subscribers_.find(event.scope);
+            if (pos != subscribers_.end()) {
+                pos->second(event);
+            }
+        });
+    }
+
+    buffers.clear();
+
+    // buffers only referenced by the registry belong to threads that have exited
+    std::unique_lock<std::mutex> lock(buffers_mutex_);
+    for (auto it = buffers_.begin(); it != buffers_.end();) {
+        if (it->use_count() == 1 && (*it)->size() == 0) {
+            dropped_by_exited_threads_ += (*it)->getDropped();
+            it = buffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::size_t TraceRecorder::getDropped() const
+{
+    std::unique_lock<std::mutex> lock(buffers_mutex_);
+    std::size_t dropped = dropped_by_exited_threads_;
+    for (const std::shared_ptr<TraceBuffer>& buffer : buffers_) {
+        dropped += buffer->getDropped();
+    }
+    return dropped;
+}
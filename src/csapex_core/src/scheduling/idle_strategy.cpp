@@ -0,0 +1,32 @@
+/// HEADER
+#include <csapex/scheduling/idle_strategy.h>
+
+/// SYSTEM
+#include <stdexcept>
+
+using namespace csapex;
+
+std::string idle_strategy::name(IdleStrategy strategy)
+{
+    switch (strategy) {
+        case IdleStrategy::BLOCK:
+            return "block";
+        case IdleStrategy::SPIN_THEN_PARK:
+            return "spin_then_park";
+        case IdleStrategy::BUSY_POLL:
+            return "busy_poll";
+    }
+    throw std::logic_error("unknown idle strategy");
+}
+
+IdleStrategy idle_strategy::fromName(const std::string& name)
+{
+    if (name == "block") {
+        return IdleStrategy::BLOCK;
+    } else if (name == "spin_then_park") {
+        return IdleStrategy::SPIN_THEN_PARK;
+    } else if (name == "busy_poll") {
+        return IdleStrategy::BUSY_POLL;
+    }
+    throw std::invalid_argument(std::string("unknown idle strategy: ") + name);
+}
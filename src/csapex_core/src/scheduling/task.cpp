@@ -6,7 +6,8 @@
 
 using namespace csapex;
 
-Task::Task(const std::string& name, std::function<void()> callback, long priority, TaskGenerator* parent) : parent_(parent), name_(name), callback_(callback), priority_(priority), scheduled_(false)
+Task::Task(const std::string& name, std::function<void()> callback, long priority, TaskGenerator* parent)
+  : parent_(parent), name_(name), callback_(callback), priority_(priority), deadline_(std::chrono::steady_clock::time_point::max()), scheduled_(false)
 {
 }
 
@@ -39,6 +40,36 @@ long Task::getPriority() const
     return priority_;
 }
 
+void Task::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    deadline_ = deadline;
+}
+
+void Task::clearDeadline()
+{
+    deadline_ = std::chrono::steady_clock::time_point::max();
+}
+
+bool Task::hasDeadline() const
+{
+    return deadline_ != std::chrono::steady_clock::time_point::max();
+}
+
+std::chrono::steady_clock::time_point Task::getDeadline() const
+{
+    return deadline_;
+}
+
+void Task::setScheduledTime(std::chrono::steady_clock::time_point time)
+{
+    scheduled_time_ = time;
+}
+
+std::chrono::steady_clock::time_point Task::getScheduledTime() const
+{
+    return scheduled_time_;
+}
+
 bool Task::isScheduled() const
 {
     return scheduled_;
@@ -48,3 +79,9 @@ void Task::setScheduled(bool scheduled)
 {
     scheduled_ = scheduled;
 }
+
+bool Task::trySetScheduled()
+{
+    bool expected = false;
+    return scheduled_.compare_exchange_strong(expected, true);
+}
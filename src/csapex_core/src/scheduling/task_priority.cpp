@@ -0,0 +1,51 @@
+/// HEADER
+#include <csapex/scheduling/task_priority.h>
+
+/// PROJECT
+#include <csapex/scheduling/task_queue.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <stdexcept>
+
+using namespace csapex;
+
+std::string task_priority::name(TaskPriorityPolicy policy)
+{
+    switch (policy) {
+        case TaskPriorityPolicy::FIFO:
+            return "fifo";
+        case TaskPriorityPolicy::CRITICAL_PATH:
+            return "critical_path";
+    }
+    throw std::logic_error("unknown task priority policy");
+}
+
+TaskPriorityPolicy task_priority::fromName(const std::string& name)
+{
+    if (name == "fifo") {
+        return TaskPriorityPolicy::FIFO;
+    } else if (name == "critical_path") {
+        return TaskPriorityPolicy::CRITICAL_PATH;
+    }
+    throw std::invalid_argument(std::string("unknown task priority policy: ") + name);
+}
+
+long task_priority::forProcessing(TaskPriorityPolicy policy, int depth)
+{
+    if (policy == TaskPriorityPolicy::FIFO) {
+        return 0;
+    }
+
+    // the lowest level is left to tasks without a priority, the highest one is reserved for control tasks
+    const long deepest = static_cast<long>(TaskQueue::PRIORITY_LEVELS) - 2;
+    return 1 + std::min<long>(std::max(depth, 0), deepest - 1);
+}
+
+long task_priority::forControl(TaskPriorityPolicy policy)
+{
+    if (policy == TaskPriorityPolicy::FIFO) {
+        return 0;
+    }
+    return static_cast<long>(TaskQueue::PRIORITY_LEVELS) - 1;
+}
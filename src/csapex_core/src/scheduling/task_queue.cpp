@@ -0,0 +1,70 @@
+/// HEADER
+#include <csapex/scheduling/task_queue.h>
+
+/// PROJECT
+#include <csapex/scheduling/task.h>
+#include <csapex/utility/assert.h>
+
+using namespace csapex;
+
+constexpr std::size_t TaskQueue::PRIORITY_LEVELS;
+
+TaskQueue::TaskQueue() : size_(0)
+{
+}
+
+std::size_t TaskQueue::getLevel(long priority)
+{
+    // clamping would silently merge different priorities into one level
+    apex_assert_hard_msg(priority >= 0 && priority < static_cast<long>(PRIORITY_LEVELS), "task priority out of range");
+    return static_cast<std::size_t>(priority);
+}
+
+void TaskQueue::push(const TaskPtr& task)
+{
+    // count first, a consumer might see the size before the task becomes visible but never the other way round
+    ++size_;
+    levels_[getLevel(task->getPriority())].push(task);
+}
+
+TaskPtr TaskQueue::pop()
+{
+    if (size_ == 0) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(consumer_mtx_);
+    TaskPtr task;
+    for (std::size_t level = PRIORITY_LEVELS; level > 0; --level) {
+        if (levels_[level - 1].pop(task)) {
+            --size_;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<TaskPtr> TaskQueue::drain()
+{
+    std::vector<TaskPtr> tasks;
+
+    std::unique_lock<std::mutex> lock(consumer_mtx_);
+    TaskPtr task;
+    for (std::size_t level = PRIORITY_LEVELS; level > 0; --level) {
+        while (levels_[level - 1].pop(task)) {
+            --size_;
+            tasks.push_back(task);
+        }
+    }
+    return tasks;
+}
+
+std::size_t TaskQueue::size() const
+{
+    return size_;
+}
+
+bool TaskQueue::empty() const
+{
+    return size_ == 0;
+}
@@ -14,21 +14,81 @@
 #include <csapex/profiling/interlude.h>
 
 /// SYSTEM
+#include <cstring>
 #include <iostream>
 #include <yaml-cpp/yaml.h>
+#ifndef WIN32
+#include <sched.h>
+#endif
 
 using namespace csapex;
 
+namespace
+{
+const std::chrono::microseconds DEFAULT_SPIN_BUDGET(50);
+
+void relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+}  // namespace
+
+const std::string ThreadGroup::WAKE_UP_STEP = "wake up";
+
 int ThreadGroup::next_id_ = ThreadGroup::MINIMUM_THREAD_ID;
+thread_local ThreadGroup::Worker* ThreadGroup::current_worker_ = nullptr;
+thread_local ThreadGroup* ThreadGroup::executing_group_ = nullptr;
 
 ThreadGroup::ThreadGroup(TimedQueuePtr timed_queue, ExceptionHandler& handler, int id, std::string name)
-  : handler_(handler), destroyed_(false), id_(id), name_(name), cpu_affinity_(new CpuAffinity), timed_queue_(timed_queue), running_(false), pause_(false), stepping_(false)
+  : handler_(handler)
+  , destroyed_(false)
+  , id_(id)
+  , name_(name)
+  , cpu_affinity_(new CpuAffinity)
+  , timed_queue_(timed_queue)
+  , worker_count_(1)
+  , priority_policy_(TaskPriorityPolicy::FIFO)
+  , sleeping_workers_(0)
+  , spinning_workers_(0)
+  , idle_strategy_(IdleStrategy::BLOCK)
+  , spin_budget_us_(DEFAULT_SPIN_BUDGET.count())
+  , realtime_priority_(0)
+  , queued_tasks_(0)
+  , deadline_scheduling_(false)
+  , queued_deadline_tasks_(0)
+  , running_(false)
+  , pause_(false)
+  , stepping_(false)
+  , executing_tasks_(0)
 {
     next_id_ = std::max(next_id_, id + 1);
     setup();
 }
 ThreadGroup::ThreadGroup(TimedQueuePtr timed_queue, ExceptionHandler& handler, std::string name)
-  : handler_(handler), destroyed_(false), id_(next_id_++), name_(name), cpu_affinity_(new CpuAffinity), timed_queue_(timed_queue), running_(false), pause_(false), stepping_(false)
+  : handler_(handler)
+  , destroyed_(false)
+  , id_(next_id_++)
+  , name_(name)
+  , cpu_affinity_(new CpuAffinity)
+  , timed_queue_(timed_queue)
+  , worker_count_(1)
+  , priority_policy_(TaskPriorityPolicy::FIFO)
+  , sleeping_workers_(0)
+  , spinning_workers_(0)
+  , idle_strategy_(IdleStrategy::BLOCK)
+  , spin_budget_us_(DEFAULT_SPIN_BUDGET.count())
+  , realtime_priority_(0)
+  , queued_tasks_(0)
+  , deadline_scheduling_(false)
+  , queued_deadline_tasks_(0)
+  , running_(false)
+  , pause_(false)
+  , stepping_(false)
+  , executing_tasks_(0)
 {
     setup();
 }
@@ -39,7 +99,7 @@ ThreadGroup::~ThreadGroup()
     for (const TaskGeneratorPtr& tg : generators_copy) {
         tg->detach();
     }
-    if (running_ || scheduler_thread_.joinable()) {
+    if (running_ || !workers_.empty()) {
         stop();
     }
     destroyed_ = true;
@@ -52,7 +112,7 @@ void ThreadGroup::setup()
 
 void ThreadGroup::updateAffinity()
 {
-    if (!scheduler_thread_.joinable()) {
+    if (workers_.empty()) {
         return;
     }
 
@@ -67,9 +127,33 @@ void ThreadGroup::updateAffinity()
             CPU_SET(cpu, &cpuset);
         }
     }
-    int rc = pthread_setaffinity_np(scheduler_thread_.native_handle(), sizeof(cpu_set_t), &cpuset);
-    if (rc != 0) {
-        std::cerr << "failed to set cpu affinity in thread " << name_ << std::endl;
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        int rc = pthread_setaffinity_np(worker->thread.native_handle(), sizeof(cpu_set_t), &cpuset);
+        if (rc != 0) {
+            std::cerr << "failed to set cpu affinity in thread " << name_ << std::endl;
+        }
+    }
+#endif
+}
+
+void ThreadGroup::updateRealtimePriority()
+{
+    if (workers_.empty()) {
+        return;
+    }
+
+#if WIN32
+    // TODO: implement for other platforms
+#else
+    int priority = realtime_priority_;
+    sched_param param;
+    param.sched_priority = priority > 0 ? std::min(priority, sched_get_priority_max(SCHED_FIFO)) : 0;
+    int policy = priority > 0 ? SCHED_FIFO : SCHED_OTHER;
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        int rc = pthread_setschedparam(worker->thread.native_handle(), policy, &param);
+        if (rc != 0) {
+            std::cerr << "failed to set realtime priority " << priority << " in thread " << name_ << ": " << std::strerror(rc) << std::endl;
+        }
     }
 #endif
 }
@@ -103,7 +187,62 @@ CpuAffinityPtr ThreadGroup::getCpuAffinity() const
 
 const std::thread& ThreadGroup::thread() const
 {
-    return scheduler_thread_;
+    static std::thread not_running;
+    if (workers_.empty()) {
+        return not_running;
+    }
+    return workers_.front()->thread;
+}
+
+std::vector<const std::thread*> ThreadGroup::getThreads() const
+{
+    std::vector<const std::thread*> threads;
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        threads.push_back(&worker->thread);
+    }
+    return threads;
+}
+
+void ThreadGroup::setWorkerCount(std::size_t worker_count)
+{
+    apex_assert_hard(worker_count > 0);
+    if (worker_count != worker_count_) {
+        std::unique_lock<std::recursive_mutex> lock(state_mtx_);
+        worker_count_ = worker_count;
+
+        if (running_) {
+            lock.unlock();
+            stopWorkers();
+
+            lock.lock();
+            running_ = true;
+            startWorkers();
+        }
+
+        lock.unlock();
+        scheduler_changed();
+    }
+}
+
+std::size_t ThreadGroup::getWorkerCount() const
+{
+    return worker_count_;
+}
+
+bool ThreadGroup::isWorkStealingEnabled() const
+{
+    return worker_count_ > 1;
+}
+
+void ThreadGroup::setWorkStealingPeers(const std::vector<ThreadGroupPtr>& peers)
+{
+    std::unique_lock<std::mutex> lock(peers_mtx_);
+    peers_.clear();
+    for (const ThreadGroupPtr& peer : peers) {
+        if (peer.get() != this) {
+            peers_.push_back(peer);
+        }
+    }
 }
 
 std::size_t ThreadGroup::size() const
@@ -155,6 +294,7 @@ void ThreadGroup::step()
     begin_step();
 
     std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+    waitForExecutingTasks(state_lock);
     for (auto generator : generators_) {
         generator->step();
     }
@@ -199,22 +339,68 @@ bool ThreadGroup::isStepDone() const
 void ThreadGroup::start()
 {
     std::unique_lock<std::recursive_mutex> lock(state_mtx_);
-    if (scheduler_thread_.joinable()) {
-        running_ = false;
-        pause_changed_.notify_all();
+    if (!workers_.empty()) {
         lock.unlock();
-
-        scheduler_thread_.join();
+        stopWorkers();
+        lock.lock();
     }
 
     running_ = true;
 
-    scheduler_thread_ = std::thread([this]() {
-        csapex::thread::set_name((name_).c_str());
-        updateAffinity();
+    startWorkers();
+}
+
+void ThreadGroup::startWorkers()
+{
+    apex_assert_hard(workers_.empty());
+
+    // all workers have to exist before the first one can try to steal from its siblings
+    for (std::size_t i = 0; i < worker_count_; ++i) {
+        std::unique_ptr<Worker> worker(new Worker);
+        worker->group = this;
+        worker->index = i;
+        workers_.push_back(std::move(worker));
+    }
+
+    for (const std::unique_ptr<Worker>& w : workers_) {
+        Worker* worker = w.get();
+        worker->thread = std::thread([this, worker]() {
+            csapex::thread::set_name((name_).c_str());
+            current_worker_ = worker;
 
-        schedulingLoop();
-    });
+            schedulingLoop(*worker);
+        });
+    }
+
+    updateAffinity();
+    updateRealtimePriority();
+}
+
+void ThreadGroup::stopWorkers()
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(state_mtx_);
+        running_ = false;
+        pause_changed_.notify_all();
+    }
+    {
+        std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
+        work_available_.notify_all();
+    }
+
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // tasks that are still queued locally are kept for the next set of workers
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        for (const TaskPtr& task : worker->tasks) {
+            tasks_.push(task);
+        }
+    }
+    workers_.clear();
 }
 
 void ThreadGroup::stop()
@@ -228,14 +414,9 @@ void ThreadGroup::stop()
     {
         std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
     }
+    stopWorkers();
     {
         std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
-        work_available_.notify_all();
-        if (scheduler_thread_.joinable()) {
-            lock.unlock();
-
-            scheduler_thread_.join();
-        }
 
         auto gen = generators_;
         for (const TaskGeneratorPtr& tg : gen) {
@@ -259,10 +440,42 @@ void ThreadGroup::clear()
 {
     {
         std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
-        tasks_.clear();
+        std::vector<TaskPtr> queued = tasks_.drain();
+        for (const TaskPtr& task : queued) {
+            task->setScheduled(false);
+        }
+        queued_tasks_ -= queued.size();
+
+        for (const std::unique_ptr<Worker>& worker : workers_) {
+            std::unique_lock<std::mutex> worker_lock(worker->tasks_mtx);
+            for (const TaskPtr& task : worker->tasks) {
+                task->setScheduled(false);
+            }
+            queued_tasks_ -= worker->tasks.size();
+            worker->tasks.clear();
+        }
+
+        {
+            std::unique_lock<std::mutex> deadline_lock(deadline_mtx_);
+            for (const auto& entry : deadline_tasks_) {
+                entry.second->setScheduled(false);
+            }
+            queued_tasks_ -= deadline_tasks_.size();
+            queued_deadline_tasks_ = 0;
+            deadline_tasks_.clear();
+        }
+
+        std::unique_lock<std::mutex> busy_lock(busy_mtx_);
+        for (const auto& pair : deferred_tasks_) {
+            for (const TaskPtr& task : pair.second) {
+                task->setScheduled(false);
+            }
+        }
+        deferred_tasks_.clear();
     }
 
     std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+    waitForExecutingTasks(state_lock);
     for (auto generator : generators_) {
         generator->reset();
     }
@@ -304,7 +517,7 @@ void ThreadGroup::checkIfStepIsDone()
     }
 }
 
-std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator)
+std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator, std::vector<DelayedTask>& delayed)
 {
     std::vector<TaskPtr> remaining_tasks;
 
@@ -312,16 +525,63 @@ std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator)
 
     TaskGeneratorPtr removed;
 
-    for (auto it = tasks_.begin(); it != tasks_.end();) {
-        TaskPtr task = *it;
+    for (const TaskPtr& task : tasks_.drain()) {
         if (task->getParent() == generator) {
             remaining_tasks.push_back(task);
-            it = tasks_.erase(it);
+            --queued_tasks_;
         } else {
-            ++it;
+            tasks_.push(task);
+        }
+    }
+
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        std::unique_lock<std::mutex> worker_lock(worker->tasks_mtx);
+        for (auto it = worker->tasks.begin(); it != worker->tasks.end();) {
+            TaskPtr task = *it;
+            if (task->getParent() == generator) {
+                remaining_tasks.push_back(task);
+                it = worker->tasks.erase(it);
+                --queued_tasks_;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> deadline_lock(deadline_mtx_);
+        for (auto it = deadline_tasks_.begin(); it != deadline_tasks_.end();) {
+            if (it->second->getParent() == generator) {
+                remaining_tasks.push_back(it->second);
+                it = deadline_tasks_.erase(it);
+                --queued_deadline_tasks_;
+                --queued_tasks_;
+            } else {
+                ++it;
+            }
         }
     }
 
+    {
+        std::unique_lock<std::mutex> busy_lock(busy_mtx_);
+        auto deferred = deferred_tasks_.find(generator);
+        if (deferred != deferred_tasks_.end()) {
+            remaining_tasks.insert(remaining_tasks.end(), deferred->second.begin(), deferred->second.end());
+            deferred_tasks_.erase(deferred);
+        }
+    }
+
+    // delayed tasks would otherwise be handed back to this group once they are due, the next scheduler delays them just as long
+    if (timed_queue_) {
+        std::vector<DelayedTask> cancelled = timed_queue_->cancel(generator);
+        delayed.insert(delayed.end(), cancelled.begin(), cancelled.end());
+    }
+
+    // the tasks are going to be rescheduled by the generator's next scheduler
+    for (const TaskPtr& task : remaining_tasks) {
+        task->setScheduled(false);
+    }
+
     for (auto it = generators_.begin(); it != generators_.end();) {
         if (it->get() == generator) {
             removed = *it;
@@ -344,56 +604,129 @@ void ThreadGroup::schedule(TaskPtr task)
 {
     apex_assert_hard(!destroyed_);
 
-    std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
+    // a task is either queued, deferred or executing, scheduling it twice would execute it twice
+    if (!task->trySetScheduled()) {
+        return;
+    }
 
-    if (!tasks_.empty()) {
-        //        for(const TaskPtr& t : tasks_) {
-        for (auto it = tasks_.begin(); it != tasks_.end(); ++it) {
-            const TaskPtr& t = *it;
-            if (t.get() == task.get()) {
-                return;
-            }
-        }
+    // only tasks that might end an idle period or are profiled are stamped, busy groups do not pay for the clock.
+    // the stamp of an earlier scheduling is cleared, so that its wait is never measured twice
+    if (sleeping_workers_ > 0 || spinning_workers_ > 0 || (profiler_ && profiler_->isEnabled())) {
+        task->setScheduledTime(std::chrono::steady_clock::now());
+    } else {
+        task->setScheduledTime(std::chrono::steady_clock::time_point());
     }
 
-    tasks_.insert(task);
+    // counted before the task becomes visible, so that the counter never underflows
+    ++queued_tasks_;
+
+    // follow-up tasks stay with the worker that produced them, idle workers will steal them.
+    // prioritized tasks all go through the shared queues, the worker queues do not know about priorities.
+    Worker* worker = current_worker_;
+    if (worker && worker->group == this && isWorkStealingEnabled() && priority_policy_ == TaskPriorityPolicy::FIFO && !usesDeadline(task)) {
+        std::unique_lock<std::mutex> worker_lock(worker->tasks_mtx);
+        worker->tasks.push_back(task);
+    } else {
+        enqueue(task);
+    }
 
-    task->setScheduled(true);
+    wakeWorkers();
 
-    work_available_.notify_all();
+    if (isWorkStealingEnabled()) {
+        notifyPeers();
+    }
 }
 
-void ThreadGroup::scheduleDelayed(TaskPtr schedulable, std::chrono::system_clock::time_point time)
+void ThreadGroup::scheduleDelayed(TaskPtr schedulable, std::chrono::steady_clock::time_point time)
 {
     timed_queue_->schedule(shared_from_this(), schedulable, time);
 }
 
-void ThreadGroup::schedulingLoop()
+void ThreadGroup::schedulingLoop(Worker& worker)
 {
     while (running_) {
-        bool keep_executing = waitForTasks();
+        bool keep_executing = waitForTasks(worker);
         while (running_ && keep_executing) {
             handlePause();
 
-            keep_executing = executeNextTask();
+            keep_executing = executeNextTask(worker);
         }
     }
 }
 
-bool ThreadGroup::waitForTasks()
+bool ThreadGroup::waitForTasks(Worker& worker)
 {
+    if (hasTasks()) {
+        return true;
+    }
+
+    worker.idle_since = std::chrono::steady_clock::now();
+
+    if (idle_strategy_ != IdleStrategy::BLOCK) {
+        if (spinForTasks()) {
+            return true;
+        }
+        if (!running_) {
+            return false;
+        }
+    }
+
     std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
-    while (tasks_.empty()) {
+
+    // announce the sleeper before checking for work, producers only lock when someone sleeps
+    ++sleeping_workers_;
+    while (!hasTasks()) {
         work_available_.wait_for(lock, std::chrono::seconds(1));
 
         if (!running_) {
+            --sleeping_workers_;
             return false;
         }
     }
+    --sleeping_workers_;
 
     return true;
 }
 
+bool ThreadGroup::hasTasks()
+{
+    return queued_tasks_ > 0 || canStealTasks();
+}
+
+bool ThreadGroup::spinForTasks()
+{
+    // spinning workers are not counted as sleeping, so producers can hand over tasks without waking anyone
+    ++spinning_workers_;
+
+    bool found = false;
+    auto park_at = std::chrono::steady_clock::now() + std::chrono::microseconds(spin_budget_us_);
+    while (running_ && !pause_) {
+        if (hasTasks()) {
+            found = true;
+            break;
+        }
+
+        if (idle_strategy_ == IdleStrategy::BUSY_POLL) {
+            std::this_thread::yield();
+        } else if (std::chrono::steady_clock::now() < park_at) {
+            relax();
+        } else {
+            break;
+        }
+    }
+
+    --spinning_workers_;
+    return found;
+}
+
+void ThreadGroup::wakeWorkers()
+{
+    if (sleeping_workers_ > 0) {
+        std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
+        work_available_.notify_all();
+    }
+}
+
 void ThreadGroup::handlePause()
 {
     std::unique_lock<std::recursive_mutex> state_lock(state_mtx_);
@@ -402,41 +735,339 @@ void ThreadGroup::handlePause()
     }
 }
 
-bool ThreadGroup::executeNextTask()
+bool ThreadGroup::hasStealableTasks() const
 {
-    std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
-    if (!tasks_.empty()) {
-        TaskPtr task = *tasks_.begin();
-        tasks_.erase(tasks_.begin());
+    return running_ && !pause_ && isWorkStealingEnabled() && queued_tasks_ > 0;
+}
 
-        task->setScheduled(false);
+bool ThreadGroup::canStealTasks()
+{
+    if (!isWorkStealingEnabled()) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(peers_mtx_);
+    for (const ThreadGroupWeakPtr& peer_weak : peers_) {
+        if (ThreadGroupPtr peer = peer_weak.lock()) {
+            if (peer->hasStealableTasks()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadGroup::notifyPeers()
+{
+    // peers are woken without holding our peer lock, their waiting workers acquire it
+    std::vector<ThreadGroupWeakPtr> peers;
+    {
+        std::unique_lock<std::mutex> lock(peers_mtx_);
+        peers = peers_;
+    }
+
+    for (const ThreadGroupWeakPtr& peer_weak : peers) {
+        if (ThreadGroupPtr peer = peer_weak.lock()) {
+            if (peer->isWorkStealingEnabled()) {
+                peer->wakeWorkers();
+            }
+        }
+    }
+}
+
+void ThreadGroup::enqueue(const TaskPtr& task)
+{
+    if (usesDeadline(task)) {
+        std::unique_lock<std::mutex> deadline_lock(deadline_mtx_);
+        // tasks with equal deadlines are inserted behind each other and keep their order
+        deadline_tasks_.emplace(task->getDeadline(), task);
+        ++queued_deadline_tasks_;
+    } else {
+        tasks_.push(task);
+    }
+}
+
+bool ThreadGroup::usesDeadline(const TaskPtr& task) const
+{
+    return deadline_scheduling_ && task->hasDeadline();
+}
+
+TaskPtr ThreadGroup::popDeadlineTask()
+{
+    if (queued_deadline_tasks_ == 0) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> deadline_lock(deadline_mtx_);
+    if (deadline_tasks_.empty()) {
+        return nullptr;
+    }
+    TaskPtr task = deadline_tasks_.begin()->second;
+    deadline_tasks_.erase(deadline_tasks_.begin());
+    --queued_deadline_tasks_;
+    return task;
+}
+
+TaskPtr ThreadGroup::popTask(Worker* worker)
+{
+    if (TaskPtr task = popDeadlineTask()) {
+        --queued_tasks_;
+        return task;
+    }
+
+    if (TaskPtr task = tasks_.pop()) {
+        --queued_tasks_;
+        return task;
+    }
+
+    if (worker) {
+        std::unique_lock<std::mutex> worker_lock(worker->tasks_mtx);
+        if (!worker->tasks.empty()) {
+            TaskPtr task = worker->tasks.front();
+            worker->tasks.pop_front();
+            --queued_tasks_;
+            return task;
+        }
+    }
+
+    for (const std::unique_ptr<Worker>& other : workers_) {
+        if (other.get() != worker) {
+            std::unique_lock<std::mutex> worker_lock(other->tasks_mtx);
+            if (!other->tasks.empty()) {
+                TaskPtr task = other->tasks.back();
+                other->tasks.pop_back();
+                --queued_tasks_;
+                return task;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+TaskPtr ThreadGroup::takeNextTask(Worker* worker)
+{
+    while (TaskPtr task = popTask(worker)) {
+        if (claimTask(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+TaskPtr ThreadGroup::stealTask()
+{
+    if (!hasStealableTasks()) {
+        return nullptr;
+    }
+    return takeNextTask(nullptr);
+}
+
+TaskPtr ThreadGroup::stealFromPeers(ThreadGroupPtr& victim)
+{
+    std::vector<ThreadGroupWeakPtr> peers;
+    {
+        std::unique_lock<std::mutex> lock(peers_mtx_);
+        peers = peers_;
+    }
+
+    for (const ThreadGroupWeakPtr& peer_weak : peers) {
+        if (ThreadGroupPtr peer = peer_weak.lock()) {
+            if (TaskPtr task = peer->stealTask()) {
+                victim = peer;
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool ThreadGroup::claimTask(const TaskPtr& task)
+{
+    // tasks of the same generator are never executed concurrently
+    TaskGenerator* generator = task->getParent();
+    if (generator && isWorkStealingEnabled()) {
+        std::unique_lock<std::mutex> busy_lock(busy_mtx_);
+        if (busy_generators_.find(generator) != busy_generators_.end()) {
+            deferred_tasks_[generator].push_back(task);
+            return false;
+        }
+        busy_generators_.insert(generator);
+    }
 
-        tasks_lock.unlock();
+    task->setScheduled(false);
+    return true;
+}
+
+void ThreadGroup::releaseTask(const TaskPtr& task)
+{
+    TaskGenerator* generator = task->getParent();
+    if (!generator) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> busy_lock(busy_mtx_);
+    if (busy_generators_.erase(generator) == 0) {
+        return;
+    }
+
+    auto deferred = deferred_tasks_.find(generator);
+    if (deferred != deferred_tasks_.end()) {
+        queued_tasks_ += deferred->second.size();
+        for (const TaskPtr& deferred_task : deferred->second) {
+            enqueue(deferred_task);
+        }
+        deferred_tasks_.erase(deferred);
+        busy_lock.unlock();
 
+        wakeWorkers();
+    }
+}
+
+bool ThreadGroup::executeNextTask(Worker& worker)
+{
+    ThreadGroupPtr victim;
+    TaskPtr task = takeNextTask(&worker);
+    if (!task && isWorkStealingEnabled()) {
+        task = stealFromPeers(victim);
+    }
+
+    if (task) {
+        if (worker.idle_since != std::chrono::steady_clock::time_point()) {
+            if (!victim) {
+                recordWakeUp(worker, task);
+            }
+            worker.idle_since = std::chrono::steady_clock::time_point();
+        }
+
+        ThreadGroup* owner = victim ? victim.get() : this;
         {
             std::unique_lock<std::recursive_mutex> state_lock(state_mtx_);
-            if (running_) {
-                state_lock.unlock();
-
-                executeTask(task);
-                return true;
+            if (!running_) {
+                owner->releaseTask(task);
+                return false;
             }
         }
+
+        owner->executeTask(getTimerName(worker), task);
+        owner->releaseTask(task);
+        return true;
     }
 
     return false;
 }
 
-void ThreadGroup::executeTask(const TaskPtr& task)
+void ThreadGroup::recordWakeUp(Worker& worker, const TaskPtr& task)
+{
+    // tasks that were queued before the worker became idle did not have to wake it up
+    std::chrono::steady_clock::time_point scheduled = task->getScheduledTime();
+    if (scheduled < worker.idle_since) {
+        return;
+    }
+
+    ProfilerPtr profiler = getProfiler();
+    if (profiler && profiler->isEnabled()) {
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - scheduled);
+        profiler->record(getTimerName(worker), WAKE_UP_STEP, latency.count());
+    }
+}
+
+std::string ThreadGroup::getTimerName(const Worker& worker) const
 {
+    if (worker_count_ > 1) {
+        // timers are not thread safe, so every worker uses its own
+        return getName() + " #" + std::to_string(worker.index);
+    }
+    return getName();
+}
+
+std::vector<std::string> ThreadGroup::getTimerNames() const
+{
+    if (worker_count_ > 1) {
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < worker_count_; ++i) {
+            names.push_back(getName() + " #" + std::to_string(i));
+        }
+        return names;
+    }
+    return { getName() };
+}
+
+void ThreadGroup::setPriorityPolicy(TaskPriorityPolicy policy)
+{
+    // tasks that are already queued keep their priority
+    priority_policy_ = policy;
+}
+
+TaskPriorityPolicy ThreadGroup::getPriorityPolicy() const
+{
+    return priority_policy_;
+}
+
+void ThreadGroup::setDeadlineScheduling(bool enabled)
+{
+    // tasks that are already queued with their deadline are still executed first
+    deadline_scheduling_ = enabled;
+}
+
+bool ThreadGroup::isDeadlineSchedulingEnabled() const
+{
+    return deadline_scheduling_;
+}
+
+void ThreadGroup::setIdleStrategy(IdleStrategy strategy)
+{
+    // workers that are already parked pick up the new strategy the next time they run out of tasks
+    idle_strategy_ = strategy;
+}
+
+IdleStrategy ThreadGroup::getIdleStrategy() const
+{
+    return idle_strategy_;
+}
+
+void ThreadGroup::setSpinBudget(std::chrono::microseconds budget)
+{
+    apex_assert_hard(budget.count() >= 0);
+    spin_budget_us_ = budget.count();
+}
+
+std::chrono::microseconds ThreadGroup::getSpinBudget() const
+{
+    return std::chrono::microseconds(spin_budget_us_);
+}
+
+void ThreadGroup::setRealtimePriority(int priority)
+{
+    apex_assert_hard(priority >= 0);
+    std::unique_lock<std::recursive_mutex> lock(state_mtx_);
+    if (priority != realtime_priority_) {
+        realtime_priority_ = priority;
+        updateRealtimePriority();
+    }
+}
+
+int ThreadGroup::getRealtimePriority() const
+{
+    return realtime_priority_;
+}
+
+void ThreadGroup::executeTask(const std::string& timer_name, const TaskPtr& task)
+{
+    // a single worker holds the execution lock while running a task, multiple workers only register
+    std::unique_lock<std::recursive_mutex> execution_lock(execution_mtx_);
+    ThreadGroup* previous_group = executing_group_;
+    bool concurrent = worker_count_ > 1;
+    if (concurrent) {
+        ++executing_tasks_;
+        executing_group_ = this;
+        execution_lock.unlock();
+    }
+
     try {
-        std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
         ProfilerPtr profiler = getProfiler();
-        Interlude::Ptr interlude;
-        if (profiler && profiler->isEnabled()) {
-            TimerPtr timer = profiler->getTimer(getName());
-            interlude = std::make_shared<Interlude>(timer, task->getName());
-        }
+        TimerPtr timer = (profiler && profiler->isEnabled()) ? profiler->getTimer(timer_name) : nullptr;
+        Interlude interlude(timer, task->getName());
 
         task->execute();
 
@@ -455,6 +1086,22 @@ void ThreadGroup::executeTask(const TaskPtr& task)
         std::cerr << "Uncaught exception of unknown type and origin in execution of task " << task->getName() << "!" << std::endl;
         throw;
     }
+
+    if (concurrent) {
+        execution_lock.lock();
+        executing_group_ = previous_group;
+        --executing_tasks_;
+        execution_done_.notify_all();
+    }
+}
+
+void ThreadGroup::waitForExecutingTasks(std::unique_lock<std::recursive_mutex>& execution_lock)
+{
+    // a task of this group might be the caller, which must not wait for itself
+    int own_tasks = executing_group_ == this ? 1 : 0;
+    while (executing_tasks_ > own_tasks) {
+        execution_done_.wait(execution_lock);
+    }
 }
 
 std::vector<TaskGeneratorPtr>::iterator ThreadGroup::begin()
@@ -480,6 +1127,11 @@ std::vector<TaskGeneratorPtr>::const_iterator ThreadGroup::end() const
 void ThreadGroup::saveSettings(YAML::Node& node)
 {
     node["affinity"] = cpu_affinity_->get();
+    node["workers"] = getWorkerCount();
+    node["deadline_scheduling"] = isDeadlineSchedulingEnabled();
+    node["idle_strategy"] = idle_strategy::name(getIdleStrategy());
+    node["spin_budget_us"] = static_cast<long>(getSpinBudget().count());
+    node["realtime_priority"] = getRealtimePriority();
 }
 
 void ThreadGroup::loadSettings(const YAML::Node& node)
@@ -488,4 +1140,19 @@ void ThreadGroup::loadSettings(const YAML::Node& node)
         std::vector<bool> affinity = node["affinity"].as<std::vector<bool>>();
         cpu_affinity_->set(affinity);
     }
+    if (node["workers"].IsDefined()) {
+        setWorkerCount(std::max<std::size_t>(1, node["workers"].as<std::size_t>()));
+    }
+    if (node["deadline_scheduling"].IsDefined()) {
+        setDeadlineScheduling(node["deadline_scheduling"].as<bool>());
+    }
+    if (node["idle_strategy"].IsDefined()) {
+        setIdleStrategy(idle_strategy::fromName(node["idle_strategy"].as<std::string>()));
+    }
+    if (node["spin_budget_us"].IsDefined()) {
+        setSpinBudget(std::chrono::microseconds(std::max(0l, node["spin_budget_us"].as<long>())));
+    }
+    if (node["realtime_priority"].IsDefined()) {
+        setRealtimePriority(std::max(0, node["realtime_priority"].as<int>()));
+    }
 }
@@ -18,13 +18,24 @@
 using namespace csapex;
 
 ThreadPool::ThreadPool(ExceptionHandler& handler, bool enable_threading, bool grouping)
-  : handler_(handler), timed_queue_(new TimedQueue), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true)
+  : handler_(handler)
+  , timed_queue_(new TimedQueue)
+  , enable_threading_(enable_threading)
+  , grouping_(grouping)
+  , private_group_cpu_affinity_(new CpuAffinity)
+  , priority_policy_(TaskPriorityPolicy::FIFO)
+  , suppress_exceptions_(true)
 {
     setup();
 }
 
 ThreadPool::ThreadPool(Executor* parent, ExceptionHandler& handler, bool enable_threading, bool grouping)
-  : handler_(handler), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true)
+  : handler_(handler)
+  , enable_threading_(enable_threading)
+  , grouping_(grouping)
+  , private_group_cpu_affinity_(new CpuAffinity)
+  , priority_policy_(TaskPriorityPolicy::FIFO)
+  , suppress_exceptions_(true)
 {
     setup();
     parent->addChild(this);
@@ -33,8 +44,10 @@ void ThreadPool::setup()
 {
     default_group_ = std::make_shared<ThreadGroup>(timed_queue_, handler_, ThreadGroup::DEFAULT_GROUP_ID, "default");
     default_group_->useProfiler(getProfiler());
+    default_group_->setPriorityPolicy(priority_policy_);
 
     groups_.push_back(default_group_);
+    updateWorkStealingPeers();
 
     observe(default_group_->end_step, [this]() { checkIfStepIsDone(); });
 
@@ -90,6 +103,7 @@ void ThreadPool::stop()
     apex_assert_hard(group_assignment_.empty());
     apex_assert_hard(groups_.empty());
     groups_.push_back(default_group_);
+    updateWorkStealingPeers();
 }
 
 bool ThreadPool::isRunning() const
@@ -224,6 +238,14 @@ void ThreadPool::assignGeneratorToGroup(TaskGenerator* task, ThreadGroup* group)
     }
 }
 
+void ThreadPool::updateWorkStealingPeers()
+{
+    // every group knows all others, stealing only happens between groups with multiple workers
+    for (const ThreadGroupPtr& group : groups_) {
+        group->setWorkStealingPeers(groups_);
+    }
+}
+
 bool ThreadPool::isInPrivateThread(TaskGenerator* task) const
 {
     return isInGroup(task, ThreadGroup::PRIVATE_THREAD);
@@ -247,8 +269,10 @@ void ThreadPool::usePrivateThreadFor(TaskGenerator* task)
 
         group->setPause(isPaused());
         group->useProfiler(getProfiler());
+        group->setPriorityPolicy(priority_policy_);
 
         groups_.push_back(group);
+        updateWorkStealingPeers();
         group->end_step.connect([this]() { checkIfStepIsDone(); });
 
         assignGeneratorToGroup(task, group.get());
@@ -311,7 +335,7 @@ int ThreadPool::createNewGroupFor(TaskGenerator* task, const std::string& name)
     return group->id();
 }
 
-ThreadGroup* ThreadPool::createGroup(const std::string& name, int id)
+ThreadGroup* ThreadPool::createGroup(const std::string& name, int id, std::size_t worker_count)
 {
     ThreadGroupPtr group;
     if (id > 0) {
@@ -319,10 +343,13 @@ ThreadGroup* ThreadPool::createGroup(const std::string& name, int id)
     } else {
         group = std::make_shared<ThreadGroup>(timed_queue_, handler_, name);
     }
+    group->setWorkerCount(worker_count);
     group->setPause(isPaused());
     group->useProfiler(getProfiler());
+    group->setPriorityPolicy(priority_policy_);
 
     groups_.push_back(group);
+    updateWorkStealingPeers();
     group->end_step.connect([this]() { checkIfStepIsDone(); });
 
     if (isRunning()) {
@@ -341,6 +368,7 @@ void ThreadPool::removeGroup(int id)
         if (group->id() == id) {
             apex_assert_hard(group->isEmpty());
             groups_.erase(it);
+            updateWorkStealingPeers();
 
             group_removed(group);
             return;
@@ -355,6 +383,7 @@ void ThreadPool::removeGroup(ThreadGroup* group)
             apex_assert_hard(group->isEmpty());
             group_removed(*it);
             groups_.erase(it);
+            updateWorkStealingPeers();
 
             return;
         }
@@ -408,6 +437,7 @@ void ThreadPool::saveSettings(YAML::Node& node)
     }
     threads["groups"] = groups;
     threads["private_affinity"] = private_group_cpu_affinity_->get();
+    threads["priority_policy"] = task_priority::name(priority_policy_);
 
     YAML::Node assignments;
     for (std::map<TaskGenerator*, ThreadGroup*>::const_iterator it = group_assignment_.begin(); it != group_assignment_.end(); ++it) {
@@ -432,6 +462,11 @@ void ThreadPool::loadSettings(YAML::Node& node)
             private_group_cpu_affinity_->set(a);
         }
 
+        const YAML::Node& priority_policy = threads["priority_policy"];
+        if (priority_policy.IsDefined()) {
+            setPriorityPolicy(task_priority::fromName(priority_policy.as<std::string>()));
+        }
+
         const YAML::Node& groups = threads["groups"];
         if (groups.IsDefined()) {
             for (std::size_t i = 0, total = groups.size(); i < total; ++i) {
@@ -446,8 +481,10 @@ void ThreadPool::loadSettings(YAML::Node& node)
                     auto g = std::make_shared<ThreadGroup>(timed_queue_, handler_, group_id, group_name);
                     g->setPause(isPaused());
                     g->useProfiler(getProfiler());
+                    g->setPriorityPolicy(priority_policy_);
 
                     groups_.push_back(g);
+                    updateWorkStealingPeers();
                     g->end_step.connect([this]() { checkIfStepIsDone(); });
 
                     group_created(g);
@@ -494,6 +531,19 @@ void ThreadPool::loadSettings(YAML::Node& node)
     }
 }
 
+void ThreadPool::setPriorityPolicy(TaskPriorityPolicy policy)
+{
+    priority_policy_ = policy;
+    for (const ThreadGroupPtr& group : groups_) {
+        group->setPriorityPolicy(policy);
+    }
+}
+
+TaskPriorityPolicy ThreadPool::getPriorityPolicy() const
+{
+    return priority_policy_;
+}
+
 void ThreadPool::setSuppressExceptions(bool suppress_exceptions)
 {
     if (suppress_exceptions_ != suppress_exceptions) {
@@ -4,13 +4,37 @@
 /// COMPONENT
 #include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/task.h>
+#include <csapex/utility/assert.h>
 #include <csapex/utility/thread.h>
 
+/// SYSTEM
+#include <algorithm>
+#include <limits>
+
 using namespace csapex;
 
-TimedQueue::TimedQueue() : scheduling_running_(false), sleeping_running_(false)
+constexpr std::chrono::microseconds TimedQueue::RESOLUTION;
+constexpr unsigned TimedQueue::SLOT_BITS;
+constexpr std::size_t TimedQueue::SLOTS;
+constexpr std::size_t TimedQueue::LEVELS;
+
+const uint64_t TimedQueue::NEVER = std::numeric_limits<uint64_t>::max();
+
+static_assert(TimedQueue::SLOTS <= 64, "the occupied slots of a level are tracked in a 64 bit mask");
+
+namespace
+{
+uint64_t lowerBits(unsigned bits)
+{
+    return (uint64_t(1) << bits) - 1;
+}
+}  // namespace
+
+TimedQueue::TimedQueue() : running_(false), epoch_(std::chrono::steady_clock::now()), current_(0), next_wake_up_(NEVER), size_(0)
 {
+    occupied_.fill(0);
 }
+
 TimedQueue::~TimedQueue()
 {
     stop();
@@ -18,121 +42,299 @@ TimedQueue::~TimedQueue()
 
 void TimedQueue::start()
 {
-    next_wake_up_ = std::chrono::system_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    apex_assert_hard(!thread_.joinable());
+    running_ = true;
+    thread_ = std::thread([this]() { loop(); });
+}
 
-    // this thread schedules tasks that have expired
-    scheduling_running_ = true;
-    scheduling_thread_ = std::thread([this]() { loop(); });
+void TimedQueue::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+        wake_up_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
 
-    // this thread sleeps until the time given by 'next_wake_up_' is reached.
-    // it then wakes up the scheduling thread
-    sleeping_running_ = true;
-    sleeping_thread_ = std::thread([this]() { sleep(); });
+std::size_t TimedQueue::size() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return size_;
 }
 
-void TimedQueue::stop()
+void TimedQueue::loop()
 {
-    if (scheduling_thread_.joinable()) {
-        {
-            std::unique_lock<std::mutex> lock(task_mtx_);
-            scheduling_running_ = false;
+    csapex::thread::set_name("queue:timer");
+
+    Expired expired;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        uint64_t now = (std::chrono::steady_clock::now() - epoch_) / RESOLUTION;
+        advanceTo(now, expired);
+
+        if (!expired.empty()) {
+            lock.unlock();
+            for (const auto& entry : expired) {
+                entry.first->schedule(entry.second);
+            }
+            expired.clear();
+            lock.lock();
+            continue;
         }
-        apex_assert_eq_hard(false, scheduling_running_);
-        tasks_changed_.notify_all();
-        apex_assert_eq_hard(false, scheduling_running_);
-        scheduling_thread_.join();
-    }
-    if (sleeping_thread_.joinable()) {
-        {
-            std::unique_lock<std::mutex> lock(sleep_mtx_);
-            sleeping_running_ = false;
+
+        next_wake_up_ = nextEvent();
+        if (next_wake_up_ == NEVER) {
+            wake_up_.wait(lock);
+        } else {
+            wake_up_.wait_until(lock, toTime(next_wake_up_));
         }
-        apex_assert_eq_hard(false, sleeping_running_);
-        next_wake_up_changed_.notify_all();
-        apex_assert_eq_hard(false, sleeping_running_);
-        sleeping_thread_.join();
     }
+    next_wake_up_ = NEVER;
 }
 
-void TimedQueue::loop()
+void TimedQueue::schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::steady_clock::time_point time)
 {
-    csapex::thread::set_name("queue:exec");
+    std::unique_lock<std::mutex> lock(mutex_);
 
-    std::unique_lock<std::mutex> lock(task_mtx_);
-    while (scheduling_running_) {
-        // wait until a task is available
-        while (tasks_.empty()) {
-            tasks_changed_.wait_for(lock, std::chrono::milliseconds(100));
-            if (!scheduling_running_) {
-                return;
-            }
+    Timer* timer;
+    if (free_timers_.empty()) {
+        timers_.emplace_back();
+        timer = &timers_.back();
+    } else {
+        timer = free_timers_.back();
+        free_timers_.pop_back();
+    }
+
+    timer->scheduler = scheduler;
+    timer->schedulable = schedulable;
+    timer->generator = schedulable->getParent();
+    // the slot of the current tick has already been handed over
+    timer->expiry = std::max(toTick(time), current_ + 1);
+
+    timer->prev_of_generator = nullptr;
+    timer->next_of_generator = nullptr;
+    if (timer->generator) {
+        Timer*& first = generators_[timer->generator];
+        if (first) {
+            first->prev_of_generator = timer;
+            timer->next_of_generator = first;
         }
+        first = timer;
+    }
+
+    insert(timer);
+    ++size_;
+
+    if (timer->expiry < next_wake_up_) {
+        // only wake up the thread if it would otherwise sleep past this timer
+        next_wake_up_ = timer->expiry;
+        wake_up_.notify_all();
+    }
+}
 
-        // schedule all tasks that have expired
-        while (!tasks_.empty()) {
-            const Unit& front = *tasks_.begin();
+std::vector<DelayedTask> TimedQueue::cancel(TaskGenerator* generator)
+{
+    std::vector<DelayedTask> tasks;
 
-            auto now = std::chrono::system_clock::now();
-            if (now >= front.time) {
-                Unit unit = front;
-                tasks_.erase(tasks_.begin());
-                lock.unlock();
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto pos = generators_.find(generator);
+    if (pos == generators_.end()) {
+        return tasks;
+    }
 
-                unit.scheduler->schedule(unit.schedulable);
+    Timer* timer = pos->second;
+    while (timer) {
+        Timer* next = timer->next_of_generator;
 
-                lock.lock();
-            } else {
-                break;
-            }
+        // the task is executed once when it is handed over, later timers of the same task have no effect
+        std::chrono::steady_clock::time_point time = toTime(timer->expiry);
+        auto pos = std::find_if(tasks.begin(), tasks.end(), [timer](const DelayedTask& delayed) { return delayed.task == timer->schedulable; });
+        if (pos == tasks.end()) {
+            tasks.push_back(DelayedTask{ timer->schedulable, time });
+        } else {
+            pos->time = std::min(pos->time, time);
         }
 
-        // notify the sleeping thread, if there are remaining tasks
-        if (!tasks_.empty()) {
-            Unit front = *tasks_.begin();
-            lock.unlock();
+        unlink(timer);
+        release(timer);
+        timer = next;
+    }
 
-            {
-                std::unique_lock<std::mutex> lock(sleep_mtx_);
-                next_wake_up_ = front.time;
-                next_wake_up_changed_.notify_all();
-            }
+    return tasks;
+}
 
-            lock.lock();
+uint64_t TimedQueue::toTick(std::chrono::steady_clock::time_point time) const
+{
+    if (time <= epoch_) {
+        return 0;
+    }
+
+    // rounded up, timers must never fire early
+    const auto resolution = std::chrono::duration_cast<std::chrono::steady_clock::duration>(RESOLUTION);
+    return static_cast<uint64_t>((time - epoch_ + resolution - std::chrono::steady_clock::duration(1)) / resolution);
+}
+
+std::chrono::steady_clock::time_point TimedQueue::toTime(uint64_t tick) const
+{
+    return epoch_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(RESOLUTION * tick);
+}
+
+void TimedQueue::insert(Timer* timer)
+{
+    // a timer is stored at the level of the highest slot digit in which it differs from the current tick,
+    // so all digits above are shared and it is moved down once the current tick reaches its slot
+    uint64_t difference = timer->expiry ^ current_;
+    std::size_t level = 0;
+    while (level < LEVELS && (difference >> (SLOT_BITS * (level + 1))) != 0) {
+        ++level;
+    }
+
+    timer->level = level;
+    if (level == LEVELS) {
+        timer->slot = 0;
+        link(timer, overflow_);
+    } else {
+        timer->slot = (timer->expiry >> (SLOT_BITS * level)) & lowerBits(SLOT_BITS);
+        link(timer, wheel_[level][timer->slot]);
+        occupied_[level] |= uint64_t(1) << timer->slot;
+    }
+}
+
+TimedQueue::Slot& TimedQueue::slotOf(const Timer* timer)
+{
+    return timer->level == LEVELS ? overflow_ : wheel_[timer->level][timer->slot];
+}
+
+void TimedQueue::link(Timer* timer, Slot& slot)
+{
+    timer->prev = slot.tail;
+    timer->next = nullptr;
+    if (slot.tail) {
+        slot.tail->next = timer;
+    } else {
+        slot.head = timer;
+    }
+    slot.tail = timer;
+}
+
+void TimedQueue::unlink(Timer* timer)
+{
+    Slot& slot = slotOf(timer);
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        slot.head = timer->next;
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    } else {
+        slot.tail = timer->prev;
+    }
+
+    if (!slot.head && timer->level < LEVELS) {
+        occupied_[timer->level] &= ~(uint64_t(1) << timer->slot);
+    }
+}
+
+void TimedQueue::release(Timer* timer)
+{
+    if (timer->generator) {
+        if (timer->prev_of_generator) {
+            timer->prev_of_generator->next_of_generator = timer->next_of_generator;
+        } else if (timer->next_of_generator) {
+            generators_[timer->generator] = timer->next_of_generator;
+        } else {
+            generators_.erase(timer->generator);
+        }
+        if (timer->next_of_generator) {
+            timer->next_of_generator->prev_of_generator = timer->prev_of_generator;
+        }
+    }
+
+    timer->scheduler.reset();
+    timer->schedulable.reset();
+    free_timers_.push_back(timer);
+    --size_;
+}
+
+uint64_t TimedQueue::nextEvent() const
+{
+    uint64_t next = NEVER;
+
+    // every occupied slot lies ahead of the current digit of its level
+    for (std::size_t level = 0; level < LEVELS; ++level) {
+        uint64_t digit = (current_ >> (SLOT_BITS * level)) & lowerBits(SLOT_BITS);
+        uint64_t ahead = digit + 1 < SLOTS ? occupied_[level] & (~uint64_t(0) << (digit + 1)) : 0;
+        if (ahead) {
+            uint64_t slot = __builtin_ctzll(ahead);
+            uint64_t tick = (current_ & ~lowerBits(SLOT_BITS * (level + 1))) | (slot << (SLOT_BITS * level));
+            next = std::min(next, tick);
         }
     }
+
+    if (overflow_.head) {
+        next = std::min(next, (current_ | lowerBits(SLOT_BITS * LEVELS)) + 1);
+    }
+
+    return next;
 }
 
-void TimedQueue::sleep()
+void TimedQueue::advanceTo(uint64_t tick, Expired& expired)
 {
-    csapex::thread::set_name("queue:sleep");
+    while (current_ < tick) {
+        // ticks without any event are skipped
+        uint64_t next = nextEvent();
+        if (next > tick) {
+            current_ = tick;
+            return;
+        }
+        current_ = next;
 
-    std::unique_lock<std::mutex> lock(sleep_mtx_);
-    while (sleeping_running_) {
-        // wait for a sleep command
-        next_wake_up_changed_.wait(lock);
+        if ((current_ & lowerBits(SLOT_BITS * LEVELS)) == 0) {
+            Timer* timer = overflow_.head;
+            overflow_.head = nullptr;
+            overflow_.tail = nullptr;
+            while (timer) {
+                Timer* next_timer = timer->next;
+                insert(timer);
+                timer = next_timer;
+            }
+        }
+
+        // higher levels first, their timers might have to move down more than one level
+        for (std::size_t level = LEVELS - 1; level > 0; --level) {
+            if ((current_ & lowerBits(SLOT_BITS * level)) == 0) {
+                cascade(level);
+            }
+        }
 
-        auto now = std::chrono::system_clock::now();
-        if (now < next_wake_up_) {
-            // the next sleep target is in the future -> sleep
-            std::this_thread::sleep_until(next_wake_up_);
-            tasks_changed_.notify_all();
+        Slot& slot = wheel_[0][current_ & lowerBits(SLOT_BITS)];
+        while (Timer* timer = slot.head) {
+            expired.emplace_back(timer->scheduler, timer->schedulable);
+            unlink(timer);
+            release(timer);
         }
     }
 }
 
-void TimedQueue::schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::system_clock::time_point time)
+void TimedQueue::cascade(std::size_t level)
 {
-    Unit unit;
-    unit.scheduler = scheduler;
-    unit.schedulable = schedulable;
-    unit.time = time;
+    std::size_t index = (current_ >> (SLOT_BITS * level)) & lowerBits(SLOT_BITS);
+    Slot& slot = wheel_[level][index];
 
-    std::unique_lock<std::mutex> lock(task_mtx_);
-    auto front = tasks_.begin();
-    tasks_.insert(unit);
+    Timer* timer = slot.head;
+    slot.head = nullptr;
+    slot.tail = nullptr;
+    occupied_[level] &= ~(uint64_t(1) << index);
 
-    if (tasks_.begin() != front) {
-        // the earliest entry changed -> notify the scheduling thread immediately
-        tasks_changed_.notify_all();
+    while (timer) {
+        Timer* next = timer->next;
+        insert(timer);
+        timer = next;
     }
 }
@@ -15,6 +15,7 @@
 #include <csapex/model/token_data.h>
 #include <csapex/param/parameter.h>
 #include <csapex/profiling/interval.h>
+#include <csapex/profiling/latency_histogram.h>
 #include <csapex/serialization/packet_serializer.h>
 #include <csapex/serialization/snippet.h>
 #include <csapex/serialization/streamable.h>
@@ -22,10 +23,15 @@
 
 /// SYSTEM
 #include <yaml-cpp/yaml.h>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 
 using namespace csapex;
 
+const uint8_t SerializationBuffer::LENGTH_ESCAPE;
+constexpr bool SerializationBuffer::HOST_IS_LITTLE_ENDIAN;
+
 bool SerializationBuffer::initialized_ = false;
 std::map<std::type_index, std::function<void(SerializationBuffer& buffer, const boost::any& a)>> SerializationBuffer::any_serializer;
 std::map<uint8_t, std::function<void(const SerializationBuffer& buffer, boost::any& a)>> SerializationBuffer::any_deserializer;
@@ -66,6 +72,42 @@ SerializationBuffer::SerializationBuffer(const uint8_t* raw_data, const std::siz
     init();
 }
 
+SerializationBuffer::SerializationBuffer(const std::shared_ptr<SerializationRegion>& region) : std::vector<uint8_t, SerializationBufferAllocator<uint8_t>>(SerializationBufferAllocator<uint8_t>(region)), pos(HEADER_LENGTH)
+{
+    if (region && region->capacity >= HEADER_LENGTH) {
+        reserve(region->capacity);
+    }
+
+    // the header is always 4 byte
+    insert(end(), HEADER_LENGTH, 0);
+
+    init();
+}
+
+SerializationBuffer SerializationBuffer::view(const uint8_t* raw_data, const std::size_t length)
+{
+    // the region is only read, the buffer never writes through the pointer
+    auto region = std::make_shared<SerializationRegion>(const_cast<uint8_t*>(raw_data), length);
+    SerializationBuffer buffer(region, length);
+    return buffer;
+}
+
+SerializationBuffer::SerializationBuffer(const std::shared_ptr<SerializationRegion>& region, std::size_t length)
+  : std::vector<uint8_t, SerializationBufferAllocator<uint8_t>>(SerializationBufferAllocator<uint8_t>(region)), pos(HEADER_LENGTH)
+{
+    // elements in the region are not initialized, so resizing exposes the data that is already there
+    reserve(length);
+    resize(length);
+
+    init();
+}
+
+bool SerializationBuffer::isInRegion() const
+{
+    const auto& region = get_allocator().region();
+    return region && capacity() > 0 && data() == region->data;
+}
+
 void SerializationBuffer::init()
 {
     if (!initialized_) {
@@ -153,6 +195,7 @@ void SerializationBuffer::init()
         ADD_ANY_TYPE(ActivityType);
         ADD_ANY_TYPE(ErrorState::ErrorLevel);
         ADD_ANY_TYPE_1PC(std::string, name(), Interval);
+        ADD_ANY_TYPE(LatencyHistogram);
 
         initialized_ = true;
     }
@@ -235,30 +278,70 @@ StreamablePtr SerializationBuffer::read() const
     return nullptr;
 }
 
+uint8_t* SerializationBuffer::grow(const std::size_t length)
+{
+    // resize grows the capacity geometrically, so many small writes stay amortized constant
+    const std::size_t offset = size();
+    resize(offset + length);
+    return data() + offset;
+}
+
+const uint8_t* SerializationBuffer::consume(const std::size_t length) const
+{
+    if (pos + length > size()) {
+        throw std::out_of_range("SerializationBuffer: read past the end of the buffer");
+    }
+    const uint8_t* start = data() + pos;
+    pos += length;
+    return start;
+}
+
+void SerializationBuffer::writeLength(const std::size_t length)
+{
+    if (length < LENGTH_ESCAPE) {
+        operator<<(static_cast<uint8_t>(length));
+    } else {
+        operator<<(LENGTH_ESCAPE);
+        operator<<(static_cast<uint64_t>(length));
+    }
+}
+
+std::size_t SerializationBuffer::readLength() const
+{
+    uint8_t short_length;
+    operator>>(short_length);
+    if (short_length < LENGTH_ESCAPE) {
+        return short_length;
+    }
+
+    uint64_t length;
+    operator>>(length);
+    return length;
+}
+
 void SerializationBuffer::writeRaw(const char* data, const std::size_t length)
 {
-    reserve(size() + length);
-    std::copy(data, data + length, std::back_inserter(*this));
+    writeRaw(reinterpret_cast<const uint8_t*>(data), length);
 }
 
 void SerializationBuffer::writeRaw(const uint8_t* data, const std::size_t length)
 {
-    reserve(size() + length);
-    std::copy(data, data + length, std::back_inserter(*this));
+    if (length > 0) {
+        std::memcpy(grow(length), data, length);
+    }
 }
 
 void SerializationBuffer::readRaw(char* data, const std::size_t length) const
 {
-    const char* start = reinterpret_cast<const char*>(&at(pos));
-    std::copy(start, start + length, data);
-    pos += length;
+    readRaw(reinterpret_cast<uint8_t*>(data), length);
 }
 
 void SerializationBuffer::readRaw(uint8_t* data, const std::size_t length) const
 {
-    const uint8_t* start = &at(pos);
-    std::copy(start, start + length, data);
-    pos += length;
+    const uint8_t* start = consume(length);
+    if (length > 0) {
+        std::memcpy(data, start, length);
+    }
 }
 
 SerializationBuffer& SerializationBuffer::writeAny(const boost::any& any)
@@ -296,93 +379,40 @@ const SerializationBuffer& SerializationBuffer::readAny(boost::any& any) const
     return *this;
 }
 
-#if G_BYTE_ORDER == G_LITTLE_ENDIAN
-union _GFloatIEEE754
-{
-    float v_float;
-    struct
-    {
-        uint mantissa : 23;
-        uint biased_exponent : 8;
-        uint sign : 1;
-    } mpn;
-};
-union _GDoubleIEEE754
-{
-    double v_double;
-    struct
-    {
-        uint mantissa_low : 32;
-        uint mantissa_high : 20;
-        uint biased_exponent : 11;
-        uint sign : 1;
-    } mpn;
-};
-#elif G_BYTE_ORDER == G_BIG_ENDIAN
-union _GFloatIEEE754
-{
-    float v_float;
-    struct
-    {
-        uint sign : 1;
-        uint biased_exponent : 8;
-        uint mantissa : 23;
-    } mpn;
-};
-union _GDoubleIEEE754
-{
-    double v_double;
-    struct
-    {
-        uint sign : 1;
-        uint biased_exponent : 11;
-        uint mantissa_high : 20;
-        uint mantissa_low : 32;
-    } mpn;
-};
-#else /* !G_LITTLE_ENDIAN && !G_BIG_ENDIAN */
-#error unknown ENDIAN type
-#endif /* !G_LITTLE_ENDIAN && !G_BIG_ENDIAN */
-
+// FLOATS
 SerializationBuffer& SerializationBuffer::operator<<(float f)
 {
-    _GFloatIEEE754 ieee;
-    ieee.v_float = f;
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+
+    const uint32_t sign = bits >> 31;
+    const uint32_t biased_exponent = (bits >> 23) & 0xFF;
+    const uint32_t mantissa = bits & 0x7FFFFF;
 
     /***
      * sign  | mantissa    |  exponent
      *   1         23             8
      *   1   | 2 - 24      | 25 - 32
      */
-    uint8_t bytes[4];
-    // memset(&bytes[0], 0, 4);
-    bytes[0] = ieee.mpn.sign << 7;
-    bytes[0] |= (ieee.mpn.mantissa >> (23 - 7));
-    bytes[1] = (ieee.mpn.mantissa >> (23 - 7 - 8)) & 0xFF;
-    bytes[2] = (ieee.mpn.mantissa >> (23 - 7 - 16)) & 0xFF;
-    bytes[3] = ieee.mpn.biased_exponent;
-
-    for (uint8_t i = 0; i < 4; ++i) {
-        push_back(bytes[i]);
-    }
+    uint8_t* bytes = grow(4);
+    bytes[0] = (sign << 7) | (mantissa >> (23 - 7));
+    bytes[1] = (mantissa >> (23 - 7 - 8)) & 0xFF;
+    bytes[2] = (mantissa >> (23 - 7 - 16)) & 0xFF;
+    bytes[3] = biased_exponent;
 
     return *this;
 }
 
 const SerializationBuffer& SerializationBuffer::operator>>(float& f) const
 {
-    uint8_t bytes[4];
-    for (uint8_t i = 0; i < 4; ++i) {
-        bytes[i] = at(pos++);
-    }
+    const uint8_t* bytes = consume(4);
 
-    _GFloatIEEE754 ieee;
+    const uint32_t sign = (bytes[0] >> 7) & 1;
+    const uint32_t mantissa = (static_cast<uint32_t>(bytes[0] & 0x7F) << (23 - 7)) | (static_cast<uint32_t>(bytes[1]) << (23 - 7 - 8)) | bytes[2];
+    const uint32_t biased_exponent = bytes[3];
 
-    ieee.mpn.sign = (bytes[0] & (1 << 7)) ? 1 : 0;
-    ieee.mpn.mantissa = ((bytes[0] & (~(1 << 7))) << (23 - 7)) | (bytes[1] << (23 - 7 - 8)) | (bytes[2] << (23 - 7 - 16));
-    ieee.mpn.biased_exponent = bytes[3];
-
-    f = ieee.v_float;
+    const uint32_t bits = (sign << 31) | (biased_exponent << 23) | mantissa;
+    std::memcpy(&f, &bits, sizeof(f));
 
     return *this;
 }
@@ -390,29 +420,18 @@ const SerializationBuffer& SerializationBuffer::operator>>(float& f) const
 // DOUBLES
 SerializationBuffer& SerializationBuffer::operator<<(double d)
 {
-    _GDoubleIEEE754 ieee;
-    ieee.v_double = d;
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
 
     /***
      * sign  | exponent   |  mantissa_high   | mantissa_low
      *   1         11             20         |   32
      *   1   | 2 - 12         | 13 - 32      |   32
+     * which is IEEE 754 in big endian byte order
      */
-    uint8_t bytes[8];
-    // memset(&bytes[0], 0, 4);
-    bytes[0] = ieee.mpn.sign << 7;
-    bytes[0] |= (ieee.mpn.biased_exponent >> (11 - 7));
-    bytes[1] = (ieee.mpn.biased_exponent << 4);
-    bytes[1] |= (ieee.mpn.mantissa_high >> (20 - 4)) & 0xFF;
-    bytes[2] = (ieee.mpn.mantissa_high >> (20 - 4 - 8)) & 0xFF;
-    bytes[3] = (ieee.mpn.mantissa_high >> (20 - 4 - 16)) & 0xFF;
-    bytes[4] = (ieee.mpn.mantissa_low >> (3 * 8)) & 0xFF;
-    bytes[5] = (ieee.mpn.mantissa_low >> (2 * 8)) & 0xFF;
-    bytes[6] = (ieee.mpn.mantissa_low >> (1 * 8)) & 0xFF;
-    bytes[7] = (ieee.mpn.mantissa_low >> (0 * 8)) & 0xFF;
-
-    for (uint8_t i = 0; i < 8; ++i) {
-        push_back(bytes[i]);
+    uint8_t* bytes = grow(8);
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        bytes[byte] = (bits >> ((7 - byte) * 8)) & 0xFF;
     }
 
     return *this;
@@ -420,20 +439,13 @@ SerializationBuffer& SerializationBuffer::operator<<(double d)
 
 const SerializationBuffer& SerializationBuffer::operator>>(double& d) const
 {
-    uint8_t bytes[8];
-    for (uint8_t i = 0; i < 8; ++i) {
-        bytes[i] = at(pos++);
-    }
-
-    _GDoubleIEEE754 ieee;
+    const uint8_t* bytes = consume(8);
 
-    ieee.mpn.sign = (bytes[0] & (1 << 7)) ? 1 : 0;
-    ieee.mpn.biased_exponent = ((bytes[0] & (~(1 << 7))) << (11 - 7)) | ((bytes[1] & (0xF0)) >> 4);
-    ieee.mpn.mantissa_high = ((bytes[1] & (~(1 << 7))) << (20 - 4)) | (bytes[2] << (20 - 4 - 8)) | (bytes[3] << (20 - 4 - 16));
-
-    ieee.mpn.mantissa_low = (bytes[4] << (3 * 8)) | (bytes[5] << (2 * 8)) | (bytes[6] << (1 * 8)) | (bytes[7] << (0 * 8));
-
-    d = ieee.v_double;
+    uint64_t bits = 0;
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        bits = (bits << 8) | bytes[byte];
+    }
+    std::memcpy(&d, &bits, sizeof(d));
 
     return *this;
 }
@@ -33,9 +33,17 @@ Snippet::Snippet()
 
 void Snippet::toYAML(YAML::Node& out) const
 {
+    ensureLoaded();
     out = *yaml_;
 }
 
+void Snippet::ensureLoaded() const
+{
+    if (!yaml_ && !file_.empty()) {
+        yaml_ = std::make_shared<YAML::Node>(YAML::LoadFile(file_)["yaml"]);
+    }
+}
+
 void Snippet::setName(const std::string& name)
 {
     name_ = name;
@@ -115,6 +123,13 @@ Snippet Snippet::load(const std::string& file)
     return res;
 }
 
+Snippet Snippet::deferred(const std::string& file)
+{
+    Snippet res;
+    res.file_ = file;
+    return res;
+}
+
 uint8_t Snippet::getPacketType() const
 {
     return PACKET_TYPE_ID;
@@ -122,6 +137,7 @@ uint8_t Snippet::getPacketType() const
 
 void Snippet::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
+    ensureLoaded();
     data << *yaml_;
     data << name_;
     data << description_;
@@ -0,0 +1,206 @@
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/factory/node_factory_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/model/node_state.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/profiling/profiler.h>
+#include <csapex/scheduling/task.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+
+#include <csapex_testing/benchmark_graphs.h>
+#include <csapex_testing/benchmark_runner.h>
+#include <csapex_testing/csapex_test_case.h>
+#include <csapex_testing/test_exception_handler.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace csapex;
+
+class BenchmarkTest : public CsApexTestCase
+{
+protected:
+    BenchmarkTest() : factory(SettingsImplementation::NoSettings, nullptr)
+    {
+        registerBenchmarkNodes(factory);
+    }
+
+    std::string run(const std::string& name, int size, std::size_t messages)
+    {
+        ThreadPool executor(eh, true, true);
+
+        // the root graph is set up like in CsApexCore
+        NodeFacadeImplementationPtr root_facade = factory.makeGraph(UUIDProvider::makeUUID_without_parent("~"), std::make_shared<UUIDProvider>());
+        executor.add(root_facade->getNodeRunner().get());
+        SubgraphNodePtr graph_node = std::dynamic_pointer_cast<SubgraphNode>(root_facade->getNode());
+        GraphFacadeImplementation root(executor, graph_node->getLocalGraph(), graph_node, root_facade);
+        makeBenchmarkGraph(name, root, factory, size);
+
+        BenchmarkRunner runner(root, executor, name);
+        EXPECT_GT(runner.getNodeCount(), 2u);
+
+        graph_node->activation();
+        executor.start();
+        runner.startWindow();
+
+        auto start = std::chrono::steady_clock::now();
+        while (!runner.hasProcessed(messages) && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        runner.stopWindow();
+        EXPECT_TRUE(runner.hasProcessed(messages)) << name;
+
+        executor.stop();
+        root.clear();
+
+        std::stringstream json;
+        runner.writeJson(json);
+        return json.str();
+    }
+
+protected:
+    NodeFactoryImplementation factory;
+    TestExceptionHandler eh;
+};
+
+TEST_F(BenchmarkTest, AllCanonicalGraphsCanBeBuilt)
+{
+    // running every graph is left to csapex_bench
+    for (const std::string& name : getBenchmarkGraphNames()) {
+        ThreadPool executor(eh, false, false);
+        SubgraphNodePtr graph_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+        GraphFacadeImplementation root(executor, graph_node->getLocalGraph(), graph_node);
+        makeBenchmarkGraph(name, root, factory, 1);
+
+        EXPECT_GT(root.getLocalGraph()->countNodes(), 2u) << name;
+        root.clear();
+    }
+}
+
+TEST_F(BenchmarkTest, SmallGraphCanBeMeasured)
+{
+    std::string json = run("linear_chain", 1, 10);
+
+    EXPECT_NE(std::string::npos, json.find("\"graph\": \"linear_chain\"")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"sink\": true")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"wait\": {")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"idle\": {")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"thread_groups\": [")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"rss_kb\"")) << json;
+}
+
+TEST_F(BenchmarkTest, RateLimitedNodesCountMissedDeadlines)
+{
+    ThreadPool executor(eh, true, true);
+    executor.getDefaultGroup()->setDeadlineScheduling(true);
+
+    NodeFacadeImplementationPtr root_facade = factory.makeGraph(UUIDProvider::makeUUID_without_parent("~"), std::make_shared<UUIDProvider>());
+    executor.add(root_facade->getNodeRunner().get());
+    SubgraphNodePtr graph_node = std::dynamic_pointer_cast<SubgraphNode>(root_facade->getNode());
+    GraphFacadeImplementation root(executor, graph_node->getLocalGraph(), graph_node, root_facade);
+    makeBenchmarkGraph("linear_chain", root, factory, 1);
+
+    NodeFacadeImplementationPtr source;
+    for (const NodeFacadeImplementationPtr& node : root.getLocalGraph()->getAllLocalNodeFacades()) {
+        if (node->getType() == "MockupSource") {
+            source = node;
+        }
+    }
+    ASSERT_NE(nullptr, source);
+    source->getNodeState()->setMaximumFrequency(1000.0);
+
+    BenchmarkRunner runner(root, executor, "linear_chain");
+    auto misses = [&]() { return source->getProfiler()->getProfile(source->getUUID().getFullName()).getCounter(NodeRunner::DEADLINE_MISSES); };
+
+    graph_node->activation();
+    executor.start();
+    runner.startWindow();
+
+    auto start = std::chrono::steady_clock::now();
+    while (!runner.hasProcessed(5) && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(runner.hasProcessed(5));
+
+    // a long task in the same group keeps the source from finishing its next cycle within one period
+    executor.getDefaultGroup()->schedule(std::make_shared<Task>("block", []() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+
+    start = std::chrono::steady_clock::now();
+    while (misses() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    runner.stopWindow();
+
+    executor.stop();
+    root.clear();
+
+    EXPECT_GT(misses(), 0);
+
+    std::stringstream json;
+    runner.writeJson(json);
+    EXPECT_NE(std::string::npos, json.str().find("\"deadline_misses\": ")) << json.str();
+    EXPECT_NE(std::string::npos, json.str().find("\"deadline_scheduling\": true")) << json.str();
+}
+
+TEST_F(BenchmarkTest, RateLimitedNodesKeepTheirDelayWhenTheirGroupChanges)
+{
+    ThreadPool executor(eh, true, true);
+
+    NodeFacadeImplementationPtr root_facade = factory.makeGraph(UUIDProvider::makeUUID_without_parent("~"), std::make_shared<UUIDProvider>());
+    executor.add(root_facade->getNodeRunner().get());
+    SubgraphNodePtr graph_node = std::dynamic_pointer_cast<SubgraphNode>(root_facade->getNode());
+    GraphFacadeImplementation root(executor, graph_node->getLocalGraph(), graph_node, root_facade);
+    makeBenchmarkGraph("linear_chain", root, factory, 1);
+
+    NodeFacadeImplementationPtr source;
+    for (const NodeFacadeImplementationPtr& node : root.getLocalGraph()->getAllLocalNodeFacades()) {
+        if (node->getType() == "MockupSource") {
+            source = node;
+        }
+    }
+    ASSERT_NE(nullptr, source);
+    source->getNodeState()->setMaximumFrequency(4.0);
+
+    BenchmarkRunner runner(root, executor, "linear_chain");
+    graph_node->activation();
+    executor.start();
+    runner.startWindow();
+
+    // from the second message on, the source waits for its next cycle in the timed queue
+    auto start = std::chrono::steady_clock::now();
+    while (!runner.hasProcessed(2) && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(runner.hasProcessed(2));
+    auto second = std::chrono::steady_clock::now();
+
+    executor.createNewGroupFor(source->getNodeRunner().get(), "other");
+    EXPECT_NE(executor.getDefaultGroup(), executor.getGroupFor(source->getNodeRunner().get()));
+
+    while (!runner.hasProcessed(3) && std::chrono::steady_clock::now() - second < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto third = std::chrono::steady_clock::now();
+    runner.stopWindow();
+
+    executor.stop();
+    root.clear();
+
+    // one period is 250 ms, the margin covers the polling above
+    ASSERT_TRUE(runner.hasProcessed(3));
+    EXPECT_GE(third - second, std::chrono::milliseconds(200));
+}
+
+TEST_F(BenchmarkTest, UnknownGraphsAreRejected)
+{
+    EXPECT_FALSE(isBenchmarkGraph("does_not_exist"));
+
+    ThreadPool executor(eh, false, false);
+    SubgraphNodePtr graph_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+    GraphFacadeImplementation root(executor, graph_node->getLocalGraph(), graph_node);
+    EXPECT_THROW(makeBenchmarkGraph("does_not_exist", root, factory, 1), std::invalid_argument);
+}
@@ -0,0 +1,204 @@
+#include <csapex/model/graph_facade.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_state.h>
+#include <csapex/core/graphio.h>
+#include <csapex/core/graph_binary_format.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class BinaryGraphTest : public SteppingTest
+{
+protected:
+    /**
+     * @brief buildGraph creates two sources that feed a multiplier inside of a subgraph, save is called while the graph exists
+     */
+    void buildGraph(const std::function<void(GraphFacadeImplementation&)>& save)
+    {
+        graph_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+        graph = graph_node->getLocalGraph();
+
+        GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+        NodeFacadeImplementationPtr src1 = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src1"), graph);
+        main_graph_facade.addNode(src1);
+
+        NodeFacadeImplementationPtr src2 = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src2"), graph);
+        main_graph_facade.addNode(src2);
+
+        NodeFacadeImplementationPtr combiner = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent("combiner"), graph);
+        main_graph_facade.addNode(combiner);
+
+        NodeFacadeImplementationPtr sink = factory.makeNode("MockupSink", UUIDProvider::makeUUID_without_parent("Sink"), graph);
+        main_graph_facade.addNode(sink);
+        sink->getNodeState()->setLabel("the sink");
+        sink->getNodeState()->setPos(Point(42, -23));
+
+        NodeFacadeImplementationPtr sub_graph_node_facade = factory.makeNode("csapex::Graph", graph->generateUUID("subgraph"), graph);
+        SubgraphNodePtr sub_graph = std::dynamic_pointer_cast<SubgraphNode>(sub_graph_node_facade->getNode());
+        apex_assert_hard(sub_graph);
+
+        GraphFacadeImplementation sub_graph_facade(executor, sub_graph->getLocalGraph(), sub_graph);
+
+        NodeFacadeImplementationPtr m = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent("m"), sub_graph->getLocalGraph());
+        sub_graph_facade.addNode(m);
+        graph->addNode(sub_graph_node_facade);
+
+        auto type = makeEmpty<connection_types::GenericValueMessage<int> >();
+
+        auto in1_map = sub_graph->addForwardingInput(type, "forwarding", false);
+        auto in2_map = sub_graph->addForwardingInput(type, "forwarding", false);
+        auto out_map = sub_graph->addForwardingOutput(type, "forwarding");
+
+        sub_graph_facade.connect(in1_map.internal, m, "input_a");
+        sub_graph_facade.connect(in2_map.internal, m, "input_b");
+        sub_graph_facade.connect(m, "output", out_map.internal);
+
+        main_graph_facade.connect(combiner, "output", sink, "input");
+
+        main_graph_facade.connect(src1, "output", in1_map.external);
+        main_graph_facade.connect(src2, "output", in2_map.external);
+        main_graph_facade.connect(out_map.external, combiner, "input_a");
+        main_graph_facade.connect(out_map.external, combiner, "input_b");
+
+        save(main_graph_facade);
+    }
+
+    /**
+     * @brief loadGraph loads the graph built by buildGraph into an empty graph and checks that it still computes the same results
+     */
+    void loadGraph(const std::function<void(GraphFacadeImplementation&)>& load)
+    {
+        auto graph_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+        auto graph = graph_node->getLocalGraph();
+        GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+        load(main_graph_facade);
+
+        NodeFacadeImplementationPtr sink_p = std::dynamic_pointer_cast<NodeFacadeImplementation>(main_graph_facade.findNodeFacade(UUIDProvider::makeUUID_without_parent("Sink")));
+        ASSERT_NE(nullptr, sink_p);
+        ASSERT_EQ("the sink", sink_p->getNodeState()->getLabel());
+        ASSERT_EQ(Point(42, -23), sink_p->getNodeState()->getPos());
+
+        std::shared_ptr<MockupSink> sink = std::dynamic_pointer_cast<MockupSink>(sink_p->getNode());
+        ASSERT_NE(nullptr, sink);
+        executor.start();
+
+        ASSERT_EQ(-1, sink->getValue());
+        for (int iter = 0; iter < 23; ++iter) {
+            ASSERT_NO_FATAL_FAILURE(step());
+
+            ASSERT_EQ(std::pow(iter * iter, 2), sink->getValue());
+        }
+
+        executor.stop();
+    }
+};
+
+TEST_F(BinaryGraphTest, YamlTreeCanBeStored)
+{
+    YAML::Node yaml = YAML::Load("{a: 1, b: [x, \"y\", {c: !custom z}], d: ~, e: '" + std::string(70000, 'q') + "'}");
+
+    SerializationBuffer data;
+    GraphBinaryFormat::writeYaml(data, yaml);
+
+    YAML::Node restored;
+    GraphBinaryFormat::readYaml(data, restored);
+
+    ASSERT_EQ(data.size(), data.getPos());
+    ASSERT_EQ(1, restored["a"].as<int>());
+    ASSERT_EQ("y", restored["b"][1].as<std::string>());
+    ASSERT_EQ("!custom", restored["b"][2]["c"].Tag());
+    ASSERT_TRUE(restored["d"].IsNull());
+    ASSERT_EQ(70000u, restored["e"].as<std::string>().size());
+}
+
+TEST_F(BinaryGraphTest, HeaderIsChecked)
+{
+    SerializationBuffer data;
+    GraphBinaryFormat::writeHeader(data);
+    ASSERT_EQ(GraphBinaryFormat::VERSION, GraphBinaryFormat::readHeader(data));
+
+    SerializationBuffer invalid;
+    invalid << std::string("#!/usr/bin/csapex");
+    ASSERT_THROW(GraphBinaryFormat::readHeader(invalid), std::runtime_error);
+
+    ASSERT_TRUE(GraphBinaryFormat::isBinaryFile("/tmp/graph.apexbin"));
+    ASSERT_FALSE(GraphBinaryFormat::isBinaryFile("/tmp/graph.apex"));
+}
+
+TEST_F(BinaryGraphTest, GraphCanBeLoadedFromBinary)
+{
+    SerializationBuffer data;
+    YAML::Node view(YAML::NodeType::Map);
+
+    buildGraph([&](GraphFacadeImplementation& facade) {
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.saveGraphTo(data, view));
+    });
+
+    loadGraph([&](GraphFacadeImplementation& facade) {
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.loadGraphFrom(data, view));
+        ASSERT_EQ(data.size(), data.getPos());
+    });
+}
+
+TEST_F(BinaryGraphTest, YamlCanBeConvertedToBinary)
+{
+    YAML::Node yaml(YAML::NodeType::Map);
+
+    buildGraph([&](GraphFacadeImplementation& facade) {
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.saveGraphTo(yaml));
+    });
+
+    SerializationBuffer data;
+    GraphIO::convertToBinary(yaml, data);
+
+    loadGraph([&](GraphFacadeImplementation& facade) {
+        GraphBinaryFormat::readHeader(data);
+        YAML::Node view;
+        GraphBinaryFormat::readYaml(data, view);
+
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.loadGraphFrom(data, view));
+    });
+}
+
+TEST_F(BinaryGraphTest, BinaryCanBeConvertedToYaml)
+{
+    SerializationBuffer data;
+
+    buildGraph([&](GraphFacadeImplementation& facade) {
+        SerializationBuffer graph;
+        YAML::Node view(YAML::NodeType::Map);
+
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.saveGraphTo(graph, view));
+
+        GraphBinaryFormat::writeHeader(data);
+        GraphBinaryFormat::writeYaml(data, view);
+        GraphBinaryFormat::append(data, graph);
+    });
+
+    YAML::Node yaml;
+    GraphIO::convertToYaml(data, yaml);
+
+    // the conversion is lossless, another round trip has to yield the same document
+    SerializationBuffer converted;
+    GraphIO::convertToBinary(yaml, converted);
+    YAML::Node reconverted;
+    GraphIO::convertToYaml(converted, reconverted);
+    ASSERT_EQ(YAML::Dump(yaml), YAML::Dump(reconverted));
+
+    loadGraph([&](GraphFacadeImplementation& facade) {
+        GraphIO io(facade, &factory, true);
+        ASSERT_NO_THROW(io.loadGraphFrom(yaml));
+    });
+}
+
+}  // namespace csapex
@@ -414,3 +414,132 @@ TEST_F(BinarySerializationTest, VectorTest)
         ASSERT_EQ(10, vector->size());
     }
 }
+
+TEST_F(BinarySerializationTest, WireFormatIsCompatible)
+{
+    SerializationBuffer buffer;
+    buffer << static_cast<int32_t>(-123456);
+    buffer << static_cast<uint64_t>(0x0102030405060708ull);
+    buffer << -2.5f;
+    buffer << 3.14159f;
+    buffer << 1.0;
+    buffer << -1234.5678;
+    buffer << std::vector<float>{ 1.5f, -0.25f };
+    buffer << std::vector<int16_t>{ 1, -2, 300 };
+
+    // bytes as written by the element wise implementation
+    std::vector<uint8_t> expected{ 0xc0, 0x1d, 0xfe, 0xff, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0xa0, 0x00, 0x00, 0x80, 0x49, 0x0f, 0xd0, 0x80, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00,
+                                   0x00, 0x00, 0xc0, 0x93, 0x4a, 0x45, 0x6d, 0x5c, 0xfa, 0xad, 0x02, 0x40, 0x00, 0x00, 0x7f, 0x80, 0x00, 0x00, 0x7d, 0x03, 0x01, 0x00, 0xfe, 0xff, 0x2c, 0x01 };
+    ASSERT_EQ(expected.size() + SerializationBuffer::HEADER_LENGTH, buffer.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + SerializationBuffer::HEADER_LENGTH));
+
+    int32_t i;
+    uint64_t u;
+    float f1, f2;
+    double d1, d2;
+    std::vector<float> vf;
+    std::vector<int16_t> vi;
+    buffer >> i >> u >> f1 >> f2 >> d1 >> d2 >> vf >> vi;
+    EXPECT_EQ(-123456, i);
+    EXPECT_EQ(0x0102030405060708ull, u);
+    EXPECT_EQ(-2.5f, f1);
+    EXPECT_EQ(3.14159f, f2);
+    EXPECT_EQ(1.0, d1);
+    EXPECT_EQ(-1234.5678, d2);
+    EXPECT_EQ((std::vector<float>{ 1.5f, -0.25f }), vf);
+    EXPECT_EQ((std::vector<int16_t>{ 1, -2, 300 }), vi);
+}
+
+TEST_F(BinarySerializationTest, LargeVectorsUseAnEscapedLength)
+{
+    std::vector<double> doubles(1000);
+    std::vector<int32_t> ints(300);
+    for (std::size_t i = 0; i < doubles.size(); ++i) {
+        doubles[i] = i * -0.5;
+    }
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = static_cast<int32_t>(i) - 150;
+    }
+    std::vector<std::string> strings(256, "str");
+
+    SerializationBuffer buffer;
+    buffer << doubles << ints << strings;
+
+    // escape byte, 64 bit length and the raw little endian block
+    EXPECT_EQ(SerializationBuffer::LENGTH_ESCAPE, buffer.at(SerializationBuffer::HEADER_LENGTH));
+    EXPECT_EQ(1000u, buffer.at(SerializationBuffer::HEADER_LENGTH + 1) + (buffer.at(SerializationBuffer::HEADER_LENGTH + 2) << 8));
+
+    std::vector<double> doubles_in;
+    std::vector<int32_t> ints_in;
+    std::vector<std::string> strings_in;
+    buffer >> doubles_in >> ints_in >> strings_in;
+
+    EXPECT_EQ(doubles, doubles_in);
+    EXPECT_EQ(ints, ints_in);
+    EXPECT_EQ(strings, strings_in);
+}
+
+TEST_F(BinarySerializationTest, ReadingPastTheEndThrows)
+{
+    SerializationBuffer buffer;
+    buffer << static_cast<uint16_t>(1);
+
+    uint32_t value;
+    EXPECT_THROW(buffer >> value, std::out_of_range);
+}
+
+TEST_F(BinarySerializationTest, LargeVectorRoundTrip)
+{
+    // 8 MB of floats, roughly a dense point cloud
+    std::vector<float> cloud(2 * 1024 * 1024);
+    for (std::size_t i = 0; i < cloud.size(); ++i) {
+        cloud[i] = static_cast<float>(i) * 0.001f;
+    }
+
+    SerializationBuffer buffer;
+    buffer << cloud;
+
+    // escape byte, 64 bit length and one contiguous block without per element overhead
+    ASSERT_EQ(SerializationBuffer::HEADER_LENGTH + 1 + sizeof(uint64_t) + cloud.size() * sizeof(float), buffer.size());
+
+    std::vector<float> result;
+    buffer >> result;
+    ASSERT_EQ(cloud, result);
+}
+
+TEST_F(BinarySerializationTest, RegionBuffersSerializeInPlace)
+{
+    std::vector<uint8_t> memory(64);
+    auto region = std::make_shared<SerializationRegion>(memory.data(), memory.size());
+
+    {
+        SerializationBuffer buffer(region);
+        buffer << static_cast<uint32_t>(0xdeadbeef) << std::string("in place");
+        ASSERT_TRUE(buffer.isInRegion());
+        ASSERT_EQ(memory.data(), buffer.data());
+
+        // reading from the region does not copy either
+        SerializationBuffer view = SerializationBuffer::view(memory.data(), buffer.size());
+        ASSERT_EQ(memory.data(), view.data());
+
+        uint32_t number;
+        std::string text;
+        view >> number >> text;
+        EXPECT_EQ(0xdeadbeef, number);
+        EXPECT_EQ("in place", text);
+
+        // copies never share the region
+        SerializationBuffer copy(buffer);
+        EXPECT_FALSE(copy.isInRegion());
+    }
+    EXPECT_FALSE(region->used);
+
+    SerializationBuffer buffer(region);
+    buffer << std::string(128, 'x');
+    EXPECT_FALSE(buffer.isInRegion());
+    EXPECT_FALSE(region->used);
+
+    std::string text;
+    buffer >> text;
+    EXPECT_EQ(std::string(128, 'x'), text);
+}
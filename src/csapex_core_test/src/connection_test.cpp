@@ -8,6 +8,13 @@
 #include <csapex/signal/slot.h>
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/msg/direct_connection.h>
+#include <csapex/msg/no_message.h>
+#include <csapex/msg/any_message.h>
+#include <csapex/model/token.h>
+#include <csapex/model/connection_description.h>
+#include <csapex/model/fulcrum.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
 #include <csapex/utility/uuid_provider.h>
 #include <csapex/utility/exceptions.h>
 
@@ -291,3 +298,127 @@ TEST_F(ConnectionTest, DirectConnectionCanBeDeleted)
     auto raw_message = i->getToken();
     ASSERT_TRUE(raw_message == nullptr);
 }
+
+TEST_F(ConnectionTest, PayloadIsSharedBetweenConnections)
+{
+    OutputPtr o = std::make_shared<StaticOutput>(uuid_provider->makeUUID("out"));
+    InputPtr a = std::make_shared<Input>(uuid_provider->makeUUID("a"));
+    InputPtr b = std::make_shared<Input>(uuid_provider->makeUUID("b"));
+
+    ConnectionPtr ca = DirectConnection::connect(o, a);
+    ConnectionPtr cb = DirectConnection::connect(o, b);
+
+    GenericValueMessage<int>::Ptr msg(new GenericValueMessage<int>);
+    msg->value = 42;
+
+    o->addMessage(std::make_shared<Token>(msg));
+    o->commitMessages(false);
+    o->publish();
+
+    TokenPtr token_a = a->getToken();
+    TokenPtr token_b = b->getToken();
+    ASSERT_NE(nullptr, token_a);
+    ASSERT_NE(nullptr, token_b);
+
+    // every connection has its own metadata
+    EXPECT_NE(token_a, token_b);
+    EXPECT_EQ(o->getToken()->getSequenceNumber(), token_a->getSequenceNumber());
+
+    EXPECT_EQ(msg, token_a->getTokenData());
+    EXPECT_EQ(msg, token_b->getTokenData());
+}
+
+TEST_F(ConnectionTest, EmptyTokensShareAnImmutablePayload)
+{
+    TokenPtr a = makeEmptyToken<NoMessage>();
+    TokenPtr b = makeEmptyToken<NoMessage>();
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a->getTokenData(), b->getTokenData());
+    EXPECT_FALSE(a->isImmutable());
+
+    TokenPtr shared = getSharedEmptyToken<NoMessage>();
+    EXPECT_EQ(shared, getSharedEmptyToken<NoMessage>());
+    EXPECT_EQ(a->getTokenData(), shared->getTokenData());
+    EXPECT_TRUE(shared->isImmutable());
+
+    TokenPtr copy = shared->shallowClone();
+    EXPECT_FALSE(copy->isImmutable());
+    EXPECT_EQ(shared->getTokenData(), copy->getTokenData());
+}
+
+TEST_F(ConnectionTest, IdleOutputsSendTheSharedEmptyPayload)
+{
+    OutputPtr o = std::make_shared<StaticOutput>(uuid_provider->makeUUID("out"));
+    InputPtr i = std::make_shared<Input>(uuid_provider->makeUUID("in"));
+
+    ConnectionPtr connection = DirectConnection::connect(o, i);
+
+    EXPECT_EQ(getSharedEmptyToken<NoMessage>(), o->getToken());
+
+    o->commitMessages(false);
+    o->publish();
+
+    TokenPtr token = i->getToken();
+    ASSERT_NE(nullptr, token);
+    EXPECT_EQ(getEmptyTokenData<NoMessage>(), token->getTokenData());
+    EXPECT_EQ(o->getToken()->getSequenceNumber(), token->getSequenceNumber());
+}
+
+TEST_F(ConnectionTest, SharedTokensAreCopiedBeforeTheyAreCommitted)
+{
+    OutputPtr o = std::make_shared<StaticOutput>(uuid_provider->makeUUID("out"));
+    TokenPtr shared = getSharedEmptyToken<AnyMessage>();
+    int seq_no = shared->getSequenceNumber();
+
+    o->addMessage(shared);
+    o->commitMessages(true);
+
+    EXPECT_NE(shared, o->getToken());
+    EXPECT_EQ(shared->getTokenData(), o->getToken()->getTokenData());
+    EXPECT_EQ(seq_no, shared->getSequenceNumber());
+}
+
+TEST_F(ConnectionTest, DescriptionKeepsItsQueueSettings)
+{
+    ConnectionDescription description(uuid_provider->makeUUID("out"), uuid_provider->makeUUID("in"), makeEmpty<AnyMessage>(), 3, true, {});
+    description.queue_capacity = 4;
+    description.queue_policy = QueuePolicy::DROP_OLDEST;
+
+    SerializationBuffer buffer;
+    buffer << description;
+
+    ConnectionDescription received;
+    buffer >> received;
+
+    EXPECT_EQ(description.from, received.from);
+    EXPECT_EQ(description.to, received.to);
+    EXPECT_EQ(3, received.id);
+    EXPECT_EQ(4u, received.queue_capacity);
+    EXPECT_EQ(QueuePolicy::DROP_OLDEST, received.queue_policy);
+}
+
+TEST_F(ConnectionTest, DescriptionsWithoutQueueSettingsCanBeRead)
+{
+    UUID from = uuid_provider->makeUUID("out");
+    UUID to = uuid_provider->makeUUID("in");
+
+    // layout written before the queue settings existed
+    SerializationBuffer buffer;
+    buffer << SemanticVersion();
+    buffer << from << to << std::string("") << std::string("") << makeEmpty<AnyMessage>() << 3 << true << std::vector<Fulcrum>();
+    buffer << std::string("next");
+
+    ConnectionDescription received;
+    buffer >> received;
+
+    EXPECT_EQ(from, received.from);
+    EXPECT_EQ(to, received.to);
+    EXPECT_EQ(3, received.id);
+    EXPECT_TRUE(received.active);
+    EXPECT_EQ(1u, received.queue_capacity);
+    EXPECT_EQ(QueuePolicy::BLOCK, received.queue_policy);
+
+    std::string next;
+    buffer >> next;
+    EXPECT_EQ("next", next);
+}
@@ -0,0 +1,280 @@
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_characteristics.h>
+#include <csapex/model/connection.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/node_constructing_test.h>
+
+namespace csapex
+{
+class NothingProcessingSink : public MockupSink
+{
+public:
+    bool processNothingMarkers() const override
+    {
+        return true;
+    }
+};
+
+class GraphAnalysisTest : public NodeConstructingTest
+{
+protected:
+    void SetUp() override
+    {
+        NodeConstructingTest::SetUp();
+
+        factory.registerNodeType(std::make_shared<NodeConstructor>("NothingProcessingSink", []() { return std::make_shared<NothingProcessingSink>(); }));
+    }
+
+    NodeFacadeImplementationPtr add(GraphFacadeImplementation& facade, const std::string& type, const std::string& name)
+    {
+        NodeFacadeImplementationPtr node = factory.makeNode(type, UUIDProvider::makeUUID_without_parent(name), facade.getLocalGraph());
+        facade.addNode(node);
+        return node;
+    }
+
+    int component(const NodeFacadeImplementationPtr& node)
+    {
+        return graph->getComponent(node->getUUID());
+    }
+
+    int depth(const NodeFacadeImplementationPtr& node)
+    {
+        return graph->getDepth(node->getUUID());
+    }
+
+    struct Snapshot
+    {
+        std::vector<int> components;
+        std::vector<NodeCharacteristics> characteristics;
+    };
+
+    Snapshot snapshot()
+    {
+        Snapshot s;
+        for (const graph::VertexPtr& vertex : *graph) {
+            s.components.push_back(vertex->getNodeCharacteristics().component);
+            s.characteristics.push_back(vertex->getNodeCharacteristics());
+        }
+        return s;
+    }
+
+    void expectSameAnalysis(const Snapshot& incremental, const Snapshot& full)
+    {
+        ASSERT_EQ(incremental.characteristics.size(), full.characteristics.size());
+        for (std::size_t i = 0; i < full.characteristics.size(); ++i) {
+            // component ids are arbitrary, only the partition has to match
+            for (std::size_t j = 0; j < full.characteristics.size(); ++j) {
+                EXPECT_EQ(full.components[i] == full.components[j], incremental.components[i] == incremental.components[j]);
+            }
+
+            const NodeCharacteristics& a = incremental.characteristics[i];
+            const NodeCharacteristics& b = full.characteristics[i];
+            EXPECT_EQ(b.depth, a.depth);
+            EXPECT_EQ(b.is_joining_vertex, a.is_joining_vertex);
+            EXPECT_EQ(b.is_joining_vertex_counterpart, a.is_joining_vertex_counterpart);
+            EXPECT_EQ(b.is_combined_by_joining_vertex, a.is_combined_by_joining_vertex);
+            EXPECT_EQ(b.is_leading_to_joining_vertex, a.is_leading_to_joining_vertex);
+            EXPECT_EQ(b.is_leading_to_essential_vertex, a.is_leading_to_essential_vertex);
+        }
+    }
+
+    void expectMatchesFullAnalysis()
+    {
+        Snapshot incremental = snapshot();
+        graph->analyzeGraph();
+        expectSameAnalysis(incremental, snapshot());
+    }
+};
+
+TEST_F(GraphAnalysisTest, ComponentsAreMergedAndSplit)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    NodeFacadeImplementationPtr a = add(main_graph_facade, "MockupSource", "a");
+    NodeFacadeImplementationPtr b = add(main_graph_facade, "StaticMultiplier", "b");
+    NodeFacadeImplementationPtr c = add(main_graph_facade, "StaticMultiplier", "c");
+    NodeFacadeImplementationPtr d = add(main_graph_facade, "MockupSink", "d");
+
+    main_graph_facade.connect(a, "output", b, "input");
+    main_graph_facade.connect(c, "output", d, "input");
+
+    ASSERT_EQ(component(a), component(b));
+    ASSERT_EQ(component(c), component(d));
+    ASSERT_NE(component(a), component(c));
+    ASSERT_EQ(1, depth(b));
+    ASSERT_EQ(0, depth(c));
+    ASSERT_EQ(1, depth(d));
+
+    ConnectionPtr bridge = main_graph_facade.connect(b, "output", c, "input");
+
+    ASSERT_EQ(component(a), component(d));
+    ASSERT_EQ(2, depth(c));
+    ASSERT_EQ(3, depth(d));
+    expectMatchesFullAnalysis();
+
+    graph->deleteConnection(bridge);
+
+    ASSERT_EQ(component(a), component(b));
+    ASSERT_EQ(component(c), component(d));
+    ASSERT_NE(component(a), component(c));
+    ASSERT_EQ(0, depth(c));
+    ASSERT_EQ(1, depth(d));
+    expectMatchesFullAnalysis();
+}
+
+TEST_F(GraphAnalysisTest, DeletingANodeSplitsItsComponent)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    NodeFacadeImplementationPtr a = add(main_graph_facade, "MockupSource", "a");
+    NodeFacadeImplementationPtr b = add(main_graph_facade, "StaticMultiplier", "b");
+    NodeFacadeImplementationPtr c = add(main_graph_facade, "MockupSink", "c");
+
+    main_graph_facade.connect(a, "output", b, "input");
+    main_graph_facade.connect(b, "output", c, "input");
+    ASSERT_EQ(component(a), component(c));
+
+    {
+        GraphTransaction transaction(*graph);
+        for (const ConnectionPtr& connection : graph->getConnections()) {
+            graph->deleteConnection(connection);
+        }
+        graph->deleteNode(b->getUUID());
+    }
+
+    ASSERT_NE(component(a), component(c));
+    ASSERT_EQ(0, depth(c));
+    expectMatchesFullAnalysis();
+}
+
+TEST_F(GraphAnalysisTest, IncrementalAnalysisMatchesFullAnalysis)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    // two streams that are joined and split again
+    NodeFacadeImplementationPtr src = add(main_graph_facade, "MockupSource", "src");
+    NodeFacadeImplementationPtr left = add(main_graph_facade, "StaticMultiplier", "left");
+    NodeFacadeImplementationPtr right = add(main_graph_facade, "StaticMultiplier", "right");
+    NodeFacadeImplementationPtr join = add(main_graph_facade, "DynamicMultiplier", "join");
+    NodeFacadeImplementationPtr sink = add(main_graph_facade, "MockupSink", "sink");
+    NodeFacadeImplementationPtr other = add(main_graph_facade, "MockupSource", "other");
+    NodeFacadeImplementationPtr other_sink = add(main_graph_facade, "AnySink", "other_sink");
+    expectMatchesFullAnalysis();
+
+    std::vector<ConnectionPtr> connections;
+    connections.push_back(main_graph_facade.connect(src, "output", left, "input"));
+    expectMatchesFullAnalysis();
+    connections.push_back(main_graph_facade.connect(src, "output", right, "input"));
+    expectMatchesFullAnalysis();
+    connections.push_back(main_graph_facade.connect(left, "output", join, "input_a"));
+    expectMatchesFullAnalysis();
+    connections.push_back(main_graph_facade.connect(right, "output", join, "input_b"));
+    expectMatchesFullAnalysis();
+    connections.push_back(main_graph_facade.connect(join, "output", sink, "input"));
+    expectMatchesFullAnalysis();
+    connections.push_back(main_graph_facade.connect(other, "output", other_sink, "input"));
+    expectMatchesFullAnalysis();
+
+    ASSERT_TRUE(left->getNodeCharacteristics().is_leading_to_joining_vertex);
+    ASSERT_TRUE(join->getNodeCharacteristics().is_joining_vertex);
+    ASSERT_TRUE(src->getNodeCharacteristics().is_joining_vertex_counterpart);
+
+    for (const ConnectionPtr& connection : connections) {
+        graph->deleteConnection(connection);
+        expectMatchesFullAnalysis();
+    }
+
+    graph->deleteNode(join->getUUID());
+    expectMatchesFullAnalysis();
+}
+
+TEST_F(GraphAnalysisTest, NestedTransactionsAreAnalyzedOnce)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    int analyses = 0;
+    slim_signal::ScopedConnection observation = graph->state_changed.connect([&analyses]() { ++analyses; });
+
+    graph->beginTransaction();
+    graph->beginTransaction();
+
+    NodeFacadeImplementationPtr a = add(main_graph_facade, "MockupSource", "a");
+    NodeFacadeImplementationPtr b = add(main_graph_facade, "StaticMultiplier", "b");
+    main_graph_facade.connect(a, "output", b, "input");
+
+    // components are maintained right away, only the characteristics are deferred
+    ASSERT_EQ(component(a), component(b));
+
+    graph->finalizeTransaction();
+    ASSERT_TRUE(graph->isInTransaction());
+    ASSERT_EQ(0, analyses);
+
+    graph->finalizeTransaction();
+    ASSERT_FALSE(graph->isInTransaction());
+    ASSERT_EQ(1, analyses);
+    ASSERT_EQ(1, depth(b));
+}
+
+TEST_F(GraphAnalysisTest, TransactionIsFinalizedWhenItsGuardIsLeft)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    int analyses = 0;
+    slim_signal::ScopedConnection observation = graph->state_changed.connect([&analyses]() { ++analyses; });
+
+    try {
+        GraphTransaction transaction(graph);
+        NodeFacadeImplementationPtr a = add(main_graph_facade, "MockupSource", "a");
+        NodeFacadeImplementationPtr b = add(main_graph_facade, "StaticMultiplier", "b");
+        main_graph_facade.connect(a, "output", b, "input");
+
+        ASSERT_TRUE(graph->isInTransaction());
+        ASSERT_EQ(0, analyses);
+        throw std::runtime_error("abort");
+
+    } catch (const std::runtime_error&) {
+    }
+
+    ASSERT_FALSE(graph->isInTransaction());
+    ASSERT_EQ(1, analyses);
+    expectMatchesFullAnalysis();
+
+    // without a graph, the guard does nothing
+    GraphTransaction nothing(GraphImplementationPtr{});
+    ASSERT_FALSE(graph->isInTransaction());
+}
+
+TEST_F(GraphAnalysisTest, EssentialVerticesAreTracedIntoTheParentGraph)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    NodeFacadeImplementationPtr src = add(main_graph_facade, "MockupSource", "src");
+
+    NodeFacadeImplementationPtr sub_graph_node_facade = factory.makeNode("csapex::Graph", graph->generateUUID("subgraph"), graph);
+    SubgraphNodePtr sub_graph = std::dynamic_pointer_cast<SubgraphNode>(sub_graph_node_facade->getNode());
+    ASSERT_NE(nullptr, sub_graph);
+    GraphFacadeImplementation sub_graph_facade(executor, sub_graph->getLocalGraph(), sub_graph);
+    main_graph_facade.addNode(sub_graph_node_facade);
+
+    NodeFacadeImplementationPtr sink = add(sub_graph_facade, "NothingProcessingSink", "sink");
+
+    auto in_map = sub_graph->addForwardingInput(makeEmpty<connection_types::GenericValueMessage<int>>(), "forwarding", false);
+    main_graph_facade.connect(src, "output", in_map.external);
+    ASSERT_FALSE(src->getNodeCharacteristics().is_leading_to_essential_vertex);
+
+    // the subgraph is analyzed on its own, the sink still needs the messages of the parent graph
+    sub_graph_facade.connect(in_map.internal, sink, "input");
+
+    ASSERT_TRUE(sink->getNodeCharacteristics().is_leading_to_essential_vertex);
+    ASSERT_TRUE(sub_graph_node_facade->getNodeCharacteristics().is_leading_to_essential_vertex);
+    ASSERT_TRUE(src->getNodeCharacteristics().is_leading_to_essential_vertex);
+}
+
+}  // namespace csapex
@@ -133,6 +133,27 @@ TEST_F(GraphTest, NodeCanBeDeleted)
     ASSERT_THROW(graph->findNode(node_id), Graph::NodeNotFoundException);
 }
 
+TEST_F(GraphTest, ConnectorOfDeletedNodeCannotBeFound)
+{
+    SubgraphNodePtr graph_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+    GraphImplementationPtr graph = graph_node->getLocalGraph();
+    UUID node_id = UUIDProvider::makeUUID_without_parent("foobarbaz");
+    NodeFacadeImplementationPtr node = factory.makeNode("MockupNode", node_id, graph);
+    graph->addNode(node);
+
+    MockupNode* mnode = dynamic_cast<MockupNode*>(node->getNode().get());
+    ASSERT_NE(nullptr, mnode);
+    UUID connector_id = mnode->test_input->getUUID();
+
+    ConnectorPtr connector_found = graph->findConnectorNoThrow(connector_id);
+    ASSERT_NE(nullptr, connector_found);
+    ASSERT_EQ(mnode->test_input, dynamic_cast<Input*>(connector_found.get()));
+
+    graph->deleteNode(node_id);
+
+    ASSERT_EQ(nullptr, graph->findConnectorNoThrow(connector_id));
+}
+
 TEST_F(GraphTest, UnknownNodeCannotBeFound)
 {
     SubgraphNode graph_node(std::make_shared<GraphImplementation>());
@@ -0,0 +1,142 @@
+#include <csapex/profiling/latency_histogram.h>
+#include <csapex/profiling/profiler_impl.h>
+#include <csapex/profiling/timer.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/csapex_io.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace csapex;
+
+class LatencyHistogramTest : public CsApexTestCase
+{
+};
+
+TEST_F(LatencyHistogramTest, SmallValuesAreCountedExactly)
+{
+    LatencyHistogram hist;
+    for (uint64_t v = 1; v <= 100; ++v) {
+        hist.record(v);
+    }
+
+    EXPECT_EQ(100u, hist.count());
+    EXPECT_EQ(100u, hist.max());
+    EXPECT_DOUBLE_EQ(50.5, hist.mean());
+    EXPECT_EQ(50u, hist.percentile(50.0));
+    EXPECT_EQ(99u, hist.percentile(99.0));
+    EXPECT_EQ(100u, hist.percentile(100.0));
+}
+
+TEST_F(LatencyHistogramTest, BucketsAreContiguous)
+{
+    std::size_t last = 0;
+    for (uint64_t v = 0; v < (1u << 16); ++v) {
+        std::size_t index = LatencyHistogram::getBucketIndex(v);
+        ASSERT_TRUE(index == last || index == last + 1) << v;
+        ASSERT_LE(v, LatencyHistogram::getBucketUpperBound(index));
+        last = index;
+    }
+}
+
+TEST_F(LatencyHistogramTest, LargeValuesHaveBoundedRelativeError)
+{
+    LatencyHistogram hist;
+    const uint64_t n = 1000000;
+    for (uint64_t v = 1; v <= n; ++v) {
+        hist.record(v);
+    }
+
+    const double tolerance = 1.0 / (1 << (LatencyHistogram::SUB_BUCKET_BITS - 1));
+    for (double p : { 50.0, 90.0, 99.0, 99.9 }) {
+        double exact = p / 100.0 * n;
+        double reported = hist.percentile(p);
+        EXPECT_GE(reported, exact) << p;
+        EXPECT_LE(reported, exact * (1.0 + tolerance)) << p;
+    }
+    EXPECT_EQ(n, hist.percentile(100.0));
+}
+
+TEST_F(LatencyHistogramTest, OutliersShowUpInTheTail)
+{
+    LatencyHistogram hist;
+    for (int i = 0; i < 999; ++i) {
+        hist.record(100);
+    }
+    hist.record(250000);
+
+    EXPECT_EQ(100u, hist.percentile(50.0));
+    EXPECT_EQ(100u, hist.percentile(99.0));
+    EXPECT_EQ(250000u, hist.percentile(99.99));
+    EXPECT_EQ(250000u, hist.max());
+}
+
+TEST_F(LatencyHistogramTest, HistogramsCanBeMergedAndReset)
+{
+    LatencyHistogram a, b;
+    a.record(10);
+    b.record(20000);
+    a.merge(b);
+
+    EXPECT_EQ(2u, a.count());
+    EXPECT_EQ(20000u, a.max());
+
+    a.reset();
+    EXPECT_EQ(0u, a.count());
+    EXPECT_EQ(0u, a.percentile(99.0));
+}
+
+TEST_F(LatencyHistogramTest, HistogramCanBeSerialized)
+{
+    LatencyHistogram hist;
+    for (uint64_t v = 1; v < 5000; v += 7) {
+        hist.record(v * v);
+    }
+
+    SerializationBuffer buffer;
+    buffer << hist;
+
+    LatencyHistogram restored;
+    buffer >> restored;
+
+    EXPECT_EQ(hist.count(), restored.count());
+    EXPECT_EQ(hist.max(), restored.max());
+    EXPECT_DOUBLE_EQ(hist.mean(), restored.mean());
+    for (double p : { 50.0, 99.0, 99.9 }) {
+        EXPECT_EQ(hist.percentile(p), restored.percentile(p));
+    }
+}
+
+TEST_F(LatencyHistogramTest, ProfileReportsPercentilesPerStep)
+{
+    ProfilerImplementation profiler(true, 4);
+    Timer::Ptr timer = profiler.getTimer("node");
+
+    for (int i = 0; i < 10; ++i) {
+        timer->restart();
+        {
+            Interlude::Ptr step = timer->step("work");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        timer->finish();
+    }
+
+    const Profile& profile = profiler.getProfile("node");
+    ProfilerStats stats = profile.getStats("work");
+    EXPECT_EQ(10u, stats.count);
+    EXPECT_GE(stats.p50, 1.0);
+    EXPECT_LE(stats.p50, stats.p99);
+    EXPECT_LE(stats.p99, stats.p999);
+    EXPECT_LE(stats.p999, stats.max);
+
+    std::size_t intervals = profile.count();
+    bool window_reset = false;
+    profiler.window_reset.connect([&]() { window_reset = true; });
+    profiler.resetWindow();
+
+    EXPECT_TRUE(window_reset);
+    EXPECT_EQ(0u, profile.getHistogram("work").count());
+    EXPECT_EQ(intervals, profile.count());
+}
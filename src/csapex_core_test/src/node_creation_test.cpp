@@ -15,6 +15,10 @@
 
 #include <csapex_testing/csapex_test_case.h>
 
+#include <mutex>
+#include <set>
+#include <thread>
+
 using namespace csapex;
 using namespace connection_types;
 
@@ -46,9 +50,12 @@ protected:
     NodeCreationTest() : factory(SettingsImplementation::NoSettings, nullptr), uuid_provider(std::make_shared<UUIDProvider>())
     {
         csapex::NodeConstructor::Ptr mockup_constructor(new csapex::NodeConstructor("MockupNode", std::bind(&NodeCreationTest::makeMockup)));
+        mockup_constructor->setConcurrentLoading(true);
         factory.registerNodeType(mockup_constructor);
 
-        factory.registerNodeType(GenericNodeFactory::createConstructorFromFunction(functionToBeWrappedIntoANode, "WrappedFunctionNode"));
+        csapex::NodeConstructor::Ptr wrapped_constructor = GenericNodeFactory::createConstructorFromFunction(functionToBeWrappedIntoANode, "WrappedFunctionNode");
+        wrapped_constructor->setConcurrentLoading(true);
+        factory.registerNodeType(wrapped_constructor);
     }
 
     virtual ~NodeCreationTest()
@@ -165,3 +172,53 @@ TEST_F(NodeCreationTest, GenericNodeCallsFunctionCorrectly)
 
     ASSERT_EQ(42, result->value);
 }
+
+TEST_F(NodeCreationTest, NodesCanBeMadeConcurrently)
+{
+    std::vector<std::pair<std::string, UUID>> requests;
+    for (int i = 0; i < 64; ++i) {
+        requests.emplace_back(i % 2 == 0 ? "MockupNode" : "WrappedFunctionNode", UUIDProvider::makeUUID_without_parent("node_" + std::to_string(i)));
+    }
+    requests.emplace_back("UnknownNode", UUIDProvider::makeUUID_without_parent("unknown"));
+
+    std::vector<NodeFacadeImplementationPtr> constructed;
+    factory.node_constructed.connect([&](NodeFacadePtr node) { constructed.push_back(std::dynamic_pointer_cast<NodeFacadeImplementation>(node)); });
+
+    std::vector<NodeFacadeImplementationPtr> nodes = factory.makeNodes(requests, uuid_provider, 4);
+    ASSERT_EQ(requests.size(), nodes.size());
+    ASSERT_EQ(nullptr, nodes.back());
+
+    // the results and the notifications follow the order of the requests, independent of the threads
+    ASSERT_EQ(requests.size() - 1, constructed.size());
+    for (std::size_t i = 0; i < constructed.size(); ++i) {
+        ASSERT_NE(nullptr, nodes[i]);
+        ASSERT_EQ(requests[i].second, nodes[i]->getUUID());
+        ASSERT_EQ(requests[i].first, nodes[i]->getType());
+        ASSERT_EQ(nodes[i], constructed[i]);
+    }
+}
+
+TEST_F(NodeCreationTest, TypesWithoutConcurrentLoadingAreMadeByTheCallingThread)
+{
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    factory.registerNodeType(std::make_shared<NodeConstructor>("SerialNode", [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        return makeMockup();
+    }));
+
+    std::vector<std::pair<std::string, UUID>> requests;
+    for (int i = 0; i < 16; ++i) {
+        requests.emplace_back("SerialNode", UUIDProvider::makeUUID_without_parent("node_" + std::to_string(i)));
+    }
+
+    std::vector<NodeFacadeImplementationPtr> nodes = factory.makeNodes(requests, uuid_provider, 4);
+    ASSERT_EQ(requests.size(), nodes.size());
+    for (const NodeFacadeImplementationPtr& node : nodes) {
+        EXPECT_NE(nullptr, node);
+    }
+
+    ASSERT_EQ(1u, threads.size());
+    EXPECT_EQ(std::this_thread::get_id(), *threads.begin());
+}
@@ -138,6 +138,40 @@ TEST_F(NodeWorkerTest, SubprocessNodeWorkerWorks)
     runSyncTest(times_4, 42);
 }
 
+TEST_F(NodeWorkerTest, SubprocessRoundTripKeepsTheSequenceNumber)
+{
+    NodeStatePtr state = std::make_shared<NodeState>(nullptr);
+    state->setExecutionType(ExecutionType::SUBPROCESS);
+    NodeFacadeImplementationPtr times_4 = factory.makeNode("StaticMultiplier4", UUIDProvider::makeUUID_without_parent("StaticMultiplier4"), graph, state);
+    NodeHandle& nh = *times_4->getNodeHandle();
+
+    OutputPtr tmp_out = std::make_shared<StaticOutput>(UUIDProvider::makeUUID_without_parent("tmp_out"));
+    InputPtr input = nh.getInput(UUIDProvider::makeUUID_without_parent("StaticMultiplier4:|:in_0"));
+    ASSERT_NE(nullptr, input);
+    OutputPtr output = nh.getOutput(UUIDProvider::makeUUID_without_parent("StaticMultiplier4:|:out_0"));
+    ASSERT_NE(nullptr, output);
+    ConnectionPtr connection = DirectConnection::connect(tmp_out, input);
+
+    // the next token sent to the child is number 42
+    tmp_out->setSequenceNumber(41);
+    msg::publish(tmp_out.get(), 23);
+    tmp_out->commitMessages(false);
+    tmp_out->publish();
+
+    ASSERT_TRUE(times_4->canProcess());
+    ASSERT_TRUE(times_4->startProcessingMessages());
+
+    // the token made by the child comes back with the number of its input
+    TokenPtr token_out = output->getToken();
+    ASSERT_NE(nullptr, token_out);
+    auto msg_out = std::dynamic_pointer_cast<connection_types::GenericValueMessage<int> const>(token_out->getTokenData());
+    ASSERT_NE(nullptr, msg_out);
+    EXPECT_EQ(23 * 4, msg_out->value);
+    EXPECT_EQ(42, token_out->getSequenceNumber());
+
+    input->removeConnection(tmp_out.get());
+}
+
 TEST_F(NodeWorkerTest, NodeWorkerCanBeSwappedOnTheFly)
 {
     NodeFacadeImplementationPtr times_4 = factory.makeNode("StaticMultiplier4", UUIDProvider::makeUUID_without_parent("StaticMultiplier4"), graph);
@@ -157,6 +157,122 @@ TEST_F(OutputAllocationTest, AllocatorCanBeSet)
     EXPECT_STREQ("frame", msgptr->frame_id.c_str());
 }
 
+TEST_F(OutputAllocationTest, PooledMessagesAreReusedOnceReleased)
+{
+    using M = connection_types::GenericValueMessage<std::vector<int>>;
+
+    MessageAllocator allocator;
+    allocator.setPooling(true);
+    ASSERT_TRUE(allocator.isPooling());
+
+    M::Ptr first = allocator.allocate<M>(std::vector<int>(1000, 23), "frame");
+    ASSERT_NE(nullptr, first);
+    M* first_address = first.get();
+    const int* first_buffer = first->value.data();
+
+    M::Ptr held = allocator.allocate<M>();
+    EXPECT_NE(first_address, held.get());
+
+    first.reset();
+
+    M::Ptr second = allocator.allocate<M>();
+    EXPECT_EQ(first_address, second.get());
+    EXPECT_TRUE(second->value.empty());
+    EXPECT_GE(second->value.capacity(), 1000u);
+    EXPECT_STREQ("/", second->frame_id.c_str());
+
+    second->value.resize(1000, 42);
+    EXPECT_EQ(first_buffer, second->value.data());
+
+    MessagePool::Statistics stats = allocator.getPoolStatistics();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+    EXPECT_EQ(1u, stats.recycled);
+    EXPECT_EQ(0u, stats.dropped);
+}
+
+TEST_F(OutputAllocationTest, StorageOfPooledTokensIsReused)
+{
+    MessageAllocator allocator;
+    allocator.setPooling(true);
+
+    auto data = allocator.allocate<connection_types::GenericValueMessage<int>>(42);
+    TokenPtr token = allocator.allocateToken(data);
+    Token* address = token.get();
+    token.reset();
+
+    token = allocator.allocateToken(data);
+    EXPECT_EQ(address, token.get());
+    EXPECT_EQ(data, token->getTokenData());
+
+    MessagePool::Statistics stats = allocator.getPoolStatistics();
+    EXPECT_EQ(1u, stats.hits);
+}
+
+TEST_F(OutputAllocationTest, PoolDropsMessagesAboveCapacity)
+{
+    using M = connection_types::GenericValueMessage<int>;
+
+    MessageAllocator allocator;
+    allocator.setPooling(true, 2);
+
+    std::vector<M::Ptr> messages;
+    for (int i = 0; i < 4; ++i) {
+        messages.push_back(allocator.allocate<M>(i));
+    }
+    messages.clear();
+
+    MessagePool::Statistics stats = allocator.getPoolStatistics();
+    EXPECT_EQ(2u, stats.recycled);
+    EXPECT_EQ(2u, stats.dropped);
+}
+
+TEST_F(OutputAllocationTest, PooledMessagesCanOutliveTheirOutput)
+{
+    using M = connection_types::GenericValueMessage<int>;
+
+    M::Ptr msg;
+    {
+        NodeFacadeImplementationPtr nf = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src1"), graph);
+        OutputPtr output = testing::getOutput(nf, "out_0");
+        ASSERT_NE(nullptr, output);
+
+        msg::setMessagePooling(output.get(), true);
+        msg = msg::allocate<M>(output.get(), 42, "frame");
+        ASSERT_EQ(1u, msg::getMessagePoolStatistics(output.get()).misses);
+    }
+
+    EXPECT_EQ(42, msg->value);
+    msg.reset();
+}
+
+TEST_F(OutputAllocationTest, SteadyStatePublishingReusesOneMessage)
+{
+    using M = connection_types::GenericValueMessage<std::vector<float>>;
+    const std::size_t elements = 64 * 1024;
+    const int iterations = 200;
+
+    MessageAllocator pooled;
+    pooled.setPooling(true);
+
+    const float* buffer = nullptr;
+    for (int i = 0; i < iterations; ++i) {
+        M::Ptr msg = pooled.allocate<M>();
+        msg->value.resize(elements, static_cast<float>(i));
+        if (i == 0) {
+            buffer = msg->value.data();
+        } else {
+            // the inner buffer is recycled, no reallocation once the pool is warm
+            ASSERT_EQ(buffer, msg->value.data()) << "iteration " << i;
+        }
+    }
+
+    MessagePool::Statistics stats = pooled.getPoolStatistics();
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(static_cast<std::size_t>(iterations - 1), stats.hits);
+    EXPECT_EQ(0u, stats.dropped);
+}
+
 using namespace boost::interprocess;
 
 template <typename T>
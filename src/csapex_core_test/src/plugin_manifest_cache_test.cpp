@@ -0,0 +1,148 @@
+#include <csapex/plugin/plugin_manifest_cache.h>
+#include <csapex/plugin/plugin_locator.h>
+#include <csapex/factory/snippet_factory.h>
+#include <csapex/serialization/snippet.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/model/tag.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <yaml-cpp/yaml.h>
+
+using namespace csapex;
+
+class PluginManifestCacheTest : public CsApexTestCase
+{
+protected:
+    PluginManifestCacheTest() : dir(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_plugin_cache_%%%%%%%%"))
+    {
+        boost::filesystem::create_directories(dir);
+        cache_file = (dir / "plugin_cache").string();
+    }
+
+    virtual ~PluginManifestCacheTest()
+    {
+        boost::filesystem::remove_all(dir);
+    }
+
+    std::string writeFile(const std::string& name, const std::string& content)
+    {
+        std::string path = (dir / name).string();
+        std::ofstream ofs(path.c_str());
+        ofs << content;
+        return path;
+    }
+
+    PluginManifestCache::NodeEntry makeEntry()
+    {
+        PluginManifestCache::NodeEntry entry;
+        entry.properties = { "opencv", "vision" };
+        return entry;
+    }
+
+    boost::filesystem::path dir;
+    std::string cache_file;
+};
+
+TEST_F(PluginManifestCacheTest, EntriesAreRestoredFromTheFile)
+{
+    std::string library = writeFile("libfoo.so", "binary");
+    PluginManifestCache::Stamp stamp = PluginManifestCache::stamp(library);
+    ASSERT_EQ(6u, stamp.size);
+
+    {
+        PluginManifestCache cache(cache_file);
+        cache.load();
+        cache.storeNode(library, stamp, "foo::Bar", makeEntry());
+        cache.storeSnippet("/snippets/a.apexs", PluginManifestCache::Stamp(), PluginManifestCache::SnippetEntry{ "a", "snippet a", { "Tag" } });
+        ASSERT_TRUE(cache.isDirty());
+        cache.save();
+        ASSERT_FALSE(cache.isDirty());
+    }
+
+    PluginManifestCache cache(cache_file);
+    cache.load();
+
+    PluginManifestCache::NodeEntry entry;
+    ASSERT_TRUE(cache.findNode(library, stamp, "foo::Bar", entry));
+    ASSERT_EQ(makeEntry().properties, entry.properties);
+
+    ASSERT_FALSE(cache.findNode(library, stamp, "foo::Baz", entry));
+
+    PluginManifestCache::SnippetEntry snippet;
+    ASSERT_TRUE(cache.findSnippet("/snippets/a.apexs", PluginManifestCache::Stamp(), snippet));
+    ASSERT_EQ("snippet a", snippet.description);
+    ASSERT_EQ(std::vector<std::string>{ "Tag" }, snippet.tags);
+}
+
+TEST_F(PluginManifestCacheTest, ChangedLibrariesInvalidateTheirEntries)
+{
+    std::string library = writeFile("libfoo.so", "binary");
+    PluginManifestCache::Stamp stamp = PluginManifestCache::stamp(library);
+
+    PluginManifestCache cache(cache_file);
+    cache.storeNode(library, stamp, "foo::Bar", makeEntry());
+
+    writeFile("libfoo.so", "rebuilt binary");
+    PluginManifestCache::Stamp changed = PluginManifestCache::stamp(library);
+    ASSERT_NE(stamp, changed);
+
+    PluginManifestCache::NodeEntry entry;
+    ASSERT_FALSE(cache.findNode(library, changed, "foo::Bar", entry));
+
+    // storing one node of a rebuilt library drops all other nodes of the old build
+    cache.storeNode(library, changed, "foo::Baz", makeEntry());
+    ASSERT_TRUE(cache.findNode(library, changed, "foo::Baz", entry));
+    ASSERT_FALSE(cache.findNode(library, stamp, "foo::Bar", entry));
+    ASSERT_FALSE(cache.findNode(library, changed, "foo::Bar", entry));
+}
+
+TEST_F(PluginManifestCacheTest, InvalidFilesAreIgnored)
+{
+    writeFile("plugin_cache", "version: 1\nlibraries: [this is not a map");
+
+    PluginManifestCache cache(cache_file);
+    ASSERT_NO_THROW(cache.load());
+
+    PluginManifestCache::NodeEntry entry;
+    ASSERT_FALSE(cache.findNode("libfoo.so", PluginManifestCache::Stamp(), "foo::Bar", entry));
+}
+
+TEST_F(PluginManifestCacheTest, CachedSnippetsAreReadOnFirstUse)
+{
+    YAML::Node graph;
+    graph["nodes"].push_back("node");
+
+    YAML::Node snippet_yaml;
+    snippet_yaml["name"] = "cached";
+    snippet_yaml["description"] = "a cached snippet";
+    snippet_yaml["tags"].push_back("Cached");
+    snippet_yaml["yaml"] = graph;
+    writeFile("cached" + Settings::template_extension, YAML::Dump(snippet_yaml));
+
+    for (int start = 0; start < 2; ++start) {
+        SettingsImplementation settings;
+        settings.set("plugin_cache", cache_file);
+
+        PluginLocator locator(settings);
+        locator.setPluginPaths("snippets", { dir.string() });
+
+        SnippetFactory factory(&locator);
+        factory.loadSnippets();
+
+        // the first start fills the cache, the second one lists the snippet from it
+        ASSERT_TRUE(boost::filesystem::exists(cache_file));
+
+        SnippetPtr snippet = factory.getSnippetNoThrow("cached");
+        ASSERT_NE(nullptr, snippet);
+        ASSERT_EQ("a cached snippet", snippet->getDescription());
+        ASSERT_EQ(1u, snippet->getTags().size());
+        ASSERT_EQ("Cached", snippet->getTags().front()->getName());
+
+        YAML::Node loaded;
+        snippet->toYAML(loaded);
+        ASSERT_EQ(YAML::Dump(graph), YAML::Dump(loaded));
+    }
+}
@@ -0,0 +1,195 @@
+#include <csapex/scheduling/task_queue.h>
+#include <csapex/scheduling/task.h>
+#include <csapex/utility/exceptions.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace csapex;
+
+namespace
+{
+TaskPtr makeTask(const std::string& name, long priority = 0)
+{
+    return std::make_shared<Task>(name, []() {}, priority);
+}
+
+// the ready queue as it was implemented in ThreadGroup before the TaskQueue
+class MultisetQueue
+{
+public:
+    void push(const TaskPtr& task)
+    {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        for (const TaskPtr& t : tasks_) {
+            if (t.get() == task.get()) {
+                return;
+            }
+        }
+        tasks_.insert(task);
+    }
+
+    TaskPtr pop()
+    {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return nullptr;
+        }
+        TaskPtr task = *tasks_.begin();
+        tasks_.erase(tasks_.begin());
+        return task;
+    }
+
+private:
+    struct greater
+    {
+        bool operator()(const TaskPtr& a, const TaskPtr& b)
+        {
+            return a->getPriority() > b->getPriority();
+        }
+    };
+
+    std::recursive_mutex mutex_;
+    std::multiset<TaskPtr, greater> tasks_;
+};
+
+}  // namespace
+
+class TaskQueueTest : public CsApexTestCase
+{
+};
+
+TEST_F(TaskQueueTest, HigherPrioritiesArePoppedFirst)
+{
+    TaskQueue queue;
+    TaskPtr low = makeTask("low", 0);
+    TaskPtr mid = makeTask("mid", 3);
+    TaskPtr high = makeTask("high", 7);
+
+    queue.push(mid);
+    queue.push(low);
+    queue.push(high);
+    ASSERT_EQ(3u, queue.size());
+
+    EXPECT_EQ(high, queue.pop());
+    EXPECT_EQ(mid, queue.pop());
+    EXPECT_EQ(low, queue.pop());
+    EXPECT_EQ(nullptr, queue.pop());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(TaskQueueTest, TasksOfOneLevelArePoppedInOrder)
+{
+    TaskQueue queue;
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 10; ++i) {
+        tasks.push_back(makeTask("task"));
+        queue.push(tasks.back());
+    }
+
+    for (const TaskPtr& task : tasks) {
+        EXPECT_EQ(task, queue.pop());
+    }
+}
+
+TEST_F(TaskQueueTest, EveryPriorityHasItsOwnLevel)
+{
+    TaskQueue queue;
+    for (long priority = 0; priority < static_cast<long>(TaskQueue::PRIORITY_LEVELS); ++priority) {
+        EXPECT_EQ(static_cast<std::size_t>(priority), TaskQueue::getLevel(priority));
+        queue.push(makeTask("task", priority));
+    }
+
+    for (long priority = TaskQueue::PRIORITY_LEVELS - 1; priority >= 0; --priority) {
+        TaskPtr task = queue.pop();
+        ASSERT_NE(nullptr, task);
+        EXPECT_EQ(priority, task->getPriority());
+    }
+}
+
+TEST_F(TaskQueueTest, PrioritiesOutsideOfTheLevelsAreRejected)
+{
+    EXPECT_THROW(TaskQueue::getLevel(-1), HardAssertionFailure);
+    EXPECT_THROW(TaskQueue::getLevel(TaskQueue::PRIORITY_LEVELS), HardAssertionFailure);
+
+    TaskQueue queue;
+    EXPECT_THROW(queue.push(makeTask("huge", 1000)), HardAssertionFailure);
+}
+
+TEST_F(TaskQueueTest, DrainReturnsAllTasks)
+{
+    TaskQueue queue;
+    queue.push(makeTask("a", 1));
+    queue.push(makeTask("b", 2));
+    queue.push(makeTask("c", 1));
+
+    std::vector<TaskPtr> drained = queue.drain();
+    ASSERT_EQ(3u, drained.size());
+    EXPECT_EQ("b", drained[0]->getName());
+    EXPECT_EQ("a", drained[1]->getName());
+    EXPECT_EQ("c", drained[2]->getName());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(TaskQueueTest, ConcurrentProducersDoNotLoseTasks)
+{
+    TaskQueue queue;
+
+    const int producers = 4;
+    const int tasks_per_producer = 2000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < tasks_per_producer; ++i) {
+                queue.push(makeTask("task", p));
+            }
+        });
+    }
+
+    int popped = 0;
+    while (popped < producers * tasks_per_producer) {
+        if (queue.pop()) {
+            ++popped;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(producers * tasks_per_producer, popped);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(TaskQueueTest, PopsInTheSameOrderAsTheMultisetQueue)
+{
+    // a few hundred ready tasks corresponds to a large graph in the default thread group
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 300; ++i) {
+        tasks.push_back(makeTask("task", i % 4));
+    }
+
+    MultisetQueue multiset;
+    TaskQueue task_queue;
+    for (const TaskPtr& task : tasks) {
+        multiset.push(task);
+        task_queue.push(task);
+    }
+    ASSERT_EQ(tasks.size(), task_queue.size());
+
+    std::size_t popped = 0;
+    while (TaskPtr expected = multiset.pop()) {
+        ASSERT_EQ(expected, task_queue.pop()) << "task " << popped;
+        ++popped;
+    }
+
+    EXPECT_EQ(tasks.size(), popped);
+    EXPECT_EQ(nullptr, task_queue.pop());
+    EXPECT_TRUE(task_queue.empty());
+}
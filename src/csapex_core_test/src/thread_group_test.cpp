@@ -0,0 +1,541 @@
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex/scheduling/task.h>
+#include <csapex/scheduling/task_generator.h>
+#include <csapex/profiling/profiler.h>
+#include <csapex/utility/thread.h>
+
+#include <csapex_testing/csapex_test_case.h>
+#include <csapex_testing/test_exception_handler.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <set>
+
+using namespace csapex;
+
+namespace
+{
+class MockupTaskGenerator : public TaskGenerator
+{
+public:
+    void assignToScheduler(Scheduler* scheduler) override
+    {
+        scheduler_ = scheduler;
+    }
+    Scheduler* getScheduler() const override
+    {
+        return scheduler_;
+    }
+    void detach() override
+    {
+        scheduler_ = nullptr;
+    }
+
+    bool isPaused() const override
+    {
+        return false;
+    }
+    void setPause(bool /*pause*/) override
+    {
+    }
+
+    bool canStartStepping() const override
+    {
+        return true;
+    }
+    void setSteppingMode(bool /*stepping*/) override
+    {
+    }
+    void step() override
+    {
+    }
+    bool isStepping() const override
+    {
+        return false;
+    }
+    bool isStepDone() const override
+    {
+        return true;
+    }
+
+    UUID getUUID() const override
+    {
+        return UUID::NONE;
+    }
+
+    void setError(const std::string& /*msg*/) override
+    {
+    }
+
+    void reset() override
+    {
+    }
+
+    void setSuppressExceptions(bool /*suppress_exceptions*/) override
+    {
+    }
+
+private:
+    Scheduler* scheduler_ = nullptr;
+};
+
+bool waitFor(const std::function<bool()>& predicate)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+}  // namespace
+
+class ThreadGroupTest : public CsApexTestCase
+{
+protected:
+    TestExceptionHandler eh;
+};
+
+TEST_F(ThreadGroupTest, WorkersExecuteTasksOfDifferentGeneratorsConcurrently)
+{
+    ThreadGroup group(nullptr, eh, "workers");
+    group.setWorkerCount(2);
+    ASSERT_EQ(2u, group.getWorkerCount());
+
+    MockupTaskGenerator a, b;
+    std::atomic<int> running(0);
+    std::atomic<int> overlapping(0);
+
+    auto blocking = [&]() {
+        ++running;
+        if (waitFor([&]() { return running == 2; })) {
+            ++overlapping;
+        }
+    };
+
+    group.start();
+    group.schedule(std::make_shared<Task>("a", blocking, 0, &a));
+    group.schedule(std::make_shared<Task>("b", blocking, 0, &b));
+
+    ASSERT_TRUE(waitFor([&]() { return overlapping == 2; }));
+
+    group.stop();
+}
+
+TEST_F(ThreadGroupTest, TasksOfOneGeneratorAreNeverExecutedConcurrently)
+{
+    ThreadGroup group(nullptr, eh, "workers");
+    group.setWorkerCount(4);
+
+    MockupTaskGenerator generator;
+    std::atomic<int> active(0);
+    std::atomic<int> executed(0);
+    std::atomic<bool> overlapped(false);
+
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 16; ++i) {
+        tasks.push_back(std::make_shared<Task>("task",
+                                               [&]() {
+                                                   if (++active > 1) {
+                                                       overlapped = true;
+                                                   }
+                                                   std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                                   --active;
+                                                   ++executed;
+                                               },
+                                               0, &generator));
+    }
+
+    group.start();
+    for (const TaskPtr& task : tasks) {
+        group.schedule(task);
+    }
+
+    ASSERT_TRUE(waitFor([&]() { return executed == 16; }));
+    EXPECT_FALSE(overlapped);
+
+    group.stop();
+}
+
+TEST_F(ThreadGroupTest, ScheduledTaskIsOnlyQueuedOnce)
+{
+    ThreadGroup group(nullptr, eh, "workers");
+    group.setWorkerCount(2);
+
+    MockupTaskGenerator generator;
+    std::atomic<int> executed(0);
+    TaskPtr task = std::make_shared<Task>("task", [&]() { ++executed; }, 0, &generator);
+
+    group.setPause(true);
+    group.start();
+    group.schedule(task);
+    group.schedule(task);
+    group.setPause(false);
+
+    ASSERT_TRUE(waitFor([&]() { return executed > 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(1, executed);
+
+    group.stop();
+}
+
+TEST_F(ThreadGroupTest, IdleGroupsStealTasksFromBusyGroups)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* busy = pool.createGroup("busy", -1, 2);
+    ThreadGroup* idle = pool.createGroup("idle", -1, 2);
+    ASSERT_TRUE(busy->isWorkStealingEnabled());
+    ASSERT_TRUE(idle->isWorkStealingEnabled());
+
+    pool.start();
+
+    MockupTaskGenerator blocker_a, blocker_b, worker;
+    std::atomic<bool> release(false);
+    std::atomic<int> blocked(0);
+    auto block = [&]() {
+        ++blocked;
+        waitFor([&]() { return release.load(); });
+    };
+    busy->schedule(std::make_shared<Task>("block a", block, 0, &blocker_a));
+    busy->schedule(std::make_shared<Task>("block b", block, 0, &blocker_b));
+    ASSERT_TRUE(waitFor([&]() { return blocked == 2; }));
+
+    std::atomic<bool> executed(false);
+    std::string executing_thread;
+    busy->schedule(std::make_shared<Task>("work",
+                                          [&]() {
+                                              executing_thread = csapex::thread::get_name();
+                                              executed = true;
+                                          },
+                                          0, &worker));
+
+    ASSERT_TRUE(waitFor([&]() { return executed.load(); }));
+    EXPECT_EQ("idle", executing_thread);
+
+    release = true;
+    pool.stop();
+}
+
+TEST_F(ThreadGroupTest, WorkerCountIsSavedWithThreadSettings)
+{
+    YAML::Node node;
+    {
+        ThreadPool pool(eh, true, true);
+        ThreadGroup* group = pool.createGroup("parallel", -1, 4);
+        ASSERT_EQ(4u, group->getWorkerCount());
+        pool.saveSettings(node);
+    }
+
+    ThreadPool pool(eh, true, true);
+    pool.loadSettings(node);
+
+    bool found = false;
+    for (const ThreadGroupPtr& group : pool.getGroups()) {
+        if (group->getName() == "parallel") {
+            found = true;
+            EXPECT_EQ(4u, group->getWorkerCount());
+        } else {
+            EXPECT_EQ(1u, group->getWorkerCount());
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_F(ThreadGroupTest, PriorityPolicyIsAppliedToAllGroupsAndSaved)
+{
+    YAML::Node node;
+    {
+        ThreadPool pool(eh, true, true);
+        ASSERT_EQ(TaskPriorityPolicy::FIFO, pool.getPriorityPolicy());
+
+        ThreadGroup* before = pool.createGroup("before");
+        pool.setPriorityPolicy(TaskPriorityPolicy::CRITICAL_PATH);
+        ThreadGroup* after = pool.createGroup("after");
+
+        EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, pool.getDefaultGroup()->getPriorityPolicy());
+        EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, before->getPriorityPolicy());
+        EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, after->getPriorityPolicy());
+
+        pool.saveSettings(node);
+    }
+
+    ThreadPool pool(eh, true, true);
+    pool.loadSettings(node);
+
+    EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, pool.getPriorityPolicy());
+    for (const ThreadGroupPtr& group : pool.getGroups()) {
+        EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, group->getPriorityPolicy());
+    }
+}
+
+TEST_F(ThreadGroupTest, CriticalPathPolicyExecutesDeeperNodesFirst)
+{
+    ThreadPool pool(eh, true, true);
+    pool.setPriorityPolicy(TaskPriorityPolicy::CRITICAL_PATH);
+    ThreadGroup* group = pool.getDefaultGroup();
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    std::vector<std::unique_ptr<MockupTaskGenerator>> generators;
+    auto schedule = [&](const std::string& name, long priority) {
+        generators.emplace_back(new MockupTaskGenerator);
+        group->schedule(std::make_shared<Task>(name,
+                                               [&, name]() {
+                                                   std::unique_lock<std::mutex> lock(order_mutex);
+                                                   order.push_back(name);
+                                               },
+                                               priority, generators.back().get()));
+    };
+
+    TaskPriorityPolicy policy = group->getPriorityPolicy();
+    schedule("source", task_priority::forProcessing(policy, 0));
+    schedule("filter", task_priority::forProcessing(policy, 1));
+    schedule("sink", task_priority::forProcessing(policy, 3));
+    schedule("unknown", task_priority::forProcessing(policy, -1));
+    schedule("parameters", task_priority::forControl(policy));
+
+    pool.start();
+    ASSERT_TRUE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(order_mutex);
+        return order.size() == 5;
+    }));
+    pool.stop();
+
+    // tasks of the same level keep their order
+    std::vector<std::string> expected{ "parameters", "sink", "filter", "source", "unknown" };
+    EXPECT_EQ(expected, order);
+
+    // very deep nodes share the deepest level but never overtake control tasks
+    EXPECT_EQ(task_priority::forProcessing(policy, 100), task_priority::forProcessing(policy, 1000));
+    EXPECT_LT(task_priority::forProcessing(policy, 1000), task_priority::forControl(policy));
+    EXPECT_EQ(0, task_priority::forProcessing(TaskPriorityPolicy::FIFO, 5));
+    EXPECT_EQ(TaskPriorityPolicy::CRITICAL_PATH, task_priority::fromName(task_priority::name(TaskPriorityPolicy::CRITICAL_PATH)));
+}
+
+TEST_F(ThreadGroupTest, DeadlineSchedulingExecutesEarliestDeadlineFirst)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* group = pool.getDefaultGroup();
+    group->setDeadlineScheduling(true);
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    std::vector<std::unique_ptr<MockupTaskGenerator>> generators;
+    auto now = std::chrono::steady_clock::now();
+    auto schedule = [&](const std::string& name, long priority, std::chrono::milliseconds deadline) {
+        generators.emplace_back(new MockupTaskGenerator);
+        TaskPtr task = std::make_shared<Task>(name,
+                                              [&, name]() {
+                                                  std::unique_lock<std::mutex> lock(order_mutex);
+                                                  order.push_back(name);
+                                              },
+                                              priority, generators.back().get());
+        if (deadline.count() > 0) {
+            task->setDeadline(now + deadline);
+        }
+        group->schedule(task);
+    };
+
+    schedule("control", 15, std::chrono::milliseconds(0));
+    schedule("late", 0, std::chrono::milliseconds(30));
+    schedule("early", 0, std::chrono::milliseconds(10));
+    schedule("removed", 0, std::chrono::milliseconds(5));
+    schedule("early too", 0, std::chrono::milliseconds(10));
+
+    // removing a generator also takes its tasks out of the deadline queue
+    std::vector<DelayedTask> delayed;
+    std::vector<TaskPtr> remaining = group->remove(generators[3].get(), delayed);
+    EXPECT_TRUE(delayed.empty());
+    ASSERT_EQ(1u, remaining.size());
+    EXPECT_EQ("removed", remaining.front()->getName());
+
+    pool.start();
+    ASSERT_TRUE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(order_mutex);
+        return order.size() == 4;
+    }));
+    pool.stop();
+
+    // tasks with a deadline run before all others, equal deadlines keep their order
+    std::vector<std::string> expected{ "early", "early too", "late", "control" };
+    EXPECT_EQ(expected, order);
+
+    YAML::Node settings;
+    group->saveSettings(settings);
+    EXPECT_TRUE(settings["deadline_scheduling"].as<bool>());
+
+    ThreadPool restored(eh, true, true);
+    restored.getDefaultGroup()->loadSettings(settings);
+    EXPECT_TRUE(restored.getDefaultGroup()->isDeadlineSchedulingEnabled());
+}
+
+TEST_F(ThreadGroupTest, DelayedTasksAreScheduledInOrderAndNeverEarly)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* group = pool.getDefaultGroup();
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    std::vector<std::unique_ptr<MockupTaskGenerator>> generators;
+    auto start = std::chrono::steady_clock::now();
+    auto schedule = [&](const std::string& name, std::chrono::milliseconds delay) {
+        generators.emplace_back(new MockupTaskGenerator);
+        auto due = start + delay;
+        group->scheduleDelayed(std::make_shared<Task>(name,
+                                                      [&, name, due]() {
+                                                          EXPECT_GE(std::chrono::steady_clock::now(), due) << name;
+                                                          std::unique_lock<std::mutex> lock(order_mutex);
+                                                          order.push_back(name);
+                                                      },
+                                                      0, generators.back().get()),
+                               due);
+    };
+
+    // the delays span several levels of the timer wheel
+    schedule("third", std::chrono::milliseconds(450));
+    schedule("first", std::chrono::milliseconds(5));
+    schedule("second", std::chrono::milliseconds(70));
+    schedule("first too", std::chrono::milliseconds(5));
+
+    pool.start();
+    ASSERT_TRUE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(order_mutex);
+        return order.size() == 4;
+    }));
+    pool.stop();
+
+    std::vector<std::string> expected{ "first", "first too", "second", "third" };
+    EXPECT_EQ(expected, order);
+}
+
+TEST_F(ThreadGroupTest, RemovingAGeneratorCancelsItsDelayedTasks)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* group = pool.getDefaultGroup();
+
+    std::atomic<int> executed(0);
+    MockupTaskGenerator removed;
+    MockupTaskGenerator kept;
+    TaskPtr removed_task = std::make_shared<Task>("removed", [&]() { ++executed; }, 0, &removed);
+    TaskPtr kept_task = std::make_shared<Task>("kept", [&]() { ++executed; }, 0, &kept);
+
+    auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    group->scheduleDelayed(removed_task, due);
+    group->scheduleDelayed(kept_task, due);
+    // far beyond the range of the wheel
+    group->scheduleDelayed(removed_task, due + std::chrono::hours(100));
+
+    // the generator's next scheduler gets the delayed task back once, with its earliest time
+    std::vector<DelayedTask> delayed;
+    std::vector<TaskPtr> remaining = group->remove(&removed, delayed);
+    EXPECT_TRUE(remaining.empty());
+    ASSERT_EQ(1u, delayed.size());
+    EXPECT_EQ(removed_task, delayed[0].task);
+    EXPECT_GE(delayed[0].time, due);
+    EXPECT_LE(delayed[0].time, due + std::chrono::milliseconds(1));
+
+    pool.start();
+    ASSERT_TRUE(waitFor([&]() { return executed == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pool.stop();
+
+    EXPECT_EQ(1, executed);
+}
+
+TEST_F(ThreadGroupTest, IdleStrategiesExecuteTasksAndRecordWakeUps)
+{
+    for (IdleStrategy strategy : { IdleStrategy::BLOCK, IdleStrategy::SPIN_THEN_PARK, IdleStrategy::BUSY_POLL }) {
+        ThreadPool pool(eh, true, true);
+        ThreadGroup* group = pool.getDefaultGroup();
+        group->setIdleStrategy(strategy);
+        group->setSpinBudget(std::chrono::microseconds(20));
+        pool.getProfiler()->setEnabled(true);
+
+        MockupTaskGenerator generator;
+        std::atomic<int> executed(0);
+        TaskPtr task = std::make_shared<Task>("task", [&]() { ++executed; }, 0, &generator);
+
+        pool.start();
+        for (int i = 1; i <= 10; ++i) {
+            // give the worker time to run out of tasks, so that every task has to wake it up
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            group->schedule(task);
+            ASSERT_TRUE(waitFor([&]() { return executed == i; })) << idle_strategy::name(strategy);
+        }
+        pool.stop();
+
+        const Profile& profile = pool.getProfiler()->getProfile(group->getTimerNames().front());
+        std::vector<std::string> steps = profile.getStepNames();
+        ASSERT_NE(steps.end(), std::find(steps.begin(), steps.end(), ThreadGroup::WAKE_UP_STEP)) << idle_strategy::name(strategy);
+        EXPECT_GT(profile.getHistogram(ThreadGroup::WAKE_UP_STEP).count(), 0u) << idle_strategy::name(strategy);
+        EXPECT_LE(profile.getHistogram(ThreadGroup::WAKE_UP_STEP).count(), 10u) << idle_strategy::name(strategy);
+    }
+}
+
+TEST_F(ThreadGroupTest, IdleStrategyAndRealtimePriorityAreSavedWithTheSettings)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* group = pool.getDefaultGroup();
+    EXPECT_EQ(IdleStrategy::BLOCK, group->getIdleStrategy());
+    EXPECT_EQ(0, group->getRealtimePriority());
+
+    // the priority is only applied to running workers, so this does not need any permissions
+    group->setIdleStrategy(IdleStrategy::SPIN_THEN_PARK);
+    group->setSpinBudget(std::chrono::microseconds(200));
+    group->setRealtimePriority(10);
+
+    YAML::Node settings;
+    group->saveSettings(settings);
+    EXPECT_EQ("spin_then_park", settings["idle_strategy"].as<std::string>());
+
+    ThreadPool restored(eh, true, true);
+    ThreadGroup* restored_group = restored.getDefaultGroup();
+    restored_group->loadSettings(settings);
+    EXPECT_EQ(IdleStrategy::SPIN_THEN_PARK, restored_group->getIdleStrategy());
+    EXPECT_EQ(std::chrono::microseconds(200), restored_group->getSpinBudget());
+    EXPECT_EQ(10, restored_group->getRealtimePriority());
+
+    EXPECT_THROW(idle_strategy::fromName("sleep"), std::invalid_argument);
+}
+
+TEST_F(ThreadGroupTest, DefaultGroupHasOneWorkerAndListsAllWorkerThreads)
+{
+    ThreadPool pool(eh, true, true);
+    ThreadGroup* group = pool.getDefaultGroup();
+    EXPECT_EQ(1u, group->getWorkerCount());
+    EXPECT_TRUE(group->getThreads().empty());
+
+    group->setWorkerCount(3);
+    pool.start();
+
+    std::vector<const std::thread*> threads = group->getThreads();
+    ASSERT_EQ(3u, threads.size());
+    EXPECT_EQ(&group->thread(), threads.front());
+    std::set<std::thread::id> ids;
+    for (const std::thread* thread : threads) {
+        ids.insert(thread->get_id());
+    }
+    EXPECT_EQ(3u, ids.size());
+
+    pool.stop();
+    EXPECT_TRUE(group->getThreads().empty());
+}
+
+TEST_F(ThreadGroupTest, WorkerCountOfTheDefaultGroupIsSaved)
+{
+    YAML::Node node;
+    {
+        ThreadPool pool(eh, true, true);
+        pool.getDefaultGroup()->setWorkerCount(3);
+        pool.saveSettings(node);
+    }
+
+    ThreadPool pool(eh, true, true);
+    ASSERT_EQ(1u, pool.getDefaultGroup()->getWorkerCount());
+    pool.loadSettings(node);
+    EXPECT_EQ(3u, pool.getDefaultGroup()->getWorkerCount());
+}
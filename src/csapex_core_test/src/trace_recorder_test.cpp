@@ -0,0 +1,187 @@
+#include <csapex/profiling/trace_recorder.h>
+#include <csapex/profiling/profiler_impl.h>
+#include <csapex/profiling/timer.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <thread>
+
+using namespace csapex;
+
+class TraceRecorderTest : public CsApexTestCase
+{
+};
+
+namespace
+{
+TraceEvent makeEvent(uint32_t scope, uint64_t duration)
+{
+    TraceEvent event;
+    event.start = TraceRecorder::now();
+    event.duration = duration;
+    event.name = TraceRecorder::intern("event");
+    event.scope = scope;
+    event.cycle = 0;
+    event.padding = 0;
+    return event;
+}
+}  // namespace
+
+TEST_F(TraceRecorderTest, NamesAreInternedOnce)
+{
+    uint32_t a = TraceRecorder::intern("trace test a");
+    uint32_t b = TraceRecorder::intern("trace test b");
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, TraceRecorder::intern("trace test a"));
+    EXPECT_EQ("trace test b", TraceRecorder::nameOf(b));
+
+    uint32_t other_thread = 0;
+    std::thread t([&]() { other_thread = TraceRecorder::intern("trace test a"); });
+    t.join();
+    EXPECT_EQ(a, other_thread);
+}
+
+TEST_F(TraceRecorderTest, BufferDropsEventsWhenFull)
+{
+    std::unique_ptr<TraceBuffer> buffer(new TraceBuffer);
+    for (std::size_t i = 0; i < TraceBuffer::CAPACITY; ++i) {
+        ASSERT_TRUE(buffer->push(makeEvent(0, i)));
+    }
+    EXPECT_FALSE(buffer->push(makeEvent(0, 0)));
+    EXPECT_EQ(1u, buffer->getDropped());
+
+    uint64_t expected = 0;
+    std::size_t consumed = buffer->consume([&](const TraceEvent& event) { EXPECT_EQ(expected++, event.duration); });
+    EXPECT_EQ(TraceBuffer::CAPACITY, consumed);
+    EXPECT_EQ(0u, buffer->size());
+    EXPECT_TRUE(buffer->push(makeEvent(0, 0)));
+}
+
+TEST_F(TraceRecorderTest, EventsOfAllThreadsReachTheirSubscriber)
+{
+    TraceRecorder& recorder = TraceRecorder::instance();
+    uint32_t scope = recorder.makeScope();
+
+    std::size_t received = 0;
+    recorder.subscribe(scope, [&](const TraceEvent& event) {
+        EXPECT_EQ(scope, event.scope);
+        ++received;
+    });
+
+    // stay below the flush threshold, so every event is still buffered when its thread exits
+    const int threads = 4;
+    const int events = TraceBuffer::CAPACITY / 2;
+    std::size_t dropped = recorder.getDropped();
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < events; ++i) {
+                recorder.record(makeEvent(scope, i));
+            }
+        });
+    }
+    for (std::thread& t : producers) {
+        t.join();
+    }
+
+    recorder.flush();
+    EXPECT_EQ(std::size_t(threads * events), received);
+    EXPECT_EQ(dropped, recorder.getDropped());
+
+    recorder.unsubscribe(scope);
+    recorder.record(makeEvent(scope, 0));
+    recorder.flush();
+    EXPECT_EQ(std::size_t(threads * events), received);
+}
+
+TEST_F(TraceRecorderTest, StepsAreAttachedToTheirCycle)
+{
+    ProfilerImplementation profiler(true, 3);
+    Timer::Ptr timer = profiler.getTimer("traced");
+
+    for (int i = 0; i < 3; ++i) {
+        timer->restart();
+        {
+            Interlude::Ptr step = timer->step("first");
+        }
+        {
+            Interlude::Ptr step = timer->step("second");
+        }
+        timer->finish();
+    }
+
+    const Profile& profile = profiler.getProfile("traced");
+    EXPECT_EQ(3u, profile.getStats("first").count);
+    EXPECT_EQ(3u, profile.getStats("second").count);
+
+    for (const Interval::Ptr& interval : profile.getIntervals()) {
+        ASSERT_TRUE(interval != nullptr);
+        ASSERT_EQ(2u, interval->sub.size());
+        EXPECT_LE(interval->getStartMicro(), interval->sub.at("first")->getStartMicro());
+        EXPECT_LE(interval->sub.at("first")->getEndMicro(), interval->sub.at("second")->getStartMicro());
+    }
+}
+
+TEST_F(TraceRecorderTest, StepsFlushedBeforeTheTimerFinishesAreKept)
+{
+    ProfilerImplementation profiler(true, 1);
+    Timer::Ptr timer = profiler.getTimer("early");
+
+    timer->restart();
+    {
+        Interlude::Ptr step = timer->step("step");
+    }
+    TraceRecorder::instance().flush();
+    timer->finish();
+
+    const Profile& profile = profiler.getProfile("early");
+    EXPECT_EQ(1u, profile.getStats("step").count);
+
+    std::vector<Interval::Ptr> intervals = profile.getIntervals();
+    ASSERT_EQ(1u, intervals.size());
+    ASSERT_TRUE(intervals.front() != nullptr);
+    EXPECT_EQ(1u, intervals.front()->sub.count("step"));
+}
+
+TEST_F(TraceRecorderTest, PublishedIntervalsAreNotModifiedLater)
+{
+    ProfilerImplementation profiler(true, 1);
+    Timer::Ptr timer = profiler.getTimer("published");
+
+    Interval::Ptr published;
+    timer->finished.connect([&](Interval::Ptr interval) { published = interval; });
+
+    timer->restart();
+    {
+        Interlude::Ptr first = timer->step("first");
+        Interlude::Ptr second = timer->step("second");
+    }
+    timer->finish();
+    ASSERT_TRUE(published != nullptr);
+    std::size_t subs_at_finish = published->sub.size();
+
+    // reading the profile attaches the buffered steps to its own copy only
+    std::vector<Interval::Ptr> intervals = profiler.getProfile("published").getIntervals();
+    ASSERT_EQ(1u, intervals.size());
+    ASSERT_TRUE(intervals.front() != nullptr);
+    EXPECT_NE(published, intervals.front());
+    EXPECT_EQ(2u, intervals.front()->sub.size());
+    EXPECT_EQ(subs_at_finish, published->sub.size());
+}
+
+TEST_F(TraceRecorderTest, DisabledTimersRecordNothing)
+{
+    ProfilerImplementation profiler(false, 1);
+    Timer::Ptr timer = profiler.getTimer("disabled");
+
+    timer->restart();
+    {
+        Interlude::Ptr step = timer->step("step");
+        Interlude null_step(static_cast<Timer*>(nullptr), "null");
+    }
+    timer->finish();
+
+    EXPECT_TRUE(profiler.getProfile("disabled").getStepNames().empty());
+}
@@ -408,3 +408,198 @@ TEST_F(TransitionTest, TestBundledAndDirectConnectionsCanBeMixed)
         ASSERT_RECEIVED(*i2, iter);
     }
 }
+
+TEST_F(TransitionTest, TestBufferedConnectionLetsProducerRunAhead)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueCapacity(3);
+
+    // the producer can fill the queue without waiting for the consumer
+    for (int iter = 0; iter < 3; ++iter) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, iter);
+        ot.sendMessages(false);
+    }
+    ASSERT_FALSE(ot.canStartSendingMessages());
+    ASSERT_EQ(2u, c->countQueuedTokens());
+
+    // the consumer receives the tokens in order
+    for (int iter = 0; iter < 3; ++iter) {
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+
+        ASSERT_RECEIVED(*i1, iter);
+        ASSERT_EQ(iter, i1->sequenceNumber());
+
+        it.notifyMessageProcessed();
+
+        ASSERT_TRUE(ot.canStartSendingMessages());
+    }
+
+    ASSERT_FALSE(it.isEnabled());
+    ASSERT_EQ(0u, c->countQueuedTokens());
+    ASSERT_EQ(0u, c->countDroppedTokens());
+}
+
+TEST_F(TransitionTest, TestFullBlockingQueueHoldsTheProducerBack)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueCapacity(2);
+
+    for (int iter = 0; iter < 2; ++iter) {
+        sendMessage(*o1, iter);
+        ot.sendMessages(false);
+    }
+    ASSERT_FALSE(ot.canStartSendingMessages());
+
+    // a token that arrives at the full queue is kept instead of failing
+    GenericValueMessage<int>::Ptr msg(new GenericValueMessage<int>);
+    msg->value = 2;
+    c->setToken(std::make_shared<Token>(msg));
+    ASSERT_EQ(2u, c->countQueuedTokens());
+    ASSERT_EQ(0u, c->countDroppedTokens());
+
+    for (int iter = 0; iter < 2; ++iter) {
+        ASSERT_FALSE(ot.canStartSendingMessages());
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+        ASSERT_RECEIVED(*i1, iter);
+        it.notifyMessageProcessed();
+    }
+
+    // the producer continues once there is room in the queue again
+    ASSERT_TRUE(ot.canStartSendingMessages());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 2);
+    it.notifyMessageProcessed();
+    ASSERT_FALSE(it.isEnabled());
+}
+
+TEST_F(TransitionTest, TestBufferedConnectionCanDropOldestTokens)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueCapacity(2);
+    c->setQueuePolicy(QueuePolicy::DROP_OLDEST);
+
+    for (int iter = 0; iter < 4; ++iter) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, iter);
+        ot.sendMessages(false);
+    }
+    ASSERT_EQ(2u, c->countDroppedTokens());
+
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 0);
+    it.notifyMessageProcessed();
+
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 3);
+    it.notifyMessageProcessed();
+
+    ASSERT_FALSE(it.isEnabled());
+}
+
+TEST_F(TransitionTest, TestBufferedConnectionCanDropNewestTokens)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueCapacity(2);
+    c->setQueuePolicy(QueuePolicy::DROP_NEWEST);
+
+    for (int iter = 0; iter < 4; ++iter) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, iter);
+        ot.sendMessages(false);
+    }
+    ASSERT_EQ(2u, c->countDroppedTokens());
+
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 0);
+    it.notifyMessageProcessed();
+
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 1);
+    it.notifyMessageProcessed();
+
+    ASSERT_FALSE(it.isEnabled());
+}
+
+TEST_F(TransitionTest, TestInputsAreRealignedAfterADroppedToken)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+    ot.addOutput(o2);
+
+    InputTransition it;
+    it.addInput(i1);
+    it.addInput(i2);
+
+    ConnectionPtr dropping = DirectConnection::connect(o1, i1);
+    dropping->setQueueCapacity(2);
+    dropping->setQueuePolicy(QueuePolicy::DROP_OLDEST);
+
+    ConnectionPtr buffered = DirectConnection::connect(o2, i2);
+    buffered->setQueueCapacity(4);
+
+    for (int iter = 0; iter < 3; ++iter) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, iter);
+        sendMessage(*o2, iter);
+        ot.sendMessages(false);
+    }
+
+    // the first input dropped the token with sequence number 1, the second one still has it queued
+    ASSERT_EQ(1u, dropping->countDroppedTokens());
+    ASSERT_EQ(2u, buffered->countQueuedTokens());
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 0);
+    ASSERT_RECEIVED(*i2, 0);
+    it.notifyMessageProcessed();
+
+    // both inputs continue with the newest sequence number instead of staying out of phase
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 2);
+    ASSERT_RECEIVED(*i2, 2);
+    ASSERT_EQ(i1->sequenceNumber(), i2->sequenceNumber());
+    it.notifyMessageProcessed();
+
+    ASSERT_FALSE(it.isEnabled());
+    ASSERT_EQ(0u, buffered->countQueuedTokens());
+
+    // later tokens stay aligned
+    sendMessage(*o1, 3);
+    sendMessage(*o2, 3);
+    ot.sendMessages(false);
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 3);
+    ASSERT_RECEIVED(*i2, 3);
+    it.notifyMessageProcessed();
+}
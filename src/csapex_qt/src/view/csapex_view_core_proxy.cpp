@@ -15,6 +15,7 @@
 #include <csapex/io/protcol/core_notes.h>
 #include <csapex/io/protcol/core_requests.h>
 #include <csapex/io/protcol/notification_message.h>
+#include <csapex/io/protcol/request_graph_snapshot.h>
 #include <csapex/model/graph_facade.h>
 #include <csapex/model/graph_facade_proxy.h>
 #include <csapex/model/graph/graph_proxy.h>
@@ -110,6 +111,9 @@ CsApexViewCoreProxy::CsApexViewCoreProxy(const SessionPtr& session)
         }
     });
 
+    // a server on the same host is reached through shared memory, the socket only signals disconnects
+    session_->negotiateSharedMemory();
+
     settings_ = std::make_shared<SettingsProxy>(session_);
     remote_plugin_locator_ = std::make_shared<PluginLocator>(*settings_);
 
@@ -137,8 +141,13 @@ CsApexViewCoreProxy::CsApexViewCoreProxy(const SessionPtr& session)
     }
 
     // make the proxys only _after_ the session is started
-    NodeFacadeProxyPtr remote_facade = std::make_shared<NodeFacadeProxy>(session_, AUUID::NONE);
-    remote_root_ = std::make_shared<GraphFacadeProxy>(session_, remote_facade);
+    // the whole graph is fetched at once, requesting every node on its own makes attaching to large graphs slow
+    auto snapshot = session_->sendRequest<RequestGraphSnapshot>();
+    apex_assert_hard(snapshot);
+    const NodeSnapshot& root = snapshot->getRoot();
+    NodeFacadeProxyPtr remote_facade = std::make_shared<NodeFacadeProxy>(session_, AUUID::NONE, root);
+    apex_assert_hard(root.subgraph);
+    remote_root_ = std::make_shared<GraphFacadeProxy>(session_, remote_facade, *root.subgraph);
 
     node_adapter_factory_ = std::make_shared<NodeAdapterFactory>(*settings_, remote_plugin_locator_.get());
     dispatcher_ = std::make_shared<CommandDispatcherProxy>(session_);
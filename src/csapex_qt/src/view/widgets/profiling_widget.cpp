@@ -80,7 +80,7 @@ void ProfilingWidget::exportCsv()
 
             ProfilerStats stats = profile.getStats(name);
 
-            of << name << "," << stats.mean << "," << stats.stddev << '\n';
+            of << name << "," << stats.mean << "," << stats.stddev << "," << stats.p50 << "," << stats.p99 << "," << stats.p999 << "," << stats.max << '\n';
         }
     }
 }
@@ -216,7 +216,8 @@ void ProfilingWidget::paintEvent(QPaintEvent*)
         if (selected_interval_) {
             std::string name = selected_interval_->name();
             ProfilerStats stats = profile.getStats(name);
-            setToolTip(QString("<b>") + QString::fromStdString(name) + "</b>:<br /> " + QString::number(stats.mean) + " &plusmn; " + QString::number(stats.stddev) + " ms");
+            setToolTip(QString("<b>") + QString::fromStdString(name) + "</b>:<br /> " + QString::number(stats.mean) + " &plusmn; " + QString::number(stats.stddev) + " ms<br />p50: " +
+                       QString::number(stats.p50) + " ms, p99: " + QString::number(stats.p99) + " ms, p99.9: " + QString::number(stats.p999) + " ms, max: " + QString::number(stats.max) + " ms");
         }
     }
 
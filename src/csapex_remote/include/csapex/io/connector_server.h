@@ -15,7 +15,7 @@ namespace csapex
 class ConnectorServer : public Observer
 {
 public:
-    ConnectorServer(SessionPtr session);
+    ConnectorServer(SessionPtr session, NoteAggregatorPtr notes);
     ~ConnectorServer();
 
     void startObserving(const ConnectablePtr& connector);
@@ -23,8 +23,10 @@ public:
 
 private:
     SessionPtr session_;
+    NoteAggregatorPtr notes_;
 
     std::unordered_map<AUUID, io::ChannelPtr, AUUID::Hasher> channels_;
+    std::unordered_map<AUUID, StatePublisherPtr, AUUID::Hasher> publishers_;
 };
 }  // namespace csapex
 
@@ -16,7 +16,7 @@ protected:
     CLONABLE_IMPLEMENTATION(Feedback);
 
 public:
-    Feedback(const std::string& message, uint8_t request_id);
+    Feedback(const std::string& message, uint32_t request_id);
     Feedback(const std::string& message);
 
     static const uint8_t PACKET_TYPE_ID = 6;
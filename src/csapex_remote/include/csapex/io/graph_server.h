@@ -15,7 +15,7 @@ namespace csapex
 class GraphServer : public Observer
 {
 public:
-    GraphServer(SessionPtr session);
+    GraphServer(SessionPtr session, NoteAggregatorPtr notes);
     ~GraphServer();
 
     void startObservingGraph(const GraphFacadeImplementationPtr& graph);
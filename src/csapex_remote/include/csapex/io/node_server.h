@@ -15,7 +15,7 @@ namespace csapex
 class NodeServer : public Observer
 {
 public:
-    NodeServer(SessionPtr session);
+    NodeServer(SessionPtr session, NoteAggregatorPtr notes);
     ~NodeServer();
 
     void startObservingNode(const NodeFacadeImplementationPtr& graph);
@@ -23,9 +23,11 @@ public:
 
 private:
     SessionPtr session_;
+    NoteAggregatorPtr notes_;
     ConnectorServerPtr connector_server_;
 
     std::unordered_map<AUUID, io::ChannelPtr, AUUID::Hasher> channels_;
+    std::unordered_map<AUUID, StatePublisherPtr, AUUID::Hasher> publishers_;
 };
 }  // namespace csapex
 
@@ -0,0 +1,97 @@
+#ifndef NOTE_AGGREGATOR_H
+#define NOTE_AGGREGATOR_H
+
+/// PROJECT
+#include <csapex/io/protcol/note_batch.h>
+#include <csapex/io/remote_io_fwd.h>
+
+/// SYSTEM
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The NoteAggregator class collects the outgoing notes of one session and sends them
+ * once per tick as a single NoteBatch. State notes with the same key supersede each other,
+ * so only the latest one is sent. Finished profiling intervals are sent at a separate, lower rate.
+ */
+class NoteAggregator
+{
+public:
+    NoteAggregator(SessionPtr session, double note_rate, double profiling_rate);
+    ~NoteAggregator();
+
+    template <typename NoteWrapper, typename... Args>
+    void sendNote(Args&&... args)
+    {
+        sendNote(std::make_shared<NoteWrapper>(std::forward<Args>(args)...));
+    }
+    void sendNote(const io::NoteConstPtr& note);
+
+    /**
+     * @brief sendStateNote replaces a pending note with the same key, the new note is sent in its place
+     */
+    void sendStateNote(const std::string& key, const io::NoteConstPtr& note);
+
+    /**
+     * @brief sendDeferredNote creates the note when the batch is sent, so that it describes the state at that time.
+     * A deferred note may be null, in which case nothing is sent.
+     */
+    void sendDeferredNote(const std::function<io::NoteConstPtr()>& make_note);
+
+    /**
+     * @brief sendInterval queues a finished interval, intervals are only sent at the profiling rate.
+     * The next interval start of the node is held back until then, so that it never arrives before the intervals that ended earlier.
+     */
+    void sendInterval(const AUUID& node, const std::shared_ptr<const Interval>& interval);
+
+    /**
+     * @brief flush sends all pending notes and intervals immediately
+     */
+    void flush();
+
+    std::size_t getDroppedIntervals() const;
+
+private:
+    struct PendingNote
+    {
+        io::NoteConstPtr note;
+        std::function<io::NoteConstPtr()> make_note;
+    };
+
+private:
+    void run();
+    void send(bool with_intervals);
+
+private:
+    SessionPtr session_;
+
+    std::chrono::steady_clock::duration note_period_;
+    std::chrono::steady_clock::duration profiling_period_;
+
+    std::mutex send_mutex_;
+    // the latest interval start of each node that waits for the intervals of that node, guarded by send_mutex_
+    std::unordered_map<AUUID, io::NoteConstPtr, AUUID::Hasher> held_start_notes_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable notes_available_;
+    bool running_;
+    std::thread worker_;
+
+    std::vector<PendingNote> pending_notes_;
+    std::unordered_map<std::string, std::size_t> pending_states_;
+
+    std::vector<NoteBatch::IntervalPack> pending_intervals_;
+    std::unordered_map<AUUID, std::size_t, AUUID::Hasher> pending_interval_nodes_;
+    std::size_t dropped_intervals_;
+};
+
+}  // namespace csapex
+
+#endif  // NOTE_AGGREGATOR_H
@@ -36,7 +36,7 @@ public:
     class CoreRequest : public RequestImplementation<CoreRequest>
     {
     public:
-        CoreRequest(uint8_t request_id);
+        CoreRequest(uint32_t request_id);
         CoreRequest(CoreRequestType request_type);
 
         template <typename... Args>
@@ -64,9 +64,9 @@ public:
     class CoreResponse : public ResponseImplementation<CoreResponse>
     {
     public:
-        CoreResponse(uint8_t request_id);
-        CoreResponse(CoreRequestType request_type, uint8_t request_id);
-        CoreResponse(CoreRequestType request_type, boost::any result, uint8_t request_id);
+        CoreResponse(uint32_t request_id);
+        CoreResponse(CoreRequestType request_type, uint32_t request_id);
+        CoreResponse(CoreRequestType request_type, boost::any result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -27,7 +27,7 @@ public:
     class GraphRequest : public RequestImplementation<GraphRequest>
     {
     public:
-        GraphRequest(uint8_t request_id);
+        GraphRequest(uint32_t request_id);
         GraphRequest(GraphRequestType request_type, const AUUID& uuid);
 
         template <typename... Args>
@@ -61,9 +61,9 @@ public:
     class GraphResponse : public ResponseImplementation<GraphResponse>
     {
     public:
-        GraphResponse(uint8_t request_id);
-        GraphResponse(GraphRequestType request_type, const AUUID& uuid, uint8_t request_id);
-        GraphResponse(GraphRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id);
+        GraphResponse(uint32_t request_id);
+        GraphResponse(GraphRequestType request_type, const AUUID& uuid, uint32_t request_id);
+        GraphResponse(GraphRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -0,0 +1,53 @@
+#ifndef NOTE_BATCH_H
+#define NOTE_BATCH_H
+
+/// PROJECT
+#include <csapex/io/note_impl.hpp>
+#include <csapex/serialization/serialization_fwd.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <vector>
+
+namespace csapex
+{
+class Interval;
+
+/**
+ * @brief The NoteBatch class carries all notes of one aggregation tick in a single packet.
+ * Finished profiling intervals are packed per node instead of being wrapped into one note each.
+ */
+class NoteBatch : public NoteImplementation<NoteBatch>
+{
+public:
+    struct IntervalPack
+    {
+        AUUID node;
+        std::vector<std::shared_ptr<const Interval>> intervals;
+    };
+
+public:
+    NoteBatch();
+    NoteBatch(const std::vector<io::NoteConstPtr>& notes, const std::vector<IntervalPack>& intervals);
+
+    virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+    const std::vector<io::NoteConstPtr>& getNotes() const;
+    const std::vector<IntervalPack>& getIntervals() const;
+
+    /**
+     * @brief unpack converts the batch back into the individual notes, in the order they have been sent.
+     * Packed intervals are returned as IntervalEndTriggered notes of their node. Intervals that started before an
+     * IntervalStartTriggered note of the same node precede that note, all others follow after the other notes.
+     */
+    std::vector<io::NoteConstPtr> unpack() const;
+
+private:
+    std::vector<io::NoteConstPtr> notes_;
+    std::vector<IntervalPack> intervals_;
+};
+
+}  // namespace csapex
+
+#endif  // NOTE_BATCH_H
@@ -13,7 +13,8 @@ namespace csapex
 {
 enum class ProfilerNoteType
 {
-    EnabledChanged
+    EnabledChanged,
+    WindowReset
 };
 
 class ProfilerNote : public NoteImplementation<ProfilerNote>
@@ -0,0 +1,71 @@
+#ifndef REQUEST_BATCH_H
+#define REQUEST_BATCH_H
+
+/// PROJECT
+#include <csapex/io/request_impl.hpp>
+#include <csapex/io/response_impl.hpp>
+#include <csapex/serialization/serialization_fwd.h>
+
+/// SYSTEM
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The RequestBatch class bundles multiple requests into one packet.
+ * The nested requests keep their own request ids, they are executed in order and
+ * all responses are sent back together in one BatchResponse.
+ */
+class RequestBatch
+{
+public:
+    class BatchRequest : public RequestImplementation<BatchRequest>
+    {
+    public:
+        BatchRequest(const std::vector<RequestConstPtr>& requests);
+        BatchRequest(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        virtual ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const override;
+
+        std::string getType() const override
+        {
+            return "RequestBatch";
+        }
+
+        const std::vector<RequestConstPtr>& getRequests() const;
+
+    private:
+        std::vector<RequestConstPtr> requests_;
+    };
+
+    class BatchResponse : public ResponseImplementation<BatchResponse>
+    {
+    public:
+        BatchResponse(const std::vector<ResponseConstPtr>& responses, uint32_t request_id);
+        BatchResponse(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        std::string getType() const override
+        {
+            return "RequestBatch";
+        }
+
+        const std::vector<ResponseConstPtr>& getResponses() const;
+
+    private:
+        std::vector<ResponseConstPtr> responses_;
+    };
+
+public:
+    using RequestT = BatchRequest;
+    using ResponseT = BatchResponse;
+};
+
+}  // namespace csapex
+
+#endif  // REQUEST_BATCH_H
@@ -0,0 +1,75 @@
+#ifndef REQUEST_GRAPH_SNAPSHOT_H
+#define REQUEST_GRAPH_SNAPSHOT_H
+
+/// PROJECT
+#include <csapex/io/request_impl.hpp>
+#include <csapex/io/response_impl.hpp>
+#include <csapex/model/graph_snapshot.h>
+#include <csapex/serialization/serialization_fwd.h>
+
+/// SYSTEM
+#include <map>
+
+namespace csapex
+{
+/**
+ * @brief The RequestGraphSnapshot class fetches the whole graph hierarchy in one packet, so that a client can attach without
+ * requesting every node, connector and parameter individually.
+ */
+class RequestGraphSnapshot
+{
+public:
+    class GraphSnapshotRequest : public RequestImplementation<GraphSnapshotRequest>
+    {
+    public:
+        GraphSnapshotRequest();
+        GraphSnapshotRequest(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        virtual ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const override;
+
+        std::string getType() const override
+        {
+            return "RequestGraphSnapshot";
+        }
+    };
+
+    class GraphSnapshotResponse : public ResponseImplementation<GraphSnapshotResponse>
+    {
+    public:
+        GraphSnapshotResponse(const NodeSnapshot& root, const std::map<int, std::string>& thread_groups, uint32_t request_id);
+        GraphSnapshotResponse(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        /**
+         * @brief getRoot returns the root node, the rest of the hierarchy is nested in its subgraph
+         */
+        const NodeSnapshot& getRoot() const;
+
+        /**
+         * @brief getThreadGroups maps the ids of all thread groups to their names
+         */
+        const std::map<int, std::string>& getThreadGroups() const;
+
+        std::string getType() const override
+        {
+            return "RequestGraphSnapshot";
+        }
+
+    private:
+        NodeSnapshot root_;
+        std::map<int, std::string> thread_groups_;
+    };
+
+public:
+    using RequestT = GraphSnapshotRequest;
+    using ResponseT = GraphSnapshotResponse;
+};
+
+}  // namespace csapex
+
+#endif  // REQUEST_GRAPH_SNAPSHOT_H
@@ -0,0 +1,69 @@
+#ifndef REQUEST_SHARED_MEMORY_H
+#define REQUEST_SHARED_MEMORY_H
+
+/// PROJECT
+#include <csapex/io/request_impl.hpp>
+#include <csapex/io/response_impl.hpp>
+#include <csapex/serialization/serialization_fwd.h>
+
+namespace csapex
+{
+/**
+ * @brief The RequestSharedMemory class offers the server a shared memory region created by a client on the same host.
+ * If the server can open it, all following packets of the session are exchanged through that region.
+ */
+class RequestSharedMemory
+{
+public:
+    class SharedMemoryRequest : public RequestImplementation<SharedMemoryRequest>
+    {
+    public:
+        SharedMemoryRequest(const std::string& name, uint64_t token);
+        SharedMemoryRequest(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        virtual ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const override;
+
+        const std::string& getName() const;
+        uint64_t getToken() const;
+
+        std::string getType() const override
+        {
+            return "RequestSharedMemory";
+        }
+
+    private:
+        std::string name_;
+        uint64_t token_;
+    };
+
+    class SharedMemoryResponse : public ResponseImplementation<SharedMemoryResponse>
+    {
+    public:
+        SharedMemoryResponse(bool accepted, uint32_t request_id);
+        SharedMemoryResponse(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        bool isAccepted() const;
+
+        std::string getType() const override
+        {
+            return "RequestSharedMemory";
+        }
+
+    private:
+        bool accepted_;
+    };
+
+public:
+    using RequestT = SharedMemoryRequest;
+    using ResponseT = SharedMemoryResponse;
+};
+
+}  // namespace csapex
+
+#endif  // REQUEST_SHARED_MEMORY_H
@@ -0,0 +1,64 @@
+#ifndef STATE_NOTES_H
+#define STATE_NOTES_H
+
+/// PROJECT
+#include <csapex/io/note_impl.hpp>
+#include <csapex/serialization/serialization_fwd.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <boost/any.hpp>
+#include <utility>
+#include <vector>
+
+namespace csapex
+{
+enum class StateNoteType
+{
+    Subscribe,
+    Snapshot,
+    Delta
+};
+
+/**
+ * @brief The StateNote class transports the pushed accessor state of a connector or a node.
+ * Values are identified by the request type of their accessor. A snapshot contains all values,
+ * a delta only the values that changed since the previous version.
+ */
+class StateNote : public NoteImplementation<StateNote>
+{
+public:
+    using Value = std::pair<uint8_t, boost::any>;
+
+public:
+    StateNote();
+    StateNote(StateNoteType note_type, const AUUID& uuid);
+    StateNote(StateNoteType note_type, const AUUID& uuid, uint32_t version, const std::vector<Value>& values);
+
+    virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+    StateNoteType getNoteType() const
+    {
+        return note_type_;
+    }
+
+    uint32_t getStateVersion() const
+    {
+        return state_version_;
+    }
+
+    const std::vector<Value>& getValues() const
+    {
+        return values_;
+    }
+
+private:
+    StateNoteType note_type_;
+    uint32_t state_version_;
+    std::vector<Value> values_;
+};
+
+}  // namespace csapex
+
+#endif  // STATE_NOTES_H
@@ -22,11 +22,16 @@ FWD(RawMessage)
 FWD(Request)
 FWD(Response)
 FWD(Feedback)
+FWD(SharedMemoryTransport)
 
 FWD(Server)
 FWD(GraphServer)
 FWD(NodeServer)
 FWD(ConnectorServer)
+FWD(NoteAggregator)
+FWD(StatePublisher)
+
+FWD(GraphSnapshot)
 
 namespace io
 {
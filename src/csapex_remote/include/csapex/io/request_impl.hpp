@@ -14,7 +14,7 @@ protected:
     CLONABLE_IMPLEMENTATION_CONSTRUCTOR(I, 0);
 
 protected:
-    RequestImplementation(uint8_t id) : Request(id)
+    RequestImplementation(uint32_t id) : Request(id)
     {
     }
 };
@@ -12,17 +12,17 @@ namespace csapex
 class Response : public Streamable
 {
 public:
-    Response(uint8_t id);
+    Response(uint32_t id);
 
     static const uint8_t PACKET_TYPE_ID = 3;
 
     virtual uint8_t getPacketType() const override;
     virtual std::string getType() const = 0;
 
-    uint8_t getRequestID() const;
+    uint32_t getRequestID() const;
 
 protected:
-    uint8_t request_id_;
+    uint32_t request_id_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,99 @@
+#ifndef RESPONSE_FUTURE_H
+#define RESPONSE_FUTURE_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+
+/// SYSTEM
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace csapex
+{
+namespace io
+{
+/**
+ * @brief The ResponseFuture class is the receiving end of an asynchronous request.
+ * In contrast to std::future it can be copied and it supports continuations, which
+ * are called once the response (or nullptr, if the session is stopped) has arrived.
+ */
+class ResponseFuture
+{
+public:
+    using Continuation = std::function<void(const ResponseConstPtr&)>;
+
+    ResponseFuture();
+
+    bool valid() const;
+    bool isReady() const;
+
+    void wait() const;
+    bool waitFor(std::chrono::milliseconds timeout) const;
+
+    /**
+     * @brief get blocks until the response is available
+     */
+    ResponseConstPtr get() const;
+
+    template <typename ResponseT>
+    std::shared_ptr<ResponseT const> getAs() const
+    {
+        return std::dynamic_pointer_cast<ResponseT const>(get());
+    }
+
+    /**
+     * @brief then registers a continuation. If the response is already available, the continuation
+     * is called immediately, otherwise it is called by the thread that receives the response.
+     * Continuations must therefore never block on another response of the same session.
+     */
+    void then(Continuation continuation) const;
+
+private:
+    friend class ResponsePromise;
+
+    struct State
+    {
+        State();
+
+        mutable std::mutex mutex;
+        std::condition_variable ready_changed;
+        bool ready;
+        ResponseConstPtr response;
+        std::vector<Continuation> continuations;
+    };
+
+    explicit ResponseFuture(const std::shared_ptr<State>& state);
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief The ResponsePromise class is the sending end of an asynchronous request
+ */
+class ResponsePromise
+{
+public:
+    ResponsePromise();
+
+    ResponseFuture getFuture() const;
+
+    /**
+     * @brief setResponse fulfills the promise, only the first call has an effect
+     * @return true, iff the promise was fulfilled by this call
+     */
+    bool setResponse(const ResponseConstPtr& response) const;
+
+private:
+    std::shared_ptr<ResponseFuture::State> state_;
+};
+
+}  // namespace io
+
+}  // namespace csapex
+
+#endif  // RESPONSE_FUTURE_H
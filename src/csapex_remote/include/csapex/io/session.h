@@ -6,15 +6,20 @@
 #include <csapex/serialization/serialization_fwd.h>
 #include <csapex/model/observer.h>
 #include <csapex/io/remote_io_fwd.h>
+#include <csapex/io/response_future.h>
+#include <csapex/serialization/serialization_buffer.h>
 #include <csapex/utility/uuid.h>
 #include <csapex/utility/slim_signal.hpp>
 
 /// SYSTEM
 #include <boost/asio.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
-#include <future>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
-#include <boost/asio.hpp>
+#include <vector>
 
 namespace csapex
 {
@@ -53,6 +58,24 @@ public:
     //
     ResponseConstPtr sendRequest(RequestConstPtr request);
 
+    /**
+     * @brief sendRequestAsync sends the request without waiting for the response.
+     * The future yields nullptr if the session is stopped before the response arrives.
+     */
+    io::ResponseFuture sendRequestAsync(RequestConstPtr request);
+
+    /**
+     * @brief sendRequestBatch sends all requests in one packet, the server answers them with one combined response.
+     * @return one future per request, in the same order
+     */
+    std::vector<io::ResponseFuture> sendRequestBatch(const std::vector<RequestConstPtr>& requests);
+
+    template <typename RequestWrapper, typename... Args>
+    io::ResponseFuture sendRequestAsync(Args&&... args)
+    {
+        return sendRequestAsync(std::make_shared<typename RequestWrapper::RequestT>(std::forward<Args>(args)...));
+    }
+
     template <typename RequestWrapper>
     std::shared_ptr<typename RequestWrapper::ResponseT const> sendRequest(std::shared_ptr<typename RequestWrapper::RequestT const> request)
     {
@@ -97,10 +120,29 @@ public:
     //
     io::ChannelPtr openChannel(const AUUID& name);
 
+    //
+    // SHARED MEMORY
+    //
+    /**
+     * @brief negotiateSharedMemory moves the traffic of a session to shared memory, if both ends run on the same host.
+     * The socket stays open, so that either side still notices when the other one disconnects.
+     * @return true, if all following packets are exchanged through shared memory
+     */
+    bool negotiateSharedMemory(std::size_t capacity = 4 * 1024 * 1024);
+
+    /**
+     * @brief acceptSharedMemory opens the region offered by the client, the response to the given request is the last packet sent via the socket
+     * @return false, if the region cannot be opened from here
+     */
+    bool acceptSharedMemory(const std::string& name, uint64_t token, uint32_t request_id);
+
+    bool isUsingSharedMemory() const;
+
 protected:
     Session(const std::string& name);
 
     void handleFeedback(const ResponseConstPtr& fb);
+    void handleNote(const io::NoteConstPtr& note);
 
 public:
     slim_signal::Signal<void(Session*)> started;
@@ -115,22 +157,61 @@ protected:
     void mainLoop();
 
     void read_async();
+    void read_body_async(uint32_t message_length);
+    void handleMessage(SerializationBuffer& buffer);
 
-    void write_packet(SerializationBuffer& buffer);
+    void startSharedMemoryReader(const SharedMemoryTransportPtr& transport);
+    void closeSharedMemory();
+
+    /**
+     * @brief write_async sends the queued packets if no write is in progress.
+     * Control packets are taken first, notes and raw messages fill up the rest of the batch.
+     * All packets of one batch are sent with a single scatter-gather write.
+     */
+    void write_async();
+    void finishBatch();
+    bool isIoThread() const;
+
+    uint32_t makeRequestID();
+    io::ResponseFuture registerRequest(const RequestConstPtr& request);
+    bool completeRequest(uint32_t request_id, const ResponseConstPtr& response);
 
 protected:
     std::thread packet_handler_thread_;
     std::unique_ptr<Socket> socket_;
 
-    uint8_t next_request_id_;
+    std::atomic<uint32_t> next_request_id_;
 
     std::recursive_mutex packets_mutex_;
     std::condition_variable_any packets_available_;
+    std::deque<StreamableConstPtr> control_packets_received_;
     std::deque<StreamableConstPtr> packets_received_;
-    std::deque<StreamableConstPtr> packets_to_send_;
+
+    // the receive buffer is reused for every message, only one read is in progress at a time.
+    // the handlers of pending reads share it, so it outlives the session until they have been called
+    std::shared_ptr<SerializationBuffer> receive_buffer_;
+
+    mutable std::mutex send_mutex_;
+    std::condition_variable send_space_available_;
+    std::deque<StreamableConstPtr> control_packets_to_send_;
+    std::deque<StreamableConstPtr> bulk_packets_to_send_;
+    // shared with the handler of the pending write, like the receive buffer
+    std::shared_ptr<std::vector<SerializationBuffer>> buffers_in_flight_;
+    bool write_in_flight_;
+    std::atomic<std::thread::id> io_thread_;
+
+    // once the packet with the given type and request id has been sent, the writes switch to shared memory,
+    // or are paused until the client knows whether the server has accepted it
+    uint8_t switch_packet_type_;
+    uint32_t switch_request_id_;
+    bool switch_after_batch_;
+    bool writes_paused_;
+    bool write_to_shared_memory_;
+    SharedMemoryTransportPtr shared_memory_;
+    std::thread shared_memory_reader_thread_;
 
     std::recursive_mutex open_requests_mutex_;
-    std::map<uint8_t, std::promise<ResponseConstPtr>*> open_requests_;
+    std::unordered_map<uint32_t, io::ResponsePromise> open_requests_;
 
     std::recursive_mutex running_mutex_;
     std::atomic<bool> running_;
@@ -0,0 +1,91 @@
+#ifndef SHARED_MEMORY_TRANSPORT_H
+#define SHARED_MEMORY_TRANSPORT_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+
+/// SYSTEM
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/interprocess/interprocess_fwd.hpp>
+
+namespace csapex
+{
+namespace impl
+{
+struct SharedMemoryRing;
+struct SharedMemoryHeader;
+}  // namespace impl
+
+/**
+ * @brief The SharedMemoryTransport class connects the two ends of a session on the same host with a pair of ring buffers.
+ * The client creates the named region and sends its name to the server, which opens it. Once both sides have mapped it,
+ * the name is removed again and the memory is freed as soon as both sides are gone.
+ * Each ring has a single writer and a single reader, so one end must not write or read from several threads at once.
+ */
+class SharedMemoryTransport
+{
+public:
+    /**
+     * @brief create allocates a new region with two rings of the given capacity
+     */
+    static SharedMemoryTransportPtr create(std::size_t capacity);
+
+    /**
+     * @brief open maps a region created by the other end, the token has to match the one it was created with
+     * @return nullptr, if no such region exists on this host
+     */
+    static SharedMemoryTransportPtr open(const std::string& name, uint64_t token);
+
+    ~SharedMemoryTransport();
+
+    const std::string& getName() const;
+    uint64_t getToken() const;
+
+    /**
+     * @brief unlink removes the name of the region, the mapping stays valid
+     */
+    void unlink();
+
+    /**
+     * @brief write copies the data into the outgoing ring, waits for the other end if the ring is full.
+     * Data larger than the ring is streamed through it.
+     * @return false, if the transport has been closed
+     */
+    bool write(const uint8_t* data, std::size_t length);
+
+    /**
+     * @brief read waits until the requested amount of data has been received
+     * @return false, if the transport has been closed
+     */
+    bool read(uint8_t* data, std::size_t length);
+
+    /**
+     * @brief close wakes up both ends, all following reads and writes fail
+     */
+    void close();
+
+private:
+    SharedMemoryTransport(const std::string& name, bool is_creator);
+
+private:
+    std::string name_;
+    bool is_creator_;
+    std::atomic<bool> closed_;
+    // only a completely set up transport closes the rings, a failed open must not close those of the other end
+    bool owns_rings_;
+
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+
+    impl::SharedMemoryHeader* header_;
+    impl::SharedMemoryRing* outgoing_;
+    impl::SharedMemoryRing* incoming_;
+    uint8_t* outgoing_data_;
+    uint8_t* incoming_data_;
+};
+
+}  // namespace csapex
+
+#endif  // SHARED_MEMORY_TRANSPORT_H
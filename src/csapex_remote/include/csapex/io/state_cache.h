@@ -0,0 +1,66 @@
+#ifndef STATE_CACHE_H
+#define STATE_CACHE_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+
+/// SYSTEM
+#include <boost/any.hpp>
+#include <mutex>
+#include <unordered_map>
+
+namespace csapex
+{
+class StateNote;
+
+/**
+ * @brief The StateCache class holds the state accessors that a StatePublisher pushes for one object.
+ * Deltas are applied in version order on top of the first snapshot, older updates are ignored.
+ */
+class StateCache
+{
+public:
+    StateCache();
+
+    /**
+     * @brief preset provides a value that is known before the first snapshot has arrived
+     */
+    template <typename Type>
+    void preset(Type type, const boost::any& value)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        values_[static_cast<uint8_t>(type)] = value;
+    }
+
+    /**
+     * @brief get returns the last cached value without waiting for a snapshot
+     * @return false, iff the value is not known yet
+     */
+    template <typename Type>
+    bool get(Type type, boost::any& value) const
+    {
+        return getValue(static_cast<uint8_t>(type), value);
+    }
+
+    /**
+     * @brief apply updates the cache from a Snapshot or a Delta note
+     * @return false, iff the note was ignored
+     */
+    bool apply(const StateNote& note);
+
+    uint32_t getVersion() const;
+
+private:
+    bool getValue(uint8_t id, boost::any& value) const;
+
+private:
+    mutable std::mutex mutex_;
+
+    bool has_snapshot_;
+    uint32_t version_;
+    std::unordered_map<uint8_t, boost::any> values_;
+};
+
+}  // namespace csapex
+
+#endif  // STATE_CACHE_H
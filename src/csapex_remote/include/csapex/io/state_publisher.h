@@ -0,0 +1,72 @@
+#ifndef STATE_PUBLISHER_H
+#define STATE_PUBLISHER_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <atomic>
+#include <boost/any.hpp>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The StatePublisher class pushes the state accessors of one connector or node to a client.
+ * Changes are only marked, the values are sampled once per note tick and only those that differ
+ * from the previously sent version are transmitted as a StateNote delta.
+ * Nothing is sent before a client has subscribed, the subscription is answered with a snapshot.
+ */
+class StatePublisher : public std::enable_shared_from_this<StatePublisher>
+{
+public:
+    /// a sampler returns an empty value if the observed object is not available, the state is sampled again on the next tick
+    using Sampler = std::function<boost::any()>;
+
+public:
+    StatePublisher(const AUUID& uuid, const NoteAggregatorPtr& notes);
+
+    template <typename Type>
+    void addValue(Type type, const Sampler& sampler)
+    {
+        entries_.push_back(Entry{ static_cast<uint8_t>(type), sampler, {} });
+    }
+
+    void markChanged();
+    void requestSnapshot();
+
+    /**
+     * @brief close stops sampling, it has to be called before the observed object is removed
+     */
+    void close();
+
+private:
+    io::NoteConstPtr makeNote();
+
+private:
+    struct Entry
+    {
+        uint8_t id;
+        Sampler sample;
+        std::vector<uint8_t> last_sent;
+    };
+
+    AUUID uuid_;
+    NoteAggregatorPtr notes_;
+
+    std::atomic<bool> subscribed_;
+    std::atomic<bool> scheduled_;
+    std::atomic<bool> snapshot_requested_;
+    std::atomic<bool> closed_;
+
+    std::mutex mutex_;
+    uint32_t version_;
+    std::vector<Entry> entries_;
+};
+
+}  // namespace csapex
+
+#endif  // STATE_PUBLISHER_H
@@ -5,6 +5,7 @@
 #include <csapex/model/connector.h>
 #include <csapex/io/session.h>
 #include <csapex/io/proxy.h>
+#include <csapex/io/state_cache.h>
 
 namespace csapex
 {
@@ -13,6 +14,7 @@ class ConnectorProxy : public Connector, public Observer, public Proxy
 public:
     ConnectorProxy(const SessionPtr& session, UUID uuid, ConnectableOwnerPtr owner);
     ConnectorProxy(const SessionPtr& session, UUID uuid, ConnectableOwnerPtr owner, const ConnectorDescription& cd);
+    ~ConnectorProxy();
 
     virtual bool isConnectedTo(const UUID& other) const override;
     virtual bool isActivelyConnectedTo(const UUID& other) const override;
@@ -32,6 +34,7 @@ public:
 
 private:
     io::ChannelPtr channel_;
+    StateCache state_;
 
 /**
  * begin: generate caches
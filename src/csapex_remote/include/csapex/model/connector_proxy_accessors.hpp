@@ -8,22 +8,26 @@ HANDLE_STATIC_ACCESSOR(IsGraphPort, bool, isGraphPort)
 HANDLE_STATIC_ACCESSOR(GetConnectorType, ConnectorType, getConnectorType)
 HANDLE_STATIC_ACCESSOR(MaxConnectionCount, int, maxConnectionCount)
 
-// TODO: make these dynamic
-HANDLE_STATIC_ACCESSOR(GetDescription, ConnectorDescription, getDescription)
-HANDLE_STATIC_ACCESSOR(IsConnected, bool, isConnected)
-
 HANDLE_DYNAMIC_ACCESSOR(IsEssential, essential_changed, bool, isEssential)
 HANDLE_DYNAMIC_ACCESSOR(GetLabel, labelChanged, std::string, getLabel)
 HANDLE_DYNAMIC_ACCESSOR(IsEnabled, enabled_changed, bool, isEnabled)
 HANDLE_DYNAMIC_ACCESSOR(GetType, typeChanged, TokenDataConstPtr, getType)
 
-HANDLE_ACCESSOR(GetCount, int, getCount)
-HANDLE_ACCESSOR(GetSequenceNumber, int, sequenceNumber)
-HANDLE_ACCESSOR(GetConnectionCount, int, countConnections)
-HANDLE_ACCESSOR(HasActiveConnection, bool, hasActiveConnection)
-HANDLE_ACCESSOR(MakeStatusString, std::string, makeStatusString)
-HANDLE_ACCESSOR(GetConnectedPorts, std::vector<UUID>, getConnectedPorts)
+// state accessors are pushed by the server when they change, unless handled explicitly they are plain accessors
+#ifndef HANDLE_STATE_ACCESSOR
+#define HANDLE_STATE_ACCESSOR(_enum, type, function) HANDLE_ACCESSOR(_enum, type, function)
+#endif
+
+HANDLE_STATE_ACCESSOR(GetDescription, ConnectorDescription, getDescription)
+HANDLE_STATE_ACCESSOR(IsConnected, bool, isConnected)
+HANDLE_STATE_ACCESSOR(GetCount, int, getCount)
+HANDLE_STATE_ACCESSOR(GetSequenceNumber, int, sequenceNumber)
+HANDLE_STATE_ACCESSOR(GetConnectionCount, int, countConnections)
+HANDLE_STATE_ACCESSOR(HasActiveConnection, bool, hasActiveConnection)
+HANDLE_STATE_ACCESSOR(MakeStatusString, std::string, makeStatusString)
+HANDLE_STATE_ACCESSOR(GetConnectedPorts, std::vector<UUID>, getConnectedPorts)
 
+#undef HANDLE_STATE_ACCESSOR
 #undef HANDLE_DYNAMIC_ACCESSOR
 #undef HANDLE_STATIC_ACCESSOR
 #undef HANDLE_ACCESSOR
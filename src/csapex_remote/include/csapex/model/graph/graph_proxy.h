@@ -10,6 +10,8 @@
 namespace csapex
 {
 class GraphImplementation;
+struct GraphSnapshot;
+struct NodeSnapshot;
 
 class GraphProxy : public Graph, public Observer
 {
@@ -44,6 +46,7 @@ public:
     ConnectionDescription getConnectionWithId(int id) const;
 
     void reload();
+    void reload(const GraphSnapshot& snapshot);
 
 /**
  * begin: generate getters
@@ -60,7 +63,7 @@ public:
      **/
 
 private:
-    void vertexAdded(const UUID& id);
+    void vertexAdded(const UUID& id, const NodeSnapshot* snapshot = nullptr);
     void vertexRemoved(const UUID& id);
 
     void connectionAdded(const ConnectionDescription& id);
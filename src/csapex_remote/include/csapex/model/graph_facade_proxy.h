@@ -9,11 +9,17 @@ namespace csapex
 {
 class GraphFacadeImplementation;
 class GraphProxy;
+struct GraphSnapshot;
 
 class GraphFacadeProxy : public GraphFacade, public Proxy
 {
 public:
     GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, GraphFacadeProxy* parent = nullptr);
+
+    /**
+     * @brief GraphFacadeProxy creates the whole hierarchy from a snapshot instead of requesting it piece by piece
+     */
+    GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, const GraphSnapshot& snapshot, GraphFacadeProxy* parent = nullptr);
     ~GraphFacadeProxy();
 
     virtual AUUID getAbsoluteUUID() const override;
@@ -79,6 +85,9 @@ protected:
     void createSubgraphFacade(NodeFacadePtr nf);
     void destroySubgraphFacade(NodeFacadePtr nf);
 
+private:
+    GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, const GraphSnapshot* snapshot, GraphFacadeProxy* parent);
+
 private:
     GraphFacadeProxy* parent_;
     io::ChannelPtr graph_channel_;
@@ -108,6 +117,9 @@ private:
 
     std::unordered_map<UUID, std::shared_ptr<GraphFacadeProxy>, UUID::Hasher> children_;
 
+    /// only set while the proxy is being constructed from a snapshot
+    const GraphSnapshot* snapshot_;
+
     long guard_;
 };
 
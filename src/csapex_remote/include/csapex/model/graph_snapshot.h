@@ -0,0 +1,82 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+#include <csapex/model/connection_description.h>
+#include <csapex/model/connector_description.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/param/param_fwd.h>
+#include <csapex/serialization/serializable.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <map>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The NodeSnapshot struct contains everything a NodeFacadeProxy would otherwise request one by one
+ */
+struct NodeSnapshot : public Serializable
+{
+protected:
+    CLONABLE_IMPLEMENTATION(NodeSnapshot);
+
+public:
+    UUID uuid;
+    std::string type;
+    std::string label;
+    int scheduler_id;
+    bool is_graph;
+
+    NodeStatePtr state;
+    std::vector<param::ParameterPtr> parameters;
+
+    std::vector<ConnectorDescription> external_inputs;
+    std::vector<ConnectorDescription> external_outputs;
+    std::vector<ConnectorDescription> external_events;
+    std::vector<ConnectorDescription> external_slots;
+
+    std::vector<ConnectorDescription> internal_inputs;
+    std::vector<ConnectorDescription> internal_outputs;
+    std::vector<ConnectorDescription> internal_events;
+    std::vector<ConnectorDescription> internal_slots;
+
+    /// only set for graph nodes
+    GraphSnapshotPtr subgraph;
+
+    NodeSnapshot();
+
+    static NodeSnapshot create(const NodeFacadeImplementationPtr& node, const GraphFacadeImplementationPtr& parent);
+
+    virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+};
+
+/**
+ * @brief The GraphSnapshot struct describes one level of the graph hierarchy, subgraphs are nested in their nodes
+ */
+struct GraphSnapshot : public Serializable
+{
+protected:
+    CLONABLE_IMPLEMENTATION(GraphSnapshot);
+
+public:
+    std::vector<NodeSnapshot> nodes;
+    std::vector<ConnectionDescription> connections;
+
+    GraphSnapshot();
+
+    static GraphSnapshotPtr create(const GraphFacadeImplementationPtr& graph);
+
+    const NodeSnapshot* findNode(const UUID& uuid) const;
+
+    virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+};
+
+}  // namespace csapex
+
+#endif  // GRAPH_SNAPSHOT_H
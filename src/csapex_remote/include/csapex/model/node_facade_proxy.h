@@ -6,6 +6,7 @@
 #include <csapex/io/io_fwd.h>
 #include <csapex/serialization/streamable.h>
 #include <csapex/io/proxy.h>
+#include <csapex/io/state_cache.h>
 
 /// SYSTEM
 #include <unordered_map>
@@ -13,11 +14,13 @@
 namespace csapex
 {
 class ProfilerProxy;
+struct NodeSnapshot;
 
 class CSAPEX_CORE_EXPORT NodeFacadeProxy : public NodeFacade, public Proxy
 {
 public:
     NodeFacadeProxy(const SessionPtr& session, AUUID uuid);
+    NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot& snapshot);
 
     ~NodeFacadeProxy();
 
@@ -70,14 +73,22 @@ public:
     void removeConnectorProxy(const ConnectorDescription& cd);
 
 private:
+    NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot* snapshot);
+
     void handleBroadcast(const BroadcastMessageConstPtr& message) override;
 
     void createParameterProxy(param::ParameterPtr proxy) const;
 
+    /**
+     * @brief fetchParameterConnectorFlags asks for the parameter flags of all uncached inputs and outputs in one batch
+     */
+    void fetchParameterConnectorFlags();
+
 private:
     AUUID uuid_;
 
     io::ChannelPtr node_channel_;
+    StateCache state_;
 
 /**
  * begin: generate caches
@@ -1,19 +1,23 @@
-// TODO: make these dynamic
+// state accessors are pushed by the server when they change, unless handled explicitly they are plain accessors
+#ifndef HANDLE_STATE_ACCESSOR
+#define HANDLE_STATE_ACCESSOR(_enum, type, function) HANDLE_ACCESSOR(_enum, type, function)
+#endif
+
 HANDLE_ACCESSOR(GetDebugDescription, std::string, getDebugDescription)
-HANDLE_ACCESSOR(CanStartStepping, bool, canStartStepping)
-HANDLE_ACCESSOR(IsActive, bool, isActive)
-HANDLE_ACCESSOR(IsSource, bool, isSource)
-HANDLE_ACCESSOR(IsSink, bool, isSink)
-HANDLE_ACCESSOR(IsProcessingNothingMessages, bool, isProcessingNothingMessages)
-HANDLE_ACCESSOR(GetExecutionState, ExecutionState, getExecutionState)
+HANDLE_STATE_ACCESSOR(CanStartStepping, bool, canStartStepping)
+HANDLE_STATE_ACCESSOR(IsActive, bool, isActive)
+HANDLE_STATE_ACCESSOR(IsSource, bool, isSource)
+HANDLE_STATE_ACCESSOR(IsSink, bool, isSink)
+HANDLE_STATE_ACCESSOR(IsProcessingNothingMessages, bool, isProcessingNothingMessages)
+HANDLE_STATE_ACCESSOR(GetExecutionState, ExecutionState, getExecutionState)
 
 HANDLE_DYNAMIC_ACCESSOR(GetLabel, label_changed, std::string, getLabel)
 HANDLE_DYNAMIC_ACCESSOR(GetSchedulerId, scheduler_changed, int, getSchedulerId)
 
-HANDLE_ACCESSOR(GetExecutionFrequency, double, getExecutionFrequency)
-HANDLE_ACCESSOR(GetMaximumFrequency, double, getMaximumFrequency)
-HANDLE_ACCESSOR(GetNodeCharacteristics, NodeCharacteristics, getNodeCharacteristics)
-HANDLE_ACCESSOR(IsProcessingEnabled, bool, isProcessingEnabled)
+HANDLE_STATE_ACCESSOR(GetExecutionFrequency, double, getExecutionFrequency)
+HANDLE_STATE_ACCESSOR(GetMaximumFrequency, double, getMaximumFrequency)
+HANDLE_STATE_ACCESSOR(GetNodeCharacteristics, NodeCharacteristics, getNodeCharacteristics)
+HANDLE_STATE_ACCESSOR(IsProcessingEnabled, bool, isProcessingEnabled)
 HANDLE_DYNAMIC_ACCESSOR(GetExternalInputs, external_inputs_changed, std::vector<ConnectorDescription>, getExternalInputs)
 HANDLE_DYNAMIC_ACCESSOR(GetExternalOutputs, external_outputs_changed, std::vector<ConnectorDescription>, getExternalOutputs)
 HANDLE_DYNAMIC_ACCESSOR(GetExternalEvents, external_events_changed, std::vector<ConnectorDescription>, getExternalEvents)
@@ -22,7 +26,7 @@ HANDLE_DYNAMIC_ACCESSOR(GetInternalInputs, internal_inputs_changed, std::vector<
 HANDLE_DYNAMIC_ACCESSOR(GetInternalOutputs, internal_outputs_changed, std::vector<ConnectorDescription>, getInternalOutputs)
 HANDLE_DYNAMIC_ACCESSOR(GetInternalEvents, internal_events_changed, std::vector<ConnectorDescription>, getInternalEvents)
 HANDLE_DYNAMIC_ACCESSOR(GetInternalSlots, internal_slots_changed, std::vector<ConnectorDescription>, getInternalSlots)
-HANDLE_ACCESSOR(IsProfiling, bool, isProfiling)
+HANDLE_STATE_ACCESSOR(IsProfiling, bool, isProfiling)
 
 HANDLE_STATIC_ACCESSOR(HasVariadicInputs, bool, hasVariadicInputs)
 HANDLE_STATIC_ACCESSOR(HasVariadicOutputs, bool, hasVariadicOutputs)
@@ -39,6 +43,7 @@ HANDLE_SIGNAL(ParameterSetChanged, parameter_set_changed)
 HANDLE_SIGNAL(ActivationChanged, activation_changed)
 HANDLE_SIGNAL(Destroyed, destroyed)
 
+#undef HANDLE_STATE_ACCESSOR
 #undef HANDLE_DYNAMIC_ACCESSOR
 #undef HANDLE_STATIC_ACCESSOR
 #undef HANDLE_ACCESSOR
@@ -15,9 +15,20 @@ public:
     ProfilerProxy(io::ChannelPtr node_channel);
 
     virtual void setEnabled(bool enabled);
+    void resetWindow() override;
 
     void updateInterval(std::shared_ptr<const Interval>& interval);
 
+    /**
+     * @brief fetchHistogram requests the latency histogram of one step from the server and stores it in the local profile
+     */
+    LatencyHistogram fetchHistogram(const std::string& key, const std::string& step);
+
+    /**
+     * @brief fetchCounter requests an event counter of one profile from the server and stores it in the local profile
+     */
+    long fetchCounter(const std::string& key, const std::string& counter);
+
 private:
     io::ChannelPtr node_channel_;
 };
@@ -16,10 +16,10 @@ public:
     virtual ~RequestSerializerInterface();
 
     virtual void serializeRequest(const Request& packet, SerializationBuffer& data) = 0;
-    virtual RequestPtr deserializeRequest(const SerializationBuffer& data, uint8_t request_id) = 0;
+    virtual RequestPtr deserializeRequest(const SerializationBuffer& data, uint32_t request_id) = 0;
 
     virtual void serializeResponse(const Response& packet, SerializationBuffer& data) = 0;
-    virtual ResponsePtr deserializeResponse(const SerializationBuffer& data, uint8_t request_id) = 0;
+    virtual ResponsePtr deserializeResponse(const SerializationBuffer& data, uint32_t request_id) = 0;
 };
 
 class RequestSerializer : public Singleton<RequestSerializer>, public Serializer
@@ -55,7 +55,7 @@ struct RequestSerializerRegistered
         {                                                                                                                                                                                              \
             packet.serializeVersioned(data);                                                                                                                                                           \
         }                                                                                                                                                                                              \
-        virtual RequestPtr deserializeRequest(const SerializationBuffer& data, uint8_t request_id) override                                                                                            \
+        virtual RequestPtr deserializeRequest(const SerializationBuffer& data, uint32_t request_id) override                                                                                            \
         {                                                                                                                                                                                              \
             auto result = std::make_shared<typename Name::RequestT>(request_id);                                                                                                                       \
             result->deserializeVersioned(data);                                                                                                                                                        \
@@ -65,7 +65,7 @@ struct RequestSerializerRegistered
         {                                                                                                                                                                                              \
             packet.serializeVersioned(data);                                                                                                                                                           \
         }                                                                                                                                                                                              \
-        virtual ResponsePtr deserializeResponse(const SerializationBuffer& data, uint8_t request_id) override                                                                                          \
+        virtual ResponsePtr deserializeResponse(const SerializationBuffer& data, uint32_t request_id) override                                                                                          \
         {                                                                                                                                                                                              \
             auto result = std::make_shared<typename Name::ResponseT>(request_id);                                                                                                                      \
             result->deserializeVersioned(data);                                                                                                                                                        \
@@ -7,18 +7,24 @@
 #include <csapex/io/session.h>
 #include <csapex/io/channel.h>
 #include <csapex/io/protcol/connector_notes.h>
+#include <csapex/io/protcol/connector_requests.h>
+#include <csapex/io/protcol/state_notes.h>
+#include <csapex/io/state_publisher.h>
 
 /// SYSTEM
 #include <iostream>
 
 using namespace csapex;
 
-ConnectorServer::ConnectorServer(SessionPtr session) : session_(session)
+ConnectorServer::ConnectorServer(SessionPtr session, NoteAggregatorPtr notes) : session_(session), notes_(notes)
 {
 }
 
 ConnectorServer::~ConnectorServer()
 {
+    for (auto& pair : publishers_) {
+        pair.second->close();
+    }
 }
 
 void ConnectorServer::startObserving(const ConnectablePtr& connector)
@@ -38,7 +44,50 @@ void ConnectorServer::startObserving(const ConnectablePtr& connector)
      * end: connect signals
      **/
 
+    StatePublisherPtr publisher = std::make_shared<StatePublisher>(connector->getAUUID(), notes_);
+    std::weak_ptr<Connectable> weak_connector = connector;
+
+/**
+ * begin: publish state
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)
+#define HANDLE_STATE_ACCESSOR(_enum, type, function)                                                                                                                                                   \
+    publisher->addValue(ConnectorRequests::ConnectorRequestType::_enum, [weak_connector]() -> boost::any {                                                                                             \
+        if (ConnectablePtr c = weak_connector.lock()) {                                                                                                                                                \
+            return c->function();                                                                                                                                                                      \
+        }                                                                                                                                                                                              \
+        return boost::any();                                                                                                                                                                           \
+    });
+
+#include <csapex/model/connector_proxy_accessors.hpp>
+    /**
+     * end: publish state
+     **/
+
+    observe(channel->note_received, [publisher](const io::NoteConstPtr& note) {
+        if (auto state_note = std::dynamic_pointer_cast<StateNote const>(note)) {
+            if (state_note->getNoteType() == StateNoteType::Subscribe) {
+                publisher->requestSnapshot();
+            }
+        }
+    });
+
+    auto connector_changed = [publisher](const ConnectablePtr&) { publisher->markChanged(); };
+    auto connection_changed = [publisher](const ConnectionPtr&) { publisher->markChanged(); };
+    auto flag_changed = [publisher](bool) { publisher->markChanged(); };
+    observe(connector->message_processed, connector_changed);
+    observe(connector->connection_added_to, connector_changed);
+    observe(connector->connection_removed_to, connector_changed);
+    observe(connector->disconnected, connector_changed);
+    observe(connector->connection_added, connection_changed);
+    observe(connector->connection_faded, connection_changed);
+    observe(connector->connectionEnabled, flag_changed);
+    observe(connector->enabled_changed, flag_changed);
+
     channels_[connector->getAUUID()] = channel;
+    publishers_[connector->getAUUID()] = publisher;
 }
 
 void ConnectorServer::stopObserving(const ConnectablePtr& connector)
@@ -47,4 +96,9 @@ void ConnectorServer::stopObserving(const ConnectablePtr& connector)
     if (pos != channels_.end()) {
         channels_.erase(pos);
     }
+    auto publisher = publishers_.find(connector->getAUUID());
+    if (publisher != publishers_.end()) {
+        publisher->second->close();
+        publishers_.erase(publisher);
+    }
 }
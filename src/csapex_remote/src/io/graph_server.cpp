@@ -21,9 +21,9 @@
 
 using namespace csapex;
 
-GraphServer::GraphServer(SessionPtr session) : session_(session)
+GraphServer::GraphServer(SessionPtr session, NoteAggregatorPtr notes) : session_(session)
 {
-    node_server_ = std::make_shared<NodeServer>(session);
+    node_server_ = std::make_shared<NodeServer>(session, notes);
 }
 
 GraphServer::~GraphServer()
@@ -5,25 +5,34 @@
 #include <csapex/model/connectable.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/node_characteristics.h>
 #include <csapex/io/session.h>
 #include <csapex/io/connector_server.h>
 #include <csapex/io/channel.h>
+#include <csapex/io/note_aggregator.h>
 #include <csapex/io/protcol/node_notes.h>
+#include <csapex/io/protcol/node_requests.h>
+#include <csapex/io/protcol/state_notes.h>
+#include <csapex/io/state_publisher.h>
 #include <csapex/io/protcol/profiler_note.h>
 #include <csapex/profiling/profiler.h>
+#include <csapex/param/parameter.h>
 
 /// SYSTEM
 #include <iostream>
 
 using namespace csapex;
 
-NodeServer::NodeServer(SessionPtr session) : session_(session)
+NodeServer::NodeServer(SessionPtr session, NoteAggregatorPtr notes) : session_(session), notes_(notes)
 {
-    connector_server_ = std::make_shared<ConnectorServer>(session_);
+    connector_server_ = std::make_shared<ConnectorServer>(session_, notes_);
 }
 
 NodeServer::~NodeServer()
 {
+    for (auto& pair : publishers_) {
+        pair.second->close();
+    }
     stopObserving();
 }
 
@@ -36,50 +45,109 @@ void NodeServer::startObservingNode(const NodeFacadeImplementationPtr& node)
         connector_server_->startObserving(std::dynamic_pointer_cast<Connectable>(c));
     }
 
+    // notes that only describe the current state of the node supersede older ones of the same kind
+    AUUID auuid = node->getAUUID();
+    NoteAggregatorPtr notes = notes_;
+    auto state_key = [auuid](NodeNoteType type) { return auuid.getFullName() + "/" + std::to_string(static_cast<int>(type)); };
+
 /**
  * begin: connect signals
  **/
 #define HANDLE_ACCESSOR(_enum, type, function)
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
-    observe(node->signal, [this, channel](const type& new_value) { channel->sendNote<NodeNote>(NodeNoteType::function##Changed, new_value); });
-#define HANDLE_SIGNAL(_enum, signal) observe(node->signal, [this, channel]() { channel->sendNote<NodeNote>(NodeNoteType::_enum##Triggered); });
+    observe(node->signal, [notes, auuid, state_key](const type& new_value) {                                                                                                                           \
+        notes->sendStateNote(state_key(NodeNoteType::function##Changed), std::make_shared<NodeNote>(NodeNoteType::function##Changed, auuid, new_value));                                                 \
+    });
+#define HANDLE_SIGNAL(_enum, signal) observe(node->signal, [notes, auuid]() { notes->sendNote<NodeNote>(NodeNoteType::_enum##Triggered, auuid); });
 
 #include <csapex/model/node_facade_proxy_accessors.hpp>
     /**
      * end: connect signals
      **/
 
-    observe(node->node_state_changed, [this, channel](NodeStatePtr state) { channel->sendNote<NodeNote>(NodeNoteType::NodeStateChanged, state); });
+    observe(node->node_state_changed, [notes, auuid, state_key](NodeStatePtr state) {
+        notes->sendStateNote(state_key(NodeNoteType::NodeStateChanged), std::make_shared<NodeNote>(NodeNoteType::NodeStateChanged, auuid, state));
+    });
+
+    observe(node->parameter_added, [notes, auuid](param::ParameterPtr p) { notes->sendNote<NodeNote>(NodeNoteType::ParameterAddedTriggered, auuid, p); });
+    observe(node->parameter_changed, [notes, auuid, state_key](param::ParameterPtr p) {
+        notes->sendStateNote(state_key(NodeNoteType::ParameterChangedTriggered) + "/" + p->name(), std::make_shared<NodeNote>(NodeNoteType::ParameterChangedTriggered, auuid, p));
+    });
+    observe(node->parameter_removed, [notes, auuid](param::ParameterPtr p) { notes->sendNote<NodeNote>(NodeNoteType::ParameterRemovedTriggered, auuid, p); });
+
+    observe(node->connector_created, [notes, auuid](ConnectorDescription c) { notes->sendNote<NodeNote>(NodeNoteType::ConnectorCreatedTriggered, auuid, c); });
 
-    observe(node->parameter_added, [this, channel](param::ParameterPtr p) { channel->sendNote<NodeNote>(NodeNoteType::ParameterAddedTriggered, p); });
-    observe(node->parameter_changed, [this, channel](param::ParameterPtr p) { channel->sendNote<NodeNote>(NodeNoteType::ParameterChangedTriggered, p); });
-    observe(node->parameter_removed, [this, channel](param::ParameterPtr p) { channel->sendNote<NodeNote>(NodeNoteType::ParameterRemovedTriggered, p); });
+    observe(node->connector_removed, [notes, auuid](ConnectorDescription c) { notes->sendNote<NodeNote>(NodeNoteType::ConnectorRemovedTriggered, auuid, c); });
 
-    observe(node->connector_created, [this, channel](ConnectorDescription c) { channel->sendNote<NodeNote>(NodeNoteType::ConnectorCreatedTriggered, c); });
+    observe(node->connection_start, [notes, auuid](ConnectorDescription c) { notes->sendNote<NodeNote>(NodeNoteType::ConnectionStartTriggered, auuid, c); });
 
-    observe(node->connector_removed, [this, channel](ConnectorDescription c) { channel->sendNote<NodeNote>(NodeNoteType::ConnectorRemovedTriggered, c); });
+    observe(node->connection_added, [notes, auuid](ConnectorDescription c) { notes->sendNote<NodeNote>(NodeNoteType::ConnectionCreatedTriggered, auuid, c); });
 
-    observe(node->connection_start, [this, channel](ConnectorDescription c) { channel->sendNote<NodeNote>(NodeNoteType::ConnectionStartTriggered, c); });
+    observe(node->connection_removed, [notes, auuid](ConnectorDescription c) { notes->sendNote<NodeNote>(NodeNoteType::ConnectionRemovedTriggered, auuid, c); });
 
-    observe(node->connection_added, [this, channel](ConnectorDescription c) { channel->sendNote<NodeNote>(NodeNoteType::ConnectionCreatedTriggered, c); });
+    observe(node->interval_start, [notes, auuid, state_key](NodeFacade* facade, ActivityType type, std::shared_ptr<const Interval> stamp) {
+        notes->sendStateNote(state_key(NodeNoteType::IntervalStartTriggered), std::make_shared<NodeNote>(NodeNoteType::IntervalStartTriggered, auuid, type, stamp));
+    });
 
-    observe(node->connection_removed, [this, channel](ConnectorDescription c) { channel->sendNote<NodeNote>(NodeNoteType::ConnectionRemovedTriggered, c); });
+    observe(node->interval_end, [notes, auuid](NodeFacade* facade, std::shared_ptr<const Interval> stamp) { notes->sendInterval(auuid, stamp); });
+    observe(node->error_event, [notes, auuid, state_key](bool e, const std::string& msg, ErrorState::ErrorLevel level) {
+        notes->sendStateNote(state_key(NodeNoteType::ErrorEvent), std::make_shared<NodeNote>(NodeNoteType::ErrorEvent, auuid, e, msg, level));
+    });
+    observe(node->notification, [notes, auuid](Notification n) { notes->sendNote<NodeNote>(NodeNoteType::Notification, auuid, n); });
 
-    observe(node->interval_start,
-            [this, channel](NodeFacade* facade, ActivityType type, std::shared_ptr<const Interval> stamp) { channel->sendNote<NodeNote>(NodeNoteType::IntervalStartTriggered, type, stamp); });
+    observe(node->start_profiling, [notes, auuid](NodeFacade*) { notes->sendNote<NodeNote>(NodeNoteType::ProfilingStartTriggered, auuid); });
+    observe(node->stop_profiling, [notes, auuid](NodeFacade*) { notes->sendNote<NodeNote>(NodeNoteType::ProfilingStopTriggered, auuid); });
+
+    StatePublisherPtr publisher = std::make_shared<StatePublisher>(auuid, notes);
+    std::weak_ptr<NodeFacadeImplementation> weak_node = node;
+
+/**
+ * begin: publish state
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)
+#define HANDLE_SIGNAL(_enum, signal)
+#define HANDLE_STATE_ACCESSOR(_enum, type, function)                                                                                                                                                   \
+    publisher->addValue(NodeRequests::NodeRequestType::_enum, [weak_node]() -> boost::any {                                                                                                            \
+        if (NodeFacadeImplementationPtr n = weak_node.lock()) {                                                                                                                                        \
+            return n->function();                                                                                                                                                                      \
+        }                                                                                                                                                                                              \
+        return boost::any();                                                                                                                                                                           \
+    });
 
-    observe(node->interval_end, [this, channel](NodeFacade* facade, std::shared_ptr<const Interval> stamp) { channel->sendNote<NodeNote>(NodeNoteType::IntervalEndTriggered, stamp); });
-    observe(node->error_event, [this, channel](bool e, const std::string& msg, ErrorState::ErrorLevel level) { channel->sendNote<NodeNote>(NodeNoteType::ErrorEvent, e, msg, level); });
-    observe(node->notification, [this, channel](Notification n) { channel->sendNote<NodeNote>(NodeNoteType::Notification, n); });
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+    /**
+     * end: publish state
+     **/
 
-    observe(node->start_profiling, [this, channel](NodeFacade*) { channel->sendNote<NodeNote>(NodeNoteType::ProfilingStartTriggered); });
-    observe(node->stop_profiling, [this, channel](NodeFacade*) { channel->sendNote<NodeNote>(NodeNoteType::ProfilingStopTriggered); });
+    observe(channel->note_received, [publisher](const io::NoteConstPtr& note) {
+        if (auto state_note = std::dynamic_pointer_cast<StateNote const>(note)) {
+            if (state_note->getNoteType() == StateNoteType::Subscribe) {
+                publisher->requestSnapshot();
+            }
+        }
+    });
+
+    observe(node->messages_processed, [publisher]() { publisher->markChanged(); });
+    observe(node->activation_changed, [publisher]() { publisher->markChanged(); });
+    observe(node->node_state_changed, [publisher](NodeStatePtr) { publisher->markChanged(); });
+    observe(node->start_profiling, [publisher](NodeFacade*) { publisher->markChanged(); });
+    observe(node->stop_profiling, [publisher](NodeFacade*) { publisher->markChanged(); });
+    observe(node->interval_start, [publisher](NodeFacade*, ActivityType, std::shared_ptr<const Interval>) { publisher->markChanged(); });
+    observe(node->interval_end, [publisher](NodeFacade*, std::shared_ptr<const Interval>) { publisher->markChanged(); });
+    observe(node->connection_added, [publisher](ConnectorDescription) { publisher->markChanged(); });
+    observe(node->connection_removed, [publisher](ConnectorDescription) { publisher->markChanged(); });
+    // a stopped handle releases its node, so the state must not be sampled anymore
+    observe(node->getNodeHandle()->stopped, [publisher]() { publisher->close(); });
 
     ProfilerPtr profiler = node->getProfiler();
     observe(profiler->enabled_changed, [this, channel](bool enabled) { channel->sendNote<ProfilerNote>(ProfilerNoteType::EnabledChanged, enabled); });
+    observe(profiler->window_reset, [this, channel]() { channel->sendNote<ProfilerNote>(ProfilerNoteType::WindowReset); });
 
     channels_[node->getAUUID()] = channel;
+    publishers_[node->getAUUID()] = publisher;
 }
 
 void NodeServer::stopObservingNode(const NodeFacadeImplementationPtr& node)
@@ -88,4 +156,9 @@ void NodeServer::stopObservingNode(const NodeFacadeImplementationPtr& node)
     if (pos != channels_.end()) {
         channels_.erase(pos);
     }
+    auto publisher = publishers_.find(node->getAUUID());
+    if (publisher != publishers_.end()) {
+        publisher->second->close();
+        publishers_.erase(publisher);
+    }
 }
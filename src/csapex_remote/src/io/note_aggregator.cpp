@@ -0,0 +1,197 @@
+/// HEADER
+#include <csapex/io/note_aggregator.h>
+
+/// PROJECT
+#include <csapex/io/protcol/node_notes.h>
+#include <csapex/io/session.h>
+#include <csapex/utility/assert.h>
+#include <csapex/utility/thread.h>
+
+using namespace csapex;
+
+namespace
+{
+// a client that cannot keep up must not make the server buffer intervals without bound
+const std::size_t MAX_PENDING_INTERVALS_PER_NODE = 256;
+
+std::chrono::steady_clock::duration toPeriod(double rate)
+{
+    apex_assert_hard(rate > 0.0);
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+}
+}  // namespace
+
+NoteAggregator::NoteAggregator(SessionPtr session, double note_rate, double profiling_rate)
+  : session_(session), note_period_(toPeriod(note_rate)), profiling_period_(toPeriod(profiling_rate)), running_(true), dropped_intervals_(0)
+{
+    worker_ = std::thread([this]() {
+        csapex::thread::set_name("note aggregator");
+        run();
+    });
+}
+
+NoteAggregator::~NoteAggregator()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    notes_available_.notify_all();
+    worker_.join();
+}
+
+void NoteAggregator::sendNote(const io::NoteConstPtr& note)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_notes_.push_back(PendingNote{ note, nullptr });
+    }
+    notes_available_.notify_all();
+}
+
+void NoteAggregator::sendDeferredNote(const std::function<io::NoteConstPtr()>& make_note)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_notes_.push_back(PendingNote{ nullptr, make_note });
+    }
+    notes_available_.notify_all();
+}
+
+void NoteAggregator::sendStateNote(const std::string& key, const io::NoteConstPtr& note)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = pending_states_.find(key);
+        if (pos != pending_states_.end()) {
+            // the superseded note is only cleared, so that the indices of the other states stay valid
+            pending_notes_[pos->second] = PendingNote();
+        }
+        pending_states_[key] = pending_notes_.size();
+        pending_notes_.push_back(PendingNote{ note, nullptr });
+    }
+    notes_available_.notify_all();
+}
+
+void NoteAggregator::sendInterval(const AUUID& node, const std::shared_ptr<const Interval>& interval)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = pending_interval_nodes_.find(node);
+        if (pos == pending_interval_nodes_.end()) {
+            pos = pending_interval_nodes_.emplace(node, pending_intervals_.size()).first;
+            pending_intervals_.emplace_back();
+            pending_intervals_.back().node = node;
+        }
+
+        std::vector<std::shared_ptr<const Interval>>& intervals = pending_intervals_[pos->second].intervals;
+        if (intervals.size() < MAX_PENDING_INTERVALS_PER_NODE) {
+            intervals.push_back(interval);
+        } else {
+            ++dropped_intervals_;
+        }
+    }
+    notes_available_.notify_all();
+}
+
+void NoteAggregator::flush()
+{
+    send(true);
+}
+
+std::size_t NoteAggregator::getDroppedIntervals() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return dropped_intervals_;
+}
+
+void NoteAggregator::run()
+{
+    auto next_profiling_flush = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        notes_available_.wait(lock, [this]() { return !running_ || !pending_notes_.empty() || !pending_intervals_.empty(); });
+
+        // everything that arrives during one tick is sent together
+        notes_available_.wait_for(lock, note_period_, [this]() { return !running_; });
+        if (!running_) {
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        bool with_intervals = now >= next_profiling_flush;
+        if (with_intervals) {
+            next_profiling_flush = now + profiling_period_;
+        }
+
+        lock.unlock();
+        send(with_intervals);
+        lock.lock();
+    }
+}
+
+void NoteAggregator::send(bool with_intervals)
+{
+    // batches have to leave in the order they were collected
+    std::unique_lock<std::mutex> send_lock(send_mutex_);
+
+    std::vector<PendingNote> pending;
+    std::vector<NoteBatch::IntervalPack> intervals;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending.swap(pending_notes_);
+        pending_states_.clear();
+
+        if (with_intervals) {
+            intervals.swap(pending_intervals_);
+            pending_interval_nodes_.clear();
+        }
+    }
+
+    // start notes held back by an earlier tick are older than anything collected now
+    std::vector<io::NoteConstPtr> notes;
+    if (with_intervals) {
+        for (const auto& held : held_start_notes_) {
+            notes.push_back(held.second);
+        }
+        held_start_notes_.clear();
+    }
+
+    // deferred notes are created without holding the lock, they may query the observed objects
+    std::vector<io::NoteConstPtr> created;
+    created.reserve(pending.size());
+    for (const PendingNote& entry : pending) {
+        io::NoteConstPtr note = entry.make_note ? entry.make_note() : entry.note;
+        if (note) {
+            created.push_back(note);
+        }
+    }
+
+    {
+        // the finished intervals of a node must not arrive after the start of its next interval,
+        // so the start waits for the next profiling flush instead of the intervals being sent early
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const io::NoteConstPtr& note : created) {
+            auto node_note = std::dynamic_pointer_cast<NodeNote const>(note);
+            if (!with_intervals && node_note && node_note->getNoteType() == NodeNoteType::IntervalStartTriggered) {
+                const AUUID& node = node_note->getAUUID();
+                if (held_start_notes_.find(node) != held_start_notes_.end() || pending_interval_nodes_.find(node) != pending_interval_nodes_.end()) {
+                    held_start_notes_[node] = note;
+                    continue;
+                }
+            }
+            notes.push_back(note);
+        }
+    }
+
+    if (notes.empty() && intervals.empty()) {
+        return;
+    }
+
+    if (notes.size() == 1 && intervals.empty()) {
+        session_->sendNote(notes.front());
+    } else {
+        session_->sendNote(std::make_shared<NoteBatch>(notes, intervals));
+    }
+}
@@ -37,7 +37,7 @@ ConnectorRequests::ConnectorRequest::ConnectorRequest(ConnectorRequestType reque
     apex_assert(uuid_ != UUID::NONE);
 }
 
-ConnectorRequests::ConnectorRequest::ConnectorRequest(uint8_t request_id) : RequestImplementation(request_id)
+ConnectorRequests::ConnectorRequest::ConnectorRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -111,16 +111,16 @@ void ConnectorRequests::ConnectorRequest::deserialize(const SerializationBuffer&
 /// RESPONSE
 ///
 
-ConnectorRequests::ConnectorResponse::ConnectorResponse(ConnectorRequestType request_type, uint8_t request_id, const AUUID& uuid)
+ConnectorRequests::ConnectorResponse::ConnectorResponse(ConnectorRequestType request_type, uint32_t request_id, const AUUID& uuid)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-ConnectorRequests::ConnectorResponse::ConnectorResponse(ConnectorRequestType request_type, boost::any result, uint8_t request_id, const AUUID& uuid)
+ConnectorRequests::ConnectorResponse::ConnectorResponse(ConnectorRequestType request_type, boost::any result, uint32_t request_id, const AUUID& uuid)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-ConnectorRequests::ConnectorResponse::ConnectorResponse(uint8_t request_id) : ResponseImplementation(request_id)
+ConnectorRequests::ConnectorResponse::ConnectorResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
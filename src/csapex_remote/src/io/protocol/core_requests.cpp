@@ -24,7 +24,7 @@ CoreRequests::CoreRequest::CoreRequest(CoreRequestType request_type) : RequestIm
 {
 }
 
-CoreRequests::CoreRequest::CoreRequest(uint8_t request_id) : RequestImplementation(request_id)
+CoreRequests::CoreRequest::CoreRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -117,13 +117,13 @@ void CoreRequests::CoreRequest::deserialize(const SerializationBuffer& data, con
 /// RESPONSE
 ///
 
-CoreRequests::CoreResponse::CoreResponse(CoreRequestType request_type, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type)
+CoreRequests::CoreResponse::CoreResponse(CoreRequestType request_type, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type)
 {
 }
-CoreRequests::CoreResponse::CoreResponse(CoreRequestType request_type, boost::any result, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(result)
+CoreRequests::CoreResponse::CoreResponse(CoreRequestType request_type, boost::any result, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(result)
 {
 }
-CoreRequests::CoreResponse::CoreResponse(uint8_t request_id) : ResponseImplementation(request_id)
+CoreRequests::CoreResponse::CoreResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
@@ -28,7 +28,7 @@ GraphRequests::GraphRequest::GraphRequest(GraphRequestType request_type, const A
 {
 }
 
-GraphRequests::GraphRequest::GraphRequest(uint8_t request_id) : RequestImplementation(request_id)
+GraphRequests::GraphRequest::GraphRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -87,15 +87,15 @@ void GraphRequests::GraphRequest::deserialize(const SerializationBuffer& data, c
 /// RESPONSE
 ///
 
-GraphRequests::GraphResponse::GraphResponse(GraphRequestType request_type, const AUUID& uuid, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
+GraphRequests::GraphResponse::GraphResponse(GraphRequestType request_type, const AUUID& uuid, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-GraphRequests::GraphResponse::GraphResponse(GraphRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+GraphRequests::GraphResponse::GraphResponse(GraphRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-GraphRequests::GraphResponse::GraphResponse(uint8_t request_id) : ResponseImplementation(request_id)
+GraphRequests::GraphResponse::GraphResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
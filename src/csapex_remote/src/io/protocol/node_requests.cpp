@@ -31,7 +31,7 @@ NodeRequests::NodeRequest::NodeRequest(NodeRequestType request_type, const AUUID
 {
 }
 
-NodeRequests::NodeRequest::NodeRequest(uint8_t request_id) : RequestImplementation(request_id)
+NodeRequests::NodeRequest::NodeRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -131,15 +131,15 @@ void NodeRequests::NodeRequest::deserialize(const SerializationBuffer& data, con
 /// RESPONSE
 ///
 
-NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
+NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-NodeRequests::NodeResponse::NodeResponse(uint8_t request_id) : ResponseImplementation(request_id)
+NodeRequests::NodeResponse::NodeResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
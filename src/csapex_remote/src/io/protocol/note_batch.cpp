@@ -0,0 +1,109 @@
+/// HEADER
+#include <csapex/io/protcol/note_batch.h>
+
+/// PROJECT
+#include <csapex/io/protcol/node_notes.h>
+#include <csapex/profiling/interval.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/note_serializer.h>
+
+/// SYSTEM
+#include <unordered_map>
+
+CSAPEX_REGISTER_NOTE_SERIALIZER(NoteBatch)
+
+using namespace csapex;
+
+NoteBatch::NoteBatch()
+{
+}
+
+NoteBatch::NoteBatch(const std::vector<io::NoteConstPtr>& notes, const std::vector<IntervalPack>& intervals) : notes_(notes), intervals_(intervals)
+{
+}
+
+void NoteBatch::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    Note::serialize(data, version);
+
+    data << notes_;
+
+    data.writeLength(intervals_.size());
+    for (const IntervalPack& pack : intervals_) {
+        data << pack.node;
+        data.writeLength(pack.intervals.size());
+        for (const std::shared_ptr<const Interval>& interval : pack.intervals) {
+            data << *interval;
+        }
+    }
+}
+
+void NoteBatch::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    Note::deserialize(data, version);
+
+    data >> notes_;
+
+    intervals_.resize(data.readLength());
+    for (IntervalPack& pack : intervals_) {
+        data >> pack.node;
+        std::size_t count = data.readLength();
+        pack.intervals.clear();
+        pack.intervals.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Interval::Ptr interval = Interval::makeEmpty();
+            data >> *interval;
+            pack.intervals.push_back(interval);
+        }
+    }
+}
+
+const std::vector<io::NoteConstPtr>& NoteBatch::getNotes() const
+{
+    return notes_;
+}
+
+const std::vector<NoteBatch::IntervalPack>& NoteBatch::getIntervals() const
+{
+    return intervals_;
+}
+
+std::vector<io::NoteConstPtr> NoteBatch::unpack() const
+{
+    std::unordered_map<AUUID, std::size_t, AUUID::Hasher> pack_of_node;
+    for (std::size_t i = 0; i < intervals_.size(); ++i) {
+        pack_of_node[intervals_[i].node] = i;
+    }
+    std::vector<std::size_t> unpacked(intervals_.size(), 0);
+
+    auto unpackInterval = [this, &unpacked](std::vector<io::NoteConstPtr>& result, std::size_t pack) {
+        const IntervalPack& interval_pack = intervals_[pack];
+        result.push_back(std::make_shared<NodeNote>(NodeNoteType::IntervalEndTriggered, interval_pack.node, interval_pack.intervals[unpacked[pack]++]));
+    };
+
+    std::vector<io::NoteConstPtr> result;
+    result.reserve(notes_.size());
+    for (const io::NoteConstPtr& note : notes_) {
+        // intervals that started before the next interval of their node have to end before it starts
+        auto node_note = std::dynamic_pointer_cast<NodeNote const>(note);
+        if (node_note && node_note->getNoteType() == NodeNoteType::IntervalStartTriggered) {
+            auto pos = pack_of_node.find(node_note->getAUUID());
+            if (pos != pack_of_node.end()) {
+                std::shared_ptr<const Interval> started = node_note->getPayload<std::shared_ptr<const Interval>>(1);
+                const std::vector<std::shared_ptr<const Interval>>& ended = intervals_[pos->second].intervals;
+                while (unpacked[pos->second] < ended.size() && (!started || ended[unpacked[pos->second]]->getStartMicro() < started->getStartMicro())) {
+                    unpackInterval(result, pos->second);
+                }
+            }
+        }
+        result.push_back(note);
+    }
+
+    for (std::size_t pack = 0; pack < intervals_.size(); ++pack) {
+        while (unpacked[pack] < intervals_[pack].intervals.size()) {
+            unpackInterval(result, pack);
+        }
+    }
+    return result;
+}
@@ -19,6 +19,7 @@
 #include <csapex/utility/uuid_provider.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <iostream>
 
 CSAPEX_REGISTER_REQUEST_SERIALIZER(ProfilerRequests)
@@ -32,7 +33,7 @@ ProfilerRequests::ProfilerRequest::ProfilerRequest(ProfilerRequestType request_t
 {
 }
 
-ProfilerRequests::ProfilerRequest::ProfilerRequest(uint8_t request_id) : RequestImplementation(request_id)
+ProfilerRequests::ProfilerRequest::ProfilerRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -49,6 +50,23 @@ ResponsePtr ProfilerRequests::ProfilerRequest::execute(const SessionPtr& session
         case ProfilerRequestType::SetEnabled:
             pf->setEnabled(getArgument<bool>(0));
             break;
+        case ProfilerRequestType::ResetWindow:
+            pf->resetWindow();
+            break;
+        case ProfilerRequestType::GetHistogram: {
+            const Profile& profile = pf->getProfile(getArgument<std::string>(0));
+            std::vector<std::string> steps = profile.getStepNames();
+            std::string step = getArgument<std::string>(1);
+            if (std::find(steps.begin(), steps.end(), step) != steps.end()) {
+                return std::make_shared<ProfilerResponse>(request_type_, uuid_, profile.getHistogram(step), getRequestID());
+            } else {
+                return std::make_shared<ProfilerResponse>(request_type_, uuid_, LatencyHistogram(), getRequestID());
+            }
+        }
+        case ProfilerRequestType::GetCounter: {
+            const Profile& profile = pf->getProfile(getArgument<std::string>(0));
+            return std::make_shared<ProfilerResponse>(request_type_, uuid_, profile.getCounter(getArgument<std::string>(1)), getRequestID());
+        }
 
         default:
             return std::make_shared<Feedback>(std::string("unknown profiler request type ") + std::to_string((int)request_type_), getRequestID());
@@ -75,16 +93,16 @@ void ProfilerRequests::ProfilerRequest::deserialize(const SerializationBuffer& d
 /// RESPONSE
 ///
 
-ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint8_t request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-ProfilerRequests::ProfilerResponse::ProfilerResponse(uint8_t request_id) : ResponseImplementation(request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
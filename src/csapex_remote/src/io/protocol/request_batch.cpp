@@ -0,0 +1,75 @@
+/// HEADER
+#include <csapex/io/protcol/request_batch.h>
+
+/// PROJECT
+#include <csapex/serialization/request_serializer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+
+CSAPEX_REGISTER_REQUEST_SERIALIZER(RequestBatch)
+
+using namespace csapex;
+
+///
+/// REQUEST
+///
+RequestBatch::BatchRequest::BatchRequest(const std::vector<RequestConstPtr>& requests) : RequestImplementation(0), requests_(requests)
+{
+}
+
+RequestBatch::BatchRequest::BatchRequest(uint32_t request_id) : RequestImplementation(request_id)
+{
+}
+
+ResponsePtr RequestBatch::BatchRequest::execute(const SessionPtr& session, CsApexCore& core) const
+{
+    std::vector<ResponseConstPtr> responses;
+    responses.reserve(requests_.size());
+    for (const RequestConstPtr& request : requests_) {
+        // a failing request must not prevent the remaining ones from being answered
+        responses.push_back(request->executeSafely(session, core));
+    }
+    return std::make_shared<BatchResponse>(responses, getRequestID());
+}
+
+void RequestBatch::BatchRequest::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << requests_;
+}
+
+void RequestBatch::BatchRequest::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> requests_;
+}
+
+const std::vector<RequestConstPtr>& RequestBatch::BatchRequest::getRequests() const
+{
+    return requests_;
+}
+
+///
+/// RESPONSE
+///
+
+RequestBatch::BatchResponse::BatchResponse(const std::vector<ResponseConstPtr>& responses, uint32_t request_id) : ResponseImplementation(request_id), responses_(responses)
+{
+}
+
+RequestBatch::BatchResponse::BatchResponse(uint32_t request_id) : ResponseImplementation(request_id)
+{
+}
+
+void RequestBatch::BatchResponse::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << responses_;
+}
+
+void RequestBatch::BatchResponse::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> responses_;
+}
+
+const std::vector<ResponseConstPtr>& RequestBatch::BatchResponse::getResponses() const
+{
+    return responses_;
+}
@@ -0,0 +1,86 @@
+/// HEADER
+#include <csapex/io/protcol/request_graph_snapshot.h>
+
+/// PROJECT
+#include <csapex/core/csapex_core.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex/serialization/request_serializer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+
+CSAPEX_REGISTER_REQUEST_SERIALIZER(RequestGraphSnapshot)
+
+using namespace csapex;
+
+///
+/// REQUEST
+///
+RequestGraphSnapshot::GraphSnapshotRequest::GraphSnapshotRequest() : RequestImplementation(0)
+{
+}
+
+RequestGraphSnapshot::GraphSnapshotRequest::GraphSnapshotRequest(uint32_t request_id) : RequestImplementation(request_id)
+{
+}
+
+ResponsePtr RequestGraphSnapshot::GraphSnapshotRequest::execute(const SessionPtr& session, CsApexCore& core) const
+{
+    (void)session;
+
+    NodeSnapshot root = NodeSnapshot::create(core.getRootNode(), nullptr);
+    root.subgraph = GraphSnapshot::create(core.getRoot());
+
+    std::map<int, std::string> thread_groups;
+    for (const ThreadGroupPtr& group : core.getThreadPool()->getGroups()) {
+        thread_groups[group->id()] = group->getName();
+    }
+
+    return std::make_shared<GraphSnapshotResponse>(root, thread_groups, getRequestID());
+}
+
+void RequestGraphSnapshot::GraphSnapshotRequest::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    (void)data;
+}
+
+void RequestGraphSnapshot::GraphSnapshotRequest::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    (void)data;
+}
+
+///
+/// RESPONSE
+///
+
+RequestGraphSnapshot::GraphSnapshotResponse::GraphSnapshotResponse(const NodeSnapshot& root, const std::map<int, std::string>& thread_groups, uint32_t request_id)
+  : ResponseImplementation(request_id), root_(root), thread_groups_(thread_groups)
+{
+}
+RequestGraphSnapshot::GraphSnapshotResponse::GraphSnapshotResponse(uint32_t request_id) : ResponseImplementation(request_id)
+{
+}
+
+void RequestGraphSnapshot::GraphSnapshotResponse::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << root_;
+    data << thread_groups_;
+}
+
+void RequestGraphSnapshot::GraphSnapshotResponse::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> root_;
+    data >> thread_groups_;
+}
+
+const NodeSnapshot& RequestGraphSnapshot::GraphSnapshotResponse::getRoot() const
+{
+    return root_;
+}
+
+const std::map<int, std::string>& RequestGraphSnapshot::GraphSnapshotResponse::getThreadGroups() const
+{
+    return thread_groups_;
+}
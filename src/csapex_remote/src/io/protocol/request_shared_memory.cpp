@@ -0,0 +1,82 @@
+/// HEADER
+#include <csapex/io/protcol/request_shared_memory.h>
+
+/// PROJECT
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/settings.h>
+#include <csapex/io/session.h>
+#include <csapex/serialization/request_serializer.h>
+#include <csapex/serialization/io/std_io.h>
+
+CSAPEX_REGISTER_REQUEST_SERIALIZER(RequestSharedMemory)
+
+using namespace csapex;
+
+///
+/// REQUEST
+///
+RequestSharedMemory::SharedMemoryRequest::SharedMemoryRequest(const std::string& name, uint64_t token) : RequestImplementation(0), name_(name), token_(token)
+{
+}
+
+RequestSharedMemory::SharedMemoryRequest::SharedMemoryRequest(uint32_t request_id) : RequestImplementation(request_id), token_(0)
+{
+}
+
+ResponsePtr RequestSharedMemory::SharedMemoryRequest::execute(const SessionPtr& session, CsApexCore& core) const
+{
+    bool accepted = false;
+    if (core.getSettings().getTemporary<bool>("remote_shared_memory", true)) {
+        accepted = session->acceptSharedMemory(name_, token_, getRequestID());
+    }
+
+    return std::make_shared<SharedMemoryResponse>(accepted, getRequestID());
+}
+
+void RequestSharedMemory::SharedMemoryRequest::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << name_;
+    data << token_;
+}
+
+void RequestSharedMemory::SharedMemoryRequest::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> name_;
+    data >> token_;
+}
+
+const std::string& RequestSharedMemory::SharedMemoryRequest::getName() const
+{
+    return name_;
+}
+
+uint64_t RequestSharedMemory::SharedMemoryRequest::getToken() const
+{
+    return token_;
+}
+
+///
+/// RESPONSE
+///
+
+RequestSharedMemory::SharedMemoryResponse::SharedMemoryResponse(bool accepted, uint32_t request_id) : ResponseImplementation(request_id), accepted_(accepted)
+{
+}
+RequestSharedMemory::SharedMemoryResponse::SharedMemoryResponse(uint32_t request_id) : ResponseImplementation(request_id), accepted_(false)
+{
+}
+
+void RequestSharedMemory::SharedMemoryResponse::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << accepted_;
+}
+
+void RequestSharedMemory::SharedMemoryResponse::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> accepted_;
+}
+
+bool RequestSharedMemory::SharedMemoryResponse::isAccepted() const
+{
+    return accepted_;
+}
@@ -0,0 +1,51 @@
+/// HEADER
+#include <csapex/io/protcol/state_notes.h>
+
+/// PROJECT
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/note_serializer.h>
+
+CSAPEX_REGISTER_NOTE_SERIALIZER(StateNote)
+
+using namespace csapex;
+
+StateNote::StateNote() : state_version_(0)
+{
+}
+
+StateNote::StateNote(StateNoteType note_type, const AUUID& uuid) : NoteImplementation(uuid), note_type_(note_type), state_version_(0)
+{
+}
+
+StateNote::StateNote(StateNoteType note_type, const AUUID& uuid, uint32_t version, const std::vector<Value>& values)
+  : NoteImplementation(uuid), note_type_(note_type), state_version_(version), values_(values)
+{
+}
+
+void StateNote::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    Note::serialize(data, version);
+
+    data << note_type_;
+    data << state_version_;
+
+    data.writeLength(values_.size());
+    for (const Value& value : values_) {
+        data << value.first;
+        data << value.second;
+    }
+}
+
+void StateNote::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    Note::deserialize(data, version);
+
+    data >> note_type_;
+    data >> state_version_;
+
+    values_.resize(data.readLength());
+    for (Value& value : values_) {
+        data >> value.first;
+        data >> value.second;
+    }
+}
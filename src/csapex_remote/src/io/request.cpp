@@ -1,6 +1,9 @@
 /// HEADER
 #include <csapex/io/request.h>
 
+/// PROJECT
+#include <csapex/io/feedback.h>
+
 using namespace csapex;
 
 uint8_t Request::getPacketType() const
@@ -8,16 +11,36 @@ uint8_t Request::getPacketType() const
     return PACKET_TYPE_ID;
 }
 
-Request::Request(uint8_t id) : request_id_(id)
+Request::Request(uint32_t id) : request_id_(id)
 {
 }
 
-void Request::overwriteRequestID(uint8_t id) const
+void Request::overwriteRequestID(uint32_t id) const
 {
     request_id_ = id;
 }
 
-uint8_t Request::getRequestID() const
+uint32_t Request::getRequestID() const
 {
     return request_id_;
 }
+
+ResponseConstPtr Request::executeSafely(const SessionPtr& session, CsApexCore& core) const
+{
+    ResponseConstPtr response;
+    try {
+        response = execute(session, core);
+
+    } catch (const std::exception& e) {
+        response = std::make_shared<Feedback>(std::string("Request has thrown an exception: ") + e.what(), getRequestID());
+
+    } catch (...) {
+        response = std::make_shared<Feedback>(std::string("Request has failed with unkown cause."), getRequestID());
+    }
+
+    if (!response) {
+        response = std::make_shared<Feedback>(std::string("Request failed to produce a response"), getRequestID());
+    }
+
+    return response;
+}
@@ -0,0 +1,96 @@
+/// HEADER
+#include <csapex/io/response_future.h>
+
+/// PROJECT
+#include <csapex/utility/assert.h>
+
+using namespace csapex;
+using namespace csapex::io;
+
+ResponseFuture::State::State() : ready(false)
+{
+}
+
+ResponseFuture::ResponseFuture()
+{
+}
+
+ResponseFuture::ResponseFuture(const std::shared_ptr<State>& state) : state_(state)
+{
+}
+
+bool ResponseFuture::valid() const
+{
+    return state_ != nullptr;
+}
+
+bool ResponseFuture::isReady() const
+{
+    apex_assert_hard(state_);
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->ready;
+}
+
+void ResponseFuture::wait() const
+{
+    apex_assert_hard(state_);
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->ready_changed.wait(lock, [this]() { return state_->ready; });
+}
+
+bool ResponseFuture::waitFor(std::chrono::milliseconds timeout) const
+{
+    apex_assert_hard(state_);
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->ready_changed.wait_for(lock, timeout, [this]() { return state_->ready; });
+}
+
+ResponseConstPtr ResponseFuture::get() const
+{
+    wait();
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->response;
+}
+
+void ResponseFuture::then(Continuation continuation) const
+{
+    apex_assert_hard(state_);
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    if (state_->ready) {
+        ResponseConstPtr response = state_->response;
+        lock.unlock();
+        continuation(response);
+    } else {
+        state_->continuations.push_back(std::move(continuation));
+    }
+}
+
+ResponsePromise::ResponsePromise() : state_(std::make_shared<ResponseFuture::State>())
+{
+}
+
+ResponseFuture ResponsePromise::getFuture() const
+{
+    return ResponseFuture(state_);
+}
+
+bool ResponsePromise::setResponse(const ResponseConstPtr& response) const
+{
+    std::vector<ResponseFuture::Continuation> continuations;
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        if (state_->ready) {
+            return false;
+        }
+        state_->ready = true;
+        state_->response = response;
+        continuations.swap(state_->continuations);
+    }
+    state_->ready_changed.notify_all();
+
+    // continuations are called without holding the lock, so they may register further continuations
+    for (const ResponseFuture::Continuation& continuation : continuations) {
+        continuation(response);
+    }
+    return true;
+}
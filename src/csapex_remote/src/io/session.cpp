@@ -13,6 +13,10 @@
 #include <csapex/io/broadcast_message.h>
 #include <csapex/io/raw_message.h>
 #include <csapex/io/protcol/core_notes.h>
+#include <csapex/io/protcol/request_batch.h>
+#include <csapex/io/protcol/note_batch.h>
+#include <csapex/io/protcol/request_shared_memory.h>
+#include <csapex/io/shared_memory_transport.h>
 #include <csapex/io/channel.h>
 #include <csapex/utility/thread.h>
 #include <csapex/utility/exceptions.h>
@@ -24,11 +28,66 @@
 using namespace csapex;
 using boost::asio::ip::tcp;
 
-Session::Session(Socket socket, const std::string& name) : socket_(new Socket(std::move(socket))), next_request_id_(1), running_(false), is_live_(false), was_live_(false), name_(name), is_valid_(true)
+namespace
 {
+// a producer of bulk traffic has to wait once this many packets are queued
+const std::size_t MAX_QUEUED_BULK_PACKETS = 1024;
+// bounds the time a control packet has to wait for the batch in front of it
+const std::size_t MAX_PACKETS_PER_WRITE = 64;
+
+bool isBulkPacket(const StreamableConstPtr& packet)
+{
+    uint8_t type = packet->getPacketType();
+    return type == io::Note::PACKET_TYPE_ID || type == RawMessage::PACKET_TYPE_ID;
 }
 
-Session::Session(const std::string& name) : next_request_id_(1), running_(false), is_live_(false), was_live_(false), name_(name), is_valid_(true)
+uint32_t getRequestID(const StreamableConstPtr& packet)
+{
+    if (auto request = std::dynamic_pointer_cast<Request const>(packet)) {
+        return request->getRequestID();
+    } else if (auto response = std::dynamic_pointer_cast<Response const>(packet)) {
+        return response->getRequestID();
+    }
+    return 0;
+}
+}  // namespace
+
+Session::Session(Socket socket, const std::string& name)
+  : socket_(new Socket(std::move(socket)))
+  , next_request_id_(1)
+  , receive_buffer_(std::make_shared<SerializationBuffer>())
+  , buffers_in_flight_(std::make_shared<std::vector<SerializationBuffer>>())
+  , write_in_flight_(false)
+  , io_thread_(std::thread::id())
+  , switch_packet_type_(0)
+  , switch_request_id_(0)
+  , switch_after_batch_(false)
+  , writes_paused_(false)
+  , write_to_shared_memory_(false)
+  , running_(false)
+  , is_live_(false)
+  , was_live_(false)
+  , name_(name)
+  , is_valid_(true)
+{
+}
+
+Session::Session(const std::string& name)
+  : next_request_id_(1)
+  , receive_buffer_(std::make_shared<SerializationBuffer>())
+  , buffers_in_flight_(std::make_shared<std::vector<SerializationBuffer>>())
+  , write_in_flight_(false)
+  , io_thread_(std::thread::id())
+  , switch_packet_type_(0)
+  , switch_request_id_(0)
+  , switch_after_batch_(false)
+  , writes_paused_(false)
+  , write_to_shared_memory_(false)
+  , running_(false)
+  , is_live_(false)
+  , was_live_(false)
+  , name_(name)
+  , is_valid_(true)
 {
 }
 
@@ -37,12 +96,14 @@ Session::~Session()
     is_valid_ = false;
     {
         std::unique_lock<std::recursive_mutex> running_lock(running_mutex_);
-        if (running_) {
-            running_ = false;
+        running_ = false;
+        if (packet_handler_thread_.joinable()) {
             packet_handler_thread_.join();
         }
     }
 
+    closeSharedMemory();
+
     if (socket_) {
         boost::system::error_code ec;
         socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
@@ -76,6 +137,10 @@ void Session::start()
     }
     started(this);
 
+    // small packets are already batched by the session, waiting for more data only delays requests
+    boost::system::error_code ec;
+    socket_->set_option(tcp::no_delay(true), ec);
+
     packet_handler_thread_ = std::thread([this]() {
         csapex::thread::set_name(name_.c_str());
         is_live_ = true;
@@ -101,27 +166,16 @@ void Session::mainLoop()
 {
     while (running_) {
         std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
-        while (running_ && (packets_received_.empty() && packets_to_send_.empty())) {
+        while (running_ && control_packets_received_.empty() && packets_received_.empty()) {
             packets_available_.wait_for(packet_lock, std::chrono::milliseconds(100));
         }
 
-        // so as not to starve the clients, we limit the max amount of packets to send
-        // before receiving other packets
         const int max_operations_per_iteration = 32;
-        for (int i = 0; i < max_operations_per_iteration && running_ && !packets_to_send_.empty(); ++i) {
-            StreamableConstPtr packet = packets_to_send_.front();
-            packets_to_send_.pop_front();
-            packet_lock.unlock();
-
-            SerializationBuffer buffer = PacketSerializer::serializePacket(packet);
-            write_packet(buffer);
-
-            packet_lock.lock();
-        }
-
-        for (int i = 0; i < max_operations_per_iteration && running_ && !packets_received_.empty(); ++i) {
-            StreamableConstPtr packet = packets_received_.front();
-            packets_received_.pop_front();
+        for (int i = 0; i < max_operations_per_iteration && running_ && !(control_packets_received_.empty() && packets_received_.empty()); ++i) {
+            // requests are handled before notes that arrived earlier
+            std::deque<StreamableConstPtr>& lane = control_packets_received_.empty() ? packets_received_ : control_packets_received_;
+            StreamableConstPtr packet = lane.front();
+            lane.pop_front();
             packet_lock.unlock();
 
             try {
@@ -138,12 +192,12 @@ void Session::mainLoop()
                         }
                         break;
                     case io::Note::PACKET_TYPE_ID:
-                        if (io::NoteConstPtr note = std::dynamic_pointer_cast<io::Note const>(packet)) {
-                            auto pos = channels_.find(note->getAUUID());
-                            if (pos != channels_.end()) {
-                                io::ChannelPtr channel = pos->second;
-                                channel->handleNote(note);
+                        if (auto batch = std::dynamic_pointer_cast<NoteBatch const>(packet)) {
+                            for (const io::NoteConstPtr& note : batch->unpack()) {
+                                handleNote(note);
                             }
+                        } else if (io::NoteConstPtr note = std::dynamic_pointer_cast<io::Note const>(packet)) {
+                            handleNote(note);
                         }
                         break;
                     default:
@@ -174,16 +228,24 @@ void Session::stop()
     //        return;
     //    }
     running_ = false;
+    send_space_available_.notify_all();
 
-    std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
-    for (auto pair : open_requests_) {
-        std::promise<ResponseConstPtr>* open_requests = pair.second;
-        open_requests->set_value(nullptr);
+    // requests registered after this point see that the session is no longer running
+    std::unordered_map<uint32_t, io::ResponsePromise> open_requests;
+    {
+        std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
+        open_requests.swap(open_requests_);
+    }
+    for (const auto& pair : open_requests) {
+        pair.second.setResponse(nullptr);
     }
 
     running_lock.unlock();
 
-    if (is_live_) {
+    closeSharedMemory();
+
+    // the thread may already have left its loop, it still has to be joined
+    if (packet_handler_thread_.joinable()) {
         packet_handler_thread_.join();
     }
     apex_assert_hard(!is_live_);
@@ -200,35 +262,124 @@ void Session::stopForced()
 
 ResponseConstPtr Session::sendRequest(RequestConstPtr request)
 {
-    if (is_live_) {
-        request->overwriteRequestID(next_request_id_++);
+    if (!is_live_) {
+        if (was_live_) {
+            throw NoConnectionException();
+        }
+        return nullptr;
+    }
 
-        std::promise<ResponseConstPtr> promise;
+    if (ResponseConstPtr response = sendRequestAsync(request).get()) {
+        return response;
+    }
+    apex_fail(std::string("The request ") + std::to_string(request->getRequestID()) + " failed to produce a response");
+    return nullptr;
+}
 
-        {
-            std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
-            open_requests_[request->getRequestID()] = &promise;
-        }
+io::ResponseFuture Session::sendRequestAsync(RequestConstPtr request)
+{
+    if (!is_live_ && was_live_) {
+        throw NoConnectionException();
+    }
 
+    io::ResponseFuture future = registerRequest(request);
+    try {
         write(request);
+    } catch (...) {
+        completeRequest(request->getRequestID(), nullptr);
+        throw;
+    }
+    return future;
+}
+
+std::vector<io::ResponseFuture> Session::sendRequestBatch(const std::vector<RequestConstPtr>& requests)
+{
+    if (!is_live_ && was_live_) {
+        throw NoConnectionException();
+    }
+
+    std::vector<io::ResponseFuture> futures;
+    futures.reserve(requests.size());
+    for (const RequestConstPtr& request : requests) {
+        futures.push_back(registerRequest(request));
+    }
 
-        std::future<ResponseConstPtr> future = promise.get_future();
+    io::ResponseFuture batch_future;
+    try {
+        batch_future = sendRequestAsync(std::make_shared<RequestBatch::BatchRequest>(requests));
+    } catch (...) {
+        for (const RequestConstPtr& request : requests) {
+            completeRequest(request->getRequestID(), nullptr);
+        }
+        throw;
+    }
 
-        future.wait();
+    batch_future.then([this, requests](const ResponseConstPtr& response) {
+        if (auto batch_response = std::dynamic_pointer_cast<RequestBatch::BatchResponse const>(response)) {
+            for (const ResponseConstPtr& nested : batch_response->getResponses()) {
+                completeRequest(nested->getRequestID(), nested);
+            }
+        }
 
-        if (ResponseConstPtr response = future.get()) {
-            apex_assert_hard(response);
-            return response;
+        // requests without an answer share the fate of the whole batch
+        FeedbackConstPtr feedback = std::dynamic_pointer_cast<Feedback const>(response);
+        for (const RequestConstPtr& request : requests) {
+            ResponseConstPtr substitute;
+            if (feedback) {
+                substitute = std::make_shared<Feedback>(feedback->getMessage(), request->getRequestID());
+            }
+            completeRequest(request->getRequestID(), substitute);
         }
-        apex_fail(std::string("The request ") + std::to_string(request->getRequestID()) + " failed to produce a response");
+    });
 
-    } else {
-        if (was_live_) {
-            throw NoConnectionException();
+    return futures;
+}
+
+uint32_t Session::makeRequestID()
+{
+    // 0 is reserved for feedback that does not belong to a request
+    uint32_t id = next_request_id_++;
+    while (id == 0) {
+        id = next_request_id_++;
+    }
+    return id;
+}
+
+io::ResponseFuture Session::registerRequest(const RequestConstPtr& request)
+{
+    io::ResponsePromise promise;
+
+    std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
+    if (!running_ || !is_live_) {
+        // there is nobody to answer, never let the caller wait
+        lock.unlock();
+        promise.setResponse(nullptr);
+        return promise.getFuture();
+    }
+
+    request->overwriteRequestID(makeRequestID());
+    apex_assert_hard(open_requests_.find(request->getRequestID()) == open_requests_.end());
+    open_requests_[request->getRequestID()] = promise;
+
+    return promise.getFuture();
+}
+
+bool Session::completeRequest(uint32_t request_id, const ResponseConstPtr& response)
+{
+    io::ResponsePromise promise;
+    {
+        std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
+        auto it = open_requests_.find(request_id);
+        if (it == open_requests_.end()) {
+            return false;
         }
+        promise = it->second;
+        open_requests_.erase(it);
     }
 
-    return nullptr;
+    // the lock is released, so continuations are free to send new requests
+    promise.setResponse(response);
+    return true;
 }
 
 void Session::sendNote(io::NoteConstPtr note)
@@ -243,24 +394,29 @@ void Session::sendNote(io::NoteConstPtr note)
 
 void Session::write(const StreamableConstPtr& packet)
 {
-    if (is_live_) {
-        {
-            if (packet_handler_thread_.get_id() != std::this_thread::get_id()) {
-                std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
-                packets_to_send_.push_back(packet);
-            } else {
-                SerializationBuffer buffer = PacketSerializer::serializePacket(packet);
-                write_packet(buffer);
-            }
-        }
-
-        packets_available_.notify_all();
-
-    } else {
+    if (!is_live_) {
         if (was_live_) {
             throw NoConnectionException();
         }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        if (isBulkPacket(packet)) {
+            // the io thread finishes the writes and the handler thread answers requests, neither may wait here
+            if (!isIoThread() && packet_handler_thread_.get_id() != std::this_thread::get_id()) {
+                while (running_ && bulk_packets_to_send_.size() >= MAX_QUEUED_BULK_PACKETS) {
+                    send_space_available_.wait_for(lock, std::chrono::milliseconds(100));
+                }
+            }
+            bulk_packets_to_send_.push_back(packet);
+        } else {
+            control_packets_to_send_.push_back(packet);
+        }
     }
+
+    write_async();
 }
 
 void Session::write(const std::string& message)
@@ -277,111 +433,357 @@ void Session::read_async()
     }
 
     SessionWeakPtr self = shared_from_this();
+    std::shared_ptr<SerializationBuffer> buffer = receive_buffer_;
+
+    buffer->resize(SerializationBuffer::HEADER_LENGTH);
+    boost::asio::async_read(*socket_, boost::asio::buffer(&buffer->at(0), SerializationBuffer::HEADER_LENGTH), [this, self, buffer](boost::system::error_code ec, std::size_t reply_length) {
+        SessionPtr session = self.lock();
+        if (!session || ec == boost::asio::error::operation_aborted) {
+            // the session is gone, only the buffer has been kept alive for this handler
+            return;
+
+        } else if (ec == boost::asio::error::eof) {
+            // do nothing
+            return;
+
+        } else if (ec == boost::asio::error::connection_reset) {
+            // disconnect
+            stop();
+            return;
+
+        } else if (reply_length > 0) {
+            io_thread_ = std::this_thread::get_id();
+
+            // payload received
+            if (reply_length == SerializationBuffer::HEADER_LENGTH) {
+                buffer->seek(0);
+                uint32_t message_length;
+                *buffer >> message_length;
+
+                if (message_length > SerializationBuffer::HEADER_LENGTH) {
+                    read_body_async(message_length);
+                    return;
+                } else {
+                    std::cerr << "got illegal message of length " << (int)message_length << std::endl;
+                }
+            } else {
+                std::cerr << "got illegal header of length " << (int)reply_length << std::endl;
+            }
+        } else {
+            std::cerr << "got an illegal reply of length " << (int)reply_length << std::endl;
+        }
+
+        read_async();
+    });
+}
+
+void Session::read_body_async(uint32_t message_length)
+{
+    SessionWeakPtr self = shared_from_this();
+    std::shared_ptr<SerializationBuffer> buffer = receive_buffer_;
+
+    // the capacity of the buffer is kept, so only messages larger than all previous ones allocate
+    buffer->resize(message_length);
+    std::size_t body_length = message_length - SerializationBuffer::HEADER_LENGTH;
+    boost::asio::async_read(*socket_, boost::asio::buffer(&buffer->at(SerializationBuffer::HEADER_LENGTH), body_length),
+                            [this, self, buffer, message_length](boost::system::error_code ec, std::size_t reply_length) {
+                                SessionPtr session = self.lock();
+                                if (!session || ec == boost::asio::error::operation_aborted || ec == boost::asio::error::eof) {
+                                    return;
+
+                                } else if (ec) {
+                                    stop();
+                                    return;
+                                }
+
+                                apex_assert_equal_hard((int)reply_length, ((int)(message_length - SerializationBuffer::HEADER_LENGTH)));
+                                handleMessage(*buffer);
 
-    std::shared_ptr<SerializationBuffer> message_data = std::make_shared<SerializationBuffer>();
-    boost::asio::async_read(
-        *socket_, boost::asio::buffer(&message_data->at(0), SerializationBuffer::HEADER_LENGTH), [this, message_data, self](boost::system::error_code ec, std::size_t reply_length) {
-            if (ec == boost::asio::error::eof) {
-                // do nothing
+                                read_async();
+                            });
+}
+
+void Session::handleMessage(SerializationBuffer& buffer)
+{
+    StreamablePtr serial = PacketSerializer::deserializePacket(buffer);
+
+    if (serial) {
+        if (FeedbackConstPtr feedback = std::dynamic_pointer_cast<Feedback const>(serial)) {
+            std::cerr << feedback->getMessage() << std::endl;
+            if (feedback->getRequestID() != 0) {
+                if (!completeRequest(feedback->getRequestID(), feedback)) {
+                    std::cerr << "got feedback for unknown request " << feedback->getRequestID() << std::endl;
+                }
+            }
+
+        } else if (ResponseConstPtr response = std::dynamic_pointer_cast<Response const>(serial)) {
+            // std::cerr << "got response #" << (int) response->getRequestID() << std::endl;
+
+            if (!completeRequest(response->getRequestID(), response)) {
+                std::cerr << "got response for unknown request " << response->getRequestID() << std::endl;
+            }
+
+        } else {
+            std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+            if (isBulkPacket(serial)) {
+                packets_received_.push_back(serial);
+            } else {
+                control_packets_received_.push_back(serial);
+            }
+            packets_available_.notify_all();
+        }
+    } else {
+        std::cerr << "could not deserialize message of length " << (int)buffer.size() << std::endl;
+    }
+}
+
+void Session::write_async()
+{
+    while (true) {
+        std::vector<StreamableConstPtr> packets;
+        SharedMemoryTransportPtr shared_memory;
+        {
+            std::unique_lock<std::mutex> lock(send_mutex_);
+            if (write_in_flight_ || writes_paused_ || !running_) {
                 return;
+            }
+
+            while (packets.size() < MAX_PACKETS_PER_WRITE && !control_packets_to_send_.empty() && !switch_after_batch_) {
+                StreamableConstPtr packet = control_packets_to_send_.front();
+                control_packets_to_send_.pop_front();
+                packets.push_back(packet);
 
-            } else if (ec == boost::asio::error::connection_reset) {
-                // disconnect
-                if (SessionPtr session = self.lock()) {
-                    stop();
+                // nothing may follow the packet that switches the transport in the same batch
+                if (switch_request_id_ != 0 && packet->getPacketType() == switch_packet_type_ && getRequestID(packet) == switch_request_id_) {
+                    switch_request_id_ = 0;
+                    switch_after_batch_ = true;
                 }
+            }
+            while (packets.size() < MAX_PACKETS_PER_WRITE && !bulk_packets_to_send_.empty() && !switch_after_batch_) {
+                packets.push_back(bulk_packets_to_send_.front());
+                bulk_packets_to_send_.pop_front();
+            }
+            if (packets.empty()) {
                 return;
+            }
 
-            } else if (reply_length > 0) {
-                // payload received
-                if (reply_length == SerializationBuffer::HEADER_LENGTH) {
-                    message_data->seek(0);
-                    uint32_t message_length;
-                    *message_data >> message_length;
-
-                    if (message_length > SerializationBuffer::HEADER_LENGTH) {
-                        message_data->resize(message_length, ' ');
-                        reply_length = boost::asio::read(*socket_, boost::asio::buffer(&message_data->at(SerializationBuffer::HEADER_LENGTH), message_length - SerializationBuffer::HEADER_LENGTH));
-                        apex_assert_equal_hard((int)reply_length, ((int)(message_length - SerializationBuffer::HEADER_LENGTH)));
-
-                        StreamablePtr serial = PacketSerializer::deserializePacket(*message_data);
-
-                        if (serial) {
-                            if (FeedbackConstPtr feedback = std::dynamic_pointer_cast<Feedback const>(serial)) {
-                                std::cerr << feedback->getMessage() << std::endl;
-                                if (feedback->getRequestID() != 0) {
-                                    std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
-                                    auto it = open_requests_.find(feedback->getRequestID());
-                                    if (it != open_requests_.end()) {
-                                        std::promise<ResponseConstPtr>* promise = it->second;
-                                        promise->set_value(feedback);
-                                        open_requests_.erase(it);
-
-                                    } else {
-                                        std::cerr << "got feedback for unknown request " << (int)feedback->getRequestID() << std::endl;
-                                    }
-                                }
+            write_in_flight_ = true;
+            if (write_to_shared_memory_) {
+                shared_memory = shared_memory_;
+            }
+        }
+        send_space_available_.notify_all();
+
+        // only the owner of the write in flight touches the buffers, so they are filled without holding the lock
+        std::shared_ptr<std::vector<SerializationBuffer>> buffers_in_flight = buffers_in_flight_;
+        buffers_in_flight->clear();
+        buffers_in_flight->reserve(packets.size());
+        for (const StreamableConstPtr& packet : packets) {
+            buffers_in_flight->push_back(PacketSerializer::serializePacket(packet));
+        }
 
-                            } else if (ResponseConstPtr response = std::dynamic_pointer_cast<Response const>(serial)) {
-                                // std::cerr << "got response #" << (int) response->getRequestID() << std::endl;
+        if (shared_memory) {
+            // the copy into the ring is the only one, the writer does not have to wait for the other end
+            bool written = true;
+            for (const SerializationBuffer& buffer : *buffers_in_flight) {
+                written = written && shared_memory->write(buffer.data(), buffer.size());
+            }
+            finishBatch();
 
-                                std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
-                                auto it = open_requests_.find(response->getRequestID());
-                                if (it != open_requests_.end()) {
-                                    std::promise<ResponseConstPtr>* promise = it->second;
-                                    apex_assert_hard(response);
-                                    promise->set_value(response);
-                                    open_requests_.erase(it);
+            if (!written) {
+                // the other end has closed the transport, the socket will notice the disconnect
+                return;
+            }
+            continue;
+        }
 
-                                } else {
-                                    std::cerr << "got response for unknown request " << (int)response->getRequestID() << std::endl;
-                                }
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(buffers_in_flight->size());
+        for (const SerializationBuffer& buffer : *buffers_in_flight) {
+            buffers.push_back(boost::asio::buffer(buffer.data(), buffer.size()));
+        }
 
-                            } else {
-                                std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
-                                packets_received_.push_back(serial);
-                                packets_available_.notify_all();
-                            }
-                        } else {
-                            std::cerr << "could not deserialize message of length " << (int)message_length << std::endl;
-                        }
-                    } else {
-                        std::cerr << "got illegal message of length " << (int)message_length << std::endl;
+        SessionWeakPtr self = shared_from_this();
+        boost::asio::async_write(*socket_, buffers, [this, self, buffers_in_flight](boost::system::error_code ec, std::size_t /*written_bytes*/) {
+            SessionPtr session = self.lock();
+            if (!session) {
+                // the socket has been closed with the session, the write was aborted
+                return;
+            }
+
+            finishBatch();
+
+            if (ec) {
+                if (ec != boost::asio::error::operation_aborted) {
+                    std::cerr << "the session has thrown an exception: " << ec.message() << std::endl;
+                    if (running_) {
+                        stop();
                     }
-                } else {
-                    std::cerr << "got illegal header of length " << (int)reply_length << std::endl;
                 }
-            } else {
-                std::cerr << "got an illegal reply of length " << (int)reply_length << std::endl;
+                return;
             }
 
-            read_async();
+            io_thread_ = std::this_thread::get_id();
+            write_async();
         });
+        return;
+    }
 }
 
-void Session::write_packet(SerializationBuffer& buffer)
+void Session::finishBatch()
 {
-    try {
-        buffer.finalize();
+    std::unique_lock<std::mutex> lock(send_mutex_);
+    write_in_flight_ = false;
+
+    if (switch_after_batch_) {
+        switch_after_batch_ = false;
+        if (shared_memory_) {
+            // the server has sent its answer, everything else goes through shared memory
+            write_to_shared_memory_ = true;
+        } else {
+            // the client waits for the answer to decide which transport to continue with
+            writes_paused_ = true;
+        }
+    }
+}
 
-        apex_assert_hard(socket_->is_open());
-        // std::cerr << (long) this << " is sending:\n" << buffer.toString() << std::endl;
+bool Session::negotiateSharedMemory(std::size_t capacity)
+{
+    if (!socket_ || !is_live_ || isUsingSharedMemory()) {
+        return isUsingSharedMemory();
+    }
 
-        std::size_t written_bytes = boost::asio::write(*socket_, boost::asio::buffer(buffer, buffer.size()));
+    boost::system::error_code ec;
+    tcp::endpoint local = socket_->local_endpoint(ec);
+    tcp::endpoint remote = socket_->remote_endpoint(ec);
+    if (ec || local.address() != remote.address()) {
+        return false;
+    }
 
-        apex_assert_eq_hard(buffer.size(), written_bytes);
+    SharedMemoryTransportPtr transport;
+    try {
+        transport = SharedMemoryTransport::create(capacity);
+    } catch (const std::exception& e) {
+        std::cerr << "cannot create shared memory for the session: " << e.what() << std::endl;
+        return false;
+    }
 
-        // std::cerr << (long) this << " has sent " << written_bytes << " bytes" << std::endl;
+    auto request = std::make_shared<RequestSharedMemory::SharedMemoryRequest>(transport->getName(), transport->getToken());
+    io::ResponseFuture future = registerRequest(request);
+    {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        switch_packet_type_ = Request::PACKET_TYPE_ID;
+        switch_request_id_ = request->getRequestID();
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "the session has thrown an exception: " << e.what() << std::endl;
-        stopForced();
+    ResponseConstPtr response;
+    try {
+        write(request);
+        response = future.get();
     } catch (...) {
-        std::cerr << "the session has crashed with an unknown cause." << std::endl;
-        stopForced();
+        completeRequest(request->getRequestID(), nullptr);
+    }
+
+    // both ends have mapped the region or never will, the name is no longer needed
+    transport->unlink();
+
+    auto shared_memory_response = std::dynamic_pointer_cast<RequestSharedMemory::SharedMemoryResponse const>(response);
+    bool accepted = shared_memory_response && shared_memory_response->isAccepted();
+    {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        switch_request_id_ = 0;
+        writes_paused_ = false;
+        if (accepted) {
+            shared_memory_ = transport;
+            write_to_shared_memory_ = true;
+        }
+    }
+    if (accepted) {
+        startSharedMemoryReader(transport);
+    }
+    write_async();
+
+    return accepted;
+}
+
+bool Session::acceptSharedMemory(const std::string& name, uint64_t token, uint32_t request_id)
+{
+    SharedMemoryTransportPtr transport = SharedMemoryTransport::open(name, token);
+    if (!transport) {
+        return false;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        if (shared_memory_) {
+            return false;
+        }
+        shared_memory_ = transport;
+        switch_packet_type_ = Response::PACKET_TYPE_ID;
+        switch_request_id_ = request_id;
+    }
+
+    startSharedMemoryReader(transport);
+    return true;
+}
+
+bool Session::isUsingSharedMemory() const
+{
+    std::unique_lock<std::mutex> lock(send_mutex_);
+    return write_to_shared_memory_;
+}
+
+void Session::startSharedMemoryReader(const SharedMemoryTransportPtr& transport)
+{
+    shared_memory_reader_thread_ = std::thread([this, transport]() {
+        csapex::thread::set_name((name_ + "_shm").c_str());
+
+        SerializationBuffer buffer;
+        while (running_) {
+            buffer.resize(SerializationBuffer::HEADER_LENGTH);
+            if (!transport->read(&buffer.at(0), SerializationBuffer::HEADER_LENGTH)) {
+                break;
+            }
+
+            buffer.seek(0);
+            uint32_t message_length;
+            buffer >> message_length;
+            if (message_length <= SerializationBuffer::HEADER_LENGTH) {
+                std::cerr << "got illegal message of length " << (int)message_length << std::endl;
+                break;
+            }
+
+            buffer.resize(message_length);
+            if (!transport->read(&buffer.at(SerializationBuffer::HEADER_LENGTH), message_length - SerializationBuffer::HEADER_LENGTH)) {
+                break;
+            }
+
+            handleMessage(buffer);
+        }
+    });
+}
+
+void Session::closeSharedMemory()
+{
+    SharedMemoryTransportPtr transport;
+    {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        transport = shared_memory_;
+    }
+    if (transport) {
+        transport->close();
+    }
+
+    if (shared_memory_reader_thread_.joinable() && shared_memory_reader_thread_.get_id() != std::this_thread::get_id()) {
+        shared_memory_reader_thread_.join();
     }
 }
 
+bool Session::isIoThread() const
+{
+    return io_thread_ == std::this_thread::get_id();
+}
+
 void Session::handleFeedback(const ResponseConstPtr& res)
 {
     if (auto feedback = std::dynamic_pointer_cast<Feedback const>(res)) {
@@ -389,6 +791,15 @@ void Session::handleFeedback(const ResponseConstPtr& res)
     }
 }
 
+void Session::handleNote(const io::NoteConstPtr& note)
+{
+    auto pos = channels_.find(note->getAUUID());
+    if (pos != channels_.end()) {
+        io::ChannelPtr channel = pos->second;
+        channel->handleNote(note);
+    }
+}
+
 slim_signal::Signal<void(const StreamableConstPtr&)>& Session::raw_packet_received(const AUUID& uuid)
 {
     auto& res = auuid_to_signal_[uuid];
@@ -0,0 +1,246 @@
+/// HEADER
+#include <csapex/io/shared_memory_transport.h>
+
+/// PROJECT
+#include <csapex/utility/assert.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <unistd.h>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+using namespace csapex;
+using namespace boost::interprocess;
+
+namespace csapex
+{
+namespace impl
+{
+// both ends check regularly whether the transport has been closed in the meantime
+static const boost::posix_time::milliseconds POLL_INTERVAL(100);
+
+static std::atomic<int> g_region_counter(0);
+
+/**
+ * @brief The SharedMemoryRing struct is one direction of the transport, read and written are running byte counts.
+ * The mutex only guards the counters, the data is copied outside of it.
+ */
+struct SharedMemoryRing
+{
+    interprocess_mutex mutex;
+    interprocess_condition readable;
+    interprocess_condition writable;
+
+    uint64_t written = 0;
+    uint64_t read = 0;
+    bool closed = false;
+};
+
+/**
+ * @brief The SharedMemoryHeader struct is placed at the beginning of the region, followed by the data of both rings
+ */
+struct SharedMemoryHeader
+{
+    uint64_t token = 0;
+    uint64_t capacity = 0;
+
+    // the creator writes into the first ring and reads from the second
+    SharedMemoryRing rings[2];
+};
+
+}  // namespace impl
+}  // namespace csapex
+
+SharedMemoryTransport::SharedMemoryTransport(const std::string& name, bool is_creator)
+  : name_(name), is_creator_(is_creator), closed_(false), owns_rings_(false), header_(nullptr), outgoing_(nullptr), incoming_(nullptr), outgoing_data_(nullptr), incoming_data_(nullptr)
+{
+}
+
+SharedMemoryTransportPtr SharedMemoryTransport::create(std::size_t capacity)
+{
+    apex_assert_hard(capacity > 0);
+
+    std::string name = "csapex_session_" + std::to_string(getpid()) + "_" + std::to_string(impl::g_region_counter++);
+    SharedMemoryTransportPtr transport(new SharedMemoryTransport(name, true));
+
+    shared_memory_object::remove(name.c_str());
+    shared_memory_object shm(create_only, name.c_str(), read_write);
+    shm.truncate(sizeof(impl::SharedMemoryHeader) + 2 * capacity);
+    transport->region_.reset(new mapped_region(shm, read_write));
+
+    uint8_t* begin = static_cast<uint8_t*>(transport->region_->get_address());
+    transport->header_ = new (begin) impl::SharedMemoryHeader;
+    std::random_device random;
+    std::mt19937_64 generator(random());
+    transport->header_->token = std::uniform_int_distribution<uint64_t>()(generator);
+    transport->header_->capacity = capacity;
+
+    transport->outgoing_ = &transport->header_->rings[0];
+    transport->incoming_ = &transport->header_->rings[1];
+    transport->outgoing_data_ = begin + sizeof(impl::SharedMemoryHeader);
+    transport->incoming_data_ = transport->outgoing_data_ + capacity;
+    transport->owns_rings_ = true;
+
+    return transport;
+}
+
+SharedMemoryTransportPtr SharedMemoryTransport::open(const std::string& name, uint64_t token)
+{
+    SharedMemoryTransportPtr transport(new SharedMemoryTransport(name, false));
+    try {
+        shared_memory_object shm(open_only, name.c_str(), read_write);
+        transport->region_.reset(new mapped_region(shm, read_write));
+
+    } catch (const interprocess_exception& e) {
+        // the client runs on another host
+        return nullptr;
+    }
+
+    if (transport->region_->get_size() < sizeof(impl::SharedMemoryHeader)) {
+        return nullptr;
+    }
+
+    uint8_t* begin = static_cast<uint8_t*>(transport->region_->get_address());
+    transport->header_ = reinterpret_cast<impl::SharedMemoryHeader*>(begin);
+    if (transport->header_->token != token) {
+        // a region of the same name, but created by another client
+        return nullptr;
+    }
+
+    uint64_t capacity = transport->header_->capacity;
+    apex_assert_hard(transport->region_->get_size() >= sizeof(impl::SharedMemoryHeader) + 2 * capacity);
+
+    transport->outgoing_ = &transport->header_->rings[1];
+    transport->incoming_ = &transport->header_->rings[0];
+    transport->incoming_data_ = begin + sizeof(impl::SharedMemoryHeader);
+    transport->outgoing_data_ = transport->incoming_data_ + capacity;
+    transport->owns_rings_ = true;
+
+    return transport;
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+    close();
+    if (is_creator_) {
+        unlink();
+    }
+}
+
+const std::string& SharedMemoryTransport::getName() const
+{
+    return name_;
+}
+
+uint64_t SharedMemoryTransport::getToken() const
+{
+    return header_->token;
+}
+
+void SharedMemoryTransport::unlink()
+{
+    shared_memory_object::remove(name_.c_str());
+}
+
+bool SharedMemoryTransport::write(const uint8_t* data, std::size_t length)
+{
+    const uint64_t capacity = header_->capacity;
+    impl::SharedMemoryRing& ring = *outgoing_;
+
+    while (length > 0) {
+        std::size_t offset;
+        std::size_t chunk;
+        {
+            scoped_lock<interprocess_mutex> lock(ring.mutex);
+            while (!ring.closed && !closed_ && ring.written - ring.read == capacity) {
+                ring.writable.timed_wait(lock, boost::posix_time::microsec_clock::universal_time() + impl::POLL_INTERVAL);
+            }
+            if (ring.closed || closed_) {
+                return false;
+            }
+
+            // copy as much as fits without wrapping, the rest follows in the next iteration
+            offset = ring.written % capacity;
+            std::size_t free = capacity - (ring.written - ring.read);
+            chunk = std::min(length, std::min<std::size_t>(free, capacity - offset));
+        }
+
+        // the reader never touches the free part of the ring, so the copy does not block it
+        std::memcpy(outgoing_data_ + offset, data, chunk);
+
+        {
+            scoped_lock<interprocess_mutex> lock(ring.mutex);
+            ring.written += chunk;
+            ring.readable.notify_all();
+        }
+
+        data += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+bool SharedMemoryTransport::read(uint8_t* data, std::size_t length)
+{
+    const uint64_t capacity = header_->capacity;
+    impl::SharedMemoryRing& ring = *incoming_;
+
+    while (length > 0) {
+        std::size_t offset;
+        std::size_t chunk;
+        {
+            scoped_lock<interprocess_mutex> lock(ring.mutex);
+            while (!ring.closed && !closed_ && ring.written == ring.read) {
+                ring.readable.timed_wait(lock, boost::posix_time::microsec_clock::universal_time() + impl::POLL_INTERVAL);
+            }
+            if (ring.closed || closed_) {
+                return false;
+            }
+
+            offset = ring.read % capacity;
+            std::size_t available = ring.written - ring.read;
+            chunk = std::min(length, std::min<std::size_t>(available, capacity - offset));
+        }
+
+        // the writer only fills the free part of the ring, so the readable part is copied without the lock
+        std::memcpy(data, incoming_data_ + offset, chunk);
+
+        {
+            scoped_lock<interprocess_mutex> lock(ring.mutex);
+            ring.read += chunk;
+            ring.writable.notify_all();
+        }
+
+        data += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+void SharedMemoryTransport::close()
+{
+    if (closed_.exchange(true)) {
+        return;
+    }
+    if (!header_ || !owns_rings_) {
+        return;
+    }
+
+    for (impl::SharedMemoryRing& ring : header_->rings) {
+        scoped_lock<interprocess_mutex> lock(ring.mutex);
+        ring.closed = true;
+        ring.readable.notify_all();
+        ring.writable.notify_all();
+    }
+}
@@ -0,0 +1,59 @@
+/// HEADER
+#include <csapex/io/state_cache.h>
+
+/// PROJECT
+#include <csapex/io/protcol/state_notes.h>
+
+using namespace csapex;
+
+StateCache::StateCache() : has_snapshot_(false), version_(0)
+{
+}
+
+bool StateCache::apply(const StateNote& note)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    switch (note.getNoteType()) {
+        case StateNoteType::Snapshot:
+            if (has_snapshot_ && note.getStateVersion() <= version_) {
+                return false;
+            }
+            has_snapshot_ = true;
+            break;
+
+        case StateNoteType::Delta:
+            // a delta is only meaningful relative to the version it was created from
+            if (!has_snapshot_ || note.getStateVersion() <= version_) {
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+    }
+
+    version_ = note.getStateVersion();
+    for (const StateNote::Value& value : note.getValues()) {
+        values_[value.first] = value.second;
+    }
+    return true;
+}
+
+uint32_t StateCache::getVersion() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return version_;
+}
+
+bool StateCache::getValue(uint8_t id, boost::any& value) const
+{
+    // getters are called from the UI, so an unknown value falls back to a request instead of waiting for the snapshot
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto pos = values_.find(id);
+    if (pos == values_.end()) {
+        return false;
+    }
+
+    value = pos->second;
+    return true;
+}
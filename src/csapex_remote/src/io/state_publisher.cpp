@@ -0,0 +1,98 @@
+/// HEADER
+#include <csapex/io/state_publisher.h>
+
+/// PROJECT
+#include <csapex/io/note_aggregator.h>
+#include <csapex/io/protcol/state_notes.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/serialization_buffer.h>
+
+/// SYSTEM
+#include <algorithm>
+
+using namespace csapex;
+
+StatePublisher::StatePublisher(const AUUID& uuid, const NoteAggregatorPtr& notes) : uuid_(uuid), notes_(notes), subscribed_(false), scheduled_(false), snapshot_requested_(false), closed_(false), version_(0)
+{
+}
+
+void StatePublisher::markChanged()
+{
+    if (!subscribed_ || closed_) {
+        // nobody has asked for the state yet, so there is nothing to update
+        return;
+    }
+
+    // many changes between two ticks only cause one sample
+    if (!scheduled_.exchange(true)) {
+        std::weak_ptr<StatePublisher> self = shared_from_this();
+        notes_->sendDeferredNote([self]() -> io::NoteConstPtr {
+            if (auto publisher = self.lock()) {
+                return publisher->makeNote();
+            }
+            return nullptr;
+        });
+    }
+}
+
+void StatePublisher::requestSnapshot()
+{
+    snapshot_requested_ = true;
+    subscribed_ = true;
+    markChanged();
+}
+
+void StatePublisher::close()
+{
+    // waits for a sample in progress, afterwards the samplers are never called again
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    entries_.clear();
+}
+
+io::NoteConstPtr StatePublisher::makeNote()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        return nullptr;
+    }
+
+    scheduled_ = false;
+    bool snapshot = snapshot_requested_;
+
+    std::vector<StateNote::Value> values;
+    std::vector<std::pair<Entry*, SerializationBuffer>> changed;
+    for (Entry& entry : entries_) {
+        boost::any value = entry.sample();
+        if (value.empty()) {
+            // the changes stay pending, so the state is sampled again on the next tick
+            lock.unlock();
+            markChanged();
+            return nullptr;
+        }
+
+        // values are compared in their serialized form, so no type needs to be comparable
+        SerializationBuffer buffer;
+        buffer << value;
+        if (snapshot || buffer.size() != entry.last_sent.size() || !std::equal(buffer.begin(), buffer.end(), entry.last_sent.begin())) {
+            changed.emplace_back(&entry, SerializationBuffer());
+            changed.back().second.swap(buffer);
+            values.emplace_back(entry.id, value);
+        }
+    }
+
+    if (values.empty()) {
+        return nullptr;
+    }
+
+    // the values only count as sent once they are part of a note, a requested snapshot stays pending until then
+    for (auto& pair : changed) {
+        pair.first->last_sent.assign(pair.second.begin(), pair.second.end());
+    }
+    if (snapshot) {
+        snapshot_requested_ = false;
+    }
+
+    ++version_;
+    return std::make_shared<StateNote>(snapshot ? StateNoteType::Snapshot : StateNoteType::Delta, uuid_, version_, values);
+}
@@ -17,6 +17,7 @@
 #include <csapex/io/protcol/graph_broadcasts.h>
 #include <csapex/io/protcol/core_notes.h>
 #include <csapex/io/graph_server.h>
+#include <csapex/io/note_aggregator.h>
 
 /// SYSTEM
 #include <cstdlib>
@@ -174,7 +175,10 @@ void TcpServer::startSession(SessionPtr session)
     });
 
     // graphs and nodes
-    GraphServerPtr graph_server = std::make_shared<GraphServer>(session);
+    double note_rate = core_.getSettings().getTemporary<double>("remote_note_rate", 30.0);
+    double profiling_rate = core_.getSettings().getTemporary<double>("remote_profiling_rate", 10.0);
+    NoteAggregatorPtr notes = std::make_shared<NoteAggregator>(session, note_rate, profiling_rate);
+    GraphServerPtr graph_server = std::make_shared<GraphServer>(session, notes);
     graph_servers_[session.get()] = graph_server;
     graph_server->startObservingGraph(core_.getRoot());
 
@@ -206,22 +210,7 @@ void TcpServer::handlePacket(const SessionPtr& session, const StreamableConstPtr
         }
 
     } else if (RequestConstPtr request = std::dynamic_pointer_cast<Request const>(packet)) {
-        StreamableConstPtr response;
-        try {
-            response = request->execute(session, core_);
-
-        } catch (const std::exception& e) {
-            response = std::make_shared<Feedback>(std::string("Request has thrown an exception: ") + e.what(), request->getRequestID());
-
-        } catch (...) {
-            response = std::make_shared<Feedback>(std::string("Request has failed with unkown cause."), request->getRequestID());
-        }
-
-        if (!response) {
-            response = std::make_shared<Feedback>(std::string("Request failed to produce a response"), request->getRequestID());
-        }
-
-        session->write(response);
+        session->write(request->executeSafely(session, core_));
 
     } else {
         session->write("packet with unknown type received");
@@ -280,7 +269,9 @@ void TcpServer::stop()
         {
             std::unique_lock<std::recursive_mutex> lock(session_mutex_);
 
-            for (const SessionPtr& session : sessions_) {
+            // stopping a session removes it from the list, the copy keeps it alive until it has stopped
+            std::vector<SessionPtr> sessions = sessions_;
+            for (const SessionPtr& session : sessions) {
                 if (session) {
                     session->stop();
                 }
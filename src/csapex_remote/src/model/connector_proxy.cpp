@@ -4,6 +4,7 @@
 /// PROJECT
 #include <csapex/io/protcol/connector_requests.h>
 #include <csapex/io/protcol/connector_notes.h>
+#include <csapex/io/protcol/state_notes.h>
 #include <csapex/io/channel.h>
 
 /// SYSTEM
@@ -48,14 +49,24 @@ ConnectorProxy::ConnectorProxy(const SessionPtr& session, UUID uuid, Connectable
                  * end: connect signals
                  **/
             }
+
+        } else if (const std::shared_ptr<StateNote const>& sn = std::dynamic_pointer_cast<StateNote const>(note)) {
+            state_.apply(*sn);
         }
     });
+
+    channel_->sendNote<StateNote>(StateNoteType::Subscribe);
 }
 
 ConnectorProxy::ConnectorProxy(const SessionPtr& session, UUID uuid, ConnectableOwnerPtr owner, const ConnectorDescription& cd) : ConnectorProxy(session, uuid, owner)
 {
-    cache_getDescription_ = cd;
-    has_getDescription_ = true;
+    state_.preset(ConnectorRequests::ConnectorRequestType::GetDescription, cd);
+}
+
+ConnectorProxy::~ConnectorProxy()
+{
+    // the note handler uses the state cache, it has to be disconnected before the members are destroyed
+    stopObserving();
 }
 
 bool ConnectorProxy::isConnectedTo(const UUID& other) const
@@ -94,6 +105,15 @@ bool ConnectorProxy::isActivelyConnectedTo(const UUID& other) const
         }                                                                                                                                                                                              \
         return value_##function##_;                                                                                                                                                                    \
     }
+#define HANDLE_STATE_ACCESSOR(_enum, type, function)                                                                                                                                                   \
+    type ConnectorProxy::function() const                                                                                                                                                              \
+    {                                                                                                                                                                                                  \
+        boost::any value;                                                                                                                                                                              \
+        if (state_.get(ConnectorRequests::ConnectorRequestType::_enum, value)) {                                                                                                                       \
+            return boost::any_cast<type>(value);                                                                                                                                                       \
+        }                                                                                                                                                                                              \
+        return request<type, ConnectorRequests>(ConnectorRequests::ConnectorRequestType::_enum, getUUID().getAbsoluteUUID());                                                                          \
+    }
 
 #include <csapex/model/connector_proxy_accessors.hpp>
 /**
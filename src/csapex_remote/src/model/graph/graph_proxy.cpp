@@ -10,6 +10,7 @@
 #include <csapex/model/node_facade.h>
 #include <csapex/model/node_facade_proxy.h>
 #include <csapex/model/node_facade_impl.h>
+#include <csapex/model/graph_snapshot.h>
 #include <csapex/io/protcol/graph_notes.h>
 #include <csapex/io/protcol/graph_requests.h>
 #include <csapex/io/session.h>
@@ -97,10 +98,21 @@ void GraphProxy::reload()
     }
 }
 
-void GraphProxy::vertexAdded(const UUID& id)
+void GraphProxy::reload(const GraphSnapshot& snapshot)
+{
+    for (const NodeSnapshot& node : snapshot.nodes) {
+        vertexAdded(node.uuid, &node);
+    }
+    for (const ConnectionDescription& ci : snapshot.connections) {
+        connectionAdded(ci);
+    }
+}
+
+void GraphProxy::vertexAdded(const UUID& id, const NodeSnapshot* snapshot)
 {
     AUUID auuid(makeUUID_forced(shared_from_this(), id.getFullName()).getAbsoluteUUID());
-    std::shared_ptr<NodeFacadeProxy> remote_node_facade = std::make_shared<NodeFacadeProxy>(graph_channel_->getSession().shared_from_this(), auuid);
+    SessionPtr session = graph_channel_->getSession().shared_from_this();
+    std::shared_ptr<NodeFacadeProxy> remote_node_facade = snapshot ? std::make_shared<NodeFacadeProxy>(session, auuid, *snapshot) : std::make_shared<NodeFacadeProxy>(session, auuid);
 
     graph::VertexPtr remote_vertex = std::make_shared<graph::Vertex>(remote_node_facade);
     remote_vertices_.push_back(remote_vertex);
@@ -4,6 +4,7 @@
 /// PROJECT
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph/graph_proxy.h>
+#include <csapex/model/graph_snapshot.h>
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/node_facade_proxy.h>
 #include <csapex/model/node_facade_impl.h>
@@ -21,7 +22,16 @@
 
 using namespace csapex;
 
-GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, GraphFacadeProxy* parent)
+GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, GraphFacadeProxy* parent) : GraphFacadeProxy(session, remote_facade, nullptr, parent)
+{
+}
+
+GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, const GraphSnapshot& snapshot, GraphFacadeProxy* parent)
+  : GraphFacadeProxy(session, remote_facade, &snapshot, parent)
+{
+}
+
+GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr remote_facade, const GraphSnapshot* snapshot, GraphFacadeProxy* parent)
   : Proxy(session)
   , parent_(parent)
   , graph_channel_(session->openChannel(remote_facade->getAUUID()))
@@ -43,7 +53,8 @@ GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr
    * end: initialize caches
    **/
 
-  guard_(-1)
+  snapshot_(snapshot)
+  , guard_(-1)
 {
     if (parent_) {
         graph_->setParent(parent_->graph_, remote_facade->getAUUID());
@@ -112,7 +123,12 @@ GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr
 
     observe(graph_->state_changed, state_changed);
 
-    graph_->reload();
+    if (snapshot_) {
+        graph_->reload(*snapshot_);
+        snapshot_ = nullptr;
+    } else {
+        graph_->reload();
+    }
 }
 
 GraphFacadeProxy::~GraphFacadeProxy()
@@ -153,7 +169,14 @@ void GraphFacadeProxy::createSubgraphFacade(NodeFacadePtr nf)
     NodeFacadeProxyPtr remote_facade = std::dynamic_pointer_cast<NodeFacadeProxy>(nf);
     apex_assert_hard(remote_facade);
 
-    std::shared_ptr<GraphFacadeProxy> sub_graph_facade = std::make_shared<GraphFacadeProxy>(session_, remote_facade, this);
+    // while constructing from a snapshot, the subgraph is contained in it as well
+    const NodeSnapshot* node_snapshot = snapshot_ ? snapshot_->findNode(remote_facade->getUUID()) : nullptr;
+    std::shared_ptr<GraphFacadeProxy> sub_graph_facade;
+    if (node_snapshot && node_snapshot->subgraph) {
+        sub_graph_facade = std::make_shared<GraphFacadeProxy>(session_, remote_facade, *node_snapshot->subgraph, this);
+    } else {
+        sub_graph_facade = std::make_shared<GraphFacadeProxy>(session_, remote_facade, this);
+    }
     children_[remote_facade->getUUID()] = sub_graph_facade;
 
     observe(sub_graph_facade->notification, notification);
@@ -0,0 +1,136 @@
+/// HEADER
+#include <csapex/model/graph_snapshot.h>
+
+/// PROJECT
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_state.h>
+#include <csapex/param/parameter.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+
+using namespace csapex;
+
+NodeSnapshot::NodeSnapshot() : scheduler_id(-1), is_graph(false)
+{
+}
+
+NodeSnapshot NodeSnapshot::create(const NodeFacadeImplementationPtr& node, const GraphFacadeImplementationPtr& parent)
+{
+    NodeSnapshot snapshot;
+    snapshot.uuid = node->getUUID();
+    snapshot.type = node->getType();
+    snapshot.label = node->getLabel();
+    snapshot.scheduler_id = node->getSchedulerId();
+    snapshot.is_graph = node->isGraph();
+
+    snapshot.state = node->getNodeState();
+    snapshot.parameters = node->getParameters();
+
+    snapshot.external_inputs = node->getExternalInputs();
+    snapshot.external_outputs = node->getExternalOutputs();
+    snapshot.external_events = node->getExternalEvents();
+    snapshot.external_slots = node->getExternalSlots();
+
+    snapshot.internal_inputs = node->getInternalInputs();
+    snapshot.internal_outputs = node->getInternalOutputs();
+    snapshot.internal_events = node->getInternalEvents();
+    snapshot.internal_slots = node->getInternalSlots();
+
+    if (snapshot.is_graph && parent) {
+        snapshot.subgraph = GraphSnapshot::create(parent->getLocalSubGraph(snapshot.uuid));
+    }
+
+    return snapshot;
+}
+
+void NodeSnapshot::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << uuid;
+    data << type;
+    data << label;
+    data << scheduler_id;
+    data << is_graph;
+
+    data << state;
+    data << parameters;
+
+    data << external_inputs;
+    data << external_outputs;
+    data << external_events;
+    data << external_slots;
+
+    data << internal_inputs;
+    data << internal_outputs;
+    data << internal_events;
+    data << internal_slots;
+
+    data << subgraph;
+}
+
+void NodeSnapshot::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> uuid;
+    data >> type;
+    data >> label;
+    data >> scheduler_id;
+    data >> is_graph;
+
+    data >> state;
+    data >> parameters;
+
+    data >> external_inputs;
+    data >> external_outputs;
+    data >> external_events;
+    data >> external_slots;
+
+    data >> internal_inputs;
+    data >> internal_outputs;
+    data >> internal_events;
+    data >> internal_slots;
+
+    data >> subgraph;
+}
+
+GraphSnapshot::GraphSnapshot()
+{
+}
+
+GraphSnapshotPtr GraphSnapshot::create(const GraphFacadeImplementationPtr& graph)
+{
+    GraphSnapshotPtr snapshot = std::make_shared<GraphSnapshot>();
+
+    std::vector<UUID> uuids = graph->enumerateAllNodes();
+    snapshot->nodes.reserve(uuids.size());
+    for (const UUID& uuid : uuids) {
+        NodeFacadeImplementationPtr node = std::dynamic_pointer_cast<NodeFacadeImplementation>(graph->findNodeFacade(uuid));
+        apex_assert_hard(node);
+        snapshot->nodes.push_back(NodeSnapshot::create(node, graph));
+    }
+
+    snapshot->connections = graph->enumerateAllConnections();
+
+    return snapshot;
+}
+
+const NodeSnapshot* GraphSnapshot::findNode(const UUID& uuid) const
+{
+    for (const NodeSnapshot& node : nodes) {
+        if (node.uuid == uuid) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+
+void GraphSnapshot::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << nodes;
+    data << connections;
+}
+
+void GraphSnapshot::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> nodes;
+    data >> connections;
+}
@@ -9,9 +9,11 @@
 #include <csapex/io/protcol/node_requests.h>
 #include <csapex/io/protcol/parameter_changed.h>
 #include <csapex/io/protcol/request_parameter.h>
+#include <csapex/io/protcol/state_notes.h>
 #include <csapex/io/raw_message.h>
 #include <csapex/io/session.h>
 #include <csapex/model/connector_proxy.h>
+#include <csapex/model/graph_snapshot.h>
 #include <csapex/model/node_characteristics.h>
 #include <csapex/model/node_state.h>
 #include <csapex/profiling/profiler_proxy.h>
@@ -23,7 +25,15 @@
 
 using namespace csapex;
 
-NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
+NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid) : NodeFacadeProxy(session, uuid, nullptr)
+{
+}
+
+NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot& snapshot) : NodeFacadeProxy(session, uuid, &snapshot)
+{
+}
+
+NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot* snapshot)
   : Proxy(session)
   , uuid_(uuid)
   ,
@@ -47,7 +57,39 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
 
     profiler_proxy_ = std::make_shared<ProfilerProxy>(node_channel_);
 
-    state_proxy_ = node_channel_->request<NodeStatePtr, NodeRequests>(NodeRequests::NodeRequestType::GetNodeState);
+    if (snapshot) {
+        state_proxy_ = snapshot->state;
+
+        cache_getType_ = snapshot->type;
+        has_getType_ = true;
+        cache_isGraph_ = snapshot->is_graph;
+        has_isGraph_ = true;
+        value_getLabel_ = snapshot->label;
+        has_getLabel_ = true;
+        value_getSchedulerId_ = snapshot->scheduler_id;
+        has_getSchedulerId_ = true;
+
+        value_getExternalInputs_ = snapshot->external_inputs;
+        has_getExternalInputs_ = true;
+        value_getExternalOutputs_ = snapshot->external_outputs;
+        has_getExternalOutputs_ = true;
+        value_getExternalEvents_ = snapshot->external_events;
+        has_getExternalEvents_ = true;
+        value_getExternalSlots_ = snapshot->external_slots;
+        has_getExternalSlots_ = true;
+
+        value_getInternalInputs_ = snapshot->internal_inputs;
+        has_getInternalInputs_ = true;
+        value_getInternalOutputs_ = snapshot->internal_outputs;
+        has_getInternalOutputs_ = true;
+        value_getInternalEvents_ = snapshot->internal_events;
+        has_getInternalEvents_ = true;
+        value_getInternalSlots_ = snapshot->internal_slots;
+        has_getInternalSlots_ = true;
+
+    } else {
+        state_proxy_ = node_channel_->request<NodeStatePtr, NodeRequests>(NodeRequests::NodeRequestType::GetNodeState);
+    }
 
     observe(node_channel_->note_received, [this](const io::NoteConstPtr& note) {
         if (const std::shared_ptr<NodeNote const>& cn = std::dynamic_pointer_cast<NodeNote const>(note)) {
@@ -159,10 +201,15 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
                     notification(cn->getPayload<Notification>(0));
                 } break;
             }
+
+        } else if (const std::shared_ptr<StateNote const>& sn = std::dynamic_pointer_cast<StateNote const>(note)) {
+            state_.apply(*sn);
         }
     });
 
-    auto params = node_channel_->request<std::vector<param::ParameterPtr>, NodeRequests>(NodeRequests::NodeRequestType::GetParameters);
+    node_channel_->sendNote<StateNote>(StateNoteType::Subscribe);
+
+    auto params = snapshot ? snapshot->parameters : node_channel_->request<std::vector<param::ParameterPtr>, NodeRequests>(NodeRequests::NodeRequestType::GetParameters);
     for (param::ParameterPtr& p : params) {
         createParameterProxy(p);
         parameter_added(p);
@@ -237,6 +284,10 @@ AUUID NodeFacadeProxy::getAUUID() const
 bool NodeFacadeProxy::isParameterInput(const UUID& id)
 {
     auto pos = is_parameter_input_.find(id);
+    if (pos == is_parameter_input_.end()) {
+        fetchParameterConnectorFlags();
+        pos = is_parameter_input_.find(id);
+    }
     if (pos == is_parameter_input_.end()) {
         bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterInput, id);
         is_parameter_input_[id] = result;
@@ -250,6 +301,10 @@ bool NodeFacadeProxy::isParameterInput(const UUID& id)
 bool NodeFacadeProxy::isParameterOutput(const UUID& id)
 {
     auto pos = is_parameter_output_.find(id);
+    if (pos == is_parameter_output_.end()) {
+        fetchParameterConnectorFlags();
+        pos = is_parameter_output_.find(id);
+    }
     if (pos == is_parameter_output_.end()) {
         bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterOutput, id);
         is_parameter_output_[id] = result;
@@ -260,6 +315,43 @@ bool NodeFacadeProxy::isParameterOutput(const UUID& id)
     }
 }
 
+void NodeFacadeProxy::fetchParameterConnectorFlags()
+{
+    // the designer asks for every connector of a node when it is drawn, one packet answers all of them
+    std::vector<UUID> inputs;
+    std::vector<UUID> outputs;
+    std::vector<RequestConstPtr> requests;
+    for (const ConnectorDescription& input : getInputs()) {
+        if (is_parameter_input_.find(input.id) == is_parameter_input_.end()) {
+            inputs.push_back(input.id);
+            requests.push_back(std::make_shared<NodeRequests::NodeRequest>(NodeRequests::NodeRequestType::IsParameterInput, uuid_.getAbsoluteUUID(), input.id));
+        }
+    }
+    for (const ConnectorDescription& output : getOutputs()) {
+        if (is_parameter_output_.find(output.id) == is_parameter_output_.end()) {
+            outputs.push_back(output.id);
+            requests.push_back(std::make_shared<NodeRequests::NodeRequest>(NodeRequests::NodeRequestType::IsParameterOutput, uuid_.getAbsoluteUUID(), output.id));
+        }
+    }
+    if (requests.empty()) {
+        return;
+    }
+
+    std::vector<io::ResponseFuture> responses = session_->sendRequestBatch(requests);
+    for (std::size_t i = 0; i < responses.size(); ++i) {
+        // connectors without an answer are requested individually
+        auto response = responses[i].getAs<NodeRequests::NodeResponse>();
+        if (!response) {
+            continue;
+        }
+        if (i < inputs.size()) {
+            is_parameter_input_[inputs[i]] = response->getResult<bool>();
+        } else {
+            is_parameter_output_[outputs[i - inputs.size()]] = response->getResult<bool>();
+        }
+    }
+}
+
 GraphPtr NodeFacadeProxy::getSubgraph() const
 {
     apex_fail("Implement remote subgraph access!");
@@ -374,6 +466,15 @@ void NodeFacadeProxy::createParameterProxy(param::ParameterPtr proxy) const
         }                                                                                                                                                                                              \
         return value_##function##_;                                                                                                                                                                    \
     }
+#define HANDLE_STATE_ACCESSOR(_enum, type, function)                                                                                                                                                   \
+    type NodeFacadeProxy::function() const                                                                                                                                                             \
+    {                                                                                                                                                                                                  \
+        boost::any value;                                                                                                                                                                              \
+        if (state_.get(NodeRequests::NodeRequestType::_enum, value)) {                                                                                                                                 \
+            return boost::any_cast<type>(value);                                                                                                                                                       \
+        }                                                                                                                                                                                              \
+        return request<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                         \
+    }
 #define HANDLE_SIGNAL(_enum, signal)
 
 #include <csapex/model/node_facade_proxy_accessors.hpp>
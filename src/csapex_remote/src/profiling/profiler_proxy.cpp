@@ -16,6 +16,9 @@ ProfilerProxy::ProfilerProxy(io::ChannelPtr node_channel) : Profiler(true, 16),
                 case ProfilerNoteType::EnabledChanged:
                     enabled_changed(cn->getPayload<bool>(0));
                     break;
+                case ProfilerNoteType::WindowReset:
+                    Profiler::resetWindow();
+                    break;
             }
         }
     });
@@ -26,6 +29,34 @@ void ProfilerProxy::setEnabled(bool enabled)
     node_channel_->sendRequest<ProfilerRequests>(ProfilerRequests::ProfilerRequestType::SetEnabled, enabled);
 }
 
+void ProfilerProxy::resetWindow()
+{
+    node_channel_->sendRequest<ProfilerRequests>(ProfilerRequests::ProfilerRequestType::ResetWindow);
+}
+
+LatencyHistogram ProfilerProxy::fetchHistogram(const std::string& key, const std::string& step)
+{
+    LatencyHistogram histogram = node_channel_->request<LatencyHistogram, ProfilerRequests>(ProfilerRequests::ProfilerRequestType::GetHistogram, key, step);
+
+    getProfile(key);
+    Profile& prof = profiles_.at(key);
+    std::unique_lock<std::mutex> lock(*prof.mutex_);
+    prof.steps_acc_[step];
+    prof.steps_hist_[step] = histogram;
+    return histogram;
+}
+
+long ProfilerProxy::fetchCounter(const std::string& key, const std::string& counter)
+{
+    long value = node_channel_->request<long, ProfilerRequests>(ProfilerRequests::ProfilerRequestType::GetCounter, key, counter);
+
+    getProfile(key);
+    Profile& prof = profiles_.at(key);
+    std::unique_lock<std::mutex> lock(*prof.mutex_);
+    prof.counters_[counter] = value;
+    return value;
+}
+
 void ProfilerProxy::updateInterval(std::shared_ptr<const Interval>& interval)
 {
     Profile& prof = profiles_.at(interval->name());
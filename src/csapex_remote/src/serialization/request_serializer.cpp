@@ -74,7 +74,7 @@ StreamablePtr RequestSerializer::deserialize(const SerializationBuffer& data)
         uint8_t direction;
         data >> direction;
 
-        uint8_t id;
+        uint32_t id;
         data >> id;
 
         if (direction == 0) {
@@ -0,0 +1,163 @@
+#include "session_test_case.h"
+
+#include <csapex/model/graph_facade_proxy.h>
+#include <csapex/model/graph_snapshot.h>
+#include <csapex/model/node_facade_proxy.h>
+#include <csapex/model/node_state.h>
+#include <csapex/msg/any_message.h>
+#include <csapex/param/parameter_factory.h>
+#include <csapex/param/value_parameter.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <algorithm>
+
+using namespace csapex;
+
+class GraphSnapshotTest : public SessionTestCase
+{
+protected:
+    GraphSnapshotTest()
+      : root_uuid(UUIDProvider::makeUUID_without_parent("~"))
+      , node_uuid(UUIDProvider::makeUUID_without_parent("node_0"))
+      , graph_uuid(UUIDProvider::makeUUID_without_parent("graph_0"))
+      , child_uuid(UUIDProvider::makeUUID_without_parent("child_0"))
+    {
+    }
+
+    NodeSnapshot makeNode(const UUID& uuid, const std::string& type, const std::string& label)
+    {
+        NodeSnapshot node;
+        node.uuid = uuid;
+        node.type = type;
+        node.label = label;
+        node.scheduler_id = 0;
+        node.is_graph = false;
+        node.state = std::make_shared<NodeState>();
+        node.state->setLabel(label);
+        node.parameters.push_back(param::ParameterFactory::declareValue("value", 42).build());
+
+        TokenDataConstPtr type_token = makeEmpty<connection_types::AnyMessage>();
+        node.external_inputs.push_back(ConnectorDescription(AUUID(uuid), UUIDProvider::makeDerivedUUID_forced(uuid, "in_0"), ConnectorType::INPUT, type_token, "in"));
+        node.external_outputs.push_back(ConnectorDescription(AUUID(uuid), UUIDProvider::makeDerivedUUID_forced(uuid, "out_0"), ConnectorType::OUTPUT, type_token, "out"));
+        return node;
+    }
+
+    GraphSnapshot makeGraph()
+    {
+        GraphSnapshot graph;
+        graph.nodes.push_back(makeNode(node_uuid, "test::Node", "node"));
+
+        NodeSnapshot graph_node = makeNode(graph_uuid, "csapex::Graph", "graph");
+        graph_node.is_graph = true;
+        graph_node.subgraph = std::make_shared<GraphSnapshot>();
+        graph_node.subgraph->nodes.push_back(makeNode(child_uuid, "test::Child", "child"));
+        graph.nodes.push_back(graph_node);
+
+        graph.connections.push_back(ConnectionDescription(graph.nodes[0].external_outputs[0].getAUUID(), graph.nodes[1].external_inputs[0].getAUUID(),
+                                                          makeEmpty<connection_types::AnyMessage>(), 0, true, {}));
+        return graph;
+    }
+
+    GraphSnapshot roundTrip(const GraphSnapshot& snapshot)
+    {
+        SerializationBuffer buffer;
+        SemanticVersion version;
+        snapshot.serialize(buffer, version);
+
+        GraphSnapshot received;
+        received.deserialize(buffer, version);
+        return received;
+    }
+
+    UUID root_uuid;
+    UUID node_uuid;
+    UUID graph_uuid;
+    UUID child_uuid;
+};
+
+TEST_F(GraphSnapshotTest, SnapshotSurvivesSerialization)
+{
+    GraphSnapshot snapshot = roundTrip(makeGraph());
+
+    ASSERT_EQ(2u, snapshot.nodes.size());
+    ASSERT_EQ(1u, snapshot.connections.size());
+
+    const NodeSnapshot* node = snapshot.findNode(node_uuid);
+    ASSERT_NE(nullptr, node);
+    EXPECT_EQ("test::Node", node->type);
+    EXPECT_EQ("node", node->label);
+    EXPECT_FALSE(node->is_graph);
+    ASSERT_NE(nullptr, node->state);
+    EXPECT_EQ("node", node->state->getLabel());
+    ASSERT_EQ(1u, node->parameters.size());
+    EXPECT_EQ("value", node->parameters[0]->name());
+    EXPECT_EQ(42, node->parameters[0]->as<int>());
+    ASSERT_EQ(1u, node->external_inputs.size());
+    EXPECT_EQ("in", node->external_inputs[0].label);
+    ASSERT_EQ(1u, node->external_outputs.size());
+    EXPECT_EQ(UUIDProvider::makeDerivedUUID_forced(node_uuid, "out_0"), node->external_outputs[0].id);
+    EXPECT_EQ(nullptr, node->subgraph);
+
+    const NodeSnapshot* graph = snapshot.findNode(graph_uuid);
+    ASSERT_NE(nullptr, graph);
+    EXPECT_TRUE(graph->is_graph);
+    ASSERT_NE(nullptr, graph->subgraph);
+    ASSERT_EQ(1u, graph->subgraph->nodes.size());
+    EXPECT_EQ("test::Child", graph->subgraph->nodes[0].type);
+
+    EXPECT_EQ(node->external_outputs[0].getAUUID(), snapshot.connections[0].from);
+    EXPECT_EQ(graph->external_inputs[0].getAUUID(), snapshot.connections[0].to);
+}
+
+TEST_F(GraphSnapshotTest, NodeFacadeProxyIsBuiltFromTheSnapshot)
+{
+    GraphSnapshot snapshot = roundTrip(makeGraph());
+    const NodeSnapshot* node = snapshot.findNode(node_uuid);
+    ASSERT_NE(nullptr, node);
+
+    NodeFacadeProxyPtr proxy = std::make_shared<NodeFacadeProxy>(client, AUUID(node_uuid), *node);
+
+    EXPECT_EQ("test::Node", proxy->getType());
+    EXPECT_EQ("node", proxy->getLabel());
+    EXPECT_FALSE(proxy->isGraph());
+    ASSERT_NE(nullptr, proxy->getNodeState());
+    EXPECT_EQ("node", proxy->getNodeState()->getLabel());
+
+    ASSERT_EQ(1u, proxy->getParameters().size());
+    EXPECT_EQ(42, proxy->getParameter("value")->as<int>());
+
+    ASSERT_EQ(1u, proxy->getExternalInputs().size());
+    ASSERT_EQ(1u, proxy->getExternalOutputs().size());
+    EXPECT_NE(nullptr, proxy->getConnector(node->external_inputs[0].id));
+    EXPECT_NE(nullptr, proxy->getConnector(node->external_outputs[0].id));
+}
+
+TEST_F(GraphSnapshotTest, GraphFacadeProxyIsBuiltFromTheSnapshot)
+{
+    NodeSnapshot root = makeNode(root_uuid, "csapex::Graph", "root");
+    root.is_graph = true;
+    root.external_inputs.clear();
+    root.external_outputs.clear();
+    root.subgraph = std::make_shared<GraphSnapshot>(roundTrip(makeGraph()));
+
+    NodeFacadeProxyPtr root_proxy = std::make_shared<NodeFacadeProxy>(client, AUUID(root_uuid), root);
+    std::shared_ptr<GraphFacadeProxy> graph = std::make_shared<GraphFacadeProxy>(client, root_proxy, *root.subgraph);
+
+    // every node and connection is known without asking the server
+    EXPECT_EQ(2u, graph->countNodes());
+    ASSERT_EQ(1u, graph->enumerateAllConnections().size());
+
+    std::vector<std::string> types;
+    for (const UUID& id : graph->enumerateAllNodes()) {
+        types.push_back(graph->findNodeFacade(id)->getType());
+    }
+    std::sort(types.begin(), types.end());
+    EXPECT_EQ((std::vector<std::string>{ "csapex::Graph", "test::Node" }), types);
+
+    GraphFacadePtr subgraph = graph->getSubGraph(graph_uuid);
+    ASSERT_NE(nullptr, subgraph);
+    EXPECT_EQ(graph.get(), subgraph->getParent());
+    ASSERT_EQ(1u, subgraph->countNodes());
+    EXPECT_EQ("test::Child", subgraph->findNodeFacade(subgraph->enumerateAllNodes().front())->getType());
+}
@@ -0,0 +1,152 @@
+#include "session_test_case.h"
+
+#include <csapex/io/channel.h>
+#include <csapex/io/note_aggregator.h>
+#include <csapex/io/protcol/node_notes.h>
+#include <csapex/io/protcol/note_batch.h>
+#include <csapex/model/activity_type.h>
+#include <csapex/profiling/interval.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <mutex>
+
+using namespace csapex;
+
+class NoteBatchTest : public SessionTestCase
+{
+protected:
+    NoteBatchTest() : node(UUIDProvider::makeUUID_without_parent("node"))
+    {
+    }
+
+    std::shared_ptr<const Interval> makeInterval()
+    {
+        // distinct start times in microseconds
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Interval::Ptr interval = Interval::makeEmpty();
+        interval->start();
+        return interval;
+    }
+
+    io::NoteConstPtr makeStartNote(const std::shared_ptr<const Interval>& interval)
+    {
+        return std::make_shared<NodeNote>(NodeNoteType::IntervalStartTriggered, node, ActivityType::PROCESS, interval);
+    }
+
+    static std::vector<std::string> describe(const std::vector<io::NoteConstPtr>& notes, const std::map<const Interval*, std::string>& names)
+    {
+        std::vector<std::string> result;
+        for (const io::NoteConstPtr& note : notes) {
+            auto node_note = std::dynamic_pointer_cast<NodeNote const>(note);
+            if (node_note && node_note->getNoteType() == NodeNoteType::IntervalStartTriggered) {
+                result.push_back("start " + names.at(node_note->getPayload<std::shared_ptr<const Interval>>(1).get()));
+            } else if (node_note && node_note->getNoteType() == NodeNoteType::IntervalEndTriggered) {
+                result.push_back("end " + names.at(node_note->getPayload<std::shared_ptr<const Interval>>(0).get()));
+            } else {
+                result.push_back("other");
+            }
+        }
+        return result;
+    }
+
+protected:
+    AUUID node;
+};
+
+TEST_F(NoteBatchTest, IntervalsEndBeforeTheNextIntervalOfTheirNodeStarts)
+{
+    std::shared_ptr<const Interval> first = makeInterval();
+    std::shared_ptr<const Interval> second = makeInterval();
+    std::shared_ptr<const Interval> third = makeInterval();
+
+    // the first two intervals have finished, the start of the second has been superseded by the third
+    io::NoteConstPtr other = std::make_shared<NodeNote>(NodeNoteType::ProfilingStartTriggered, node);
+    NoteBatch batch({ other, makeStartNote(third) }, { NoteBatch::IntervalPack{ node, { first, second } } });
+
+    std::map<const Interval*, std::string> names{ { first.get(), "first" }, { second.get(), "second" }, { third.get(), "third" } };
+    std::vector<std::string> expected{ "other", "end first", "end second", "start third" };
+    EXPECT_EQ(expected, describe(batch.unpack(), names));
+}
+
+TEST_F(NoteBatchTest, IntervalsThatStartedLaterFollowTheStart)
+{
+    std::shared_ptr<const Interval> first = makeInterval();
+    std::shared_ptr<const Interval> second = makeInterval();
+
+    // the second interval started and finished within the same batch
+    NoteBatch batch({ makeStartNote(second) }, { NoteBatch::IntervalPack{ node, { first, second } } });
+
+    std::map<const Interval*, std::string> names{ { first.get(), "first" }, { second.get(), "second" } };
+    std::vector<std::string> expected{ "end first", "start second", "end second" };
+    EXPECT_EQ(expected, describe(batch.unpack(), names));
+}
+
+TEST_F(NoteBatchTest, OrderSurvivesSerialization)
+{
+    std::shared_ptr<const Interval> first = makeInterval();
+    std::shared_ptr<const Interval> second = makeInterval();
+
+    NoteBatch batch({ makeStartNote(second) }, { NoteBatch::IntervalPack{ node, { first } } });
+
+    SerializationBuffer buffer;
+    SemanticVersion version;
+    batch.serialize(buffer, version);
+
+    NoteBatch received;
+    received.deserialize(buffer, version);
+
+    std::vector<io::NoteConstPtr> notes = received.unpack();
+    ASSERT_EQ(2u, notes.size());
+    auto end = std::dynamic_pointer_cast<NodeNote const>(notes[0]);
+    auto start = std::dynamic_pointer_cast<NodeNote const>(notes[1]);
+    ASSERT_NE(nullptr, end);
+    ASSERT_NE(nullptr, start);
+    EXPECT_EQ(NodeNoteType::IntervalEndTriggered, end->getNoteType());
+    EXPECT_EQ(first->getStartMicro(), end->getPayload<std::shared_ptr<const Interval>>(0)->getStartMicro());
+    EXPECT_EQ(NodeNoteType::IntervalStartTriggered, start->getNoteType());
+}
+
+TEST_F(NoteBatchTest, StartOfAnIntervalWaitsForTheFinishedIntervalsOfItsNode)
+{
+    std::mutex mutex;
+    std::vector<NodeNoteType> received;
+    io::ChannelPtr channel = client->openChannel(node);
+    channel->note_received.connect([&](const io::NoteConstPtr& note) {
+        if (auto node_note = std::dynamic_pointer_cast<NodeNote const>(note)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            received.push_back(node_note->getNoteType());
+        }
+    });
+    auto count = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return received.size();
+    };
+    auto waitFor = [&](std::size_t n) {
+        for (int i = 0; i < 2000 && count() < n; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return count() >= n;
+    };
+
+    // intervals alone are only sent every 100 s, except for the very first tick
+    NoteAggregator aggregator(server, 100.0, 0.01);
+    aggregator.sendInterval(node, makeInterval());
+    ASSERT_TRUE(waitFor(1));
+
+    std::shared_ptr<const Interval> finished = makeInterval();
+    std::shared_ptr<const Interval> started = makeInterval();
+    aggregator.sendInterval(node, finished);
+    aggregator.sendStateNote("start", makeStartNote(started));
+
+    // neither the interval nor the start may leave before the next profiling flush
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(1u, count());
+
+    aggregator.flush();
+    ASSERT_TRUE(waitFor(3));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::vector<NodeNoteType> expected{ NodeNoteType::IntervalEndTriggered, NodeNoteType::IntervalEndTriggered, NodeNoteType::IntervalStartTriggered };
+    EXPECT_EQ(expected, received);
+}
@@ -0,0 +1,71 @@
+#include "session_test_case.h"
+
+#include <csapex/io/feedback.h>
+#include <csapex/io/protcol/request_batch.h>
+
+using namespace csapex;
+
+class RequestBatchTest : public SessionTestCase
+{
+};
+
+TEST_F(RequestBatchTest, AsyncRequestsAreAnswered)
+{
+    std::vector<io::ResponseFuture> futures;
+    for (int i = 0; i < 300; ++i) {
+        futures.push_back(client->sendRequestAsync<EchoRequests>(i));
+    }
+
+    for (int i = 0; i < 300; ++i) {
+        auto response = futures[i].getAs<EchoRequests::EchoResponse>();
+        ASSERT_NE(nullptr, response) << i;
+        EXPECT_EQ(2 * i, response->value);
+    }
+}
+
+TEST_F(RequestBatchTest, BatchedRequestsAreAnsweredInOrder)
+{
+    std::vector<RequestConstPtr> requests;
+    for (int i = 0; i < 50; ++i) {
+        requests.push_back(std::make_shared<EchoRequests::EchoRequest>(i));
+    }
+
+    std::vector<io::ResponseFuture> futures = client->sendRequestBatch(requests);
+    ASSERT_EQ(requests.size(), futures.size());
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        auto response = futures[i].getAs<EchoRequests::EchoResponse>();
+        ASSERT_NE(nullptr, response) << i;
+        EXPECT_EQ(requests[i]->getRequestID(), response->getRequestID());
+        EXPECT_EQ(2 * static_cast<int>(i), response->value);
+    }
+}
+
+TEST_F(RequestBatchTest, FailingRequestsDoNotAffectTheRestOfTheBatch)
+{
+    std::vector<RequestConstPtr> requests{ std::make_shared<EchoRequests::EchoRequest>(1), std::make_shared<EchoRequests::EchoRequest>(-1),
+                                           std::make_shared<EchoRequests::EchoRequest>(3) };
+
+    std::vector<io::ResponseFuture> futures = client->sendRequestBatch(requests);
+    ASSERT_EQ(3u, futures.size());
+
+    auto first = futures[0].getAs<EchoRequests::EchoResponse>();
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(2, first->value);
+
+    auto feedback = futures[1].getAs<Feedback>();
+    ASSERT_NE(nullptr, feedback);
+    EXPECT_EQ(requests[1]->getRequestID(), feedback->getRequestID());
+
+    auto last = futures[2].getAs<EchoRequests::EchoResponse>();
+    ASSERT_NE(nullptr, last);
+    EXPECT_EQ(6, last->value);
+}
+
+TEST_F(RequestBatchTest, BatchesAfterTheSessionStoppedThrow)
+{
+    client->stop();
+
+    std::vector<RequestConstPtr> requests{ std::make_shared<EchoRequests::EchoRequest>(1) };
+    EXPECT_THROW(client->sendRequestBatch(requests), Session::NoConnectionException);
+}
@@ -0,0 +1,157 @@
+#include "session_test_case.h"
+
+#include <csapex/io/channel.h>
+#include <csapex/io/protcol/state_notes.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <atomic>
+#include <mutex>
+
+using namespace csapex;
+
+class SessionTest : public SessionTestCase
+{
+protected:
+    SessionTest() : object(UUIDProvider::makeUUID_without_parent("object"))
+    {
+    }
+
+    template <typename Predicate>
+    static bool waitFor(Predicate predicate)
+    {
+        for (int i = 0; i < 5000 && !predicate(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
+
+    io::NoteConstPtr makeNote(uint32_t version)
+    {
+        return std::make_shared<StateNote>(StateNoteType::Subscribe, object, version, std::vector<StateNote::Value>{});
+    }
+
+protected:
+    AUUID object;
+};
+
+TEST_F(SessionTest, RequestIsAnswered)
+{
+    auto response = client->sendRequest<EchoRequests>(21);
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(42, response->value);
+}
+
+TEST_F(SessionTest, NotesAreReceivedInOrder)
+{
+    std::mutex mutex;
+    std::vector<uint32_t> versions;
+    io::ChannelPtr channel = client->openChannel(object);
+    channel->note_received.connect([&](const io::NoteConstPtr& note) {
+        if (auto state_note = std::dynamic_pointer_cast<StateNote const>(note)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            versions.push_back(state_note->getStateVersion());
+        }
+    });
+
+    const uint32_t count = 100;
+    for (uint32_t i = 0; i < count; ++i) {
+        server->sendNote(makeNote(i));
+    }
+
+    ASSERT_TRUE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return versions.size() >= count;
+    }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_EQ(count, versions.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        EXPECT_EQ(i, versions[i]);
+    }
+}
+
+TEST_F(SessionTest, RequestDuringAFloodOfNotesIsStillAnswered)
+{
+    const int flood_size = 3000;
+
+    std::atomic<int> received(0);
+    io::ChannelPtr channel = server->openChannel(object);
+    channel->note_received.connect([&](const io::NoteConstPtr&) { ++received; });
+
+    std::thread flood([&]() {
+        for (int i = 0; i < flood_size; ++i) {
+            client->sendNote(makeNote(i));
+        }
+    });
+
+    // requests overtake the notes that are still queued
+    auto response = client->sendRequest<EchoRequests>(5);
+    flood.join();
+
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(10, response->value);
+
+    ASSERT_TRUE(waitFor([&]() { return received == flood_size; }));
+}
+
+TEST_F(SessionTest, NotesStayInOrderWhenSwitchingToSharedMemory)
+{
+    std::mutex mutex;
+    std::vector<uint32_t> to_client;
+    std::vector<uint32_t> to_server;
+    auto record = [&mutex](std::vector<uint32_t>& versions) {
+        return [&mutex, &versions](const io::NoteConstPtr& note) {
+            if (auto state_note = std::dynamic_pointer_cast<StateNote const>(note)) {
+                std::unique_lock<std::mutex> lock(mutex);
+                versions.push_back(state_note->getStateVersion());
+            }
+        };
+    };
+    io::ChannelPtr client_channel = client->openChannel(object);
+    client_channel->note_received.connect(record(to_client));
+    io::ChannelPtr server_channel = server->openChannel(object);
+    server_channel->note_received.connect(record(to_server));
+
+    // both directions are busy while the transport is switched
+    const uint32_t count = 2000;
+    std::thread server_flood([&]() {
+        for (uint32_t i = 0; i < count; ++i) {
+            server->sendNote(makeNote(i));
+        }
+    });
+    std::thread client_flood([&]() {
+        for (uint32_t i = 0; i < count; ++i) {
+            client->sendNote(makeNote(i));
+        }
+    });
+
+    // both sessions share one io thread here, so the ring has to hold everything the server sends before the client reads it
+    bool switched = client->negotiateSharedMemory();
+    server_flood.join();
+    client_flood.join();
+    ASSERT_TRUE(switched);
+    EXPECT_TRUE(client->isUsingSharedMemory());
+    EXPECT_TRUE(waitFor([&]() { return server->isUsingSharedMemory(); }));
+
+    // traffic after the switch
+    for (uint32_t i = count; i < 2 * count; ++i) {
+        server->sendNote(makeNote(i));
+        client->sendNote(makeNote(i));
+    }
+    auto response = client->sendRequest<EchoRequests>(21);
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(42, response->value);
+
+    ASSERT_TRUE(waitFor([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return to_client.size() >= 2 * count && to_server.size() >= 2 * count;
+    }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_EQ(2 * count, to_client.size());
+    ASSERT_EQ(2 * count, to_server.size());
+    for (uint32_t i = 0; i < 2 * count; ++i) {
+        EXPECT_EQ(i, to_client[i]);
+        EXPECT_EQ(i, to_server[i]);
+    }
+}
@@ -0,0 +1,125 @@
+/// HEADER
+#include "session_test_case.h"
+
+/// PROJECT
+#include <csapex/io/feedback.h>
+#include <csapex/io/protcol/request_batch.h>
+#include <csapex/io/protcol/request_shared_memory.h>
+#include <csapex/serialization/request_serializer.h>
+#include <csapex/serialization/io/std_io.h>
+
+/// SYSTEM
+#include <stdexcept>
+
+CSAPEX_REGISTER_REQUEST_SERIALIZER(EchoRequests)
+
+using namespace csapex;
+using boost::asio::ip::tcp;
+
+EchoRequests::EchoResponse::EchoResponse(int value, uint32_t request_id) : ResponseImplementation(request_id), value(value)
+{
+}
+
+EchoRequests::EchoResponse::EchoResponse(uint32_t request_id) : ResponseImplementation(request_id), value(0)
+{
+}
+
+void EchoRequests::EchoResponse::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << value;
+}
+
+void EchoRequests::EchoResponse::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> value;
+}
+
+EchoRequests::EchoRequest::EchoRequest(int value) : RequestImplementation(0), value(value)
+{
+}
+
+EchoRequests::EchoRequest::EchoRequest(uint32_t request_id) : RequestImplementation(request_id), value(0)
+{
+}
+
+ResponsePtr EchoRequests::EchoRequest::execute(const SessionPtr& session, CsApexCore& core) const
+{
+    if (value < 0) {
+        throw std::runtime_error("negative value");
+    }
+    return std::make_shared<EchoResponse>(2 * value, getRequestID());
+}
+
+void EchoRequests::EchoRequest::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << value;
+}
+
+void EchoRequests::EchoRequest::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> value;
+}
+
+SessionTestCase::SessionTestCase()
+{
+}
+
+void SessionTestCase::SetUp()
+{
+    tcp::acceptor acceptor(io_service, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    tcp::socket client_socket(io_service);
+    tcp::socket server_socket(io_service);
+    client_socket.connect(acceptor.local_endpoint());
+    acceptor.accept(server_socket);
+
+    server = std::make_shared<Session>(std::move(server_socket), "server");
+    client = std::make_shared<Session>(std::move(client_socket), "client");
+
+    std::weak_ptr<Session> weak_server = server;
+    server->packet_received.connect([weak_server](const StreamableConstPtr& packet) {
+        SessionPtr server = weak_server.lock();
+        if (!server) {
+            return;
+        }
+        RequestConstPtr request = std::dynamic_pointer_cast<Request const>(packet);
+        if (!request) {
+            return;
+        }
+        if (std::dynamic_pointer_cast<EchoRequests::EchoRequest const>(request) || std::dynamic_pointer_cast<RequestBatch::BatchRequest const>(request)) {
+            // echo requests and batches of them never access the core
+            CsApexCore* core = nullptr;
+            server->write(request->executeSafely(server, *core));
+
+        } else if (auto shared_memory = std::dynamic_pointer_cast<RequestSharedMemory::SharedMemoryRequest const>(request)) {
+            bool accepted = server->acceptSharedMemory(shared_memory->getName(), shared_memory->getToken(), shared_memory->getRequestID());
+            server->write(std::make_shared<RequestSharedMemory::SharedMemoryResponse>(accepted, shared_memory->getRequestID()));
+
+        } else {
+            server->write(std::make_shared<Feedback>(std::string("unexpected request ") + request->getType(), request->getRequestID()));
+        }
+    });
+
+    server->start();
+    client->start();
+
+    work_.reset(new boost::asio::io_service::work(io_service));
+    io_thread_ = std::thread([this]() { io_service.run(); });
+
+    // synchronous requests are answered once the packet handler of the client is running
+    while (!client->sendRequest(std::make_shared<EchoRequests::EchoRequest>(0))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void SessionTestCase::TearDown()
+{
+    client->stop();
+    server->stop();
+
+    work_.reset();
+    io_service.stop();
+    io_thread_.join();
+
+    client.reset();
+    server.reset();
+}
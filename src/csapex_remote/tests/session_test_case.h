@@ -0,0 +1,89 @@
+#ifndef SESSION_TEST_CASE_H
+#define SESSION_TEST_CASE_H
+
+/// PROJECT
+#include <csapex/io/session.h>
+#include <csapex/io/request_impl.hpp>
+#include <csapex/io/response_impl.hpp>
+
+/// SYSTEM
+#include <boost/asio.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+namespace csapex
+{
+/**
+ * @brief The EchoRequests class answers a value with its double, negative values make the request throw
+ */
+class EchoRequests
+{
+public:
+    class EchoResponse : public ResponseImplementation<EchoResponse>
+    {
+    public:
+        EchoResponse(int value, uint32_t request_id);
+        EchoResponse(uint32_t request_id);
+
+        void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        std::string getType() const override
+        {
+            return "EchoRequests";
+        }
+
+        int value;
+    };
+
+    class EchoRequest : public RequestImplementation<EchoRequest>
+    {
+    public:
+        EchoRequest(int value);
+        EchoRequest(uint32_t request_id);
+
+        ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const override;
+
+        void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        std::string getType() const override
+        {
+            return "EchoRequests";
+        }
+
+        int value;
+    };
+
+public:
+    using RequestT = EchoRequest;
+    using ResponseT = EchoResponse;
+};
+
+/**
+ * @brief The SessionTestCase class connects a client and a server session via a loopback socket.
+ * The server answers echo requests and accepts shared memory, all other requests are answered with Feedback.
+ */
+class SessionTestCase : public ::testing::Test
+{
+protected:
+    SessionTestCase();
+
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    boost::asio::io_service io_service;
+
+    SessionPtr server;
+    SessionPtr client;
+
+private:
+    std::unique_ptr<boost::asio::io_service::work> work_;
+    std::thread io_thread_;
+};
+
+}  // namespace csapex
+
+#endif  // SESSION_TEST_CASE_H
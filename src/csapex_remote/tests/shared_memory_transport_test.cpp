@@ -0,0 +1,80 @@
+#include <csapex/io/shared_memory_transport.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace csapex;
+
+namespace
+{
+bool transfer(SharedMemoryTransport& from, SharedMemoryTransport& to, const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> received(data.size());
+    bool read = false;
+    std::thread reader([&]() { read = to.read(received.data(), received.size()); });
+    bool written = from.write(data.data(), data.size());
+    reader.join();
+    return written && read && received == data;
+}
+}  // namespace
+
+TEST(SharedMemoryTransportTest, CreatedRegionCanBeOpened)
+{
+    SharedMemoryTransportPtr creator = SharedMemoryTransport::create(64);
+    ASSERT_NE(nullptr, creator);
+    EXPECT_FALSE(creator->getName().empty());
+
+    SharedMemoryTransportPtr other = SharedMemoryTransport::open(creator->getName(), creator->getToken());
+    ASSERT_NE(nullptr, other);
+    EXPECT_EQ(creator->getToken(), other->getToken());
+
+    EXPECT_TRUE(transfer(*creator, *other, { 1, 2, 3 }));
+    EXPECT_TRUE(transfer(*other, *creator, { 4, 5 }));
+}
+
+TEST(SharedMemoryTransportTest, DataLargerThanTheRingIsStreamed)
+{
+    SharedMemoryTransportPtr creator = SharedMemoryTransport::create(16);
+    SharedMemoryTransportPtr other = SharedMemoryTransport::open(creator->getName(), creator->getToken());
+    ASSERT_NE(nullptr, other);
+
+    std::vector<uint8_t> data(1000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    EXPECT_TRUE(transfer(*creator, *other, data));
+}
+
+TEST(SharedMemoryTransportTest, UnknownRegionCannotBeOpened)
+{
+    EXPECT_EQ(nullptr, SharedMemoryTransport::open("csapex_session_does_not_exist", 0));
+}
+
+TEST(SharedMemoryTransportTest, TokenMismatchLeavesTheRegionOpen)
+{
+    SharedMemoryTransportPtr creator = SharedMemoryTransport::create(64);
+
+    // the failed attempt is destroyed right away, it must not close the rings of the creator
+    EXPECT_EQ(nullptr, SharedMemoryTransport::open(creator->getName(), creator->getToken() + 1));
+
+    SharedMemoryTransportPtr other = SharedMemoryTransport::open(creator->getName(), creator->getToken());
+    ASSERT_NE(nullptr, other);
+    EXPECT_TRUE(transfer(*creator, *other, { 1, 2, 3 }));
+}
+
+TEST(SharedMemoryTransportTest, CloseFailsReadsAndWritesOfBothEnds)
+{
+    SharedMemoryTransportPtr creator = SharedMemoryTransport::create(64);
+    SharedMemoryTransportPtr other = SharedMemoryTransport::open(creator->getName(), creator->getToken());
+    ASSERT_NE(nullptr, other);
+
+    uint8_t byte = 0;
+    std::thread reader([&]() { EXPECT_FALSE(other->read(&byte, 1)); });
+    creator->close();
+    reader.join();
+
+    EXPECT_FALSE(creator->write(&byte, 1));
+    EXPECT_FALSE(other->write(&byte, 1));
+}
@@ -0,0 +1,114 @@
+#include "session_test_case.h"
+
+#include <csapex/io/channel.h>
+#include <csapex/io/note_aggregator.h>
+#include <csapex/io/protcol/state_notes.h>
+#include <csapex/io/state_cache.h>
+#include <csapex/io/state_publisher.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <mutex>
+
+using namespace csapex;
+
+class StatePublisherTest : public SessionTestCase
+{
+protected:
+    StatePublisherTest() : object(UUIDProvider::makeUUID_without_parent("object"))
+    {
+    }
+
+    void SetUp() override
+    {
+        SessionTestCase::SetUp();
+
+        channel = client->openChannel(object);
+        channel->note_received.connect([this](const io::NoteConstPtr& note) {
+            if (auto state_note = std::dynamic_pointer_cast<StateNote const>(note)) {
+                std::unique_lock<std::mutex> lock(mutex);
+                received.push_back(state_note);
+            }
+        });
+    }
+
+    std::vector<std::shared_ptr<StateNote const>> waitForNotes(std::size_t count)
+    {
+        for (int i = 0; i < 2000; ++i) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (received.size() >= count) {
+                    return received;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        return received;
+    }
+
+protected:
+    AUUID object;
+    io::ChannelPtr channel;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<StateNote const>> received;
+};
+
+TEST_F(StatePublisherTest, SubscriptionIsAnsweredWithASnapshot)
+{
+    auto aggregator = std::make_shared<NoteAggregator>(server, 100.0, 1.0);
+    auto publisher = std::make_shared<StatePublisher>(object, aggregator);
+    int value = 1;
+    publisher->addValue(0, [&]() -> boost::any { return value; });
+
+    // not subscribed yet
+    publisher->markChanged();
+    publisher->requestSnapshot();
+
+    std::vector<std::shared_ptr<StateNote const>> notes = waitForNotes(1);
+    ASSERT_EQ(1u, notes.size());
+    EXPECT_EQ(StateNoteType::Snapshot, notes[0]->getNoteType());
+    ASSERT_EQ(1u, notes[0]->getValues().size());
+    EXPECT_EQ(1, boost::any_cast<int>(notes[0]->getValues()[0].second));
+
+    publisher->close();
+}
+
+TEST_F(StatePublisherTest, SnapshotIsRetriedUntilItCanBeSampled)
+{
+    auto aggregator = std::make_shared<NoteAggregator>(server, 100.0, 1.0);
+    auto publisher = std::make_shared<StatePublisher>(object, aggregator);
+    std::atomic<bool> available(false);
+    publisher->addValue(0, [&]() -> boost::any { return 1; });
+    publisher->addValue(1, [&]() -> boost::any { return available ? boost::any(2) : boost::any(); });
+
+    // the second value cannot be sampled, so no note is produced
+    publisher->requestSnapshot();
+    aggregator->flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(waitForNotes(0).empty());
+
+    // nothing else changes, the publisher keeps sampling on its own
+    available = true;
+
+    std::vector<std::shared_ptr<StateNote const>> notes = waitForNotes(1);
+    ASSERT_EQ(1u, notes.size());
+    EXPECT_EQ(StateNoteType::Snapshot, notes[0]->getNoteType());
+    EXPECT_EQ(2u, notes[0]->getValues().size());
+
+    publisher->close();
+}
+
+TEST_F(StatePublisherTest, CacheDoesNotWaitForTheFirstSnapshot)
+{
+    StateCache cache;
+    boost::any value;
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(cache.get(0, value));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    cache.preset(0, 1);
+    ASSERT_TRUE(cache.get(0, value));
+    EXPECT_EQ(1, boost::any_cast<int>(value));
+}
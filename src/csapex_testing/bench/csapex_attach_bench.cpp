@@ -0,0 +1,212 @@
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/exception_handler.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/io/protcol/request_graph_snapshot.h>
+#include <csapex/io/session.h>
+#include <csapex/io/tcp_server.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph_facade_proxy.h>
+#include <csapex/model/graph_snapshot.h>
+#include <csapex/model/node_facade_proxy.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex_testing/benchmark_graphs.h>
+#include <csapex_testing/benchmark_runner.h>
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+using namespace csapex;
+using boost::asio::ip::tcp;
+
+namespace
+{
+struct Options
+{
+    Options() : graph("fan_out"), sizes({ 8, 32, 128 }), repetitions(3), port(42124), shared_memory(false)
+    {
+    }
+
+    std::string graph;
+    std::vector<int> sizes;
+    int repetitions;
+    int port;
+    bool shared_memory;
+};
+
+void usage(const char* bin)
+{
+    std::cout << "usage: " << bin << " [options]\n"
+              << "\n"
+              << "  measures how long a remote client needs to attach to a running server,\n"
+              << "  once by requesting every node on its own and once from a single graph snapshot\n"
+              << "\n"
+              << "  --graph <name>     synthetic graph to attach to (default fan_out)\n"
+              << "  --size <n>         size of the synthetic graph, may be given multiple times (default 8, 32, 128)\n"
+              << "  --repeat <n>       attaches per size and method, the fastest one is reported (default 3)\n"
+              << "  --port <n>         tcp port of the server (default 42124)\n"
+              << "  --shared-memory    exchange the packets through shared memory instead of the socket\n"
+              << std::endl;
+}
+
+bool parse(int argc, char* argv[], Options& options)
+{
+    bool sizes_given = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--graph" && has_value) {
+            options.graph = argv[++i];
+        } else if (arg == "--size" && has_value) {
+            if (!sizes_given) {
+                options.sizes.clear();
+                sizes_given = true;
+            }
+            options.sizes.push_back(std::stoi(argv[++i]));
+        } else if (arg == "--repeat" && has_value) {
+            options.repetitions = std::stoi(argv[++i]);
+        } else if (arg == "--port" && has_value) {
+            options.port = std::stoi(argv[++i]);
+        } else if (arg == "--shared-memory") {
+            options.shared_memory = true;
+        } else {
+            std::cerr << "invalid argument: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (!isBenchmarkGraph(options.graph)) {
+        std::cerr << "unknown graph: " << options.graph << std::endl;
+        return false;
+    }
+    for (int size : options.sizes) {
+        if (size <= 0) {
+            return false;
+        }
+    }
+    return options.repetitions > 0;
+}
+
+/**
+ * @brief The Client struct is a session on a loopback socket, the way a remote ui connects to the server
+ */
+struct Client
+{
+    Client(int port) : socket(io)
+    {
+        socket.connect(tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+        session = std::make_shared<Session>(std::move(socket), "attach_bench");
+        session->start();
+        worker = std::thread([this]() {
+            boost::asio::io_service::work work(io);
+            io.run();
+        });
+        while (!session->isRunning()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // the packet handler thread goes live shortly after the session has been started
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    ~Client()
+    {
+        session->stop();
+        io.stop();
+        worker.join();
+    }
+
+    boost::asio::io_service io;
+    tcp::socket socket;
+    SessionPtr session;
+    std::thread worker;
+};
+
+double attachPerNode(const SessionPtr& session)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    NodeFacadeProxyPtr remote_facade = std::make_shared<NodeFacadeProxy>(session, AUUID::NONE);
+    std::shared_ptr<GraphFacadeProxy> root = std::make_shared<GraphFacadeProxy>(session, remote_facade);
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double attachFromSnapshot(const SessionPtr& session)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    auto snapshot = session->sendRequest<RequestGraphSnapshot>();
+    apex_assert_hard(snapshot && snapshot->getRoot().subgraph);
+    NodeFacadeProxyPtr remote_facade = std::make_shared<NodeFacadeProxy>(session, AUUID::NONE, snapshot->getRoot());
+    std::shared_ptr<GraphFacadeProxy> root = std::make_shared<GraphFacadeProxy>(session, remote_facade, *snapshot->getRoot().subgraph);
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double fastest(int repetitions, const std::function<double()>& attach)
+{
+    double best = attach();
+    for (int i = 1; i < repetitions; ++i) {
+        best = std::min(best, attach());
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ExceptionHandler eh(false);
+    SettingsImplementation settings;
+    settings.set("path_to_bin", std::string(argv[0]));
+    settings.set("require_boot_plugin", false);
+    settings.set("headless", true);
+    settings.set("port", options.port);
+
+    CsApexCore core(settings, eh);
+    registerBenchmarkNodes(*core.getNodeFactory());
+
+    TcpServer server(core);
+    server.start();
+
+    // all attaches share one connection, the proxies of the previous attach are gone before the next one starts
+    Client client(options.port);
+    if (options.shared_memory && !client.session->negotiateSharedMemory()) {
+        std::cerr << "the server did not accept shared memory" << std::endl;
+        return 2;
+    }
+
+    std::cout << "{\n  \"graph\": \"" << options.graph << "\",\n  \"shared_memory\": " << (options.shared_memory ? "true" : "false") << ",\n  \"attach\": [";
+
+    for (std::size_t i = 0; i < options.sizes.size(); ++i) {
+        int size = options.sizes[i];
+
+        core.getRoot()->clear();
+        makeBenchmarkGraph(options.graph, *core.getRoot(), *core.getNodeFactory(), size);
+
+        std::size_t nodes = BenchmarkRunner(*core.getRoot(), *core.getThreadPool(), options.graph).getNodeCount();
+        std::cerr << "attaching to " << options.graph << " with " << nodes << " nodes" << std::endl;
+
+        double per_node = fastest(options.repetitions, [&]() { return attachPerNode(client.session); });
+        double snapshot = fastest(options.repetitions, [&]() { return attachFromSnapshot(client.session); });
+
+        std::cout << (i == 0 ? "\n" : ",\n") << "    { \"size\": " << size << ", \"nodes\": " << nodes << ", \"per_node_ms\": " << per_node << ", \"snapshot_ms\": " << snapshot
+                  << ", \"speedup\": " << per_node / snapshot << " }";
+    }
+
+    std::cout << "\n  ]\n}" << std::endl;
+
+    server.stop();
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/exception_handler.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/model/connection_description.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_state.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex_testing/benchmark_graphs.h>
+#include <csapex_testing/benchmark_runner.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace csapex;
+
+namespace
+{
+struct Options
+{
+    Options()
+      : size(8)
+      , warmup(1.0)
+      , duration(5.0)
+      , messages(0)
+      , priority(TaskPriorityPolicy::FIFO)
+      , deadline_scheduling(false)
+      , override_idle_strategy(false)
+      , idle_strategy(IdleStrategy::BLOCK)
+      , spin_budget_us(-1)
+      , realtime_priority(-1)
+      , rate(0.0)
+    {
+    }
+
+    std::string graph;
+    int size;
+    double warmup;
+    double duration;
+    std::size_t messages;
+    std::string output;
+    std::string save;
+    TaskPriorityPolicy priority;
+    bool deadline_scheduling;
+    bool override_idle_strategy;
+    IdleStrategy idle_strategy;
+    long spin_budget_us;
+    int realtime_priority;
+    double rate;
+};
+
+void usage(const char* bin)
+{
+    std::cout << "usage: " << bin << " <graph> [options]\n"
+              << "\n"
+              << "  <graph>            an .apex file or one of the synthetic graphs:\n";
+    for (const std::string& name : getBenchmarkGraphNames()) {
+        std::cout << "                       " << name << "\n";
+    }
+    std::cout << "\n"
+              << "  --size <n>         size of the synthetic graph (default 8)\n"
+              << "  --warmup <s>       seconds to run before measuring (default 1)\n"
+              << "  --duration <s>     seconds to measure, 0 to only stop on --messages (default 5)\n"
+              << "  --messages <n>     stop once every sink processed n messages\n"
+              << "  --output <file>    write the JSON report to a file instead of stdout\n"
+              << "  --save <file>      save the benchmarked graph as .apex file\n"
+              << "  --priority <name>  task priority policy of the thread pool, fifo or critical_path (default fifo)\n"
+              << "  --deadline         execute rate limited nodes in earliest deadline first order in all thread groups\n"
+              << "  --idle <name>      idle strategy of all thread groups, block, spin_then_park or busy_poll\n"
+              << "  --spin <us>        spin budget of all thread groups for spin_then_park\n"
+              << "  --realtime <prio>  run all thread groups with SCHED_FIFO at the given priority, 0 for the default policy\n"
+              << "  --rate <hz>        limit the sources of the graph, so that the thread groups idle between two messages\n"
+              << std::endl;
+}
+
+bool parse(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--size" && has_value) {
+            options.size = std::stoi(argv[++i]);
+        } else if (arg == "--warmup" && has_value) {
+            options.warmup = std::stod(argv[++i]);
+        } else if (arg == "--duration" && has_value) {
+            options.duration = std::stod(argv[++i]);
+        } else if (arg == "--messages" && has_value) {
+            options.messages = std::stoul(argv[++i]);
+        } else if (arg == "--output" && has_value) {
+            options.output = argv[++i];
+        } else if (arg == "--save" && has_value) {
+            options.save = argv[++i];
+        } else if (arg == "--priority" && has_value) {
+            try {
+                options.priority = task_priority::fromName(argv[++i]);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+        } else if (arg == "--deadline") {
+            options.deadline_scheduling = true;
+        } else if (arg == "--idle" && has_value) {
+            try {
+                options.idle_strategy = idle_strategy::fromName(argv[++i]);
+                options.override_idle_strategy = true;
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+        } else if (arg == "--spin" && has_value) {
+            options.spin_budget_us = std::stol(argv[++i]);
+        } else if (arg == "--realtime" && has_value) {
+            options.realtime_priority = std::stoi(argv[++i]);
+        } else if (arg == "--rate" && has_value) {
+            options.rate = std::stod(argv[++i]);
+        } else if (arg.compare(0, 2, "--") != 0 && options.graph.empty()) {
+            options.graph = arg;
+        } else {
+            std::cerr << "invalid argument: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (options.graph.empty() || options.size <= 0) {
+        return false;
+    }
+    if (options.spin_budget_us < -1 || options.realtime_priority < -1 || options.rate < 0.0) {
+        return false;
+    }
+    if (options.duration <= 0.0 && options.messages == 0) {
+        std::cerr << "either a duration or a message count is required" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void limitSources(GraphFacadeImplementation& root, double rate)
+{
+    std::set<UUID> has_inputs;
+    for (const ConnectionDescription& connection : root.enumerateAllConnections()) {
+        has_inputs.insert(connection.to.parentUUID());
+    }
+    for (const NodeFacadeImplementationPtr& node : root.getLocalGraph()->getAllLocalNodeFacades()) {
+        if (has_inputs.count(node->getUUID()) == 0) {
+            node->getNodeState()->setMaximumFrequency(rate);
+        }
+    }
+}
+
+double secondsSince(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ExceptionHandler eh(false);
+    SettingsImplementation settings;
+    settings.set("path_to_bin", std::string(argv[0]));
+    settings.set("require_boot_plugin", false);
+    settings.set("headless", true);
+
+    CsApexCore core(settings, eh);
+    registerBenchmarkNodes(*core.getNodeFactory());
+
+    if (isBenchmarkGraph(options.graph)) {
+        makeBenchmarkGraph(options.graph, *core.getRoot(), *core.getNodeFactory(), options.size);
+    } else {
+        core.load(options.graph);
+    }
+
+    if (!options.save.empty()) {
+        core.saveAs(options.save, true);
+    }
+
+    // applied after loading, so that the policy saved with a graph file does not override the requested one
+    core.getThreadPool()->setPriorityPolicy(options.priority);
+    for (const ThreadGroupPtr& group : core.getThreadPool()->getGroups()) {
+        if (options.deadline_scheduling) {
+            group->setDeadlineScheduling(true);
+        }
+        if (options.override_idle_strategy) {
+            group->setIdleStrategy(options.idle_strategy);
+        }
+        if (options.spin_budget_us >= 0) {
+            group->setSpinBudget(std::chrono::microseconds(options.spin_budget_us));
+        }
+        if (options.realtime_priority >= 0) {
+            group->setRealtimePriority(options.realtime_priority);
+        }
+    }
+
+    // idle groups only wake up when a throttled source starts the next message
+    if (options.rate > 0.0) {
+        limitSources(*core.getRoot(), options.rate);
+    }
+
+    BenchmarkRunner runner(*core.getRoot(), *core.getThreadPool(), options.graph);
+    std::cerr << "benchmarking " << options.graph << " with " << runner.getNodeCount() << " nodes" << std::endl;
+
+    core.startMainLoop();
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.warmup));
+
+    runner.startWindow();
+    auto start = std::chrono::steady_clock::now();
+    while (core.isMainLoopRunning()) {
+        if (options.duration > 0.0 && secondsSince(start) >= options.duration) {
+            break;
+        }
+        if (options.messages > 0 && runner.hasProcessed(options.messages)) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    runner.stopWindow();
+
+    core.shutdown();
+    core.joinMainLoop();
+
+    if (options.output.empty()) {
+        runner.writeJson(std::cout);
+    } else {
+        std::ofstream out(options.output);
+        runner.writeJson(out);
+    }
+
+    return core.getReturnCode();
+}
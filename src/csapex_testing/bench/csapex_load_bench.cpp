@@ -0,0 +1,166 @@
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/exception_handler.h>
+#include <csapex/core/settings.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex_testing/benchmark_graphs.h>
+#include <csapex_testing/benchmark_runner.h>
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace csapex;
+
+namespace
+{
+struct Options
+{
+    Options() : graph("fan_out"), sizes({ 32, 128, 512 }), repetitions(3), threads(0), directory(boost::filesystem::temp_directory_path().string())
+    {
+    }
+
+    std::string graph;
+    std::vector<int> sizes;
+    int repetitions;
+    int threads;
+    std::string directory;
+};
+
+void usage(const char* bin)
+{
+    std::cout << "usage: " << bin << " [options]\n"
+              << "\n"
+              << "  measures how long loading a saved graph takes, once from yaml and once from the binary format,\n"
+              << "  each with a single thread and with concurrent node construction\n"
+              << "\n"
+              << "  --graph <name>     synthetic graph to save and load (default fan_out)\n"
+              << "  --size <n>         size of the synthetic graph, may be given multiple times (default 32, 128, 512)\n"
+              << "  --repeat <n>       loads per size and format, the fastest one is reported (default 3)\n"
+              << "  --threads <n>      threads for the concurrent loads, 0 uses one per core (default 0)\n"
+              << "  --dir <path>       directory for the saved graphs (default the temporary directory)\n"
+              << std::endl;
+}
+
+bool parse(int argc, char* argv[], Options& options)
+{
+    bool sizes_given = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--graph" && has_value) {
+            options.graph = argv[++i];
+        } else if (arg == "--size" && has_value) {
+            if (!sizes_given) {
+                options.sizes.clear();
+                sizes_given = true;
+            }
+            options.sizes.push_back(std::stoi(argv[++i]));
+        } else if (arg == "--repeat" && has_value) {
+            options.repetitions = std::stoi(argv[++i]);
+        } else if (arg == "--threads" && has_value) {
+            options.threads = std::stoi(argv[++i]);
+        } else if (arg == "--dir" && has_value) {
+            options.directory = argv[++i];
+        } else {
+            std::cerr << "invalid argument: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (!isBenchmarkGraph(options.graph)) {
+        std::cerr << "unknown graph: " << options.graph << std::endl;
+        return false;
+    }
+    for (int size : options.sizes) {
+        if (size <= 0) {
+            return false;
+        }
+    }
+    return options.repetitions > 0 && options.threads >= 0;
+}
+
+double fastest(int repetitions, const std::function<double()>& load)
+{
+    double best = load();
+    for (int i = 1; i < repetitions; ++i) {
+        best = std::min(best, load());
+    }
+    return best;
+}
+
+double timeLoad(CsApexCore& core, Settings& settings, const std::string& file, int threads, std::size_t expected_nodes)
+{
+    settings.set("load_threads", threads);
+
+    // only the load itself is measured, not the teardown of the previous graph
+    core.reset();
+
+    auto start = std::chrono::steady_clock::now();
+    core.load(file);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    apex_assert_hard(core.getRoot()->getLocalGraph()->countNodes() == expected_nodes);
+    return ms;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ExceptionHandler eh(false);
+    SettingsImplementation settings;
+    settings.set("path_to_bin", std::string(argv[0]));
+    settings.set("require_boot_plugin", false);
+    settings.set("headless", true);
+
+    CsApexCore core(settings, eh);
+    registerBenchmarkNodes(*core.getNodeFactory());
+
+    std::cout << "{\n  \"graph\": \"" << options.graph << "\",\n  \"load\": [";
+
+    for (std::size_t i = 0; i < options.sizes.size(); ++i) {
+        int size = options.sizes[i];
+
+        core.getRoot()->clear();
+        makeBenchmarkGraph(options.graph, *core.getRoot(), *core.getNodeFactory(), size);
+
+        std::size_t nodes = core.getRoot()->getLocalGraph()->countNodes();
+        std::cerr << "loading " << options.graph << " with " << nodes << " nodes" << std::endl;
+
+        boost::filesystem::path base = boost::filesystem::path(options.directory) / ("csapex_load_bench_" + options.graph + "_" + std::to_string(size));
+        std::string yaml_file = base.string() + Settings::config_extension;
+        std::string binary_file = base.string() + Settings::config_extension_binary;
+
+        core.saveAs(yaml_file, true);
+        core.saveAs(binary_file, true);
+
+        double yaml = fastest(options.repetitions, [&]() { return timeLoad(core, settings, yaml_file, 1, nodes); });
+        double binary = fastest(options.repetitions, [&]() { return timeLoad(core, settings, binary_file, 1, nodes); });
+        double yaml_parallel = fastest(options.repetitions, [&]() { return timeLoad(core, settings, yaml_file, options.threads, nodes); });
+        double binary_parallel = fastest(options.repetitions, [&]() { return timeLoad(core, settings, binary_file, options.threads, nodes); });
+
+        std::cout << (i == 0 ? "\n" : ",\n") << "    { \"size\": " << size << ", \"nodes\": " << nodes << ", \"yaml_bytes\": " << boost::filesystem::file_size(yaml_file)
+                  << ", \"binary_bytes\": " << boost::filesystem::file_size(binary_file) << ", \"yaml_ms\": " << yaml << ", \"binary_ms\": " << binary
+                  << ", \"speedup\": " << yaml / binary << ", \"yaml_parallel_ms\": " << yaml_parallel << ", \"binary_parallel_ms\": " << binary_parallel
+                  << ", \"parallel_speedup\": " << binary / binary_parallel << " }";
+
+        boost::filesystem::remove(yaml_file);
+        boost::filesystem::remove(binary_file);
+    }
+
+    std::cout << "\n  ]\n}" << std::endl;
+
+    return 0;
+}
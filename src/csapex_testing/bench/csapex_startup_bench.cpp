@@ -0,0 +1,113 @@
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/exception_handler.h>
+#include <csapex/core/settings.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/factory/node_factory_impl.h>
+#include <csapex/factory/snippet_factory.h>
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace csapex;
+
+namespace
+{
+struct Options
+{
+    Options() : repetitions(3), cache((boost::filesystem::temp_directory_path() / "csapex_startup_bench_plugin_cache").string())
+    {
+    }
+
+    int repetitions;
+    std::string cache;
+};
+
+void usage(const char* bin)
+{
+    std::cout << "usage: " << bin << " [options]\n"
+              << "\n"
+              << "  measures how long starting up the core takes, once without the plugin manifest cache (cold)\n"
+              << "  and once with the cache that the cold start has written (warm)\n"
+              << "\n"
+              << "  --repeat <n>       starts per variant, the fastest one is reported (default 3)\n"
+              << "  --cache <path>     cache file to use, it is deleted before every cold start (default in the temporary directory)\n"
+              << std::endl;
+}
+
+bool parse(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--repeat" && has_value) {
+            options.repetitions = std::stoi(argv[++i]);
+        } else if (arg == "--cache" && has_value) {
+            options.cache = argv[++i];
+        } else {
+            std::cerr << "invalid argument: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    return options.repetitions > 0;
+}
+
+double fastest(int repetitions, const std::function<double()>& start)
+{
+    double best = start();
+    for (int i = 1; i < repetitions; ++i) {
+        best = std::min(best, start());
+    }
+    return best;
+}
+
+double timeStartup(const char* bin, const Options& options, bool cold, std::size_t& node_types, std::size_t& snippets)
+{
+    if (cold) {
+        boost::filesystem::remove(options.cache);
+    }
+
+    ExceptionHandler eh(false);
+    SettingsImplementation settings;
+    settings.set("path_to_bin", std::string(bin));
+    settings.set("require_boot_plugin", false);
+    settings.set("headless", true);
+    settings.set("plugin_cache", options.cache);
+
+    // the core loads the node plugins and snippets while it is constructed
+    auto start = std::chrono::steady_clock::now();
+    CsApexCore core(settings, eh);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    node_types = core.getNodeFactory()->getConstructors().size();
+    snippets = core.getSnippetFactory()->getSnippets().size();
+    return ms;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::size_t node_types = 0;
+    std::size_t snippets = 0;
+
+    double cold = fastest(options.repetitions, [&]() { return timeStartup(argv[0], options, true, node_types, snippets); });
+    double warm = fastest(options.repetitions, [&]() { return timeStartup(argv[0], options, false, node_types, snippets); });
+
+    std::cout << "{\n  \"node_types\": " << node_types << ",\n  \"snippets\": " << snippets << ",\n  \"cold_ms\": " << cold << ",\n  \"warm_ms\": " << warm
+              << ",\n  \"speedup\": " << cold / warm << "\n}" << std::endl;
+
+    boost::filesystem::remove(options.cache);
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef BENCHMARK_GRAPHS_H
+#define BENCHMARK_GRAPHS_H
+
+/// PROJECT
+#include <csapex/factory/factory_fwd.h>
+#include <csapex/model/model_fwd.h>
+
+/// SYSTEM
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief registerBenchmarkNodes makes the mockup nodes used by the benchmark graphs available in the given factory
+ */
+void registerBenchmarkNodes(NodeFactoryImplementation& factory);
+
+/**
+ * @brief getBenchmarkGraphNames lists the canonical synthetic graphs:
+ * linear_chain, fan_out, fan_in, diamond, nested_subgraph and iterated_container
+ */
+std::vector<std::string> getBenchmarkGraphNames();
+bool isBenchmarkGraph(const std::string& name);
+
+/**
+ * @brief makeBenchmarkGraph fills the graph with one of the canonical benchmark graphs
+ * @param size the chain length, fan width, branch length, nesting depth or vector size, depending on the graph
+ */
+void makeBenchmarkGraph(const std::string& name, GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size);
+
+}  // namespace csapex
+
+#endif  // BENCHMARK_GRAPHS_H
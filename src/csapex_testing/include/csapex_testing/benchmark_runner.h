@@ -0,0 +1,84 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/model/observer.h>
+#include <csapex/profiling/latency_histogram.h>
+#include <csapex/scheduling/scheduling_fwd.h>
+
+/// SYSTEM
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace csapex
+{
+class Interval;
+
+/**
+ * @brief The BenchmarkRunner class measures a running graph during a time window.
+ * Every node is profiled, per node the processing latency, the time its processing task waited from being scheduled until its execution started
+ * and the idle time between the end of one activation and the start of the next are recorded, together with the deadlines a rate limited node missed. Thread group utilization and the wake-up latency
+ * of idle workers are derived from the task steps of the thread pool's profiler.
+ */
+class BenchmarkRunner : public Observer
+{
+public:
+    BenchmarkRunner(GraphFacadeImplementation& root, ThreadPool& thread_pool, const std::string& name);
+    ~BenchmarkRunner();
+
+    void startWindow();
+    void stopWindow();
+
+    /**
+     * @brief hasProcessed checks whether every sink of the root graph has processed the given number of messages in this window
+     */
+    bool hasProcessed(std::size_t messages) const;
+
+    double getWindowSeconds() const;
+    std::size_t getNodeCount() const;
+
+    void writeJson(std::ostream& out) const;
+
+private:
+    struct NodeRecord
+    {
+        NodeRecord();
+
+        std::string uuid;
+        std::string type;
+        bool sink;
+
+        mutable std::mutex mutex;
+        LatencyHistogram latency;
+        LatencyHistogram idle;
+        LatencyHistogram wait;
+        long last_end;
+        long deadline_misses_at_start;
+        long deadline_misses;
+    };
+
+    void instrument(GraphFacadeImplementation& graph, bool is_root);
+    void record(NodeFacade* node, const std::shared_ptr<const Interval>& interval);
+    long countDeadlineMisses(NodeFacade* node) const;
+    LatencyHistogram getQueueWait(NodeFacade* node) const;
+
+private:
+    ThreadPool& thread_pool_;
+    std::string name_;
+
+    std::map<NodeFacade*, std::unique_ptr<NodeRecord>> records_;
+
+    std::atomic<bool> measuring_;
+    std::chrono::steady_clock::time_point window_start_;
+    std::chrono::steady_clock::time_point window_end_;
+};
+
+}  // namespace csapex
+
+#endif  // BENCHMARK_RUNNER_H
@@ -84,6 +84,26 @@ private:
     Output* output_;
 };
 
+/**
+ * @brief The MockupJoinNode class synchronizes two inputs and forwards the larger value
+ */
+class MockupJoinNode
+{
+public:
+    MockupJoinNode();
+
+    void setup(csapex::NodeModifier& node_modifier);
+
+    void setupParameters(Parameterizable& parameters);
+
+    void process(NodeModifier& node_modifier, Parameterizable& parameters);
+
+private:
+    Input* input_a_;
+    Input* input_b_;
+    Output* output_;
+};
+
 class MockupSource : public Node
 {
 public:
@@ -101,6 +121,26 @@ private:
     Output* out;
 };
 
+/**
+ * @brief The MockupVectorSource class publishes vectors of a configurable size
+ */
+class MockupVectorSource : public Node
+{
+public:
+    MockupVectorSource();
+
+    void setup(NodeModifier& node_modifier) override;
+
+    void setupParameters(Parameterizable& parameters) override;
+
+    void process() override;
+
+private:
+    Output* out;
+
+    int i;
+};
+
 class MockupSink : public Node
 {
 public:
@@ -0,0 +1,248 @@
+/// HEADER
+#include <csapex_testing/benchmark_graphs.h>
+
+/// PROJECT
+#include <csapex/factory/node_factory_impl.h>
+#include <csapex/factory/node_wrapper.hpp>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_state.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/generic_vector_message.hpp>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/utility/assert.h>
+#include <csapex_testing/mockup_nodes.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <stdexcept>
+
+using namespace csapex;
+
+namespace
+{
+template <typename T>
+NodePtr makeNode()
+{
+    return NodePtr(new T());
+}
+
+void registerType(NodeFactoryImplementation& factory, const std::string& type, std::function<NodePtr()> constructor)
+{
+    if (!factory.isValidType(type)) {
+        // the mockups share no state, so load_bench can measure loading them concurrently
+        NodeConstructorPtr node_constructor = std::make_shared<NodeConstructor>(type, constructor);
+        node_constructor->setConcurrentLoading(true);
+        factory.registerNodeType(node_constructor, true);
+    }
+}
+
+NodeFacadeImplementationPtr addNode(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, const std::string& type, const std::string& prefix)
+{
+    GraphImplementationPtr local = graph.getLocalGraph();
+    NodeFacadeImplementationPtr node = factory.makeNode(type, local->generateUUID(prefix), local);
+    apex_assert_hard(node);
+    // benchmarks measure the scheduling overhead, so nodes are never throttled
+    node->getNodeState()->setMaximumFrequency(0.0);
+    graph.addNode(node);
+    return node;
+}
+
+// parameters are also exposed as connectors, so connectors are looked up by their label
+UUID getInput(const NodeFacadeImplementationPtr& node, const std::string& label = "input")
+{
+    for (const InputPtr& input : node->getNodeHandle()->getExternalInputs()) {
+        if (input->getLabel() == label) {
+            return input->getUUID();
+        }
+    }
+    throw std::runtime_error(std::string("node ") + node->getUUID().getFullName() + " has no input " + label);
+}
+
+UUID getOutput(const NodeFacadeImplementationPtr& node, const std::string& label = "output")
+{
+    for (const OutputPtr& output : node->getNodeHandle()->getExternalOutputs()) {
+        if (output->getLabel() == label) {
+            return output->getUUID();
+        }
+    }
+    throw std::runtime_error(std::string("node ") + node->getUUID().getFullName() + " has no output " + label);
+}
+
+/**
+ * @brief The Segment struct describes the entry and exit connector of a part of a benchmark graph
+ */
+struct Segment
+{
+    UUID input;
+    UUID output;
+};
+
+Segment makeChain(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int length)
+{
+    apex_assert_hard(length > 0);
+
+    NodeFacadeImplementationPtr first = addNode(graph, factory, "MockupRelay", "relay");
+    NodeFacadeImplementationPtr last = first;
+    for (int i = 1; i < length; ++i) {
+        NodeFacadeImplementationPtr next = addNode(graph, factory, "MockupRelay", "relay");
+        graph.connect(getOutput(last), getInput(next));
+        last = next;
+    }
+    return Segment{ getInput(first), getOutput(last) };
+}
+
+Segment makeNested(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int depth)
+{
+    if (depth == 0) {
+        return makeChain(graph, factory, 1);
+    }
+
+    NodeFacadeImplementationPtr subgraph_facade = addNode(graph, factory, "csapex::Graph", "subgraph");
+    SubgraphNodePtr subgraph = std::dynamic_pointer_cast<SubgraphNode>(subgraph_facade->getNode());
+    apex_assert_hard(subgraph);
+    GraphFacadeImplementationPtr inner = graph.getLocalSubGraph(subgraph_facade->getUUID());
+
+    auto type = makeEmpty<connection_types::GenericValueMessage<int>>();
+    RelayMapping in = subgraph->addForwardingInput(type, "input", false);
+    RelayMapping out = subgraph->addForwardingOutput(type, "output");
+
+    Segment content = makeNested(*inner, factory, depth - 1);
+    inner->connect(in.internal, content.input);
+    inner->connect(content.output, out.internal);
+
+    return Segment{ in.external, out.external };
+}
+
+void makeLinearChain(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupSource", "source");
+    NodeFacadeImplementationPtr sink = addNode(graph, factory, "MockupSink", "sink");
+
+    Segment chain = makeChain(graph, factory, size);
+    graph.connect(getOutput(source), chain.input);
+    graph.connect(chain.output, getInput(sink));
+}
+
+void makeFanOut(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupSource", "source");
+    for (int i = 0; i < size; ++i) {
+        NodeFacadeImplementationPtr relay = addNode(graph, factory, "MockupRelay", "relay");
+        NodeFacadeImplementationPtr sink = addNode(graph, factory, "MockupSink", "sink");
+        graph.connect(getOutput(source), getInput(relay));
+        graph.connect(getOutput(relay), getInput(sink));
+    }
+}
+
+void makeFanIn(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    // the sources are joined pairwise, every join waits for a message on both inputs
+    UUID joined = getOutput(addNode(graph, factory, "MockupSource", "source"));
+    for (int i = 1; i < std::max(size, 2); ++i) {
+        NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupSource", "source");
+        NodeFacadeImplementationPtr join = addNode(graph, factory, "MockupJoin", "join");
+        graph.connect(joined, getInput(join, "input_a"));
+        graph.connect(getOutput(source), getInput(join, "input_b"));
+        joined = getOutput(join);
+    }
+
+    NodeFacadeImplementationPtr sink = addNode(graph, factory, "MockupSink", "sink");
+    graph.connect(joined, getInput(sink));
+}
+
+void makeDiamond(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupSource", "source");
+    NodeFacadeImplementationPtr join = addNode(graph, factory, "MockupJoin", "join");
+    NodeFacadeImplementationPtr sink = addNode(graph, factory, "MockupSink", "sink");
+
+    for (const char* branch : { "input_a", "input_b" }) {
+        Segment chain = makeChain(graph, factory, size);
+        graph.connect(getOutput(source), chain.input);
+        graph.connect(chain.output, getInput(join, branch));
+    }
+    graph.connect(getOutput(join), getInput(sink));
+}
+
+void makeNestedSubgraph(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupSource", "source");
+    NodeFacadeImplementationPtr sink = addNode(graph, factory, "MockupSink", "sink");
+
+    Segment nested = makeNested(graph, factory, size);
+    graph.connect(getOutput(source), nested.input);
+    graph.connect(nested.output, getInput(sink));
+}
+
+void makeIteratedContainer(GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    NodeFacadeImplementationPtr source = addNode(graph, factory, "MockupVectorSource", "source");
+    source->getNode()->getParameter("size")->set<int>(size);
+    NodeFacadeImplementationPtr sink = addNode(graph, factory, "AnySink", "sink");
+
+    NodeFacadeImplementationPtr subgraph_facade = addNode(graph, factory, "csapex::Graph", "iteration");
+    SubgraphNodePtr subgraph = std::dynamic_pointer_cast<SubgraphNode>(subgraph_facade->getNode());
+    apex_assert_hard(subgraph);
+    GraphFacadeImplementationPtr inner = graph.getLocalSubGraph(subgraph_facade->getUUID());
+
+    auto type = connection_types::GenericVectorMessage::make<int>();
+    RelayMapping in = subgraph->addForwardingInput(type, "input", false);
+    RelayMapping out = subgraph->addForwardingOutput(type, "output");
+    subgraph->setIterationEnabled(in.external, true);
+
+    Segment chain = makeChain(*inner, factory, 1);
+    inner->connect(in.internal, chain.input);
+    inner->connect(chain.output, out.internal);
+
+    graph.connect(getOutput(source), in.external);
+    graph.connect(out.external, getInput(sink));
+}
+
+}  // namespace
+
+void csapex::registerBenchmarkNodes(NodeFactoryImplementation& factory)
+{
+    registerType(factory, "MockupSource", &makeNode<MockupSource>);
+    registerType(factory, "MockupVectorSource", &makeNode<MockupVectorSource>);
+    registerType(factory, "MockupSink", &makeNode<MockupSink>);
+    registerType(factory, "AnySink", &makeNode<AnySink>);
+    registerType(factory, "MockupRelay", &makeNode<NodeWrapper<MockupStaticMultiplierNode<1>>>);
+    registerType(factory, "MockupJoin", &makeNode<NodeWrapper<MockupJoinNode>>);
+}
+
+std::vector<std::string> csapex::getBenchmarkGraphNames()
+{
+    return { "linear_chain", "fan_out", "fan_in", "diamond", "nested_subgraph", "iterated_container" };
+}
+
+bool csapex::isBenchmarkGraph(const std::string& name)
+{
+    std::vector<std::string> names = getBenchmarkGraphNames();
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+void csapex::makeBenchmarkGraph(const std::string& name, GraphFacadeImplementation& graph, NodeFactoryImplementation& factory, int size)
+{
+    apex_assert_hard(size > 0);
+
+    if (name == "linear_chain") {
+        makeLinearChain(graph, factory, size);
+    } else if (name == "fan_out") {
+        makeFanOut(graph, factory, size);
+    } else if (name == "fan_in") {
+        makeFanIn(graph, factory, size);
+    } else if (name == "diamond") {
+        makeDiamond(graph, factory, size);
+    } else if (name == "nested_subgraph") {
+        makeNestedSubgraph(graph, factory, size);
+    } else if (name == "iterated_container") {
+        makeIteratedContainer(graph, factory, size);
+    } else {
+        throw std::invalid_argument(std::string("unknown benchmark graph ") + name);
+    }
+}
@@ -0,0 +1,289 @@
+/// HEADER
+#include <csapex_testing/benchmark_runner.h>
+
+/// PROJECT
+#include <csapex/model/connection_description.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/profiling/interval.h>
+#include <csapex/profiling/profiler.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+using namespace csapex;
+
+namespace
+{
+std::string quote(const std::string& str)
+{
+    std::stringstream ss;
+    ss << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                ss << "\\\"";
+                break;
+            case '\\':
+                ss << "\\\\";
+                break;
+            case '\n':
+                ss << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                } else {
+                    ss << c;
+                }
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+void writeDistribution(std::ostream& out, const LatencyHistogram& hist)
+{
+    out << "{\"count\": " << hist.count() << ", \"mean\": " << hist.mean() << ", \"p50\": " << hist.percentile(50.0) << ", \"p99\": " << hist.percentile(99.0)
+        << ", \"p999\": " << hist.percentile(99.9) << ", \"max\": " << hist.max() << "}";
+}
+
+long readProcStatusKb(const std::string& key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size() + 1, key + ":") == 0) {
+            std::stringstream ss(line.substr(key.size() + 1));
+            long value = -1;
+            ss >> value;
+            return value;
+        }
+    }
+    return -1;
+}
+}  // namespace
+
+BenchmarkRunner::NodeRecord::NodeRecord() : sink(false), last_end(-1), deadline_misses_at_start(0), deadline_misses(0)
+{
+}
+
+BenchmarkRunner::BenchmarkRunner(GraphFacadeImplementation& root, ThreadPool& thread_pool, const std::string& name)
+  : thread_pool_(thread_pool), name_(name), measuring_(false), window_start_(std::chrono::steady_clock::now()), window_end_(window_start_)
+{
+    instrument(root, true);
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+    stopObserving();
+}
+
+void BenchmarkRunner::instrument(GraphFacadeImplementation& graph, bool is_root)
+{
+    std::set<UUID> has_inputs;
+    std::set<UUID> has_outputs;
+    for (const ConnectionDescription& connection : graph.enumerateAllConnections()) {
+        has_outputs.insert(connection.from.parentUUID());
+        has_inputs.insert(connection.to.parentUUID());
+    }
+
+    for (const NodeFacadeImplementationPtr& node : graph.getLocalGraph()->getAllLocalNodeFacades()) {
+        std::unique_ptr<NodeRecord> node_record(new NodeRecord);
+        node_record->uuid = node->getAUUID().getFullName();
+        node_record->type = node->getType();
+        node_record->sink = is_root && has_inputs.count(node->getUUID()) > 0 && has_outputs.count(node->getUUID()) == 0;
+        records_[node.get()] = std::move(node_record);
+
+        node->setProfiling(true);
+        observe(node->interval_end, [this](NodeFacade* facade, std::shared_ptr<const Interval> interval) { record(facade, interval); });
+
+        if (node->isGraph()) {
+            instrument(*graph.getLocalSubGraph(node->getUUID()), false);
+        }
+    }
+}
+
+void BenchmarkRunner::record(NodeFacade* node, const std::shared_ptr<const Interval>& interval)
+{
+    auto pos = records_.find(node);
+    if (pos == records_.end()) {
+        return;
+    }
+
+    NodeRecord& record = *pos->second;
+    long start = interval->getStartMicro();
+    long end = interval->getEndMicro();
+
+    std::unique_lock<std::mutex> lock(record.mutex);
+    if (measuring_) {
+        record.latency.record(std::max(0l, end - start));
+        if (record.last_end >= 0 && start >= record.last_end) {
+            record.idle.record(start - record.last_end);
+        }
+    }
+    record.last_end = end;
+}
+
+long BenchmarkRunner::countDeadlineMisses(NodeFacade* node) const
+{
+    ProfilerPtr profiler = node->getProfiler();
+    return profiler ? profiler->getProfile(node->getUUID().getFullName()).getCounter(NodeRunner::DEADLINE_MISSES) : 0;
+}
+
+LatencyHistogram BenchmarkRunner::getQueueWait(NodeFacade* node) const
+{
+    ProfilerPtr profiler = node->getProfiler();
+    if (!profiler) {
+        return LatencyHistogram();
+    }
+
+    const Profile& profile = profiler->getProfile(node->getUUID().getFullName());
+    std::vector<std::string> steps = profile.getStepNames();
+    if (std::find(steps.begin(), steps.end(), NodeRunner::QUEUE_WAIT) == steps.end()) {
+        return LatencyHistogram();
+    }
+    return profile.getHistogram(NodeRunner::QUEUE_WAIT);
+}
+
+void BenchmarkRunner::startWindow()
+{
+    for (auto& pair : records_) {
+        NodeRecord& record = *pair.second;
+        std::unique_lock<std::mutex> lock(record.mutex);
+        record.latency.reset();
+        record.idle.reset();
+        record.wait.reset();
+        record.deadline_misses_at_start = countDeadlineMisses(pair.first);
+        record.deadline_misses = 0;
+
+        // the queue wait is recorded by the node runner in the profile of the node
+        if (ProfilerPtr profiler = pair.first->getProfiler()) {
+            profiler->resetWindow();
+        }
+    }
+
+    ProfilerPtr profiler = thread_pool_.getProfiler();
+    profiler->setEnabled(true);
+    profiler->resetWindow();
+
+    window_start_ = std::chrono::steady_clock::now();
+    measuring_ = true;
+}
+
+void BenchmarkRunner::stopWindow()
+{
+    measuring_ = false;
+    window_end_ = std::chrono::steady_clock::now();
+
+    // the nodes might be gone by the time the report is written
+    for (auto& pair : records_) {
+        NodeRecord& record = *pair.second;
+        std::unique_lock<std::mutex> lock(record.mutex);
+        record.deadline_misses = countDeadlineMisses(pair.first) - record.deadline_misses_at_start;
+        record.wait = getQueueWait(pair.first);
+    }
+}
+
+bool BenchmarkRunner::hasProcessed(std::size_t messages) const
+{
+    bool any_sink = false;
+    for (const auto& pair : records_) {
+        const NodeRecord& record = *pair.second;
+        if (record.sink) {
+            any_sink = true;
+            std::unique_lock<std::mutex> lock(record.mutex);
+            if (record.latency.count() < messages) {
+                return false;
+            }
+        }
+    }
+    return any_sink;
+}
+
+double BenchmarkRunner::getWindowSeconds() const
+{
+    auto end = measuring_ ? std::chrono::steady_clock::now() : window_end_;
+    return std::chrono::duration<double>(end - window_start_).count();
+}
+
+std::size_t BenchmarkRunner::getNodeCount() const
+{
+    return records_.size();
+}
+
+void BenchmarkRunner::writeJson(std::ostream& out) const
+{
+    double seconds = getWindowSeconds();
+
+    out << "{\n";
+    out << "  \"graph\": " << quote(name_) << ",\n";
+    out << "  \"duration_s\": " << seconds << ",\n";
+    out << "  \"time_unit\": \"us\",\n";
+    out << "  \"priority_policy\": " << quote(task_priority::name(thread_pool_.getPriorityPolicy())) << ",\n";
+
+    out << "  \"nodes\": [";
+    bool first = true;
+    for (const auto& pair : records_) {
+        const NodeRecord& record = *pair.second;
+        std::unique_lock<std::mutex> lock(record.mutex);
+
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"uuid\": " << quote(record.uuid) << ", \"type\": " << quote(record.type) << ", \"sink\": " << (record.sink ? "true" : "false");
+        out << ", \"throughput_hz\": " << (seconds > 0.0 ? record.latency.count() / seconds : 0.0);
+        out << ", \"latency\": ";
+        writeDistribution(out, record.latency);
+        out << ", \"wait\": ";
+        writeDistribution(out, record.wait);
+        out << ", \"idle\": ";
+        writeDistribution(out, record.idle);
+        out << ", \"deadline_misses\": " << record.deadline_misses;
+        out << "}";
+    }
+    out << "\n  ],\n";
+
+    out << "  \"thread_groups\": [";
+    ProfilerPtr profiler = thread_pool_.getProfiler();
+    first = true;
+    for (const ThreadGroupPtr& group : thread_pool_.getGroups()) {
+        // the busy time is the sum of all task steps the workers of the group recorded during the window
+        double busy_us = 0.0;
+        LatencyHistogram wake_up;
+        for (const std::string& timer : group->getTimerNames()) {
+            const Profile& profile = profiler->getProfile(timer);
+            for (const std::string& step : profile.getStepNames()) {
+                const LatencyHistogram& hist = profile.getHistogram(step);
+                if (step == ThreadGroup::WAKE_UP_STEP) {
+                    wake_up.merge(hist);
+                } else {
+                    busy_us += hist.mean() * hist.count();
+                }
+            }
+        }
+
+        std::size_t workers = group->getWorkerCount();
+        double capacity_us = seconds * 1e6 * workers;
+
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"name\": " << quote(group->getName()) << ", \"id\": " << group->id() << ", \"workers\": " << workers << ", \"tasks\": " << group->size()
+            << ", \"deadline_scheduling\": " << (group->isDeadlineSchedulingEnabled() ? "true" : "false") << ", \"idle_strategy\": " << quote(idle_strategy::name(group->getIdleStrategy()))
+            << ", \"spin_budget_us\": " << group->getSpinBudget().count() << ", \"realtime_priority\": " << group->getRealtimePriority() << ", \"busy_s\": " << busy_us * 1e-6
+            << ", \"utilization\": " << (capacity_us > 0.0 ? busy_us / capacity_us : 0.0) << ", \"wake_up_latency\": ";
+        writeDistribution(out, wake_up);
+        out << "}";
+    }
+    out << "\n  ],\n";
+
+    out << "  \"memory\": {\"rss_kb\": " << readProcStatusKb("VmRSS") << ", \"peak_rss_kb\": " << readProcStatusKb("VmHWM") << "}\n";
+    out << "}\n";
+}
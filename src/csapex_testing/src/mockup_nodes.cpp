@@ -7,6 +7,10 @@
 #include <csapex/model/token.h>
 #include <csapex/param/parameter_factory.h>
 #include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/generic_vector_message.hpp>
+
+/// SYSTEM
+#include <algorithm>
 
 using namespace csapex;
 
@@ -32,6 +36,28 @@ void MockupDynamicMultiplierNode::process(NodeModifier& node_modifier, Parameter
     msg::publish(output_, a * b);
 }
 
+MockupJoinNode::MockupJoinNode()
+{
+}
+
+void MockupJoinNode::setup(csapex::NodeModifier& node_modifier)
+{
+    input_a_ = node_modifier.addInput<int>("input_a");
+    input_b_ = node_modifier.addInput<int>("input_b");
+    output_ = node_modifier.addOutput<int>("output");
+}
+
+void MockupJoinNode::setupParameters(Parameterizable& /*parameters*/)
+{
+}
+
+void MockupJoinNode::process(NodeModifier& node_modifier, Parameterizable& /*parameters*/)
+{
+    int a = msg::getValue<int>(input_a_);
+    int b = msg::getValue<int>(input_b_);
+    msg::publish(output_, std::max(a, b));
+}
+
 MockupSource::MockupSource()
 {
 }
@@ -59,6 +85,27 @@ int MockupSource::getValue() const
     return readParameter<int>("value");
 }
 
+MockupVectorSource::MockupVectorSource() : i(0)
+{
+}
+
+void MockupVectorSource::setup(NodeModifier& node_modifier)
+{
+    out = node_modifier.addOutput<connection_types::GenericVectorMessage, int>("output");
+}
+
+void MockupVectorSource::setupParameters(Parameterizable& parameters)
+{
+    parameters.addParameter(param::ParameterFactory::declareRange<int>("size", 0, 1024, 8, 1));
+}
+
+void MockupVectorSource::process()
+{
+    auto vector = std::make_shared<std::vector<int>>(readParameter<int>("size"), i);
+    msg::publish<connection_types::GenericVectorMessage, int>(out, vector);
+    ++i;
+}
+
 MockupSink::MockupSink() : aborted(false), value(-1)
 {
 }
@@ -0,0 +1,83 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+/// SYSTEM
+#include <atomic>
+#include <utility>
+
+namespace csapex
+{
+/**
+ * @brief The MPSCQueue class is an unbounded lock-free FIFO queue for many producers and one consumer.
+ * Pushing is wait-free, popping must only ever happen from one thread at a time.
+ * An element that is currently being pushed might not be visible to pop() yet.
+ */
+template <typename T>
+class MPSCQueue
+{
+private:
+    struct Node
+    {
+        Node() : next(nullptr)
+        {
+        }
+        explicit Node(T&& v) : next(nullptr), value(std::move(v))
+        {
+        }
+
+        std::atomic<Node*> next;
+        T value;
+    };
+
+public:
+    MPSCQueue() : head_(new Node), tail_(head_.load())
+    {
+    }
+
+    ~MPSCQueue()
+    {
+        T value;
+        while (pop(value)) {
+        }
+        delete tail_;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void push(T value)
+    {
+        Node* node = new Node(std::move(value));
+        Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T& value)
+    {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+
+        // the popped node becomes the new sentinel, its value is moved out
+        value = std::move(next->value);
+        next->value = T();
+        tail_ = next;
+        delete tail;
+        return true;
+    }
+
+    bool empty() const
+    {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    std::atomic<Node*> head_;
+    Node* tail_;
+};
+
+}  // namespace csapex
+
+#endif  // MPSC_QUEUE_HPP
@@ -0,0 +1,23 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+/// PROJECT
+#include <csapex_util_export.h>
+
+/// SYSTEM
+#include <cstddef>
+#include <functional>
+
+namespace csapex
+{
+/**
+ * @brief parallelFor calls fn once for every index in [0, count) on up to threads threads, the calling thread takes part.
+ * Indices are handed out in ascending order. If fn throws, the remaining indices are skipped and the first exception
+ * is rethrown after all threads have finished.
+ * @param threads the number of threads to use, 0 uses one per hardware thread
+ */
+CSAPEX_UTILS_EXPORT void parallelFor(std::size_t count, std::size_t threads, const std::function<void(std::size_t)>& fn);
+
+}  // namespace csapex
+
+#endif  // PARALLEL_FOR_H
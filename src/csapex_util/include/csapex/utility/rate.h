@@ -25,18 +25,23 @@ public:
     bool isImmediate() const;
     void setImmediate(bool immediate);
 
+    /**
+     * @brief getPeriod returns the time between two cycles at the target frequency
+     */
+    std::chrono::steady_clock::duration getPeriod() const;
+
     void keepUp();
 
     void startCycle();
-    std::chrono::system_clock::time_point endOfCycle() const;
+    std::chrono::steady_clock::time_point endOfCycle() const;
 
 public:
     double frequency_;
     bool immediate_;
 
-    std::chrono::system_clock::time_point last_scheduled_tick_;
-    std::chrono::system_clock::time_point last_tick_;
-    std::deque<std::chrono::system_clock::time_point> real_ticks_;
+    std::chrono::steady_clock::time_point last_scheduled_tick_;
+    std::chrono::steady_clock::time_point last_tick_;
+    std::deque<std::chrono::steady_clock::time_point> real_ticks_;
 };
 
 }  // namespace csapex
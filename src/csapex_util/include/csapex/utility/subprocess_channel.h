@@ -4,6 +4,7 @@
 /// SYSTEM
 #include <mutex>
 #include <memory>
+#include <string>
 #include <boost/interprocess/interprocess_fwd.hpp>
 
 /// FORWARD DECLARATIONS
@@ -70,22 +71,57 @@ public:
         SubprocessChannel* parent = nullptr;
     };
 
+    /**
+     * @brief Payload grants exclusive write access to the payload region, so a message can be serialized in place
+     */
+    struct Payload
+    {
+        uint8_t* data = nullptr;
+        std::size_t capacity = 0;
+
+    private:
+        friend class SubprocessChannel;
+        std::unique_lock<std::recursive_mutex> lock;
+    };
+
 public:
     SubprocessChannel(const std::string& name_space, bool is_control_channel = false, int32_t size = -1);
 
     ~SubprocessChannel();
 
+    /**
+     * @brief read waits for the next message
+     * @return a message whose data points directly into the shared payload region, valid until the message is destroyed
+     */
     Message read();
+
+    /**
+     * @brief write copies the message into the shared payload region, which grows if the message does not fit
+     * Messages that were serialized into an acquired payload are not copied.
+     */
     void write(const Message& message);
+
+    /**
+     * @brief acquirePayload waits until the last message has been read and locks the channel for this thread
+     * @return the current payload region, which stays valid until the payload is destroyed
+     */
+    Payload acquirePayload();
+
     bool hasMessage() const;
 
+    std::size_t getPayloadCapacity() const;
+
     void shutdown();
 
 private:
     void allocate();
+    void allocatePayload(std::size_t capacity);
+    void mapPayload();
 
 private:
     std::shared_ptr<boost::interprocess::managed_shared_memory> shm_segment;
+    std::shared_ptr<boost::interprocess::mapped_region> payload_region_;
+    std::string payload_name_;
 
     mutable std::recursive_mutex channel_mutex_;
 
@@ -9,6 +9,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace csapex
 {
@@ -24,6 +25,9 @@ class AUUID;
  *  - ID[0]    - the unique id of this instance
  *  - ID[1]    - the unique id of the parent id
  *  - ...
+ *
+ * Each identifier is interned in a process wide name table, so copying, comparing and hashing
+ * UUIDs only touches integers. Names are reference counted by the UUIDs using them.
  */
 class CSAPEX_UTILS_EXPORT UUID
 {
@@ -36,6 +40,20 @@ public:
 
     static UUID NONE;
 
+    /// interned identifier of one level of a UUID
+    typedef uint32_t Symbol;
+
+    /**
+     * @brief intern returns the symbol of name without referencing it
+     * The symbol stays valid while a UUID refers to it, names that no UUID ever used are kept.
+     * @throws std::overflow_error once every symbol is in use
+     */
+    static Symbol intern(const std::string& name);
+    static const std::string& nameOf(Symbol symbol);
+
+    /// the number of names currently in the name table
+    static std::size_t countNames();
+
 public:
     friend bool CSAPEX_UTILS_EXPORT operator==(const std::string& str, const UUID& uuid_);
     friend bool CSAPEX_UTILS_EXPORT operator==(const UUID& uuid_, const std::string& str);
@@ -84,6 +102,12 @@ public:
     bool empty() const;
     std::size_t depth() const;
 
+    /**
+     * @brief symbol returns the interned identifier of one level
+     * @param level 0 for the id itself, depth() - 1 for the root
+     */
+    Symbol symbol(std::size_t level) const;
+
     bool global() const;
     std::string globalName() const;
 
@@ -94,12 +118,39 @@ public:
 
 private:
     explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation);
-    explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<std::string>& representation);
+    explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<Symbol>& representation);
     explicit UUID(std::weak_ptr<UUIDProvider> parent, const UUID& representation);
 
+protected:
+    /**
+     * @brief Level is one interned identifier that keeps its name in the table alive
+     */
+    class CSAPEX_UTILS_EXPORT Level
+    {
+    public:
+        explicit Level(const std::string& name);
+        /// symbol has to be referenced already, e.g. by another UUID
+        Level(Symbol symbol);
+        Level(const Level& other);
+        Level(Level&& other) noexcept;
+        ~Level();
+
+        Level& operator=(const Level& other);
+        Level& operator=(Level&& other) noexcept;
+
+        operator Symbol() const
+        {
+            return symbol_;
+        }
+
+    private:
+        Symbol symbol_;
+        bool owned_ = true;
+    };
+
 protected:
     std::weak_ptr<UUIDProvider> parent_;
-    std::vector<std::string> representation_;
+    std::vector<Level> representation_;
 };
 
 /**
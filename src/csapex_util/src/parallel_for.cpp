@@ -0,0 +1,71 @@
+/// HEADER
+#include <csapex/utility/parallel_for.h>
+
+/// PROJECT
+#include <csapex/utility/thread.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace csapex;
+
+void csapex::parallelFor(std::size_t count, std::size_t threads, const std::function<void(std::size_t)>& fn)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, count);
+
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&]() {
+        while (!failed) {
+            std::size_t i = next++;
+            if (i >= count) {
+                break;
+            }
+            try {
+                fn(i);
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back([&work]() {
+            csapex::thread::set_name("parallel_for");
+            work();
+        });
+    }
+    work();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
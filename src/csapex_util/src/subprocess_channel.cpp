@@ -5,10 +5,14 @@
 #include <csapex/utility/assert.h>
 
 /// SYSTEM
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <boost/optional.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 
@@ -19,10 +23,11 @@ namespace csapex
 {
 namespace impl
 {
-template <typename T>
-using ShmAllocator = boost::interprocess::allocator<T, boost::interprocess::managed_shared_memory::segment_manager>;
+// the control segment only holds the ShmBlock, message data lives in a separate payload region
+static const std::size_t CONTROL_SEGMENT_SIZE = 4096;
+static const std::size_t MAX_PAYLOAD_NAME_LENGTH = 256;
 
-using shared_buffer = typename boost::interprocess::basic_string<uint8_t, std::char_traits<uint8_t>, ShmAllocator<uint8_t>>;
+static std::atomic<int> g_payload_counter(0);
 
 struct ShmBlock
 {
@@ -32,6 +37,10 @@ struct ShmBlock
 
     SubprocessChannel::MessageType message_type = SubprocessChannel::MessageType::NONE;
 
+    char payload_name[MAX_PAYLOAD_NAME_LENGTH] = { 0 };
+    std::size_t payload_capacity = 0;
+    std::size_t payload_length = 0;
+
     bool is_full = false;
     bool active = true;
 };
@@ -74,7 +83,6 @@ SubprocessChannel::Message::~Message()
     if (parent) {
         scoped_lock<interprocess_mutex> lock(parent->shm_block_->m);
 
-        parent->shm_segment->destroy<impl::shared_buffer>("data");
         parent->shm_block_->is_full = false;
         parent->is_locked_ = false;
         parent->shm_block_->message_read.notify_all();
@@ -106,6 +114,7 @@ SubprocessChannel::SubprocessChannel(const std::string& name_space, bool is_cont
 
 SubprocessChannel::~SubprocessChannel()
 {
+    shared_memory_object::remove(shm_block_->payload_name);
     shared_memory_object::remove(name_space_.c_str());
 }
 
@@ -113,17 +122,59 @@ void SubprocessChannel::allocate()
 {
     try {
         //        std::cout << "try to create shared memory object " << getUUID() << std::endl;
-        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), size_));
+        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), impl::CONTROL_SEGMENT_SIZE));
 
     } catch (const boost::interprocess::interprocess_exception& e) {
         //        std::cout << "could not create shared memory object: " << e.what() << std::endl;
         //        std::cout << "removing shared memory object " << getUUID() << std::endl;
         shared_memory_object::remove(name_space_.c_str());
-        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), size_));
+        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), impl::CONTROL_SEGMENT_SIZE));
     }
 
     // Create a managed shared memory segment
     shm_block_ = shm_segment->construct<impl::ShmBlock>("shm")();
+
+    // the initial payload region is mapped before forking, so both processes share it without opening it by name
+    allocatePayload(size_ > 0 ? size_ : 1024);
+}
+
+void SubprocessChannel::allocatePayload(std::size_t capacity)
+{
+    std::string name = name_space_ + "_payload_" + std::to_string(getpid()) + "_" + std::to_string(impl::g_payload_counter++);
+    apex_assert_hard(name.size() < impl::MAX_PAYLOAD_NAME_LENGTH);
+
+    shared_memory_object::remove(name.c_str());
+    shared_memory_object payload(create_only, name.c_str(), read_write);
+    payload.truncate(capacity);
+    payload_region_.reset(new mapped_region(payload, read_write));
+
+    // the reader has already consumed the old region, unlinking it only frees it once both sides unmapped it
+    if (shm_block_->payload_name[0] != 0) {
+        shared_memory_object::remove(shm_block_->payload_name);
+    }
+
+    std::strncpy(shm_block_->payload_name, name.c_str(), impl::MAX_PAYLOAD_NAME_LENGTH);
+    shm_block_->payload_capacity = capacity;
+    payload_name_ = name;
+}
+
+void SubprocessChannel::mapPayload()
+{
+    if (payload_name_ != shm_block_->payload_name) {
+        // the other process has grown the payload region
+        shared_memory_object payload(open_only, shm_block_->payload_name, read_write);
+        payload_region_.reset(new mapped_region(payload, read_write));
+        payload_name_ = shm_block_->payload_name;
+    }
+}
+
+std::size_t SubprocessChannel::getPayloadCapacity() const
+{
+    std::unique_lock<std::recursive_mutex> channel_lock(channel_mutex_);
+
+    scoped_lock<interprocess_mutex> lock(shm_block_->m);
+
+    return shm_block_->payload_capacity;
 }
 
 bool SubprocessChannel::hasMessage() const
@@ -167,16 +218,14 @@ SubprocessChannel::Message SubprocessChannel::read()
         }
     }
 
-    std::pair<impl::shared_buffer*, managed_shared_memory::size_type> input = shm_segment->find<impl::shared_buffer>("data");
+    mapPayload();
 
     Message result(this);
     is_locked_ = true;
 
-    if (input.first) {
-        result.type = shm_block_->message_type;
-        result.data = input.first->c_str();
-        result.length = input.first->size();
-    }
+    result.type = shm_block_->message_type;
+    result.data = static_cast<const uint8_t*>(payload_region_->get_address());
+    result.length = shm_block_->payload_length;
 
     return result;
 }
@@ -185,8 +234,6 @@ void SubprocessChannel::write(const Message& message)
 {
     std::unique_lock<std::recursive_mutex> channel_lock(channel_mutex_);
 
-    const impl::ShmAllocator<int> alloc_inst(shm_segment->get_segment_manager());
-
     scoped_lock<interprocess_mutex> lock(shm_block_->m);
 
     if (is_shutdown_) {
@@ -203,7 +250,15 @@ void SubprocessChannel::write(const Message& message)
 
     apex_assert_hard(!is_locked_);
 
-    shm_segment->construct<impl::shared_buffer>("data")(message.data, message.length, alloc_inst);
+    mapPayload();
+    if (message.length > shm_block_->payload_capacity) {
+        allocatePayload(std::max(message.length, 2 * shm_block_->payload_capacity));
+    }
+
+    if (message.length > 0 && message.data != payload_region_->get_address()) {
+        std::memcpy(payload_region_->get_address(), message.data, message.length);
+    }
+    shm_block_->payload_length = message.length;
 
     shm_block_->message_type = message.type;
     shm_block_->is_full = true;
@@ -211,6 +266,29 @@ void SubprocessChannel::write(const Message& message)
     shm_block_->message_available.notify_all();
 }
 
+SubprocessChannel::Payload SubprocessChannel::acquirePayload()
+{
+    Payload payload;
+    payload.lock = std::unique_lock<std::recursive_mutex>(channel_mutex_);
+
+    scoped_lock<interprocess_mutex> lock(shm_block_->m);
+
+    while (shm_block_->is_full && !is_shutdown_) {
+        shm_block_->message_read.wait(lock);
+    }
+
+    if (is_shutdown_) {
+        return payload;
+    }
+
+    // the reader is done with the region and only this side writes to it while the channel is locked
+    mapPayload();
+    payload.data = static_cast<uint8_t*>(payload_region_->get_address());
+    payload.capacity = shm_block_->payload_capacity;
+
+    return payload;
+}
+
 void SubprocessChannel::shutdown()
 {
     is_shutdown_ = true;
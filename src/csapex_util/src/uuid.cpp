@@ -12,13 +12,233 @@
 #include <ostream>
 #include <sstream>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
 
 using namespace csapex;
 
+namespace
+{
+/**
+ * The NameTable maps every UUID level to a compact symbol.
+ * Every UUID level holds a reference to its name, a name is removed and its symbol is reused once the last reference is gone.
+ * Looking up a referenced symbol does not need to lock:
+ * entries are written before their symbol is handed out and stored in chunks that never move.
+ * Chunks are reached through lazily allocated directories, so the table grows up to the whole symbol range.
+ */
+class NameTable
+{
+public:
+    static const std::size_t CHUNK_BITS = 10;
+    static const std::size_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const std::size_t DIRECTORY_BITS = 10;
+    static const std::size_t DIRECTORY_SIZE = 1 << DIRECTORY_BITS;
+    static const std::size_t MAX_DIRECTORIES = (std::size_t(1) << (32 - CHUNK_BITS - DIRECTORY_BITS));
+
+    struct Entry
+    {
+        std::string name;
+        std::atomic<uint32_t> references{ 0 };
+        bool live = false;
+    };
+
+    typedef std::array<std::atomic<Entry*>, DIRECTORY_SIZE> Directory;
+
+    static NameTable& instance()
+    {
+        // intentionally leaked, UUIDs might still be printed during static destruction
+        static NameTable* table = new NameTable;
+        return *table;
+    }
+
+    UUID::Symbol intern(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return find(name);
+    }
+
+    UUID::Symbol acquire(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        UUID::Symbol symbol = find(name);
+        entry(symbol).references.fetch_add(1, std::memory_order_relaxed);
+        return symbol;
+    }
+
+    /// the caller already holds a reference, so the entry cannot be removed concurrently
+    void acquire(UUID::Symbol symbol)
+    {
+        entry(symbol).references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release(UUID::Symbol symbol)
+    {
+        Entry& e = entry(symbol);
+        if (e.references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        // the name might have been acquired again or already been removed by another release
+        if (e.live && e.references.load(std::memory_order_acquire) == 0) {
+            symbols_.erase(e.name);
+            e.name.clear();
+            e.live = false;
+            free_symbols_.push_back(symbol);
+        }
+    }
+
+    const std::string& lookup(UUID::Symbol symbol) const
+    {
+        return entry(symbol).name;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return symbols_.size();
+    }
+
+private:
+    NameTable() : next_symbol_(0)
+    {
+        for (auto& directory : directories_) {
+            directory.store(nullptr);
+        }
+    }
+
+    Entry& entry(UUID::Symbol symbol) const
+    {
+        const Directory* directory = directories_[symbol >> (CHUNK_BITS + DIRECTORY_BITS)].load(std::memory_order_acquire);
+        Entry* chunk = (*directory)[(symbol >> CHUNK_BITS) & (DIRECTORY_SIZE - 1)].load(std::memory_order_acquire);
+        return chunk[symbol & (CHUNK_SIZE - 1)];
+    }
+
+    /// requires mutex_ to be locked
+    UUID::Symbol find(const std::string& name)
+    {
+        auto pos = symbols_.find(name);
+        if (pos != symbols_.end()) {
+            return pos->second;
+        }
+
+        UUID::Symbol symbol;
+        if (!free_symbols_.empty()) {
+            symbol = free_symbols_.back();
+            free_symbols_.pop_back();
+
+        } else {
+            if (next_symbol_ > std::numeric_limits<UUID::Symbol>::max()) {
+                throw std::overflow_error("too many distinct UUID names");
+            }
+            symbol = static_cast<UUID::Symbol>(next_symbol_++);
+            allocateEntry(symbol);
+        }
+
+        Entry& e = entry(symbol);
+        e.name = name;
+        e.live = true;
+
+        symbols_.emplace(name, symbol);
+        return symbol;
+    }
+
+    void allocateEntry(UUID::Symbol symbol)
+    {
+        Directory* directory = directories_[symbol >> (CHUNK_BITS + DIRECTORY_BITS)].load(std::memory_order_relaxed);
+        if (!directory) {
+            directory = new Directory;
+            for (auto& chunk : *directory) {
+                chunk.store(nullptr, std::memory_order_relaxed);
+            }
+            directories_[symbol >> (CHUNK_BITS + DIRECTORY_BITS)].store(directory, std::memory_order_release);
+        }
+
+        std::atomic<Entry*>& slot = (*directory)[(symbol >> CHUNK_BITS) & (DIRECTORY_SIZE - 1)];
+        if (!slot.load(std::memory_order_relaxed)) {
+            slot.store(new Entry[CHUNK_SIZE], std::memory_order_release);
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, UUID::Symbol> symbols_;
+    std::vector<UUID::Symbol> free_symbols_;
+    uint64_t next_symbol_;
+    std::array<std::atomic<Directory*>, MAX_DIRECTORIES> directories_;
+};
+
+bool lessByName(UUID::Symbol a, UUID::Symbol b)
+{
+    return a != b && NameTable::instance().lookup(a) < NameTable::instance().lookup(b);
+}
+
+}  // namespace
+
 const std::string UUID::namespace_separator = ":|:";
 UUID UUID::NONE;
 AUUID AUUID::NONE;
 
+UUID::Symbol UUID::intern(const std::string& name)
+{
+    return NameTable::instance().intern(name);
+}
+
+const std::string& UUID::nameOf(Symbol symbol)
+{
+    return NameTable::instance().lookup(symbol);
+}
+
+std::size_t UUID::countNames()
+{
+    return NameTable::instance().size();
+}
+
+// Level
+
+UUID::Level::Level(const std::string& name) : symbol_(NameTable::instance().acquire(name))
+{
+}
+
+UUID::Level::Level(Symbol symbol) : symbol_(symbol)
+{
+    NameTable::instance().acquire(symbol_);
+}
+
+UUID::Level::Level(const Level& other) : Level(other.symbol_)
+{
+}
+
+UUID::Level::Level(Level&& other) noexcept : symbol_(other.symbol_), owned_(other.owned_)
+{
+    other.owned_ = false;
+}
+
+UUID::Level& UUID::Level::operator=(const Level& other)
+{
+    Level copy(other);
+    std::swap(symbol_, copy.symbol_);
+    std::swap(owned_, copy.owned_);
+    return *this;
+}
+
+UUID::Level& UUID::Level::operator=(Level&& other) noexcept
+{
+    std::swap(symbol_, other.symbol_);
+    std::swap(owned_, other.owned_);
+    return *this;
+}
+
+UUID::Level::~Level()
+{
+    if (owned_) {
+        NameTable::instance().release(symbol_);
+    }
+}
+
 std::size_t UUID::Hasher::operator()(const UUID& k) const
 {
     return k.hash();
@@ -33,19 +253,24 @@ std::size_t UUID::depth() const
     return representation_.size();
 }
 
+UUID::Symbol UUID::symbol(std::size_t level) const
+{
+    return representation_[level];
+}
+
 bool UUID::global() const
 {
     if (empty() || composite()) {
         return false;
     }
 
-    return representation_.back().at(0) == ':';
+    return nameOf(representation_.back()).at(0) == ':';
 }
 
 std::string UUID::globalName() const
 {
     apex_assert_hard(global());
-    return representation_.back().substr(1);
+    return nameOf(representation_.back()).substr(1);
 }
 
 std::string UUID::stripNamespace(const std::string& name)
@@ -73,13 +298,13 @@ UUID& UUID::operator=(const UUID& other)
     return *this;
 }
 
-UUID::UUID(std::weak_ptr<UUIDProvider> parent, const UUID& copy) : UUID(parent, copy.representation_)
+UUID::UUID(std::weak_ptr<UUIDProvider> parent, const UUID& copy) : parent_(parent), representation_(copy.representation_)
 {
 }
 
-UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<std::string>& representation) : parent_(parent), representation_(representation)
+UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<Symbol>& representation) : parent_(parent), representation_(representation.begin(), representation.end())
 {
-    apex_assert_hard(representation_.empty() || representation_.back() != "~");
+    apex_assert_hard(representation_.empty() || nameOf(representation_.back()) != "~");
 }
 
 UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation) : parent_(parent)
@@ -115,7 +340,7 @@ UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation
         std::string sub_id = representation.substr(begin, end - begin);
 
         if (sub_id != "~") {
-            representation_.push_back(sub_id);
+            representation_.emplace_back(sub_id);
         }
         end = pos;
 
@@ -123,7 +348,7 @@ UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation
             return;
         }
     }
-    apex_assert_hard(representation_.empty() || representation_.back() != "~");
+    apex_assert_hard(representation_.empty() || nameOf(representation_.back()) != "~");
 }
 
 void UUID::free()
@@ -135,7 +360,7 @@ void UUID::free()
 
 bool UUID::operator<(const UUID& other) const
 {
-    return representation_ < other.representation_;
+    return std::lexicographical_compare(representation_.begin(), representation_.end(), other.representation_.begin(), other.representation_.end(), lessByName);
 }
 
 std::string UUID::getFullName() const
@@ -146,26 +371,26 @@ std::string UUID::getFullName() const
 
     std::stringstream ss;
     auto it = representation_.rbegin();
-    ss << *it;
+    ss << nameOf(*it);
     for (++it; it != representation_.rend(); ++it) {
         ss << namespace_separator;
-        ss << *it;
+        ss << nameOf(*it);
     }
     return ss.str();
 }
 
 std::size_t UUID::hash() const
 {
-    if (empty()) {
-        return 0;
-    } else {
-        return boost::hash<std::string>()(representation_.front());
+    std::size_t seed = 0;
+    for (Symbol s : representation_) {
+        boost::hash_combine(seed, s);
     }
+    return seed;
 }
 
 std::string UUID::getShortName() const
 {
-    return stripNamespace(representation_.front());
+    return stripNamespace(nameOf(representation_.front()));
 }
 
 bool UUID::composite() const
@@ -175,8 +400,8 @@ bool UUID::composite() const
 
 bool UUID::contains(const std::string& sub) const
 {
-    for (const std::string& s : representation_) {
-        if (s == sub) {
+    for (Symbol s : representation_) {
+        if (nameOf(s) == sub) {
             return true;
         }
     }
@@ -200,9 +425,9 @@ UUID UUID::nestedUUID() const
 UUID UUID::rootUUID() const
 {
     if (auto parent = parent_.lock()) {
-        return UUID(parent, representation_.back());
+        return UUID(parent, std::vector<Symbol>{ representation_.back() });
     } else {
-        return UUID(std::weak_ptr<UUIDProvider>(), representation_.back());
+        return UUID(std::weak_ptr<UUIDProvider>(), std::vector<Symbol>{ representation_.back() });
     }
 }
 
@@ -211,11 +436,11 @@ UUID UUID::reshape(std::size_t _depth) const
     if (_depth > depth()) {
         throw std::invalid_argument("cannot reshape UUID to a larger size");
     }
-    return UUID(parent_, std::vector<std::string>(representation_.begin(), representation_.begin() + static_cast<long>(_depth)));
+    return UUID(parent_, std::vector<Symbol>(representation_.begin(), representation_.begin() + static_cast<long>(_depth)));
 }
 UUID UUID::reshapeSoft(std::size_t max_depth) const
 {
-    return UUID(parent_, std::vector<std::string>(representation_.begin(), representation_.begin() + static_cast<long>(std::min(depth(), max_depth))));
+    return UUID(parent_, std::vector<Symbol>(representation_.begin(), representation_.begin() + static_cast<long>(std::min(depth(), max_depth))));
 }
 
 UUID UUID::makeRelativeTo(const UUID& prefix) const
@@ -227,7 +452,7 @@ UUID UUID::makeRelativeTo(const UUID& prefix) const
         ++this_it;
     }
 
-    auto reversed = std::vector<std::string>(this_it, representation_.rend());
+    auto reversed = std::vector<Symbol>(this_it, representation_.rend());
     std::reverse(reversed.begin(), reversed.end());
     return UUID(parent_, reversed);
 }
@@ -240,13 +465,13 @@ UUID UUID::id() const
 std::string UUID::type() const
 {
     apex_assert_hard(!representation_.empty());
-    std::string t = representation_.front();
+    const std::string& t = nameOf(representation_.front());
     return t.substr(0, t.find("_"));
 }
 std::string UUID::name() const
 {
     apex_assert_hard(!representation_.empty());
-    std::string t = representation_.front();
+    const std::string& t = nameOf(representation_.front());
     return t.substr(t.find("_") + 1);
 }
 
@@ -255,7 +480,7 @@ AUUID UUID::getAbsoluteUUID() const
     if (auto parent = parent_.lock()) {
         UUID parent_uuid = parent->getAbsoluteUUID();
         UUID uuid = *this;
-        for (const std::string& part : parent_uuid.representation_) {
+        for (Symbol part : parent_uuid.representation_) {
             uuid.representation_.push_back(part);
         }
         return AUUID(uuid);
@@ -286,17 +511,7 @@ bool operator==(const UUID& uuid_, const std::string& str)
 }
 bool operator==(const UUID& a, const UUID& b)
 {
-    if (a.representation_.size() != b.representation_.size()) {
-        return false;
-    }
-
-    for (auto ita = a.representation_.begin(), itb = b.representation_.begin(); ita != a.representation_.end(); ++ita, ++itb) {
-        if (*ita != *itb) {
-            return false;
-        }
-    }
-
-    return true;
+    return a.representation_ == b.representation_;
 }
 
 bool operator!=(const UUID& a, const UUID& b)
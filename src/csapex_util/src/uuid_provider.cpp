@@ -80,7 +80,7 @@ UUID UUIDProvider::generateUUID(const std::string& prefix)
 UUID UUIDProvider::makeDerivedUUID(const UUID& parent, const UUID& child)
 {
     UUID result = child;
-    for (const std::string& level : parent.representation_) {
+    for (UUID::Symbol level : parent.representation_) {
         result.representation_.push_back(level);
     }
     registerUUID(result);
@@ -90,7 +90,7 @@ UUID UUIDProvider::makeDerivedUUID(const UUID& parent, const UUID& child)
 UUID UUIDProvider::makeDerivedUUID_forced(const UUID& parent, const UUID& child)
 {
     UUID result = child;
-    for (const std::string& level : parent.representation_) {
+    for (UUID::Symbol level : parent.representation_) {
         result.representation_.push_back(level);
     }
     return result;
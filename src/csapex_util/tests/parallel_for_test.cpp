@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+
+#include <csapex/utility/parallel_for.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace csapex;
+
+TEST(ParallelForTest, EveryIndexIsVisitedOnce)
+{
+    for (std::size_t threads : { 0, 1, 3, 64 }) {
+        std::vector<std::atomic<int>> visits(1000);
+        for (std::atomic<int>& v : visits) {
+            v = 0;
+        }
+
+        parallelFor(visits.size(), threads, [&](std::size_t i) { ++visits[i]; });
+
+        for (const std::atomic<int>& v : visits) {
+            ASSERT_EQ(1, v);
+        }
+    }
+}
+
+TEST(ParallelForTest, EmptyRangeIsAllowed)
+{
+    bool called = false;
+    parallelFor(0, 4, [&](std::size_t) { called = true; });
+    ASSERT_FALSE(called);
+}
+
+TEST(ParallelForTest, ExceptionsArePropagated)
+{
+    std::atomic<int> calls(0);
+    ASSERT_THROW(parallelFor(100, 4,
+                             [&](std::size_t i) {
+                                 ++calls;
+                                 if (i == 10) {
+                                     throw std::runtime_error("failure");
+                                 }
+                             }),
+                 std::runtime_error);
+    ASSERT_LE(calls, 100);
+}
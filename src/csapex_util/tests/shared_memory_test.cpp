@@ -2,9 +2,12 @@
 
 #include <csapex/utility/subprocess.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <thread>
 #include <condition_variable>
+#include <vector>
 
 using namespace csapex;
 
@@ -376,3 +379,73 @@ TEST_F(SharedMemoryTest, MessageHandleActsAsRAII)
 
     ASSERT_EQ(SubprocessChannel::MessageType::PROCESS_SYNC, sp.out.read().type);
 }
+
+TEST_F(SharedMemoryTest, LargeMessagesGrowThePayloadRegion)
+{
+    Subprocess sp("test");
+
+    std::vector<uint8_t> large(4 * 1024 * 1024);
+    for (std::size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<uint8_t>(i * 31);
+    }
+    ASSERT_LT(sp.in.getPayloadCapacity(), large.size());
+
+    sp.fork([&sp]() {
+        for (std::size_t i = 0; i < 2; ++i) {
+            SubprocessChannel::Message message = sp.in.read();
+
+            // echo the message, this grows the region of the other channel from within the child
+            std::vector<uint8_t> copy(message.data, message.data + message.length);
+            sp.out.write({ SubprocessChannel::MessageType::PROCESS_SYNC, copy.data(), copy.size() });
+        }
+    });
+
+    sp.in.write({ SubprocessChannel::MessageType::PROCESS_SYNC, large.data(), large.size() });
+    {
+        SubprocessChannel::Message message = sp.out.read();
+        ASSERT_EQ(SubprocessChannel::MessageType::PROCESS_SYNC, message.type);
+        ASSERT_EQ(large.size(), message.length);
+        EXPECT_TRUE(std::equal(large.begin(), large.end(), message.data));
+    }
+    EXPECT_GE(sp.in.getPayloadCapacity(), large.size());
+
+    // small messages reuse the grown region
+    sp.in.write({ SubprocessChannel::MessageType::PROCESS_SYNC, "small" });
+    {
+        SubprocessChannel::Message message = sp.out.read();
+        EXPECT_EQ("small", message.toString());
+    }
+}
+
+TEST_F(SharedMemoryTest, MessagesCanBeWrittenInPlace)
+{
+    Subprocess sp("test");
+
+    sp.fork([&sp]() {
+        std::string received;
+        {
+            SubprocessChannel::Message message = sp.in.read();
+            received = message.toString();
+        }
+
+        // answer in place as well
+        SubprocessChannel::Payload payload = sp.out.acquirePayload();
+        std::string answer = received + " back";
+        std::memcpy(payload.data, answer.data(), answer.size());
+        sp.out.write({ SubprocessChannel::MessageType::PROCESS_FINISHED, payload.data, answer.size() });
+    });
+
+    {
+        SubprocessChannel::Payload payload = sp.in.acquirePayload();
+        ASSERT_NE(nullptr, payload.data);
+        ASSERT_EQ(sp.in.getPayloadCapacity(), payload.capacity);
+
+        std::string request = "there and";
+        std::memcpy(payload.data, request.data(), request.size());
+        sp.in.write({ SubprocessChannel::MessageType::PROCESS_SYNC, payload.data, request.size() });
+    }
+
+    SubprocessChannel::Message message = sp.out.read();
+    ASSERT_EQ(SubprocessChannel::MessageType::PROCESS_FINISHED, message.type);
+    EXPECT_EQ("there and back", message.toString());
+}
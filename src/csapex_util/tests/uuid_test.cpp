@@ -247,6 +247,78 @@ TEST_F(UUIDTest, UUIDsCanBeReshaped)
     ASSERT_THROW(baz.reshape(1000), std::invalid_argument);
 }
 
+TEST_F(UUIDTest, LevelsAreInterned)
+{
+    UUID a = UUIDProvider::makeUUID_without_parent("graph_0:|:node_1");
+    UUID b = UUIDProvider::makeUUID_without_parent("node_1");
+
+    ASSERT_EQ(2, a.depth());
+    EXPECT_EQ(a.symbol(0), b.symbol(0));
+    EXPECT_NE(a.symbol(0), a.symbol(1));
+    EXPECT_EQ(UUID::intern("graph_0"), a.symbol(1));
+    EXPECT_EQ("node_1", UUID::nameOf(a.symbol(0)));
+
+    EXPECT_EQ(b, a.id());
+    EXPECT_EQ(UUID::Hasher()(b), UUID::Hasher()(a.id()));
+}
+
+TEST_F(UUIDTest, OrderingFollowsTheNames)
+{
+    // intern in reverse order, the ordering must not depend on the symbols
+    UUID z = UUIDProvider::makeUUID_without_parent("order_z");
+    UUID a = UUIDProvider::makeUUID_without_parent("order_a");
+    UUID za = UUIDProvider::makeUUID_without_parent("order_a:|:order_z");
+
+    EXPECT_TRUE(a < z);
+    EXPECT_FALSE(z < a);
+    EXPECT_FALSE(a < a);
+    EXPECT_TRUE(z < za);
+}
+
+TEST_F(UUIDTest, NameTableGrowsBeyondOneDirectory)
+{
+    // one directory covers 2^20 symbols, the names have to stay resolvable after the next one is allocated
+    const std::size_t names = (1 << 20) + 2000;
+    std::vector<UUID::Symbol> symbols;
+    symbols.reserve(names);
+    for (std::size_t i = 0; i < names; ++i) {
+        symbols.push_back(UUID::intern("grow_" + std::to_string(i)));
+    }
+
+    for (std::size_t i = 0; i < names; i += 997) {
+        EXPECT_EQ("grow_" + std::to_string(i), UUID::nameOf(symbols[i]));
+    }
+    EXPECT_EQ("grow_" + std::to_string(names - 1), UUID::nameOf(symbols.back()));
+    EXPECT_EQ(symbols.back(), UUID::intern("grow_" + std::to_string(names - 1)));
+}
+
+TEST_F(UUIDTest, NamesAreRemovedWithTheirLastUUID)
+{
+    const std::size_t before = UUID::countNames();
+    {
+        UUID a = UUIDProvider::makeUUID_without_parent("refcount_parent:|:refcount_child");
+        EXPECT_EQ(before + 2, UUID::countNames());
+
+        UUID parent = a.parentUUID();
+        UUID copy = a;
+        a = UUID();
+        EXPECT_EQ(before + 2, UUID::countNames());
+        EXPECT_EQ("refcount_parent:|:refcount_child", copy.getFullName());
+
+        copy = UUID();
+        EXPECT_EQ(before + 1, UUID::countNames());
+        EXPECT_EQ("refcount_parent", parent.getFullName());
+    }
+    EXPECT_EQ(before, UUID::countNames());
+
+    // freed symbols are reused for new names
+    for (int i = 0; i < 1000; ++i) {
+        UUID tmp = UUIDProvider::makeUUID_without_parent("refcount_" + std::to_string(i));
+        EXPECT_EQ("refcount_" + std::to_string(i), tmp.getFullName());
+    }
+    EXPECT_EQ(before, UUID::countNames());
+}
+
 // test reshaping thoroughly
 // refactor other methods to use reshape
 // implement reshape more efficiently